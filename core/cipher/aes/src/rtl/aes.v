@@ -4,6 +4,23 @@
 // --------
 // Top level wrapper for the AES block cipher core.
 //
+// Besides single block operations the wrapper can run the core in
+// counter (CTR) mode on its own: the host loads a counter block and
+// the number of blocks, gives one start command, and then reads the
+// keystream out of a FIFO while the core keeps generating it. The
+// counter is incremented in the core, over the full block or over the
+// low 64 or 32 bits as set in the config register. The keystream FIFO
+// is emptied when a run starts, and a run can be aborted at any time
+// with the abort bit in the control register, which also empties the
+// FIFO.
+//
+// The key memory has 16 slots. Init expands the key into the slot
+// selected in the key slot register, and blocks are processed with
+// the schedule in the selected slot, so the host can switch between
+// up to 16 expanded keys by writing the slot register only. The
+// erase bit in the control register zeroes the schedule in the
+// selected slot and the key registers.
+//
 //
 // Author: Joachim Strombergson
 // Copyright (c) 2014, NORDUnet A/S
@@ -63,14 +80,28 @@ module aes(
   localparam ADDR_CTRL        = 8'h08;
   localparam CTRL_INIT_BIT    = 0;
   localparam CTRL_NEXT_BIT    = 1;
+  localparam CTRL_CTR_BIT     = 2;
+  localparam CTRL_ABORT_BIT   = 3;
+  localparam CTRL_ERASE_BIT   = 4;
 
   localparam ADDR_STATUS      = 8'h09;
   localparam STATUS_READY_BIT = 0;
   localparam STATUS_VALID_BIT = 1;
+  localparam STATUS_CTR_BIT   = 2;
 
   localparam ADDR_CONFIG      = 8'h0a;
   localparam CTRL_ENCDEC_BIT  = 0;
   localparam CTRL_KEYLEN_BIT  = 1;
+  localparam CTRL_CTRW_LOW    = 2;
+  localparam CTRL_CTRW_HIGH   = 3;
+
+  localparam ADDR_CTR_BLOCKS  = 8'h0b;
+  localparam ADDR_KS_AVAIL    = 8'h0c;
+
+  // Key slot used by init and block processing, and the number of
+  // slots in the key memory.
+  localparam ADDR_KEY_SLOT    = 8'h0d;
+  localparam ADDR_KEY_SLOTS   = 8'h0e;
 
   localparam ADDR_KEY0        = 8'h10;
   localparam ADDR_KEY7        = 8'h17;
@@ -83,9 +114,34 @@ module aes(
   localparam ADDR_RESULT2     = 8'h32;
   localparam ADDR_RESULT3     = 8'h33;
 
+  localparam ADDR_CTR0        = 8'h40;
+  localparam ADDR_CTR3        = 8'h43;
+
+  // Keystream read window. Every read in the window returns the next
+  // 32-bit word from the keystream FIFO, allowing the host to do burst
+  // reads of up to ADDR_KS_AVAIL words without polling status.
+  localparam ADDR_KS_DATA      = 8'h60;
+  localparam ADDR_KS_DATA_LAST = 8'h7f;
+
+  // Counter increment widths.
+  localparam CTRW_128         = 2'h0;
+  localparam CTRW_64          = 2'h1;
+  localparam CTRW_32          = 2'h2;
+
+  // Keystream FIFO, in blocks.
+  localparam KS_DEPTH         = 8;
+
+  // Key memory slots.
+  localparam SLOT_BITS        = 4;
+  localparam NUM_SLOTS        = 1 << SLOT_BITS;
+
+  localparam CTR_IDLE         = 2'h0;
+  localparam CTR_START        = 2'h1;
+  localparam CTR_WAIT         = 2'h2;
+
   localparam CORE_NAME0       = 32'h61657320; // "aes "
   localparam CORE_NAME1       = 32'h20202020; // "    "
-  localparam CORE_VERSION     = 32'h302e3630; // "0.60"
+  localparam CORE_VERSION     = 32'h302e3932; // "0.92"
 
 
   //----------------------------------------------------------------
@@ -97,10 +153,21 @@ module aes(
   reg next_reg;
   reg next_new;
 
+  reg erase_reg;
+  reg erase_new;
+
+  reg ctr_start_new;
+
   reg encdec_reg;
   reg keylen_reg;
   reg config_we;
 
+  reg [1 : 0] ctrw_reg;
+
+  reg [(SLOT_BITS - 1) : 0] key_slot_reg;
+  reg                       key_slot_we;
+  reg [(NUM_SLOTS - 1) : 0] slot_keylen_reg;
+
   reg [31 : 0] block_reg [0 : 3];
   reg          block_we;
 
@@ -111,6 +178,31 @@ module aes(
   reg           valid_reg;
   reg           ready_reg;
 
+  reg [31 : 0]  ctr_reg [0 : 3];
+  reg           ctr_we;
+  reg [127 : 0] ctr_inc_new;
+  reg           ctr_inc_we;
+
+  reg [31 : 0]  ctr_blocks_reg;
+  reg [31 : 0]  ctr_blocks_new;
+  reg           ctr_blocks_we;
+  reg           ctr_blocks_dec;
+  reg           ctr_blocks_set;
+
+  reg [1 : 0]   ctr_ctrl_reg;
+  reg [1 : 0]   ctr_ctrl_new;
+  reg           ctr_ctrl_we;
+
+  reg           ctr_abort_reg;
+  reg           ctr_abort;
+
+  reg [127 : 0] ks_mem [0 : (KS_DEPTH - 1)];
+  reg           ks_push;
+  reg [3 : 0]   ks_wr_ptr_reg;
+  reg [5 : 0]   ks_rd_ptr_reg;
+  reg           ks_pop;
+  reg           ks_flush;
+
 
   //----------------------------------------------------------------
   // Wires.
@@ -118,9 +210,18 @@ module aes(
   reg [31 : 0]   tmp_read_data;
   reg            tmp_error;
 
+  reg            ctr_next;
+  wire           ctr_busy;
+  wire [127 : 0] ctr_block;
+  wire [3 : 0]   ks_blocks;
+  wire [5 : 0]   ks_words;
+  wire [127 : 0] ks_head;
+  wire [31 : 0]  ks_data;
+
   wire           core_encdec;
   wire           core_init;
   wire           core_next;
+  wire           core_erase;
   wire           core_ready;
   wire [255 : 0] core_key;
   wire           core_keylen;
@@ -138,28 +239,47 @@ module aes(
   assign core_key = {key_reg[0], key_reg[1], key_reg[2], key_reg[3],
                      key_reg[4], key_reg[5], key_reg[6], key_reg[7]};
 
-  assign core_block  = {block_reg[0], block_reg[1],
-                        block_reg[2], block_reg[3]};
+  assign core_block  = ctr_busy ? ctr_block :
+                       {block_reg[0], block_reg[1], block_reg[2], block_reg[3]};
+
   assign core_init   = init_reg;
-  assign core_next   = next_reg;
-  assign core_encdec = encdec_reg;
-  assign core_keylen = keylen_reg;
+  assign core_next   = next_reg | ctr_next;
+  assign core_erase  = erase_reg;
+  assign core_encdec = encdec_reg | ctr_busy;
+
+  assign ctr_busy  = (ctr_ctrl_reg != CTR_IDLE);
+  assign ctr_block = {ctr_reg[0], ctr_reg[1], ctr_reg[2], ctr_reg[3]};
+
+  // Blocks in the FIFO, and words left to read. The write pointer
+  // counts blocks, the read pointer counts words, both with one extra
+  // bit to tell a full FIFO from an empty one.
+  assign ks_blocks = ks_wr_ptr_reg - ks_rd_ptr_reg[5 : 2];
+  assign ks_words  = {ks_wr_ptr_reg, 2'b00} - ks_rd_ptr_reg;
+  assign ks_head   = ks_mem[ks_rd_ptr_reg[4 : 2]];
+  assign ks_data   = ks_head[(3 - ks_rd_ptr_reg[1 : 0]) * 32 +: 32];
+
+  // The key length is remembered per slot when the key is expanded,
+  // so that switching slot also switches key length.
+  assign core_keylen = slot_keylen_reg[key_slot_reg];
 
 
   //----------------------------------------------------------------
   // core instantiation.
   //----------------------------------------------------------------
-  aes_core core(
+  aes_core #(.SLOT_BITS(SLOT_BITS))
+           core(
                 .clk(clk),
                 .reset_n(reset_n),
 
                 .encdec(core_encdec),
                 .init(core_init),
                 .next(core_next),
+                .erase(core_erase),
                 .ready(core_ready),
 
                 .key(core_key),
                 .keylen(core_keylen),
+                .key_slot(key_slot_reg),
 
                 .block(core_block),
                 .result(core_result),
@@ -185,14 +305,31 @@ module aes(
           for (i = 0 ; i < 8 ; i = i + 1)
             key_reg[i] <= 32'h0;
 
+          for (i = 0 ; i < 4 ; i = i + 1)
+            ctr_reg[i] <= 32'h0;
+
+          for (i = 0 ; i < KS_DEPTH ; i = i + 1)
+            ks_mem[i] <= 128'h0;
+
           init_reg   <= 1'b0;
           next_reg   <= 1'b0;
+          erase_reg  <= 1'b0;
           encdec_reg <= 1'b0;
           keylen_reg <= 1'b0;
+          ctrw_reg   <= CTRW_128;
+
+          key_slot_reg    <= {SLOT_BITS{1'b0}};
+          slot_keylen_reg <= {NUM_SLOTS{1'b0}};
 
           result_reg <= 128'h0;
           valid_reg  <= 1'b0;
           ready_reg  <= 1'b0;
+
+          ctr_blocks_reg <= 32'h0;
+          ctr_ctrl_reg   <= CTR_IDLE;
+          ctr_abort_reg  <= 1'b0;
+          ks_wr_ptr_reg  <= 4'h0;
+          ks_rd_ptr_reg  <= 6'h0;
         end
       else
         begin
@@ -201,11 +338,26 @@ module aes(
           result_reg <= core_result;
           init_reg   <= init_new;
           next_reg   <= next_new;
+          erase_reg  <= erase_new;
 
           if (config_we)
             begin
               encdec_reg <= write_data[CTRL_ENCDEC_BIT];
               keylen_reg <= write_data[CTRL_KEYLEN_BIT];
+              ctrw_reg   <= write_data[CTRL_CTRW_HIGH : CTRL_CTRW_LOW];
+            end
+
+          if (key_slot_we)
+            key_slot_reg <= write_data[(SLOT_BITS - 1) : 0];
+
+          if (init_new)
+            slot_keylen_reg[key_slot_reg] <= keylen_reg;
+
+          if (erase_new)
+            begin
+              slot_keylen_reg[key_slot_reg] <= 1'b0;
+              for (i = 0 ; i < 8 ; i = i + 1)
+                key_reg[i] <= 32'h0;
             end
 
           if (key_we)
@@ -213,10 +365,174 @@ module aes(
 
           if (block_we)
             block_reg[address[1 : 0]] <= write_data;
+
+          if (ctr_we)
+            ctr_reg[address[1 : 0]] <= write_data;
+
+          if (ctr_inc_we)
+            begin
+              ctr_reg[0] <= ctr_inc_new[127 : 96];
+              ctr_reg[1] <= ctr_inc_new[95 : 64];
+              ctr_reg[2] <= ctr_inc_new[63 : 32];
+              ctr_reg[3] <= ctr_inc_new[31 : 0];
+            end
+
+          if (ctr_blocks_we)
+            ctr_blocks_reg <= ctr_blocks_new;
+
+          if (ctr_ctrl_we)
+            ctr_ctrl_reg <= ctr_ctrl_new;
+
+          // An abort is held until the FSM is back in idle.
+          if (ctr_abort)
+            ctr_abort_reg <= 1'b1;
+          else if (!ctr_busy)
+            ctr_abort_reg <= 1'b0;
+
+          if (ks_flush)
+            begin
+              ks_wr_ptr_reg <= 4'h0;
+              ks_rd_ptr_reg <= 6'h0;
+            end
+          else
+            begin
+              if (ks_push)
+                begin
+                  ks_mem[ks_wr_ptr_reg[2 : 0]] <= core_result;
+                  ks_wr_ptr_reg <= ks_wr_ptr_reg + 1'b1;
+                end
+
+              if (ks_pop)
+                ks_rd_ptr_reg <= ks_rd_ptr_reg + 1'b1;
+            end
         end
     end // reg_update
 
 
+  //----------------------------------------------------------------
+  // ctr_inc
+  //
+  // The next counter block. Only the low ctrw bits of the counter
+  // are incremented, the rest of the block is left as it is.
+  //----------------------------------------------------------------
+  always @*
+    begin : ctr_inc
+      case (ctrw_reg)
+        CTRW_64:
+          ctr_inc_new = {ctr_block[127 : 64], ctr_block[63 : 0] + 1'b1};
+
+        CTRW_32:
+          ctr_inc_new = {ctr_block[127 : 32], ctr_block[31 : 0] + 1'b1};
+
+        default:
+          ctr_inc_new = ctr_block + 1'b1;
+      endcase // case (ctrw_reg)
+    end // ctr_inc
+
+
+  //----------------------------------------------------------------
+  // ctr_blocks_logic
+  //
+  // The number of blocks left to generate. Written by the host
+  // before a CTR run, counted down as blocks are generated and
+  // cleared by an abort.
+  //----------------------------------------------------------------
+  always @*
+    begin : ctr_blocks_logic
+      ctr_blocks_new = 32'h0;
+      ctr_blocks_we  = 1'b0;
+
+      if (ctr_abort)
+        begin
+          ctr_blocks_new = 32'h0;
+          ctr_blocks_we  = 1'b1;
+        end
+      else if (ctr_blocks_dec)
+        begin
+          ctr_blocks_new = ctr_blocks_reg - 1'b1;
+          ctr_blocks_we  = 1'b1;
+        end
+      else if (ctr_blocks_set)
+        begin
+          ctr_blocks_new = write_data;
+          ctr_blocks_we  = 1'b1;
+        end
+    end // ctr_blocks_logic
+
+
+  //----------------------------------------------------------------
+  // ctr_ctrl
+  //
+  // CTR mode FSM. Runs the core on the counter block for as long
+  // as there are blocks left to generate and room in the keystream
+  // FIFO, pushing each result into the FIFO and incrementing the
+  // counter. The counter is updated when the result is pushed, so
+  // it is stable when the encipher datapath samples it.
+  //
+  // On an abort the block in the core, if any, is allowed to finish
+  // so that the core is ready for the host, but its result is
+  // dropped and the FSM goes back to idle.
+  //----------------------------------------------------------------
+  always @*
+    begin : ctr_ctrl
+      ctr_next       = 1'b0;
+      ctr_inc_we     = 1'b0;
+      ctr_blocks_dec = 1'b0;
+      ks_push        = 1'b0;
+      ctr_ctrl_new   = CTR_IDLE;
+      ctr_ctrl_we    = 1'b0;
+
+      case (ctr_ctrl_reg)
+        CTR_IDLE:
+          begin
+            if (ctr_start_new)
+              begin
+                ctr_ctrl_new = CTR_START;
+                ctr_ctrl_we  = 1'b1;
+              end
+          end
+
+        CTR_START:
+          begin
+            if ((ctr_blocks_reg == 32'h0) || ctr_abort_reg)
+              begin
+                ctr_ctrl_new = CTR_IDLE;
+                ctr_ctrl_we  = 1'b1;
+              end
+            else if (core_ready && (ks_blocks != KS_DEPTH))
+              begin
+                ctr_next     = 1'b1;
+                ctr_ctrl_new = CTR_WAIT;
+                ctr_ctrl_we  = 1'b1;
+              end
+          end
+
+        CTR_WAIT:
+          begin
+            if (core_ready && ctr_abort_reg)
+              begin
+                ctr_ctrl_new = CTR_IDLE;
+                ctr_ctrl_we  = 1'b1;
+              end
+            else if (core_ready)
+              begin
+                ks_push        = 1'b1;
+                ctr_inc_we     = 1'b1;
+                ctr_blocks_dec = 1'b1;
+                ctr_ctrl_new   = CTR_START;
+                ctr_ctrl_we    = 1'b1;
+              end
+          end
+
+        default:
+          begin
+            ctr_ctrl_new = CTR_IDLE;
+            ctr_ctrl_we  = 1'b1;
+          end
+      endcase // case (ctr_ctrl_reg)
+    end // ctr_ctrl
+
+
   //----------------------------------------------------------------
   // api
   //
@@ -224,42 +540,89 @@ module aes(
   //----------------------------------------------------------------
   always @*
     begin : api
-      init_new      = 1'b0;
-      next_new      = 1'b0;
-      config_we     = 1'b0;
-      key_we        = 1'b0;
-      block_we      = 1'b0;
-      tmp_read_data = 32'h0;
-      tmp_error     = 1'b0;
+      init_new       = 1'b0;
+      next_new       = 1'b0;
+      erase_new      = 1'b0;
+      ctr_start_new  = 1'b0;
+      config_we      = 1'b0;
+      key_slot_we    = 1'b0;
+      key_we         = 1'b0;
+      block_we       = 1'b0;
+      ctr_we         = 1'b0;
+      ctr_blocks_set = 1'b0;
+      ks_pop         = 1'b0;
+      ks_flush       = 1'b0;
+      ctr_abort      = 1'b0;
+      tmp_read_data  = 32'h0;
+      tmp_error      = 1'b0;
 
       if (cs)
         begin
           if (we)
             begin
-              if (address == ADDR_CTRL)
+              // The core, the counter and the config belong to the
+              // CTR FSM while it is running. Only an abort is taken
+              // then, and it wins over the other control bits. The
+              // keystream FIFO is emptied when a run starts or is
+              // aborted, so no stale keystream is ever read out.
+              if ((address == ADDR_CTRL) && write_data[CTRL_ABORT_BIT])
+                begin
+                  ctr_abort = 1'b1;
+                  ks_flush  = 1'b1;
+                end
+              else if ((address == ADDR_CTRL) && !ctr_busy)
                 begin
-                  init_new = write_data[CTRL_INIT_BIT];
-                  next_new = write_data[CTRL_NEXT_BIT];
+                  init_new      = write_data[CTRL_INIT_BIT];
+                  next_new      = write_data[CTRL_NEXT_BIT];
+                  erase_new     = write_data[CTRL_ERASE_BIT];
+                  ctr_start_new = write_data[CTRL_CTR_BIT];
+                  ks_flush      = write_data[CTRL_CTR_BIT];
                 end
 
-              if (address == ADDR_CONFIG)
+              if ((address == ADDR_CONFIG) && !ctr_busy)
                 config_we = 1'b1;
 
+              // The slot must not change under the key expansion or
+              // a block being processed.
+              if ((address == ADDR_KEY_SLOT) && !ctr_busy && core_ready)
+                key_slot_we = 1'b1;
+
               if ((address >= ADDR_KEY0) && (address <= ADDR_KEY7))
                 key_we = 1'b1;
 
               if ((address >= ADDR_BLOCK0) && (address <= ADDR_BLOCK3))
                 block_we = 1'b1;
+
+              if ((address >= ADDR_CTR0) && (address <= ADDR_CTR3) && !ctr_busy)
+                ctr_we = 1'b1;
+
+              if ((address == ADDR_CTR_BLOCKS) && !ctr_busy)
+                ctr_blocks_set = 1'b1;
             end // if (we)
 
+          else if ((address >= ADDR_KS_DATA) && (address <= ADDR_KS_DATA_LAST))
+            begin
+              // Reads in the keystream window. Words are only
+              // consumed when the FIFO has data, reading an empty
+              // FIFO is signalled as an error.
+              tmp_read_data = ks_data;
+              ks_pop        = (ks_words != 6'h0);
+              tmp_error     = (ks_words == 6'h0);
+            end
+
           else
             begin
               case (address)
-                ADDR_NAME0:   tmp_read_data = CORE_NAME0;
-                ADDR_NAME1:   tmp_read_data = CORE_NAME1;
-                ADDR_VERSION: tmp_read_data = CORE_VERSION;
-                ADDR_CTRL:    tmp_read_data = {28'h0, keylen_reg, encdec_reg, next_reg, init_reg};
-                ADDR_STATUS:  tmp_read_data = {30'h0, valid_reg, ready_reg};
+                ADDR_NAME0:      tmp_read_data = CORE_NAME0;
+                ADDR_NAME1:      tmp_read_data = CORE_NAME1;
+                ADDR_VERSION:    tmp_read_data = CORE_VERSION;
+                ADDR_CTRL:       tmp_read_data = {28'h0, keylen_reg, encdec_reg, next_reg, init_reg};
+                ADDR_STATUS:     tmp_read_data = {29'h0, ctr_busy, valid_reg, ready_reg};
+                ADDR_CONFIG:     tmp_read_data = {28'h0, ctrw_reg, keylen_reg, encdec_reg};
+                ADDR_CTR_BLOCKS: tmp_read_data = ctr_blocks_reg;
+                ADDR_KS_AVAIL:   tmp_read_data = {26'h0, ks_words};
+                ADDR_KEY_SLOT:   tmp_read_data = key_slot_reg;
+                ADDR_KEY_SLOTS:  tmp_read_data = NUM_SLOTS;
 
                 default:
                   begin
@@ -268,6 +631,9 @@ module aes(
 
               if ((address >= ADDR_RESULT0) && (address <= ADDR_RESULT3))
                 tmp_read_data = result_reg[(3 - (address - ADDR_RESULT0)) * 32 +: 32];
+
+              if ((address >= ADDR_CTR0) && (address <= ADDR_CTR3))
+                tmp_read_data = ctr_reg[address[1 : 0]];
             end
         end
     end // addr_decoder
@@ -38,17 +38,20 @@
 //
 //======================================================================
 
-module aes_core(
+module aes_core #(parameter SLOT_BITS = 4)
+               (
                 input wire            clk,
                 input wire            reset_n,
 
                 input wire            encdec,
                 input wire            init,
                 input wire            next,
+                input wire            erase,
                 output wire           ready,
 
                 input wire [255 : 0]  key,
                 input wire            keylen,
+                input wire [(SLOT_BITS - 1) : 0] key_slot,
 
                 input wire [127 : 0]  block,
                 output wire [127 : 0] result,
@@ -149,13 +152,16 @@ module aes_core(
                               );
 
 
-  aes_key_mem keymem(
+  aes_key_mem #(.SLOT_BITS(SLOT_BITS))
+              keymem(
                      .clk(clk),
                      .reset_n(reset_n),
 
                      .key(key),
                      .keylen(keylen),
                      .init(init),
+                     .erase(erase),
+                     .slot(key_slot),
 
                      .round(muxed_round_nr),
                      .round_key(round_key),
@@ -275,7 +281,9 @@ module aes_core(
       case (aes_core_ctrl_reg)
         CTRL_IDLE:
           begin
-            if (init)
+            // An erase of the key slot is handled like an init,
+            // the core is not ready until the key memory is.
+            if (init || erase)
               begin
                 init_state        = 1'b1;
                 ready_new         = 1'b0;
@@ -3,6 +3,10 @@
 // aes_key_mem.v
 // -------------
 // The AES key memort including round key generator.
+// The memory has 2**SLOT_BITS slots, each holding an expanded key
+// schedule, so that switching between keys that have already been
+// expanded only needs a change of slot. Erase zeroes all round keys
+// in the selected slot.
 //
 //
 // Author: Joachim Strombergson
@@ -37,13 +41,16 @@
 //
 //======================================================================
 
-module aes_key_mem(
+module aes_key_mem #(parameter SLOT_BITS = 4)
+                  (
                    input wire            clk,
                    input wire            reset_n,
 
                    input wire [255 : 0]  key,
                    input wire            keylen,
                    input wire            init,
+                   input wire            erase,
+                   input wire [(SLOT_BITS - 1) : 0] slot,
 
                    input wire    [3 : 0] round,
                    output wire [127 : 0] round_key,
@@ -68,12 +75,17 @@ module aes_key_mem(
   localparam CTRL_INIT     = 3'h1;
   localparam CTRL_GENERATE = 3'h2;
   localparam CTRL_DONE     = 3'h3;
+  localparam CTRL_ERASE    = 3'h4;
+
+  // Every key slot holds a full schedule of 16 round keys, of which
+  // 11 or 15 are used.
+  localparam NUM_SLOTS     = 1 << SLOT_BITS;
 
 
   //----------------------------------------------------------------
   // Registers.
   //----------------------------------------------------------------
-  reg [127 : 0] key_mem [0 : 14];
+  reg [127 : 0] key_mem [0 : (16 * NUM_SLOTS - 1)];
   reg [127 : 0] key_mem_new;
   reg           key_mem_we;
 
@@ -112,6 +124,7 @@ module aes_key_mem(
   reg [31 : 0] tmp_sboxw;
 
   reg           round_key_update;
+  reg           round_key_erase;
   reg [3 : 0]   num_rounds;
 
   reg [127 : 0] tmp_round_key;
@@ -134,13 +147,8 @@ module aes_key_mem(
   //----------------------------------------------------------------
   always @ (posedge clk or negedge reset_n)
     begin: reg_update
-      integer i;
-
       if (!reset_n)
         begin
-          for (i = 0 ; i < 14 ; i = i + 1)
-            key_mem [i] <= 128'h0;
-
           prev_key0_reg    <= 128'h0;
           prev_key1_reg    <= 128'h0;
           rcon_reg         <= 8'h0;
@@ -159,9 +167,6 @@ module aes_key_mem(
           if (rcon_we)
             rcon_reg <= rcon_new;
 
-          if (key_mem_we)
-            key_mem[round_ctr_reg] <= key_mem_new;
-
           if (prev_key0_we)
             prev_key0_reg <= prev_key0_new;
 
@@ -174,14 +179,30 @@ module aes_key_mem(
     end // reg_update
 
 
+  //----------------------------------------------------------------
+  // key_mem_update
+  //
+  // Write port for the key memory. The memory has no reset so that
+  // it can be mapped to distributed RAM, the schedules in the slots
+  // are only valid after init. A slot is wiped with erase, which
+  // writes zero to its 16 round keys one per cycle.
+  //----------------------------------------------------------------
+  always @ (posedge clk)
+    begin : key_mem_update
+      if (key_mem_we)
+        key_mem[{slot, round_ctr_reg}] <= key_mem_new;
+    end // key_mem_update
+
+
   //----------------------------------------------------------------
   // key_mem_read
   //
-  // Combinational read port for the key memory.
+  // Combinational read port for the key memory. Reads the round
+  // key from the schedule in the selected slot.
   //----------------------------------------------------------------
   always @*
     begin : key_mem_read
-      tmp_round_key = key_mem[round];
+      tmp_round_key = key_mem[{slot, round}];
     end // key_mem_read
 
 
@@ -230,6 +251,14 @@ module aes_key_mem(
       trw = rotstw ^ rconw;
       tw = new_sboxw;
 
+      // Zero the round key and the previous keys.
+      if (round_key_erase)
+        begin
+          key_mem_we   = 1'b1;
+          prev_key0_we = 1'b1;
+          prev_key1_we = 1'b1;
+        end
+
       // Generate the specific round keys.
       if (round_key_update)
         begin
@@ -400,6 +429,7 @@ module aes_key_mem(
       ready_new        = 1'b0;
       ready_we         = 1'b0;
       round_key_update = 1'b0;
+      round_key_erase  = 1'b0;
       round_ctr_rst    = 1'b0;
       round_ctr_inc    = 1'b0;
       key_mem_ctrl_new = CTRL_IDLE;
@@ -415,6 +445,14 @@ module aes_key_mem(
                 key_mem_ctrl_new = CTRL_INIT;
                 key_mem_ctrl_we  = 1'b1;
               end
+            else if (erase)
+              begin
+                ready_new        = 1'b0;
+                ready_we         = 1'b1;
+                round_ctr_rst    = 1'b1;
+                key_mem_ctrl_new = CTRL_ERASE;
+                key_mem_ctrl_we  = 1'b1;
+              end
           end
 
         CTRL_INIT:
@@ -435,6 +473,17 @@ module aes_key_mem(
               end
           end
 
+        CTRL_ERASE:
+          begin
+            round_ctr_inc   = 1'b1;
+            round_key_erase = 1'b1;
+            if (round_ctr_reg == 4'hf)
+              begin
+                key_mem_ctrl_new = CTRL_DONE;
+                key_mem_ctrl_we  = 1'b1;
+              end
+          end
+
         CTRL_DONE:
           begin
             ready_new        = 1'b1;
@@ -60,12 +60,20 @@ module tb_aes();
   parameter CTRL_NEXT_BIT    = 1;
   parameter CTRL_ENCDEC_BIT  = 2;
   parameter CTRL_KEYLEN_BIT  = 3;
+  parameter CTRL_CTR         = 8'h04;
+  parameter CTRL_ABORT       = 8'h08;
+  parameter CTRL_ERASE       = 8'h10;
 
   parameter ADDR_STATUS      = 8'h09;
   parameter STATUS_READY_BIT = 0;
   parameter STATUS_VALID_BIT = 1;
+  parameter STATUS_CTR_BIT   = 2;
 
   parameter ADDR_CONFIG      = 8'h0a;
+  parameter ADDR_CTR_BLOCKS  = 8'h0b;
+  parameter ADDR_KS_AVAIL    = 8'h0c;
+  parameter ADDR_KEY_SLOT    = 8'h0d;
+  parameter ADDR_KEY_SLOTS   = 8'h0e;
 
   parameter ADDR_KEY0        = 8'h10;
   parameter ADDR_KEY1        = 8'h11;
@@ -86,6 +94,17 @@ module tb_aes();
   parameter ADDR_RESULT2     = 8'h32;
   parameter ADDR_RESULT3     = 8'h33;
 
+  parameter ADDR_CTR0        = 8'h40;
+  parameter ADDR_CTR1        = 8'h41;
+  parameter ADDR_CTR2        = 8'h42;
+  parameter ADDR_CTR3        = 8'h43;
+
+  parameter ADDR_KS_DATA     = 8'h60;
+
+  parameter CTRW_128         = 2'h0;
+  parameter CTRW_64          = 2'h1;
+  parameter CTRW_32          = 2'h2;
+
   parameter AES_128_BIT_KEY = 0;
   parameter AES_256_BIT_KEY = 1;
 
@@ -287,14 +306,19 @@ module tb_aes();
   // Read a data word from the given address in the DUT.
   // the word read will be available in the global variable
   // read_data.
+  //
+  // The data is sampled at the clock edge that sees cs, like the
+  // bus does. Reads in the keystream window pop the FIFO on that
+  // edge, so sampling after it would give the next word.
   //----------------------------------------------------------------
   task read_word(input [11 : 0]  address);
     begin
       tb_address = address;
       tb_cs = 1;
       tb_we = 0;
-      #(CLK_PERIOD);
+      @(posedge tb_clk);
       read_data = tb_read_data;
+      #(CLK_HALF_PERIOD);
       tb_cs = 0;
 
       if (DEBUG)
@@ -556,6 +580,547 @@ module tb_aes();
   endtask // nist_kwp_test
 
 
+  //----------------------------------------------------------------
+  // write_ctr()
+  //
+  // Write the given counter block to the dut.
+  //----------------------------------------------------------------
+  task write_ctr(input [127 : 0] ctr);
+    begin
+      write_word(ADDR_CTR0, ctr[127  :  96]);
+      write_word(ADDR_CTR1, ctr[95   :  64]);
+      write_word(ADDR_CTR2, ctr[63   :  32]);
+      write_word(ADDR_CTR3, ctr[31   :   0]);
+    end
+  endtask // write_ctr
+
+
+  //----------------------------------------------------------------
+  // read_ctr()
+  //
+  // Read the counter block in the dut into result_data.
+  //----------------------------------------------------------------
+  task read_ctr;
+    begin
+      read_word(ADDR_CTR0);
+      result_data[127 : 096] = read_data;
+      read_word(ADDR_CTR1);
+      result_data[095 : 064] = read_data;
+      read_word(ADDR_CTR2);
+      result_data[063 : 032] = read_data;
+      read_word(ADDR_CTR3);
+      result_data[031 : 000] = read_data;
+    end
+  endtask // read_ctr
+
+
+  //----------------------------------------------------------------
+  // run_ctr()
+  //
+  // Load the counter and block count, start a CTR run and wait
+  // for it to finish. Returns the number of cycles from the start
+  // command until the last block is in the keystream FIFO.
+  //----------------------------------------------------------------
+  task run_ctr(input [127 : 0] ctr,
+               input [1 : 0]   ctrw,
+               input           key_length,
+               input [31 : 0]  blocks,
+               output [31 : 0] cycles);
+    begin : run_ctr
+      reg [31 : 0] start;
+      reg          busy;
+
+      write_ctr(ctr);
+      write_word(ADDR_CTR_BLOCKS, blocks);
+      write_word(ADDR_CONFIG, (8'h00 + (ctrw << 2) + (key_length << 1)));
+
+      start = cycle_ctr;
+      write_word(ADDR_CTRL, 8'h04);
+
+      busy = 1'b1;
+      while (busy)
+        begin
+          read_word(ADDR_STATUS);
+          busy = read_data[STATUS_CTR_BIT];
+        end
+      cycles = cycle_ctr - start;
+    end
+  endtask // run_ctr
+
+
+  //----------------------------------------------------------------
+  // ctr_mode_test()
+  //
+  // Perform a four block CTR mode test and check the keystream
+  // read out of the FIFO against the expected ciphertext.
+  //----------------------------------------------------------------
+  task ctr_mode_test(input [7 : 0]   tc_number,
+                     input [255 : 0] key,
+                     input           key_length,
+                     input [127 : 0] ctr,
+                     input [511 : 0] plaintext,
+                     input [511 : 0] expected);
+    begin : ctr_mode_test
+      reg [511 : 0] ciphertext;
+      reg [31 : 0]  cycles;
+      integer i;
+
+      $display("*** TC %0d CTR mode test started.", tc_number);
+      tc_ctr = tc_ctr + 1;
+
+      init_key(key, key_length);
+      run_ctr(ctr, CTRW_128, key_length, 4, cycles);
+
+      read_word(ADDR_KS_AVAIL);
+      if (read_data != 16)
+        begin
+          $display("*** ERROR: TC %0d expected 16 keystream words, got %0d.",
+                   tc_number, read_data);
+          error_ctr = error_ctr + 1;
+        end
+
+      for (i = 0 ; i < 16 ; i = i + 1)
+        begin
+          read_word(ADDR_KS_DATA + i);
+          ciphertext[(15 - i) * 32 +: 32] = read_data ^ plaintext[(15 - i) * 32 +: 32];
+        end
+
+      $display("*** TC %0d: 4 blocks in %0d cycles, %0d cycles per block.",
+               tc_number, cycles, cycles / 4);
+
+      if (ciphertext == expected)
+        begin
+          $display("*** TC %0d successful.", tc_number);
+          $display("");
+        end
+      else
+        begin
+          $display("*** ERROR: TC %0d NOT successful.", tc_number);
+          $display("Expected: 0x%0128x", expected);
+          $display("Got:      0x%0128x", ciphertext);
+          $display("");
+
+          error_ctr = error_ctr + 1;
+        end
+    end
+  endtask // ctr_mode_test
+
+
+  //----------------------------------------------------------------
+  // ctr_width_test()
+  //
+  // Check that the counter only carries within the configured
+  // increment width, and that the block count runs down to zero.
+  //----------------------------------------------------------------
+  task ctr_width_test(input [7 : 0]   tc_number,
+                      input [1 : 0]   ctrw,
+                      input [127 : 0] ctr,
+                      input [127 : 0] expected);
+    begin : ctr_width_test
+      reg [31 : 0] cycles;
+      integer i;
+
+      $display("*** TC %0d CTR increment width test started.", tc_number);
+      tc_ctr = tc_ctr + 1;
+
+      run_ctr(ctr, ctrw, AES_128_BIT_KEY, 2, cycles);
+
+      // Empty the keystream FIFO.
+      for (i = 0 ; i < 8 ; i = i + 1)
+        read_word(ADDR_KS_DATA + i);
+
+      read_ctr();
+      read_word(ADDR_CTR_BLOCKS);
+
+      if ((result_data == expected) && (read_data == 0))
+        begin
+          $display("*** TC %0d successful.", tc_number);
+          $display("");
+        end
+      else
+        begin
+          $display("*** ERROR: TC %0d NOT successful.", tc_number);
+          $display("Expected: 0x%032x, 0 blocks left", expected);
+          $display("Got:      0x%032x, %0d blocks left", result_data, read_data);
+          $display("");
+
+          error_ctr = error_ctr + 1;
+        end
+    end
+  endtask // ctr_width_test
+
+
+  //----------------------------------------------------------------
+  // wait_ctr_idle()
+  //
+  // Wait for the CTR FSM to be idle, for at most 1000 status
+  // reads. Returns 1 if it is.
+  //----------------------------------------------------------------
+  task wait_ctr_idle(output idle);
+    begin : wait_ctr_idle
+      integer i;
+
+      idle = 1'b0;
+      for (i = 0 ; (i < 1000) && !idle ; i = i + 1)
+        begin
+          read_word(ADDR_STATUS);
+          idle = !read_data[STATUS_CTR_BIT];
+        end
+    end
+  endtask // wait_ctr_idle
+
+
+  //----------------------------------------------------------------
+  // ctr_abort_test()
+  //
+  // Abandon CTR runs the way a host that times out or dies does:
+  // once with the FIFO full and the FSM waiting for room, once
+  // right after the start while a block is in the core, and once
+  // by leaving a finished run's keystream unread. After each the
+  // core must take a new run and give the right keystream, with no
+  // stale words first.
+  //----------------------------------------------------------------
+  task ctr_abort_test(input [7 : 0]   tc_number,
+                      input [255 : 0] key,
+                      input [127 : 0] ctr,
+                      input [511 : 0] plaintext,
+                      input [511 : 0] expected);
+    begin : ctr_abort_test
+      integer start_errors;
+      reg     idle;
+
+      start_errors = error_ctr;
+      $display("*** TC %0d CTR abort test started.", tc_number);
+      tc_ctr = tc_ctr + 1;
+
+      // A long run nobody reads. The FIFO fills and the FSM stalls.
+      init_key(key, AES_128_BIT_KEY);
+      write_ctr(ctr);
+      write_word(ADDR_CTR_BLOCKS, 32'd1000);
+      write_word(ADDR_CONFIG, 8'h00 + (CTRW_128 << 2));
+      write_word(ADDR_CTRL, CTRL_CTR);
+      #(1000 * CLK_PERIOD);
+
+      // Writes other than the abort are ignored while it runs.
+      write_word(ADDR_CTR_BLOCKS, 32'd5);
+      read_word(ADDR_CTR_BLOCKS);
+      if (read_data == 32'd5)
+        begin
+          $display("*** ERROR: block count written during a run.");
+          error_ctr = error_ctr + 1;
+        end
+
+      write_word(ADDR_CTRL, CTRL_ABORT);
+      wait_ctr_idle(idle);
+      read_word(ADDR_KS_AVAIL);
+      if (!idle || (read_data != 0))
+        begin
+          $display("*** ERROR: abort with a full FIFO, idle %0d, %0d words left.",
+                   idle, read_data);
+          error_ctr = error_ctr + 1;
+        end
+      read_word(ADDR_CTR_BLOCKS);
+      if (read_data != 0)
+        begin
+          $display("*** ERROR: %0d blocks left after abort.", read_data);
+          error_ctr = error_ctr + 1;
+        end
+
+      // Abort right after the start, with the first block in the core.
+      write_word(ADDR_CTR_BLOCKS, 32'd1000);
+      write_word(ADDR_CTRL, CTRL_CTR);
+      write_word(ADDR_CTRL, CTRL_ABORT);
+      wait_ctr_idle(idle);
+      read_word(ADDR_KS_AVAIL);
+      if (!idle || (read_data != 0))
+        begin
+          $display("*** ERROR: abort during a block, idle %0d, %0d words left.",
+                   idle, read_data);
+          error_ctr = error_ctr + 1;
+        end
+
+      // A finished run whose keystream is never read.
+      write_word(ADDR_CTR_BLOCKS, 32'd2);
+      write_word(ADDR_CTRL, CTRL_CTR);
+      wait_ctr_idle(idle);
+
+      if (error_ctr == start_errors)
+        $display("*** TC %0d successful.", tc_number);
+      else
+        $display("*** ERROR: TC %0d NOT successful.", tc_number);
+      $display("");
+
+      // The next run starts with an empty FIFO.
+      ctr_mode_test(tc_number + 1, key, AES_128_BIT_KEY, ctr,
+                    plaintext, expected);
+    end
+  endtask // ctr_abort_test
+
+
+  //----------------------------------------------------------------
+  // nist_ctr_tests()
+  //
+  // CTR mode tests based on the NIST SP 800-38A test vectors.
+  //----------------------------------------------------------------
+  task nist_ctr_tests;
+    reg [255 : 0] nist_aes128_key;
+    reg [255 : 0] nist_aes256_key;
+    reg [127 : 0] nist_ctr;
+    reg [511 : 0] nist_plaintext;
+    reg [511 : 0] nist_ctr_128_expected;
+    reg [511 : 0] nist_ctr_256_expected;
+
+    begin
+      nist_aes128_key = 256'h2b7e151628aed2a6abf7158809cf4f3c00000000000000000000000000000000;
+      nist_aes256_key = 256'h603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4;
+
+      nist_ctr        = 128'hf0f1f2f3f4f5f6f7f8f9fafbfcfdfeff;
+
+      nist_plaintext  = {128'h6bc1bee22e409f96e93d7e117393172a,
+                         128'hae2d8a571e03ac9c9eb76fac45af8e51,
+                         128'h30c81c46a35ce411e5fbc1191a0a52ef,
+                         128'hf69f2445df4f9b17ad2b417be66c3710};
+
+      nist_ctr_128_expected = {128'h874d6191b620e3261bef6864990db6ce,
+                               128'h9806f66b7970fdff8617187bb9fffdff,
+                               128'h5ae4df3edbd5d35e5b4f09020db03eab,
+                               128'h1e031dda2fbe03d1792170a0f3009cee};
+
+      nist_ctr_256_expected = {128'h601ec313775789a5b7a7f504bbf3d228,
+                               128'hf443e3ca4d62b59aca84e990cacaf5c5,
+                               128'h2b0930daa23de94ce87017ba2d84988d,
+                               128'hdfc9c58db67aada613c2dd08457941a6};
+
+      $display("");
+      $display("NIST SP 800-38A CTR mode tests");
+      $display("------------------------------");
+      ctr_mode_test(8'h20, nist_aes128_key, AES_128_BIT_KEY, nist_ctr,
+                    nist_plaintext, nist_ctr_128_expected);
+
+      ctr_mode_test(8'h21, nist_aes256_key, AES_256_BIT_KEY, nist_ctr,
+                    nist_plaintext, nist_ctr_256_expected);
+
+      $display("");
+      $display("CTR increment width tests");
+      $display("-------------------------");
+      ctr_width_test(8'h22, CTRW_128,
+                     128'h0000000000000000ffffffffffffffff,
+                     128'h00000000000000010000000000000001);
+
+      ctr_width_test(8'h23, CTRW_64,
+                     128'h0000000000000000ffffffffffffffff,
+                     128'h00000000000000000000000000000001);
+
+      ctr_width_test(8'h24, CTRW_32,
+                     128'h0000000000000000ffffffffffffffff,
+                     128'h0000000000000000ffffffff00000001);
+
+      $display("");
+      $display("CTR abort tests");
+      $display("---------------");
+      ctr_abort_test(8'h25, nist_aes128_key, nist_ctr,
+                     nist_plaintext, nist_ctr_128_expected);
+    end
+  endtask // nist_ctr_tests
+
+
+
+  //----------------------------------------------------------------
+  // run_block()
+  //
+  // Encipher the given block with the key in the current slot,
+  // without doing any key init, and check the result.
+  //----------------------------------------------------------------
+  task run_block(input [127 : 0] block, input [127 : 0] expected);
+    begin
+      write_block(block);
+      write_word(ADDR_CTRL, 8'h02);
+      wait_ready();
+      read_result();
+
+      if (result_data != expected)
+        begin
+          $display("Expected: 0x%032x", expected);
+          $display("Got:      0x%032x", result_data);
+          error_ctr = error_ctr + 1;
+        end
+    end
+  endtask // run_block
+
+
+  //----------------------------------------------------------------
+  // key_slot_test()
+  //
+  // Expand the NIST AES-128 and AES-256 keys into two different
+  // slots and then switch between them without any further key
+  // init, checking that each slot keeps its key and key length.
+  // Then erase one slot and check that only that slot lost its key.
+  //----------------------------------------------------------------
+  task key_slot_test;
+    begin : key_slot_test
+      integer start_errors;
+
+      start_errors = error_ctr;
+      tc_ctr = tc_ctr + 1;
+      $display("*** TC 0x30 key slot test started.");
+
+      read_word(ADDR_KEY_SLOTS);
+      $display("*** Core has %0d key slots.", read_data);
+
+      write_word(ADDR_KEY_SLOT, 32'h3);
+      init_key(256'h2b7e151628aed2a6abf7158809cf4f3c00000000000000000000000000000000,
+               AES_128_BIT_KEY);
+
+      write_word(ADDR_KEY_SLOT, 32'h9);
+      init_key(256'h603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4,
+               AES_256_BIT_KEY);
+
+      // Config now says 256 bits, the slot has to override it.
+      write_word(ADDR_CONFIG, 8'h03);
+      write_word(ADDR_KEY_SLOT, 32'h3);
+      run_block(128'h6bc1bee22e409f96e93d7e117393172a,
+                128'h3ad77bb40d7a3660a89ecaf32466ef97);
+
+      write_word(ADDR_KEY_SLOT, 32'h9);
+      run_block(128'h6bc1bee22e409f96e93d7e117393172a,
+                128'hf3eed1bdb5d2a03c064b5a7e3db181f8);
+
+      write_word(ADDR_KEY_SLOT, 32'h3);
+      run_block(128'hae2d8a571e03ac9c9eb76fac45af8e51,
+                128'hf5d3d58503b9699de785895a96fdbaaf);
+
+      write_word(ADDR_KEY_SLOT, 32'h9);
+      write_word(ADDR_CTRL, CTRL_ERASE);
+      wait_ready();
+      write_block(128'h6bc1bee22e409f96e93d7e117393172a);
+      write_word(ADDR_CTRL, 8'h02);
+      wait_ready();
+      read_result();
+      if (result_data == 128'hf3eed1bdb5d2a03c064b5a7e3db181f8)
+        begin
+          $display("*** ERROR: slot 9 still holds its key after erase.");
+          error_ctr = error_ctr + 1;
+        end
+
+      write_word(ADDR_KEY_SLOT, 32'h3);
+      run_block(128'h6bc1bee22e409f96e93d7e117393172a,
+                128'h3ad77bb40d7a3660a89ecaf32466ef97);
+
+      write_word(ADDR_KEY_SLOT, 32'h0);
+
+      if (error_ctr == start_errors)
+        $display("*** TC 0x30 successful.");
+      else
+        $display("*** ERROR: TC 0x30 NOT successful.");
+      $display("");
+    end
+  endtask // key_slot_test
+
+
+  //----------------------------------------------------------------
+  // rate_result()
+  //
+  // Display the cycles per block and the MB/s at 50 MHz for a
+  // number of blocks processed in the given number of cycles.
+  //----------------------------------------------------------------
+  task rate_result(input [7 : 0] tc_number, input [31 : 0] blocks,
+                   input [31 : 0] cycles);
+    begin
+      $display("*** TC %0d: %0d blocks in %0d cycles, %0d cycles per block, %0d.%01d MB/s at 50 MHz.",
+               tc_number, blocks, cycles, cycles / blocks,
+               (blocks * 16 * 50) / cycles, ((blocks * 160 * 50) / cycles) % 10);
+    end
+  endtask // rate_result
+
+
+  //----------------------------------------------------------------
+  // bulk_rate_tests()
+  //
+  // Bus cycles per block for the access patterns of the host code.
+  // Single block test writes the key and expands it for every block.
+  // The ECB/CBC driver expands the key once and then does a block
+  // write, next, status poll and result read per block. The CTR
+  // driver starts one run and reads the keystream FIFO in bursts.
+  //----------------------------------------------------------------
+  task bulk_rate_tests;
+    begin : bulk_rate_tests
+      reg [255 : 0] key;
+      reg [127 : 0] plaintext;
+      reg [127 : 0] expected;
+      reg [31 : 0]  start;
+      reg [31 : 0]  avail;
+      reg [31 : 0]  checksum;
+      integer i;
+      integer j;
+
+      key       = 256'h2b7e151628aed2a6abf7158809cf4f3c00000000000000000000000000000000;
+      plaintext = 128'h6bc1bee22e409f96e93d7e117393172a;
+      expected  = 128'h3ad77bb40d7a3660a89ecaf32466ef97;
+
+      $display("*** TC 60 single block pattern started.");
+      tc_ctr = tc_ctr + 1;
+      start = cycle_ctr;
+      for (i = 0 ; i < 16 ; i = i + 1)
+        begin
+          write_word(ADDR_KEY0, key[255 : 224]);
+          write_word(ADDR_KEY1, key[223 : 192]);
+          write_word(ADDR_KEY2, key[191 : 160]);
+          write_word(ADDR_KEY3, key[159 : 128]);
+          write_word(ADDR_CONFIG, 8'h00);
+          write_word(ADDR_CTRL, 8'h01);
+          wait_ready();
+          write_word(ADDR_CONFIG, 8'h01);
+          run_block(plaintext, expected);
+        end
+      rate_result(8'd60, 16, cycle_ctr - start);
+
+      $display("*** TC 61 ECB driver pattern started.");
+      tc_ctr = tc_ctr + 1;
+      init_key(key, AES_128_BIT_KEY);
+      write_word(ADDR_CONFIG, 8'h01);
+      start = cycle_ctr;
+      for (i = 0 ; i < 16 ; i = i + 1)
+        run_block(plaintext, expected);
+      rate_result(8'd61, 16, cycle_ctr - start);
+
+      $display("*** TC 62 CTR driver pattern started.");
+      tc_ctr = tc_ctr + 1;
+      start = cycle_ctr;
+      write_ctr(128'hf0f1f2f3f4f5f6f7f8f9fafbfcfdfeff);
+      write_word(ADDR_CTR_BLOCKS, 32'd16);
+      write_word(ADDR_CONFIG, 8'h01);
+      write_word(ADDR_CTRL, CTRL_CTR);
+
+      checksum = 32'h0;
+      i = 0;
+      while (i < 64)
+        begin
+          read_word(ADDR_KS_AVAIL);
+          avail = read_data;
+          if (avail > 32)
+            avail = 32;
+          if (avail > 64 - i)
+            avail = 64 - i;
+
+          for (j = 0 ; j < avail ; j = j + 1)
+            begin
+              read_word(ADDR_KS_DATA + j);
+              checksum = {checksum[30 : 0], checksum[31]} ^ read_data;
+            end
+          i = i + avail;
+        end
+      rate_result(8'd62, 16, cycle_ctr - start);
+
+      if (checksum != 32'h8366b3ec)
+        begin
+          $display("*** ERROR: TC 62 keystream checksum 0x%08x, expected 0x8366b3ec.",
+                   checksum);
+          error_ctr = error_ctr + 1;
+        end
+      $display("");
+    end
+  endtask // bulk_rate_tests
+
 
   //----------------------------------------------------------------
   // main
@@ -575,6 +1140,9 @@ module tb_aes();
 
       nist_fips_tests();
       nist_kwp_test();
+      nist_ctr_tests();
+      key_slot_test();
+      bulk_rate_tests();
 
       display_test_results();
 
@@ -88,10 +88,12 @@ module tb_aes_core();
                .encdec(tb_encdec),
                .init(tb_init),
                .next(tb_next),
+               .erase(1'b0),
                .ready(tb_ready),
 
                .key(tb_key),
                .keylen(tb_keylen),
+               .key_slot(4'h0),
 
                .block(tb_block),
                .result(tb_result)
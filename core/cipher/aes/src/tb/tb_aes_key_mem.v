@@ -74,6 +74,8 @@ module tb_aes_key_mem();
   reg [255 : 0]  tb_key;
   reg            tb_keylen;
   reg            tb_init;
+  reg            tb_erase;
+  reg [3 : 0]    tb_slot;
   reg [3 : 0]    tb_round;
   wire [127 : 0] tb_round_key;
   wire           tb_ready;
@@ -92,6 +94,8 @@ module tb_aes_key_mem();
                   .key(tb_key),
                   .keylen(tb_keylen),
                   .init(tb_init),
+                  .erase(tb_erase),
+                  .slot(tb_slot),
 
                   .round(tb_round),
                   .round_key(tb_round_key),
@@ -218,6 +222,8 @@ module tb_aes_key_mem();
       tb_key     = {8{32'h00000000}};
       tb_keylen  = 0;
       tb_init    = 0;
+      tb_erase   = 0;
+      tb_slot    = 4'h0;
       tb_round   = 4'h0;
     end
   endtask // init_sim
@@ -372,6 +378,115 @@ module tb_aes_key_mem();
   endtask // test_key_256
 
 
+  //----------------------------------------------------------------
+  // expand_key()
+  //
+  // Expand the given key into the given key slot.
+  //----------------------------------------------------------------
+  task expand_key(input [3 : 0] slot, input [255 : 0] key, input key_length);
+    begin
+      tb_slot = slot;
+      tb_key = key;
+      tb_keylen = key_length;
+      tb_init = 1;
+      #(2 * CLK_PERIOD);
+      tb_init = 0;
+      wait_ready();
+    end
+  endtask // expand_key
+
+
+  //----------------------------------------------------------------
+  // test_slots()
+  //
+  // Expand different keys into three slots and check that every
+  // slot still holds its own schedule after the others have been
+  // written.
+  //----------------------------------------------------------------
+  task test_slots;
+    begin
+      $display("** Testing key slots.");
+      $display("");
+
+      expand_key(4'h1, 256'hffffffffffffffffffffffffffffffff00000000000000000000000000000000,
+                 AES_128_BIT_KEY);
+      expand_key(4'h0, 256'h0, AES_128_BIT_KEY);
+      expand_key(4'hf, 256'h603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4,
+                 AES_256_BIT_KEY);
+
+      tb_slot = 4'h1;
+      check_key(4'h0, 128'hffffffffffffffffffffffffffffffff);
+      check_key(4'h1, 128'he8e9e9e917161616e8e9e9e917161616);
+
+      tb_slot = 4'h0;
+      check_key(4'h1, 128'h62636363626363636263636362636363);
+      check_key(4'ha, 128'hb4ef5bcb3e92e21123e951cf6f8f188e);
+
+      tb_slot = 4'hf;
+      check_key(4'h1, 128'h1f352c073b6108d72d9810a30914dff4);
+      check_key(4'he, 128'hfe4890d1e6188d0b046df344706c631e);
+
+      tb_slot = 4'h0;
+      tc_ctr = tc_ctr + 1;
+    end
+  endtask // test_slots
+
+
+  //----------------------------------------------------------------
+  // test_erase()
+  //
+  // Expand keys into two slots, erase one of them and check that
+  // all of its 16 round keys and the previous key registers are
+  // zero while the other slot is left alone.
+  //----------------------------------------------------------------
+  task test_erase;
+    begin : test_erase
+      integer i;
+      integer start_errors;
+
+      $display("** Testing key slot erase.");
+      $display("");
+      start_errors = error_ctr;
+
+      expand_key(4'h3, 256'h603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4,
+                 AES_256_BIT_KEY);
+      expand_key(4'h4, 256'h2b7e151628aed2a6abf7158809cf4f3c00000000000000000000000000000000,
+                 AES_128_BIT_KEY);
+
+      tb_slot = 4'h3;
+      tb_erase = 1;
+      #(2 * CLK_PERIOD);
+      tb_erase = 0;
+      if (tb_ready)
+        begin
+          $display("*** ERROR: ready still set during erase.");
+          error_ctr = error_ctr + 1;
+        end
+      wait_ready();
+
+      for (i = 0 ; i < 16 ; i = i + 1)
+        check_key(i, 128'h0);
+
+      if ((dut.prev_key0_reg != 128'h0) || (dut.prev_key1_reg != 128'h0))
+        begin
+          $display("*** ERROR: previous keys not cleared by erase.");
+          error_ctr = error_ctr + 1;
+        end
+
+      tb_slot = 4'h4;
+      check_key(4'h0, 128'h2b7e151628aed2a6abf7158809cf4f3c);
+      check_key(4'ha, 128'hd014f9a8c9ee2589e13f0cc8b6630ca6);
+
+      if (error_ctr == start_errors)
+        $display("** Key slot erase ok.");
+      $display("");
+
+      tb_slot = 4'h0;
+      tc_ctr = tc_ctr + 1;
+    end
+  endtask // test_erase
+
+
   //----------------------------------------------------------------
   // display_test_result()
   //
@@ -637,6 +752,9 @@ module tb_aes_key_mem();
                    expected_08, expected_09, expected_10, expected_11,
                    expected_12, expected_13, expected_14);
 
+      test_slots();
+      test_erase();
+
 
       display_test_result();
       $display("");
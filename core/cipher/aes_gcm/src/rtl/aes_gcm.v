@@ -0,0 +1,792 @@
+//======================================================================
+//
+// aes_gcm.v
+// ---------
+// AES-GCM engine (NIST SP 800-38D) with a memory like interface.
+// The counter blocks are enciphered by the pipelined AES core, one
+// per cycle, and the GHASH core folds in the AAD and the ciphertext
+// as it comes out, so a buffer of data is encrypted or decrypted and
+// authenticated in one run.
+//
+// The host fills an input buffer with up to 64 blocks of AAD or data,
+// starts a run and reads the result from an output buffer, as with
+// aes_pipe.
+//
+// Address map (address[9:8]):
+//   00: registers
+//   01: input buffer,  address[7:2] is the block, address[1:0] the word
+//   10: output buffer, address[7:2] is the block, address[1:0] the word
+//
+//
+// Copyright (c) 2016, NORDUnet A/S
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// - Neither the name of the NORDUnet nor the names of its contributors may
+//   be used to endorse or promote products derived from this software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+module aes_gcm(
+               // Clock and reset.
+               input wire           clk,
+               input wire           reset_n,
+
+               // Control.
+               input wire           cs,
+               input wire           we,
+
+               // Data ports.
+               input wire  [9 : 0]  address,
+               input wire  [31 : 0] write_data,
+               output wire [31 : 0] read_data
+              );
+
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  localparam AREA_REGS        = 2'h0;
+  localparam AREA_IN_BUF      = 2'h1;
+  localparam AREA_OUT_BUF     = 2'h2;
+
+  localparam ADDR_NAME0       = 8'h00;
+  localparam ADDR_NAME1       = 8'h01;
+  localparam ADDR_VERSION     = 8'h02;
+
+  localparam ADDR_CTRL        = 8'h08;
+  localparam CTRL_INIT_BIT    = 0;
+  localparam CTRL_NEXT_BIT    = 1;
+  localparam CTRL_START_BIT   = 2;
+  localparam CTRL_FINISH_BIT  = 3;
+
+  localparam ADDR_STATUS      = 8'h09;
+  localparam STATUS_READY_BIT = 0;
+  localparam STATUS_VALID_BIT = 1;
+
+  localparam ADDR_CONFIG      = 8'h0a;
+  localparam CTRL_ENCDEC_BIT  = 0;
+  localparam CTRL_KEYLEN_BIT  = 1;
+  localparam CTRL_AAD_BIT     = 2;
+
+  localparam ADDR_NUM_BLOCKS  = 8'h0b;
+  localparam ADDR_CYCLES      = 8'h0c;
+  localparam ADDR_LAST_LEN    = 8'h0d;
+
+  localparam ADDR_KEY0        = 8'h10;
+  localparam ADDR_KEY7        = 8'h17;
+
+  localparam ADDR_IV0         = 8'h18;
+  localparam ADDR_IV2         = 8'h1a;
+
+  localparam ADDR_TAG0        = 8'h20;
+  localparam ADDR_TAG3        = 8'h23;
+
+  localparam MAX_BLOCKS       = 7'h40;
+
+  localparam CORE_NAME0       = 32'h61657367; // "aesg"
+  localparam CORE_NAME1       = 32'h636d2020; // "cm  "
+  localparam CORE_VERSION     = 32'h302e3130; // "0.10"
+
+  localparam ENG_IDLE         = 3'h0;
+  localparam ENG_KEY          = 3'h1;
+  localparam ENG_HKEY         = 3'h2;
+  localparam ENG_HPOW         = 3'h3;
+  localparam ENG_J0           = 3'h4;
+  localparam ENG_RUN          = 3'h5;
+  localparam ENG_LEN          = 3'h6;
+  localparam ENG_TAG          = 3'h7;
+
+
+  //----------------------------------------------------------------
+  // Registers including update variables and write enable.
+  //----------------------------------------------------------------
+  reg init_reg;
+  reg init_new;
+
+  reg next_reg;
+  reg next_new;
+
+  reg start_reg;
+  reg start_new;
+
+  reg finish_reg;
+  reg finish_new;
+
+  reg encdec_reg;
+  reg keylen_reg;
+  reg aad_reg;
+  reg config_we;
+
+  reg [6 : 0] num_blocks_reg;
+  reg         num_blocks_we;
+
+  reg [4 : 0] last_len_reg;
+  reg         last_len_we;
+
+  reg [31 : 0] key_reg [0 : 7];
+  reg          key_we;
+
+  reg [31 : 0] iv_reg [0 : 2];
+  reg          iv_we;
+
+  reg [31 : 0] in_buf0 [0 : 63];
+  reg [31 : 0] in_buf1 [0 : 63];
+  reg [31 : 0] in_buf2 [0 : 63];
+  reg [31 : 0] in_buf3 [0 : 63];
+  reg          in_buf_we;
+
+  reg [31 : 0] out_buf0 [0 : 63];
+  reg [31 : 0] out_buf1 [0 : 63];
+  reg [31 : 0] out_buf2 [0 : 63];
+  reg [31 : 0] out_buf3 [0 : 63];
+  reg          out_buf_we;
+
+  reg [127 : 0] aes_in_reg;
+  reg [127 : 0] aes_in_new;
+  reg           aes_in_valid_reg;
+  reg           aes_in_valid_new;
+
+  reg [127 : 0] ctr_reg;
+  reg [127 : 0] ctr_new;
+  reg           ctr_we;
+
+  reg [127 : 0] ek0_reg;
+  reg           ek0_we;
+
+  reg [63 : 0]  aad_bits_reg;
+  reg [63 : 0]  aad_bits_new;
+  reg           aad_bits_we;
+
+  reg [63 : 0]  ct_bits_reg;
+  reg [63 : 0]  ct_bits_new;
+  reg           ct_bits_we;
+
+  reg [127 : 0] tag_reg;
+  reg           tag_we;
+
+  reg [6 : 0]   in_ptr_reg;
+  reg [6 : 0]   in_ptr_new;
+  reg           in_ptr_we;
+
+  reg [6 : 0]   out_ptr_reg;
+  reg [6 : 0]   out_ptr_new;
+  reg           out_ptr_we;
+
+  reg [6 : 0]   gh_ptr_reg;
+  reg [6 : 0]   gh_ptr_new;
+  reg           gh_ptr_we;
+
+  reg [31 : 0]  cycles_reg;
+  reg [31 : 0]  cycles_new;
+  reg           cycles_we;
+
+  reg           valid_reg;
+  reg           valid_new;
+  reg           valid_we;
+
+  reg [2 : 0]   eng_ctrl_reg;
+  reg [2 : 0]   eng_ctrl_new;
+  reg           eng_ctrl_we;
+
+  reg [31 : 0]  read_data_reg;
+
+
+  //----------------------------------------------------------------
+  // Wires.
+  //----------------------------------------------------------------
+  reg [31 : 0]   tmp_read_data;
+
+  reg            ghash_init;
+  reg            ghash_clear;
+  reg            ghash_block_valid;
+  reg [127 : 0]  ghash_block;
+  reg            ghash_flush;
+
+  wire [1 : 0]   area;
+  wire [7 : 0]   reg_addr;
+  wire [5 : 0]   buf_addr;
+
+  wire [255 : 0] core_key;
+  wire [95 : 0]  core_iv;
+  wire           core_ready;
+  wire           core_out_valid;
+  wire [127 : 0] core_out_block;
+
+  wire           ghash_block_ready;
+  wire           ghash_ready;
+  wire [127 : 0] ghash_y;
+
+  wire [127 : 0] xor_in;
+  wire [127 : 0] gh_in;
+  wire [127 : 0] gh_out;
+  wire [127 : 0] xor_result;
+  wire [127 : 0] last_mask;
+  wire [127 : 0] xor_mask;
+  wire [127 : 0] gh_mask;
+  wire [63 : 0]  run_bits;
+
+  wire           busy;
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity for ports etc.
+  //----------------------------------------------------------------
+  assign read_data = read_data_reg;
+
+  assign area     = address[9 : 8];
+  assign reg_addr = address[7 : 0];
+  assign buf_addr = address[7 : 2];
+
+  assign core_key = {key_reg[0], key_reg[1], key_reg[2], key_reg[3],
+                     key_reg[4], key_reg[5], key_reg[6], key_reg[7]};
+
+  assign core_iv  = {iv_reg[0], iv_reg[1], iv_reg[2]};
+
+  assign busy = eng_ctrl_reg != ENG_IDLE;
+
+  // The input block at the output pointer, XORed with the keystream
+  // as it leaves the pipeline, and the block at the GHASH pointer.
+  assign xor_in = {in_buf0[out_ptr_reg[5 : 0]], in_buf1[out_ptr_reg[5 : 0]],
+                   in_buf2[out_ptr_reg[5 : 0]], in_buf3[out_ptr_reg[5 : 0]]};
+
+  assign gh_in  = {in_buf0[gh_ptr_reg[5 : 0]], in_buf1[gh_ptr_reg[5 : 0]],
+                   in_buf2[gh_ptr_reg[5 : 0]], in_buf3[gh_ptr_reg[5 : 0]]};
+
+  assign gh_out = {out_buf0[gh_ptr_reg[5 : 0]], out_buf1[gh_ptr_reg[5 : 0]],
+                   out_buf2[gh_ptr_reg[5 : 0]], out_buf3[gh_ptr_reg[5 : 0]]};
+
+  // Only the last block of a run can be short.
+  assign last_mask  = {128{1'b1}} << (8'd128 - {last_len_reg, 3'b000});
+  assign xor_mask   = (out_ptr_reg == num_blocks_reg - 1'b1) ? last_mask : {128{1'b1}};
+  assign gh_mask    = (gh_ptr_reg == num_blocks_reg - 1'b1) ? last_mask : {128{1'b1}};
+  assign xor_result = (xor_in ^ core_out_block) & xor_mask;
+
+  assign run_bits = {50'h0, num_blocks_reg - 1'b1, 7'h0} + {56'h0, last_len_reg, 3'b000};
+
+
+  //----------------------------------------------------------------
+  // core instantiations.
+  //----------------------------------------------------------------
+  aes_pipe_core core(
+                     .clk(clk),
+                     .reset_n(reset_n),
+
+                     .init(init_reg),
+                     .ready(core_ready),
+
+                     .key(core_key),
+                     .keylen(keylen_reg),
+
+                     .in_valid(aes_in_valid_reg),
+                     .in_block(aes_in_reg),
+
+                     .out_valid(core_out_valid),
+                     .out_block(core_out_block)
+                    );
+
+  ghash_core ghash(
+                   .clk(clk),
+                   .reset_n(reset_n),
+
+                   .init(ghash_init),
+                   .clear(ghash_clear),
+                   .h(core_out_block),
+
+                   .block_valid(ghash_block_valid),
+                   .block(ghash_block),
+                   .block_ready(ghash_block_ready),
+
+                   .flush(ghash_flush),
+                   .ready(ghash_ready),
+
+                   .y(ghash_y)
+                  );
+
+
+  //----------------------------------------------------------------
+  // reg_update
+  // Update functionality for all registers in the core.
+  // All registers are positive edge triggered with asynchronous
+  // active low reset.
+  //----------------------------------------------------------------
+  always @ (posedge clk or negedge reset_n)
+    begin : reg_update
+      integer i;
+
+      if (!reset_n)
+        begin
+          for (i = 0 ; i < 8 ; i = i + 1)
+            key_reg[i] <= 32'h0;
+
+          for (i = 0 ; i < 3 ; i = i + 1)
+            iv_reg[i] <= 32'h0;
+
+          init_reg         <= 1'b0;
+          next_reg         <= 1'b0;
+          start_reg        <= 1'b0;
+          finish_reg       <= 1'b0;
+          encdec_reg       <= 1'b0;
+          keylen_reg       <= 1'b0;
+          aad_reg          <= 1'b0;
+          num_blocks_reg   <= 7'h1;
+          last_len_reg     <= 5'h10;
+          aes_in_reg       <= 128'h0;
+          aes_in_valid_reg <= 1'b0;
+          ctr_reg          <= 128'h0;
+          ek0_reg          <= 128'h0;
+          aad_bits_reg     <= 64'h0;
+          ct_bits_reg      <= 64'h0;
+          tag_reg          <= 128'h0;
+          in_ptr_reg       <= 7'h0;
+          out_ptr_reg      <= 7'h0;
+          gh_ptr_reg       <= 7'h0;
+          cycles_reg       <= 32'h0;
+          valid_reg        <= 1'b0;
+          eng_ctrl_reg     <= ENG_IDLE;
+        end
+      else
+        begin
+          init_reg         <= init_new;
+          next_reg         <= next_new;
+          start_reg        <= start_new;
+          finish_reg       <= finish_new;
+          aes_in_reg       <= aes_in_new;
+          aes_in_valid_reg <= aes_in_valid_new;
+
+          if (config_we)
+            begin
+              encdec_reg <= write_data[CTRL_ENCDEC_BIT];
+              keylen_reg <= write_data[CTRL_KEYLEN_BIT];
+              aad_reg    <= write_data[CTRL_AAD_BIT];
+            end
+
+          if (num_blocks_we)
+            num_blocks_reg <= write_data[6 : 0];
+
+          if (last_len_we)
+            last_len_reg <= write_data[4 : 0];
+
+          if (key_we)
+            key_reg[reg_addr[2 : 0]] <= write_data;
+
+          if (iv_we)
+            iv_reg[reg_addr[1 : 0]] <= write_data;
+
+          if (ctr_we)
+            ctr_reg <= ctr_new;
+
+          if (ek0_we)
+            ek0_reg <= core_out_block;
+
+          if (aad_bits_we)
+            aad_bits_reg <= aad_bits_new;
+
+          if (ct_bits_we)
+            ct_bits_reg <= ct_bits_new;
+
+          if (tag_we)
+            tag_reg <= ghash_y ^ ek0_reg;
+
+          if (in_ptr_we)
+            in_ptr_reg <= in_ptr_new;
+
+          if (out_ptr_we)
+            out_ptr_reg <= out_ptr_new;
+
+          if (gh_ptr_we)
+            gh_ptr_reg <= gh_ptr_new;
+
+          if (cycles_we)
+            cycles_reg <= cycles_new;
+
+          if (valid_we)
+            valid_reg <= valid_new;
+
+          if (eng_ctrl_we)
+            eng_ctrl_reg <= eng_ctrl_new;
+        end
+    end // reg_update
+
+
+  //----------------------------------------------------------------
+  // buf_update
+  //
+  // The input and output buffers, each four memories of one word
+  // per block. Besides the bus, the input buffer is read at the
+  // output pointer for the XOR with the keystream and at the GHASH
+  // pointer, and the output buffer at the GHASH pointer.
+  //----------------------------------------------------------------
+  always @ (posedge clk)
+    begin : buf_update
+      if (in_buf_we)
+        case (address[1 : 0])
+          2'h0: in_buf0[buf_addr] <= write_data;
+          2'h1: in_buf1[buf_addr] <= write_data;
+          2'h2: in_buf2[buf_addr] <= write_data;
+          2'h3: in_buf3[buf_addr] <= write_data;
+        endcase // case (address[1 : 0])
+
+      if (out_buf_we)
+        begin
+          out_buf0[out_ptr_reg[5 : 0]] <= xor_result[127 : 096];
+          out_buf1[out_ptr_reg[5 : 0]] <= xor_result[095 : 064];
+          out_buf2[out_ptr_reg[5 : 0]] <= xor_result[063 : 032];
+          out_buf3[out_ptr_reg[5 : 0]] <= xor_result[031 : 000];
+        end
+
+      if (cs && !we)
+        read_data_reg <= tmp_read_data;
+    end // buf_update
+
+
+  //----------------------------------------------------------------
+  // api
+  //
+  // The interface command decoding logic. Reads are registered,
+  // the data is available the cycle after cs.
+  //----------------------------------------------------------------
+  always @*
+    begin : api
+      init_new      = 1'b0;
+      next_new      = 1'b0;
+      start_new     = 1'b0;
+      finish_new    = 1'b0;
+      config_we     = 1'b0;
+      num_blocks_we = 1'b0;
+      last_len_we   = 1'b0;
+      key_we        = 1'b0;
+      iv_we         = 1'b0;
+      in_buf_we     = 1'b0;
+      tmp_read_data = 32'h0;
+
+      if (cs)
+        begin
+          if (we)
+            begin
+              if ((area == AREA_REGS) && !busy)
+                begin
+                  if (reg_addr == ADDR_CTRL)
+                    begin
+                      init_new   = write_data[CTRL_INIT_BIT];
+                      next_new   = write_data[CTRL_NEXT_BIT];
+                      start_new  = write_data[CTRL_START_BIT];
+                      finish_new = write_data[CTRL_FINISH_BIT];
+                    end
+
+                  if (reg_addr == ADDR_CONFIG)
+                    config_we = 1'b1;
+
+                  if ((reg_addr == ADDR_NUM_BLOCKS) &&
+                      (write_data[6 : 0] != 7'h0) &&
+                      (write_data[6 : 0] <= MAX_BLOCKS))
+                    num_blocks_we = 1'b1;
+
+                  if ((reg_addr == ADDR_LAST_LEN) &&
+                      (write_data[4 : 0] != 5'h0) &&
+                      (write_data[4 : 0] <= 5'h10))
+                    last_len_we = 1'b1;
+
+                  if ((reg_addr >= ADDR_KEY0) && (reg_addr <= ADDR_KEY7))
+                    key_we = 1'b1;
+
+                  if ((reg_addr >= ADDR_IV0) && (reg_addr <= ADDR_IV2))
+                    iv_we = 1'b1;
+                end
+
+              if ((area == AREA_IN_BUF) && !busy)
+                in_buf_we = 1'b1;
+            end // if (we)
+
+          else
+            begin
+              case (area)
+                AREA_REGS:
+                  begin
+                    if ((reg_addr >= ADDR_TAG0) && (reg_addr <= ADDR_TAG3))
+                      tmp_read_data = tag_reg[(3 - reg_addr[1 : 0]) * 32 +: 32];
+
+                    case (reg_addr)
+                      ADDR_NAME0:      tmp_read_data = CORE_NAME0;
+                      ADDR_NAME1:      tmp_read_data = CORE_NAME1;
+                      ADDR_VERSION:    tmp_read_data = CORE_VERSION;
+                      ADDR_CTRL:       tmp_read_data = {28'h0, finish_reg, start_reg,
+                                                        next_reg, init_reg};
+                      ADDR_STATUS:     tmp_read_data = {30'h0, valid_reg, !busy};
+                      ADDR_CONFIG:     tmp_read_data = {29'h0, aad_reg, keylen_reg, encdec_reg};
+                      ADDR_NUM_BLOCKS: tmp_read_data = {25'h0, num_blocks_reg};
+                      ADDR_CYCLES:     tmp_read_data = cycles_reg;
+                      ADDR_LAST_LEN:   tmp_read_data = {27'h0, last_len_reg};
+                      default:
+                        begin
+                        end
+                    endcase // case (reg_addr)
+                  end
+
+                AREA_OUT_BUF:
+                  case (address[1 : 0])
+                    2'h0: tmp_read_data = out_buf0[buf_addr];
+                    2'h1: tmp_read_data = out_buf1[buf_addr];
+                    2'h2: tmp_read_data = out_buf2[buf_addr];
+                    2'h3: tmp_read_data = out_buf3[buf_addr];
+                  endcase // case (address[1 : 0])
+
+                default:
+                  begin
+                  end
+              endcase // case (area)
+            end
+        end
+    end // api
+
+
+  //----------------------------------------------------------------
+  // eng_ctrl
+  //
+  // init expands the key and computes H = E(K, 0) and its powers.
+  // start takes a 96 bit IV, computes E(K, J0) for the tag and
+  // clears the hash and the lengths. next runs the input buffer:
+  // AAD goes straight to GHASH, data is XORed with the keystream
+  // and the ciphertext goes to GHASH as soon as it is in the output
+  // buffer. finish hashes the lengths and computes the tag.
+  //----------------------------------------------------------------
+  always @*
+    begin : eng_ctrl
+      aes_in_new        = 128'h0;
+      aes_in_valid_new  = 1'b0;
+      ctr_new           = 128'h0;
+      ctr_we            = 1'b0;
+      ek0_we            = 1'b0;
+      aad_bits_new      = 64'h0;
+      aad_bits_we       = 1'b0;
+      ct_bits_new       = 64'h0;
+      ct_bits_we        = 1'b0;
+      tag_we            = 1'b0;
+      out_buf_we        = 1'b0;
+      in_ptr_new        = 7'h0;
+      in_ptr_we         = 1'b0;
+      out_ptr_new       = 7'h0;
+      out_ptr_we        = 1'b0;
+      gh_ptr_new        = 7'h0;
+      gh_ptr_we         = 1'b0;
+      ghash_init        = 1'b0;
+      ghash_clear       = 1'b0;
+      ghash_block_valid = 1'b0;
+      ghash_block       = 128'h0;
+      ghash_flush       = 1'b0;
+      cycles_new        = cycles_reg + 1'b1;
+      cycles_we         = busy;
+      valid_new         = 1'b0;
+      valid_we          = 1'b0;
+      eng_ctrl_new      = ENG_IDLE;
+      eng_ctrl_we       = 1'b0;
+
+      case (eng_ctrl_reg)
+        ENG_IDLE:
+          begin
+            if (init_reg || next_reg || start_reg || finish_reg)
+              begin
+                cycles_new = 32'h0;
+                cycles_we  = 1'b1;
+                valid_new  = 1'b0;
+                valid_we   = 1'b1;
+              end
+
+            if (init_reg)
+              begin
+                eng_ctrl_new = ENG_KEY;
+                eng_ctrl_we  = 1'b1;
+              end
+
+            else if (start_reg)
+              begin
+                aes_in_new       = {core_iv, 32'h1};
+                aes_in_valid_new = 1'b1;
+                ctr_new          = {core_iv, 32'h2};
+                ctr_we           = 1'b1;
+                aad_bits_we      = 1'b1;
+                ct_bits_we       = 1'b1;
+                ghash_clear      = 1'b1;
+                eng_ctrl_new     = ENG_J0;
+                eng_ctrl_we      = 1'b1;
+              end
+
+            else if (next_reg)
+              begin
+                // There is nothing to encipher for AAD, so the
+                // output pointer starts at the end.
+                in_ptr_new   = aad_reg ? num_blocks_reg : 7'h0;
+                in_ptr_we    = 1'b1;
+                out_ptr_new  = aad_reg ? num_blocks_reg : 7'h0;
+                out_ptr_we   = 1'b1;
+                gh_ptr_new   = 7'h0;
+                gh_ptr_we    = 1'b1;
+
+                if (aad_reg)
+                  begin
+                    aad_bits_new = aad_bits_reg + run_bits;
+                    aad_bits_we  = 1'b1;
+                  end
+                else
+                  begin
+                    ct_bits_new = ct_bits_reg + run_bits;
+                    ct_bits_we  = 1'b1;
+                  end
+
+                eng_ctrl_new = ENG_RUN;
+                eng_ctrl_we  = 1'b1;
+              end
+
+            else if (finish_reg)
+              begin
+                eng_ctrl_new = ENG_LEN;
+                eng_ctrl_we  = 1'b1;
+              end
+          end
+
+        ENG_KEY:
+          begin
+            if (core_ready)
+              begin
+                aes_in_new       = 128'h0;
+                aes_in_valid_new = 1'b1;
+                eng_ctrl_new     = ENG_HKEY;
+                eng_ctrl_we      = 1'b1;
+              end
+          end
+
+        ENG_HKEY:
+          begin
+            // H = E(K, 0) goes straight from the pipeline to GHASH.
+            if (core_out_valid)
+              begin
+                ghash_init   = 1'b1;
+                eng_ctrl_new = ENG_HPOW;
+                eng_ctrl_we  = 1'b1;
+              end
+          end
+
+        ENG_HPOW:
+          begin
+            if (ghash_ready)
+              begin
+                eng_ctrl_new = ENG_IDLE;
+                eng_ctrl_we  = 1'b1;
+              end
+          end
+
+        ENG_J0:
+          begin
+            if (core_out_valid)
+              begin
+                ek0_we       = 1'b1;
+                eng_ctrl_new = ENG_IDLE;
+                eng_ctrl_we  = 1'b1;
+              end
+          end
+
+        ENG_RUN:
+          begin
+            // Feed the counter blocks to the pipeline.
+            if (in_ptr_reg < num_blocks_reg)
+              begin
+                aes_in_new       = ctr_reg;
+                aes_in_valid_new = 1'b1;
+                ctr_new          = {ctr_reg[127 : 32], ctr_reg[31 : 0] + 1'b1};
+                ctr_we           = 1'b1;
+                in_ptr_new       = in_ptr_reg + 1'b1;
+                in_ptr_we        = 1'b1;
+              end
+
+            // Collect the results.
+            if (core_out_valid)
+              begin
+                out_buf_we  = 1'b1;
+                out_ptr_new = out_ptr_reg + 1'b1;
+                out_ptr_we  = 1'b1;
+              end
+
+            // Hash the AAD or the ciphertext of the blocks that are
+            // done. When encrypting, that is the output buffer.
+            if (gh_ptr_reg < out_ptr_reg)
+              begin
+                ghash_block_valid = 1'b1;
+
+                if (!aad_reg && encdec_reg)
+                  ghash_block = gh_out;
+                else
+                  ghash_block = gh_in & gh_mask;
+
+                if (ghash_block_ready)
+                  begin
+                    gh_ptr_new = gh_ptr_reg + 1'b1;
+                    gh_ptr_we  = 1'b1;
+
+                    if (gh_ptr_new == num_blocks_reg)
+                      begin
+                        valid_new    = 1'b1;
+                        valid_we     = 1'b1;
+                        eng_ctrl_new = ENG_IDLE;
+                        eng_ctrl_we  = 1'b1;
+                      end
+                  end
+              end
+          end
+
+        ENG_LEN:
+          begin
+            ghash_block_valid = 1'b1;
+            ghash_block       = {aad_bits_reg, ct_bits_reg};
+
+            if (ghash_block_ready)
+              begin
+                ghash_flush  = 1'b1;
+                eng_ctrl_new = ENG_TAG;
+                eng_ctrl_we  = 1'b1;
+              end
+          end
+
+        ENG_TAG:
+          begin
+            if (ghash_ready)
+              begin
+                tag_we       = 1'b1;
+                valid_new    = 1'b1;
+                valid_we     = 1'b1;
+                eng_ctrl_new = ENG_IDLE;
+                eng_ctrl_we  = 1'b1;
+              end
+          end
+
+        default:
+          begin
+          end
+      endcase // case (eng_ctrl_reg)
+    end // eng_ctrl
+endmodule // aes_gcm
+
+//======================================================================
+// EOF aes_gcm.v
+//======================================================================
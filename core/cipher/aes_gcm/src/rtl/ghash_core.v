@@ -0,0 +1,443 @@
+//======================================================================
+//
+// ghash_core.v
+// ------------
+// GHASH core for GCM (NIST SP 800-38D), with precomputed powers of
+// the hash subkey H.
+//
+// init loads H, computes H^2, H^3 and H^4 and clears the hash. clear
+// only clears the hash, and drops any blocks not yet folded in.
+// Blocks are then given one at a time with block_valid whenever
+// block_ready is set. They are collected in groups of four, and each
+// group is folded into the hash as
+//
+//   Y = (Y ^ B1) * H^4 ^ B2 * H^3 ^ B3 * H^2 ^ B4 * H
+//
+// using four digit serial multipliers that run in parallel, so four
+// blocks are folded in for the latency of one multiplication. A
+// group takes 128 / DIGIT_BITS + 1 cycles, during which the next
+// group is being collected. flush folds in a last, partial group,
+// and no blocks are taken until that is done. ready is set when all
+// blocks given have been folded in.
+//
+//
+// Copyright (c) 2016, NORDUnet A/S
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// - Neither the name of the NORDUnet nor the names of its contributors may
+//   be used to endorse or promote products derived from this software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+module ghash_core #(parameter DIGIT_BITS = 8)
+                  (
+                   input wire            clk,
+                   input wire            reset_n,
+
+                   input wire            init,
+                   input wire            clear,
+                   input wire [127 : 0]  h,
+
+                   input wire            block_valid,
+                   input wire [127 : 0]  block,
+                   output wire           block_ready,
+
+                   input wire            flush,
+                   output wire           ready,
+
+                   output wire [127 : 0] y
+                  );
+
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  localparam NUM_MULS   = 4;
+  localparam NUM_DIGITS = 128 / DIGIT_BITS;
+
+  localparam CTRL_IDLE  = 2'h0;
+  localparam CTRL_POW2  = 2'h1;
+  localparam CTRL_POW34 = 2'h2;
+  localparam CTRL_MUL   = 2'h3;
+
+
+  //----------------------------------------------------------------
+  // Registers including update variables and write enable.
+  //----------------------------------------------------------------
+  reg [127 : 0] hpow_reg [0 : (NUM_MULS - 1)];
+  reg           hpow1_we;
+  reg           hpow2_we;
+  reg           hpow34_we;
+
+  reg [127 : 0] grp_reg [0 : (NUM_MULS - 1)];
+  reg           grp_we;
+
+  reg [2 : 0]   grp_cnt_reg;
+  reg [2 : 0]   grp_cnt_new;
+  reg           grp_cnt_we;
+
+  reg           flush_reg;
+  reg           flush_new;
+  reg           flush_we;
+
+  reg [127 : 0] x_reg [0 : (NUM_MULS - 1)];
+  reg [127 : 0] z_reg [0 : (NUM_MULS - 1)];
+  reg [127 : 0] v_reg [0 : (NUM_MULS - 1)];
+  reg           mul_start;
+  reg           mul_step;
+
+  reg [7 : 0]   digit_ctr_reg;
+  reg [7 : 0]   digit_ctr_new;
+  reg           digit_ctr_we;
+
+  reg [127 : 0] y_reg;
+  reg [127 : 0] y_new;
+  reg           y_we;
+
+  reg [1 : 0]   ghash_ctrl_reg;
+  reg [1 : 0]   ghash_ctrl_new;
+  reg           ghash_ctrl_we;
+
+
+  //----------------------------------------------------------------
+  // Wires.
+  //----------------------------------------------------------------
+  reg [127 : 0]  start_x [0 : (NUM_MULS - 1)];
+  reg [127 : 0]  start_v [0 : (NUM_MULS - 1)];
+
+  wire [127 : 0] step_z [0 : (NUM_MULS - 1)];
+  wire [127 : 0] step_v [0 : (NUM_MULS - 1)];
+
+  wire           busy;
+  wire           take_block;
+  wire           group_full;
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity for ports etc.
+  //----------------------------------------------------------------
+  assign busy        = (ghash_ctrl_reg == CTRL_POW2) || (ghash_ctrl_reg == CTRL_POW34);
+  assign group_full  = grp_cnt_reg == NUM_MULS;
+  assign block_ready = !busy && !group_full && !flush_reg;
+  assign take_block  = block_valid && block_ready;
+
+  assign ready = (ghash_ctrl_reg == CTRL_IDLE) && (grp_cnt_reg == 3'h0) &&
+                 !flush_reg && !flush;
+
+  assign y     = y_reg;
+
+
+  //----------------------------------------------------------------
+  // The multipliers. Each takes the next digit of its x register
+  // every cycle.
+  //----------------------------------------------------------------
+  genvar m;
+  generate
+    for (m = 0 ; m < NUM_MULS ; m = m + 1)
+      begin : muls
+        ghash_mul_digit #(.DIGIT_BITS(DIGIT_BITS))
+                        mul(
+                            .z(z_reg[m]),
+                            .v(v_reg[m]),
+                            .x(x_reg[m][127 -: DIGIT_BITS]),
+                            .z_new(step_z[m]),
+                            .v_new(step_v[m])
+                           );
+      end
+  endgenerate
+
+
+  //----------------------------------------------------------------
+  // reg_update
+  //
+  // Update functionality for all registers in the core.
+  // All registers are positive edge triggered with asynchronous
+  // active low reset.
+  //----------------------------------------------------------------
+  always @ (posedge clk or negedge reset_n)
+    begin : reg_update
+      integer i;
+
+      if (!reset_n)
+        begin
+          for (i = 0 ; i < NUM_MULS ; i = i + 1)
+            begin
+              hpow_reg[i] <= 128'h0;
+              grp_reg[i]  <= 128'h0;
+              x_reg[i]    <= 128'h0;
+              z_reg[i]    <= 128'h0;
+              v_reg[i]    <= 128'h0;
+            end
+
+          grp_cnt_reg    <= 3'h0;
+          flush_reg      <= 1'b0;
+          digit_ctr_reg  <= 8'h0;
+          y_reg          <= 128'h0;
+          ghash_ctrl_reg <= CTRL_IDLE;
+        end
+      else
+        begin
+          if (hpow1_we)
+            hpow_reg[0] <= h;
+
+          if (hpow2_we)
+            hpow_reg[1] <= step_z[0];
+
+          if (hpow34_we)
+            begin
+              hpow_reg[2] <= step_z[0];
+              hpow_reg[3] <= step_z[1];
+            end
+
+          if (grp_we)
+            grp_reg[grp_cnt_reg[1 : 0]] <= block;
+
+          if (grp_cnt_we)
+            grp_cnt_reg <= grp_cnt_new;
+
+          if (flush_we)
+            flush_reg <= flush_new;
+
+          for (i = 0 ; i < NUM_MULS ; i = i + 1)
+            begin
+              if (mul_start)
+                begin
+                  x_reg[i] <= start_x[i];
+                  z_reg[i] <= 128'h0;
+                  v_reg[i] <= start_v[i];
+                end
+
+              if (mul_step)
+                begin
+                  x_reg[i] <= {x_reg[i][(127 - DIGIT_BITS) : 0], {DIGIT_BITS{1'b0}}};
+                  z_reg[i] <= step_z[i];
+                  v_reg[i] <= step_v[i];
+                end
+            end
+
+          if (digit_ctr_we)
+            digit_ctr_reg <= digit_ctr_new;
+
+          if (y_we)
+            y_reg <= y_new;
+
+          if (ghash_ctrl_we)
+            ghash_ctrl_reg <= ghash_ctrl_new;
+        end
+    end // reg_update
+
+
+  //----------------------------------------------------------------
+  // mul_operands
+  //
+  // The operands for a group of n blocks: block j, with the hash
+  // added to the first one, is multiplied by H^(n - j). Unused
+  // multipliers get zero. During init the multipliers compute
+  // H * H and then H^2 * H and H^2 * H^2.
+  //----------------------------------------------------------------
+  always @*
+    begin : mul_operands
+      integer i;
+
+      for (i = 0 ; i < NUM_MULS ; i = i + 1)
+        begin
+          start_x[i] = 128'h0;
+          start_v[i] = 128'h0;
+        end
+
+      case (ghash_ctrl_reg)
+        CTRL_IDLE:
+          begin
+            if (init)
+              begin
+                start_x[0] = h;
+                start_v[0] = h;
+              end
+            else
+              begin
+                for (i = 0 ; i < NUM_MULS ; i = i + 1)
+                  if (i < grp_cnt_reg)
+                    begin
+                      start_x[i] = grp_reg[i];
+                      start_v[i] = hpow_reg[grp_cnt_reg - 1 - i];
+                    end
+
+                start_x[0] = grp_reg[0] ^ y_reg;
+              end
+          end
+
+        CTRL_POW2:
+          begin
+            start_x[0] = step_z[0];
+            start_v[0] = hpow_reg[0];
+            start_x[1] = step_z[0];
+            start_v[1] = step_z[0];
+          end
+
+        default:
+          begin
+          end
+      endcase // case (ghash_ctrl_reg)
+    end // mul_operands
+
+
+  //----------------------------------------------------------------
+  // ghash_ctrl
+  //----------------------------------------------------------------
+  always @*
+    begin : ghash_ctrl
+      hpow1_we       = 1'b0;
+      hpow2_we       = 1'b0;
+      hpow34_we      = 1'b0;
+      grp_we         = 1'b0;
+      grp_cnt_new    = grp_cnt_reg;
+      grp_cnt_we     = 1'b0;
+      flush_new      = 1'b0;
+      flush_we       = 1'b0;
+      mul_start      = 1'b0;
+      mul_step       = 1'b0;
+      digit_ctr_new  = 8'h0;
+      digit_ctr_we   = 1'b0;
+      y_new          = 128'h0;
+      y_we           = 1'b0;
+      ghash_ctrl_new = CTRL_IDLE;
+      ghash_ctrl_we  = 1'b0;
+
+      if (flush)
+        begin
+          flush_new = 1'b1;
+          flush_we  = 1'b1;
+        end
+
+      if (take_block)
+        begin
+          grp_we      = 1'b1;
+          grp_cnt_new = grp_cnt_reg + 1'b1;
+          grp_cnt_we  = 1'b1;
+        end
+
+      case (ghash_ctrl_reg)
+        CTRL_IDLE:
+          begin
+            if (init)
+              begin
+                hpow1_we       = 1'b1;
+                mul_start      = 1'b1;
+                digit_ctr_new  = 8'h0;
+                digit_ctr_we   = 1'b1;
+                grp_cnt_new    = 3'h0;
+                grp_cnt_we     = 1'b1;
+                flush_new      = 1'b0;
+                flush_we       = 1'b1;
+                y_we           = 1'b1;
+                ghash_ctrl_new = CTRL_POW2;
+                ghash_ctrl_we  = 1'b1;
+              end
+
+            else if (group_full || (flush_reg && (grp_cnt_reg != 3'h0)))
+              begin
+                // The group is handed to the multipliers, so the
+                // next one can be collected at once.
+                mul_start      = 1'b1;
+                digit_ctr_new  = 8'h0;
+                digit_ctr_we   = 1'b1;
+                grp_cnt_new    = 3'h0;
+                grp_cnt_we     = 1'b1;
+                ghash_ctrl_new = CTRL_MUL;
+                ghash_ctrl_we  = 1'b1;
+              end
+
+            else if (flush_reg && !flush)
+              begin
+                flush_new = 1'b0;
+                flush_we  = 1'b1;
+              end
+          end
+
+        CTRL_POW2, CTRL_POW34, CTRL_MUL:
+          begin
+            mul_step      = 1'b1;
+            digit_ctr_new = digit_ctr_reg + 1'b1;
+            digit_ctr_we  = 1'b1;
+
+            if (digit_ctr_reg == NUM_DIGITS - 1)
+              begin
+                mul_step = 1'b0;
+
+                case (ghash_ctrl_reg)
+                  CTRL_POW2:
+                    begin
+                      hpow2_we       = 1'b1;
+                      mul_start      = 1'b1;
+                      digit_ctr_new  = 8'h0;
+                      ghash_ctrl_new = CTRL_POW34;
+                      ghash_ctrl_we  = 1'b1;
+                    end
+
+                  CTRL_POW34:
+                    begin
+                      hpow34_we      = 1'b1;
+                      ghash_ctrl_new = CTRL_IDLE;
+                      ghash_ctrl_we  = 1'b1;
+                    end
+
+                  default:
+                    begin
+                      y_new          = step_z[0] ^ step_z[1] ^ step_z[2] ^ step_z[3];
+                      y_we           = 1'b1;
+                      ghash_ctrl_new = CTRL_IDLE;
+                      ghash_ctrl_we  = 1'b1;
+                    end
+                endcase // case (ghash_ctrl_reg)
+              end
+          end
+
+        default:
+          begin
+          end
+      endcase // case (ghash_ctrl_reg)
+
+      // clear also drops a group in progress, so that a message that
+      // was never finished does not leave anything behind.
+      if (clear && !init && !busy)
+        begin
+          grp_cnt_new    = 3'h0;
+          grp_cnt_we     = 1'b1;
+          flush_new      = 1'b0;
+          flush_we       = 1'b1;
+          mul_start      = 1'b0;
+          mul_step       = 1'b0;
+          y_new          = 128'h0;
+          y_we           = 1'b1;
+          ghash_ctrl_new = CTRL_IDLE;
+          ghash_ctrl_we  = 1'b1;
+        end
+    end // ghash_ctrl
+endmodule // ghash_core
+
+//======================================================================
+// EOF ghash_core.v
+//======================================================================
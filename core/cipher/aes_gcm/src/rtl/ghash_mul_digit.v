@@ -0,0 +1,104 @@
+//======================================================================
+//
+// ghash_mul_digit.v
+// -----------------
+// One digit step of a digit serial GF(2^128) multiplier with the GCM
+// bit order and reduction polynomial (NIST SP 800-38D, algorithm 1).
+//
+// The step takes the next DIGIT_BITS bits of the multiplier x, most
+// significant first, and updates the product z and the shifted
+// multiplicand v. Purely combinational.
+//
+//
+// Copyright (c) 2016, NORDUnet A/S
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// - Neither the name of the NORDUnet nor the names of its contributors may
+//   be used to endorse or promote products derived from this software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+module ghash_mul_digit #(parameter DIGIT_BITS = 8)
+                       (
+                        input wire [127 : 0]             z,
+                        input wire [127 : 0]             v,
+                        input wire [(DIGIT_BITS - 1) : 0] x,
+
+                        output wire [127 : 0]            z_new,
+                        output wire [127 : 0]            v_new
+                       );
+
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  localparam R = {8'he1, 120'h0};
+
+
+  //----------------------------------------------------------------
+  // Wires.
+  //----------------------------------------------------------------
+  reg [127 : 0] tmp_z;
+  reg [127 : 0] tmp_v;
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity for ports etc.
+  //----------------------------------------------------------------
+  assign z_new = tmp_z;
+  assign v_new = tmp_v;
+
+
+  //----------------------------------------------------------------
+  // mul_logic
+  //
+  // For each bit of x: add v to z if the bit is set, then multiply
+  // v by the generator, which in the GCM bit order is a right shift
+  // with the bit shifted out folding R back in.
+  //----------------------------------------------------------------
+  always @*
+    begin : mul_logic
+      integer i;
+
+      tmp_z = z;
+      tmp_v = v;
+
+      for (i = DIGIT_BITS - 1 ; i >= 0 ; i = i - 1)
+        begin
+          if (x[i])
+            tmp_z = tmp_z ^ tmp_v;
+
+          if (tmp_v[0])
+            tmp_v = {1'b0, tmp_v[127 : 1]} ^ R;
+          else
+            tmp_v = {1'b0, tmp_v[127 : 1]};
+        end
+    end // mul_logic
+endmodule // ghash_mul_digit
+
+//======================================================================
+// EOF ghash_mul_digit.v
+//======================================================================
@@ -0,0 +1,690 @@
+//======================================================================
+//
+// tb_aes_gcm.v
+// ------------
+// Testbench for the AES-GCM engine, using the GCM test cases 2, 4
+// and 16 (McGrew and Viega, as used in NIST CAVP), and 64 byte,
+// 1 KiB and 64 KiB messages to measure the throughput.
+//
+//
+// Copyright (c) 2016, NORDUnet A/S
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// - Neither the name of the NORDUnet nor the names of its contributors may
+//   be used to endorse or promote products derived from this software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+//------------------------------------------------------------------
+// Test module.
+//------------------------------------------------------------------
+module tb_aes_gcm();
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  parameter DEBUG     = 0;
+
+  parameter CLK_HALF_PERIOD = 1;
+  parameter CLK_PERIOD      = 2 * CLK_HALF_PERIOD;
+
+  // The DUT address map.
+  parameter ADDR_NAME0       = 10'h000;
+  parameter ADDR_NAME1       = 10'h001;
+  parameter ADDR_VERSION     = 10'h002;
+
+  parameter ADDR_CTRL        = 10'h008;
+  parameter CTRL_INIT        = 32'h1;
+  parameter CTRL_NEXT        = 32'h2;
+  parameter CTRL_START       = 32'h4;
+  parameter CTRL_FINISH      = 32'h8;
+
+  parameter ADDR_STATUS      = 10'h009;
+  parameter STATUS_READY_BIT = 0;
+  parameter STATUS_VALID_BIT = 1;
+
+  parameter ADDR_CONFIG      = 10'h00a;
+  parameter CONFIG_ENCRYPT   = 3'h1;
+  parameter CONFIG_AAD       = 3'h4;
+
+  parameter ADDR_NUM_BLOCKS  = 10'h00b;
+  parameter ADDR_CYCLES      = 10'h00c;
+  parameter ADDR_LAST_LEN    = 10'h00d;
+
+  parameter ADDR_KEY0        = 10'h010;
+  parameter ADDR_IV0         = 10'h018;
+  parameter ADDR_TAG0        = 10'h020;
+
+  parameter ADDR_IN_BUF      = 10'h100;
+  parameter ADDR_OUT_BUF     = 10'h200;
+
+  parameter MAX_BLOCKS       = 64;
+
+  parameter AES_128_BIT_KEY = 0;
+  parameter AES_256_BIT_KEY = 1;
+
+
+  //----------------------------------------------------------------
+  // Register and Wire declarations.
+  //----------------------------------------------------------------
+  reg [31 : 0]  cycle_ctr;
+  reg [31 : 0]  error_ctr;
+  reg [31 : 0]  tc_ctr;
+
+  reg [31 : 0]  read_data;
+  reg [127 : 0] result_data;
+
+  reg           key_length;
+
+  reg           tb_clk;
+  reg           tb_reset_n;
+  reg           tb_cs;
+  reg           tb_we;
+  reg [9 : 0]   tb_address;
+  reg [31 : 0]  tb_write_data;
+  wire [31 : 0] tb_read_data;
+
+
+  //----------------------------------------------------------------
+  // Device Under Test.
+  //----------------------------------------------------------------
+  aes_gcm dut(
+              .clk(tb_clk),
+              .reset_n(tb_reset_n),
+              .cs(tb_cs),
+              .we(tb_we),
+              .address(tb_address),
+              .write_data(tb_write_data),
+              .read_data(tb_read_data)
+             );
+
+
+  //----------------------------------------------------------------
+  // clk_gen
+  //
+  // Always running clock generator process.
+  //----------------------------------------------------------------
+  always
+    begin : clk_gen
+      #CLK_HALF_PERIOD;
+      tb_clk = !tb_clk;
+    end // clk_gen
+
+
+  //----------------------------------------------------------------
+  // sys_monitor()
+  //
+  // An always running process that creates a cycle counter and
+  // conditionally displays information about the DUT.
+  //----------------------------------------------------------------
+  always
+    begin : sys_monitor
+      cycle_ctr = cycle_ctr + 1;
+
+      #(CLK_PERIOD);
+
+      if (DEBUG)
+        begin
+          dump_dut_state();
+        end
+    end
+
+
+  //----------------------------------------------------------------
+  // dump_dut_state()
+  //
+  // Dump the state of the dump when needed.
+  //----------------------------------------------------------------
+  task dump_dut_state;
+    begin
+      $display("cycle: 0x%016x", cycle_ctr);
+      $display("State of DUT");
+      $display("------------");
+      $display("engine: state = 0x%01x, in_ptr = 0x%02x, out_ptr = 0x%02x, gh_ptr = 0x%02x",
+               dut.eng_ctrl_reg, dut.in_ptr_reg, dut.out_ptr_reg, dut.gh_ptr_reg);
+      $display("aes:    ready = 0x%01x, in_valid = 0x%01x, out_valid = 0x%01x",
+               dut.core_ready, dut.aes_in_valid_reg, dut.core_out_valid);
+      $display("ghash:  ready = 0x%01x, block_ready = 0x%01x, y = 0x%032x",
+               dut.ghash_ready, dut.ghash_block_ready, dut.ghash_y);
+      $display("ctr = 0x%032x, aad_bits = 0x%016x, ct_bits = 0x%016x",
+               dut.ctr_reg, dut.aad_bits_reg, dut.ct_bits_reg);
+      $display("");
+    end
+  endtask // dump_dut_state
+
+
+  //----------------------------------------------------------------
+  // reset_dut()
+  //
+  // Toggle reset to put the DUT into a well known state.
+  //----------------------------------------------------------------
+  task reset_dut;
+    begin
+      $display("*** Toggle reset.");
+      tb_reset_n = 0;
+
+      #(2 * CLK_PERIOD);
+      tb_reset_n = 1;
+      $display("");
+    end
+  endtask // reset_dut
+
+
+  //----------------------------------------------------------------
+  // display_test_results()
+  //
+  // Display the accumulated test results.
+  //----------------------------------------------------------------
+  task display_test_results;
+    begin
+      if (error_ctr == 0)
+        begin
+          $display("*** All %02d test cases completed successfully", tc_ctr);
+        end
+      else
+        begin
+          $display("*** %02d tests completed - %02d test cases did not complete successfully.",
+                   tc_ctr, error_ctr);
+        end
+    end
+  endtask // display_test_results
+
+
+  //----------------------------------------------------------------
+  // init_sim()
+  //
+  // Initialize all counters and testbed functionality as well
+  // as setting the DUT inputs to defined values.
+  //----------------------------------------------------------------
+  task init_sim;
+    begin
+      cycle_ctr     = 0;
+      error_ctr     = 0;
+      tc_ctr        = 0;
+      key_length    = 0;
+
+      tb_clk        = 0;
+      tb_reset_n    = 1;
+
+      tb_cs         = 0;
+      tb_we         = 0;
+      tb_address    = 10'h0;
+      tb_write_data = 32'h0;
+    end
+  endtask // init_sim
+
+
+  //----------------------------------------------------------------
+  // write_word()
+  //
+  // Write the given word to the DUT using the DUT interface.
+  //----------------------------------------------------------------
+  task write_word(input [9 : 0]  address,
+                  input [31 : 0] word);
+    begin
+      if (DEBUG)
+        begin
+          $display("*** Writing 0x%08x to 0x%03x.", word, address);
+          $display("");
+        end
+
+      tb_address = address;
+      tb_write_data = word;
+      tb_cs = 1;
+      tb_we = 1;
+      #(2 * CLK_PERIOD);
+      tb_cs = 0;
+      tb_we = 0;
+    end
+  endtask // write_word
+
+
+  //----------------------------------------------------------------
+  // read_word()
+  //
+  // Read a data word from the given address in the DUT.
+  // the word read will be available in the global variable
+  // read_data.
+  //----------------------------------------------------------------
+  task read_word(input [9 : 0]  address);
+    begin
+      tb_address = address;
+      tb_cs = 1;
+      tb_we = 0;
+      #(CLK_PERIOD);
+      read_data = tb_read_data;
+      tb_cs = 0;
+
+      if (DEBUG)
+        begin
+          $display("*** Reading 0x%08x from 0x%03x.", read_data, address);
+          $display("");
+        end
+    end
+  endtask // read_word
+
+
+  //----------------------------------------------------------------
+  // write_in_block()
+  //
+  // Write the given block to the given slot in the input buffer.
+  //----------------------------------------------------------------
+  task write_in_block(input [5 : 0] slot, input [127 : 0] block);
+    begin
+      write_word(ADDR_IN_BUF + {slot, 2'h0},        block[127 : 096]);
+      write_word(ADDR_IN_BUF + {slot, 2'h0} + 2'h1, block[095 : 064]);
+      write_word(ADDR_IN_BUF + {slot, 2'h0} + 2'h2, block[063 : 032]);
+      write_word(ADDR_IN_BUF + {slot, 2'h0} + 2'h3, block[031 : 000]);
+    end
+  endtask // write_in_block
+
+
+  //----------------------------------------------------------------
+  // read_out_block()
+  //
+  // Read the block in the given slot of the output buffer into
+  // result_data.
+  //----------------------------------------------------------------
+  task read_out_block(input [5 : 0] slot);
+    begin
+      read_word(ADDR_OUT_BUF + {slot, 2'h0});
+      result_data[127 : 096] = read_data;
+      read_word(ADDR_OUT_BUF + {slot, 2'h0} + 2'h1);
+      result_data[095 : 064] = read_data;
+      read_word(ADDR_OUT_BUF + {slot, 2'h0} + 2'h2);
+      result_data[063 : 032] = read_data;
+      read_word(ADDR_OUT_BUF + {slot, 2'h0} + 2'h3);
+      result_data[031 : 000] = read_data;
+    end
+  endtask // read_out_block
+
+
+  //----------------------------------------------------------------
+  // read_tag()
+  //
+  // Read the tag into result_data.
+  //----------------------------------------------------------------
+  task read_tag;
+    begin
+      read_word(ADDR_TAG0);
+      result_data[127 : 096] = read_data;
+      read_word(ADDR_TAG0 + 1);
+      result_data[095 : 064] = read_data;
+      read_word(ADDR_TAG0 + 2);
+      result_data[063 : 032] = read_data;
+      read_word(ADDR_TAG0 + 3);
+      result_data[031 : 000] = read_data;
+    end
+  endtask // read_tag
+
+
+  //----------------------------------------------------------------
+  // wait_status()
+  //
+  // Wait for the given status bit to be set.
+  //----------------------------------------------------------------
+  task wait_status(input integer bit_no);
+    begin : wait_status
+      reg done;
+      done = 1'b0;
+
+      while (done != 1'b1)
+        begin
+          read_word(ADDR_STATUS);
+          done = read_data[bit_no];
+        end
+    end
+  endtask // wait_status
+
+
+  //----------------------------------------------------------------
+  // init_key()
+  //
+  // Write the key and key length and let the DUT expand the key
+  // and compute the hash subkey.
+  //----------------------------------------------------------------
+  task init_key(input [255 : 0] key, input keylen);
+    begin : init_key
+      integer i;
+
+      for (i = 0 ; i < 8 ; i = i + 1)
+        write_word(ADDR_KEY0 + i, key[(255 - 32 * i) -: 32]);
+
+      key_length = keylen;
+      write_word(ADDR_CONFIG, {29'h0, 1'b0, key_length, 1'b0});
+      write_word(ADDR_CTRL, CTRL_INIT);
+      wait_status(STATUS_READY_BIT);
+    end
+  endtask // init_key
+
+
+  //----------------------------------------------------------------
+  // start_iv()
+  //
+  // Start a new message with the given IV.
+  //----------------------------------------------------------------
+  task start_iv(input [95 : 0] iv);
+    begin
+      write_word(ADDR_IV0,     iv[95 : 64]);
+      write_word(ADDR_IV0 + 1, iv[63 : 32]);
+      write_word(ADDR_IV0 + 2, iv[31 : 00]);
+      write_word(ADDR_CTRL, CTRL_START);
+      wait_status(STATUS_READY_BIT);
+    end
+  endtask // start_iv
+
+
+  //----------------------------------------------------------------
+  // run_blocks()
+  //
+  // Run num_blocks blocks from the input buffer, the last one
+  // last_len bytes long, as AAD or data, and wait for the result.
+  //----------------------------------------------------------------
+  task run_blocks(input [2 : 0] mode,
+                  input [6 : 0] num_blocks,
+                  input [4 : 0] last_len);
+    begin
+      write_word(ADDR_CONFIG, {29'h0, mode[2], key_length, mode[0]});
+      write_word(ADDR_NUM_BLOCKS, {25'h0, num_blocks});
+      write_word(ADDR_LAST_LEN, {27'h0, last_len});
+      write_word(ADDR_CTRL, CTRL_NEXT);
+      wait_status(STATUS_VALID_BIT);
+    end
+  endtask // run_blocks
+
+
+  //----------------------------------------------------------------
+  // gcm_test()
+  //
+  // Run a message of up to 64 bytes of AAD and 64 bytes of data,
+  // first byte in the MSBs, through the DUT and check the result
+  // and the tag. Encrypts when encdec is set, otherwise decrypts.
+  //----------------------------------------------------------------
+  task gcm_test(input [7 : 0]   tc_number,
+                input [255 : 0] key,
+                input           keylen,
+                input [95 : 0]  iv,
+                input [511 : 0] aad,
+                input [6 : 0]   aad_len,
+                input [511 : 0] data,
+                input [6 : 0]   data_len,
+                input           encdec,
+                input [511 : 0] expected,
+                input [127 : 0] expected_tag);
+    begin : gcm_test
+      integer i;
+      integer tc_errors;
+      reg [6 : 0]   num_blocks;
+      reg [127 : 0] expected_block;
+
+      tc_errors = 0;
+      $display("*** TC %0d started.", tc_number);
+      tc_ctr = tc_ctr + 1;
+
+      init_key(key, keylen);
+      start_iv(iv);
+
+      if (aad_len > 0)
+        begin
+          num_blocks = (aad_len + 15) / 16;
+          for (i = 0 ; i < num_blocks ; i = i + 1)
+            write_in_block(i, aad[(511 - 128 * i) -: 128]);
+          run_blocks(CONFIG_AAD, num_blocks, aad_len - 16 * (num_blocks - 1));
+        end
+
+      if (data_len > 0)
+        begin
+          num_blocks = (data_len + 15) / 16;
+          for (i = 0 ; i < num_blocks ; i = i + 1)
+            write_in_block(i, data[(511 - 128 * i) -: 128]);
+          run_blocks({2'h0, encdec}, num_blocks, data_len - 16 * (num_blocks - 1));
+
+          for (i = 0 ; i < num_blocks ; i = i + 1)
+            begin
+              read_out_block(i);
+              expected_block = expected[(511 - 128 * i) -: 128];
+              if (result_data != expected_block)
+                begin
+                  $display("Error in block %0d:", i);
+                  $display("Expected: 0x%032x", expected_block);
+                  $display("Got:      0x%032x", result_data);
+                  tc_errors = tc_errors + 1;
+                end
+            end
+        end
+
+      write_word(ADDR_CTRL, CTRL_FINISH);
+      wait_status(STATUS_VALID_BIT);
+      read_tag();
+
+      if (result_data != expected_tag)
+        begin
+          $display("Error in tag:");
+          $display("Expected: 0x%032x", expected_tag);
+          $display("Got:      0x%032x", result_data);
+          tc_errors = tc_errors + 1;
+        end
+
+      if (tc_errors == 0)
+        $display("*** TC %0d successful.", tc_number);
+      else
+        begin
+          $display("*** ERROR: TC %0d NOT successful.", tc_number);
+          error_ctr = error_ctr + 1;
+        end
+      $display("");
+    end
+  endtask // gcm_test
+
+
+  //----------------------------------------------------------------
+  // gcm_vector_tests()
+  //
+  // GCM test cases 2 (AES-128, one block), 4 (AES-128, AAD and a
+  // partial last block) in both directions and 16 (AES-256).
+  //----------------------------------------------------------------
+  task gcm_vector_tests;
+    reg [255 : 0] tc4_key;
+    reg [95 : 0]  tc4_iv;
+    reg [511 : 0] tc4_aad;
+    reg [511 : 0] tc4_plaintext;
+    reg [511 : 0] tc4_ciphertext;
+    reg [511 : 0] tc16_ciphertext;
+
+    begin
+      tc4_key         = 256'hfeffe9928665731c6d6a8f946730830800000000000000000000000000000000;
+      tc4_iv          = 96'hcafebabefacedbaddecaf888;
+      tc4_aad         = {160'hfeedfacedeadbeeffeedfacedeadbeefabaddad2, 352'h0};
+
+      tc4_plaintext   = {128'hd9313225f88406e5a55909c5aff5269a,
+                         128'h86a7a9531534f7da2e4c303d8a318a72,
+                         128'h1c3c0c95956809532fcf0e2449a6b525,
+                         128'hb16aedf5aa0de657ba637b39_00000000};
+
+      tc4_ciphertext  = {128'h42831ec2217774244b7221b784d0d49c,
+                         128'he3aa212f2c02a4e035c17e2329aca12e,
+                         128'h21d514b25466931c7d8f6a5aac84aa05,
+                         128'h1ba30b396a0aac973d58e091_00000000};
+
+      tc16_ciphertext = {128'h522dc1f099567d07f47f37a32a84427d,
+                         128'h643a8cdcbfe5c0c97598a2bd2555d1aa,
+                         128'h8cb08e48590dbb3da7b08b1056828838,
+                         128'hc5f61e6393ba7a0abcc9f662_00000000};
+
+      $display("GCM test vectors");
+      $display("----------------");
+      gcm_test(8'h01, 256'h0, AES_128_BIT_KEY, 96'h0,
+               512'h0, 7'd0,
+               512'h0, 7'd16, 1'b1,
+               {128'h0388dace60b6a392f328c2b971b2fe78, 384'h0},
+               128'hab6e47d42cec13bdf53a67b21257bddf);
+
+      gcm_test(8'h02, tc4_key, AES_128_BIT_KEY, tc4_iv,
+               tc4_aad, 7'd20,
+               tc4_plaintext, 7'd60, 1'b1,
+               tc4_ciphertext,
+               128'h5bc94fbc3221a5db94fae95ae7121a47);
+
+      gcm_test(8'h03, tc4_key, AES_128_BIT_KEY, tc4_iv,
+               tc4_aad, 7'd20,
+               tc4_ciphertext, 7'd60, 1'b0,
+               tc4_plaintext,
+               128'h5bc94fbc3221a5db94fae95ae7121a47);
+
+      gcm_test(8'h04, {tc4_key[255 : 128], tc4_key[255 : 128]}, AES_256_BIT_KEY, tc4_iv,
+               tc4_aad, 7'd20,
+               tc4_plaintext, 7'd60, 1'b1,
+               tc16_ciphertext,
+               128'h76fc6ece0f4e1768cddf8853bb2d551b);
+    end
+  endtask // gcm_vector_tests
+
+
+  //----------------------------------------------------------------
+  // throughput_test()
+  //
+  // Encrypt a message of num_blocks blocks, the test case 3
+  // plaintext repeated, in runs of up to 64 blocks. Report the
+  // cycles spent in the runs and the cycles for the whole message,
+  // start to tag, including the bus transfers. Only the tag is
+  // checked.
+  //----------------------------------------------------------------
+  task throughput_test(input [7 : 0]   tc_number,
+                       input integer   num_blocks,
+                       input [127 : 0] expected_tag);
+    begin : throughput_test
+      integer i;
+      integer j;
+      integer run_len;
+      reg [511 : 0] plaintext;
+      reg [31 : 0]  start_cycle;
+      reg [31 : 0]  run_cycles;
+      reg [31 : 0]  total_cycles;
+
+      plaintext    = {128'hd9313225f88406e5a55909c5aff5269a,
+                      128'h86a7a9531534f7da2e4c303d8a318a72,
+                      128'h1c3c0c95956809532fcf0e2449a6b525,
+                      128'hb16aedf5aa0de657ba637b391aafd255};
+
+      $display("*** TC %0d throughput test of %0d bytes started.", tc_number,
+               16 * num_blocks);
+      tc_ctr = tc_ctr + 1;
+
+      init_key(256'hfeffe9928665731c6d6a8f946730830800000000000000000000000000000000,
+               AES_128_BIT_KEY);
+
+      start_cycle = cycle_ctr;
+      run_cycles  = 0;
+      start_iv(96'hcafebabefacedbaddecaf888);
+
+      for (i = 0 ; i < num_blocks ; i = i + run_len)
+        begin
+          run_len = num_blocks - i;
+          if (run_len > MAX_BLOCKS)
+            run_len = MAX_BLOCKS;
+
+          for (j = 0 ; j < run_len ; j = j + 1)
+            write_in_block(j, plaintext[(511 - 128 * (j % 4)) -: 128]);
+
+          run_blocks({2'h0, 1'b1}, run_len, 5'h10);
+          read_word(ADDR_CYCLES);
+          run_cycles = run_cycles + read_data;
+
+          for (j = 0 ; j < run_len ; j = j + 1)
+            read_out_block(j);
+        end
+
+      write_word(ADDR_CTRL, CTRL_FINISH);
+      wait_status(STATUS_VALID_BIT);
+      read_tag();
+      total_cycles = cycle_ctr - start_cycle;
+
+      $display("*** Runs took %0d cycles (%0d.%02d cycles/block).",
+               run_cycles, run_cycles / num_blocks,
+               ((100 * run_cycles) / num_blocks) % 100);
+      $display("*** Message took %0d cycles (%0d.%02d cycles/block), including the bus transfers.",
+               total_cycles, total_cycles / num_blocks,
+               ((100 * total_cycles) / num_blocks) % 100);
+
+      if (result_data == expected_tag)
+        $display("*** TC %0d successful.", tc_number);
+      else
+        begin
+          $display("*** ERROR: TC %0d NOT successful.", tc_number);
+          $display("Expected: 0x%032x", expected_tag);
+          $display("Got:      0x%032x", result_data);
+          error_ctr = error_ctr + 1;
+        end
+      $display("");
+    end
+  endtask // throughput_test
+
+
+  //----------------------------------------------------------------
+  // throughput_tests()
+  //
+  // Throughput for 64 byte, 1 KiB and 64 KiB messages. The tags
+  // were computed with a software GCM that passes test case 3.
+  //----------------------------------------------------------------
+  task throughput_tests;
+    begin
+      $display("Throughput tests");
+      $display("----------------");
+      throughput_test(8'h05, 4,    128'h4d5c2af327cd64a62cf35abd2ba6fab4);
+      throughput_test(8'h06, 64,   128'hccbbbccf86014d934b685519a140cdea);
+      throughput_test(8'h07, 4096, 128'hfdb94f07cb3b5c61b87c7271794a6a2c);
+    end
+  endtask // throughput_tests
+
+
+  //----------------------------------------------------------------
+  // main
+  //
+  // The main test functionality.
+  //----------------------------------------------------------------
+  initial
+    begin : main
+      $display("   -= Testbench for AES-GCM started =-");
+      $display("    ==================================");
+      $display("");
+
+      init_sim();
+      reset_dut();
+
+      gcm_vector_tests();
+      throughput_tests();
+
+      display_test_results();
+
+      $display("");
+      $display("*** AES-GCM simulation done. ***");
+      $finish;
+    end // main
+endmodule // tb_aes_gcm
+
+//======================================================================
+// EOF tb_aes_gcm.v
+//======================================================================
@@ -0,0 +1,376 @@
+//======================================================================
+//
+// tb_ghash_core.v
+// ---------------
+// Testbench for the GHASH core, using hash subkeys and GHASH values
+// from the GCM test cases 2 and 4 (McGrew and Viega, as used in
+// NIST CAVP).
+//
+//
+// Copyright (c) 2016, NORDUnet A/S
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// - Neither the name of the NORDUnet nor the names of its contributors may
+//   be used to endorse or promote products derived from this software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+//------------------------------------------------------------------
+// Test module.
+//------------------------------------------------------------------
+module tb_ghash_core();
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  parameter DEBUG = 0;
+
+  parameter CLK_HALF_PERIOD = 1;
+  parameter CLK_PERIOD      = 2 * CLK_HALF_PERIOD;
+
+
+  //----------------------------------------------------------------
+  // Register and Wire declarations.
+  //----------------------------------------------------------------
+  reg [31 : 0]   cycle_ctr;
+  reg [31 : 0]   error_ctr;
+  reg [31 : 0]   tc_ctr;
+
+  reg            tb_clk;
+  reg            tb_reset_n;
+  reg            tb_init;
+  reg            tb_clear;
+  reg [127 : 0]  tb_h;
+  reg            tb_block_valid;
+  reg [127 : 0]  tb_block;
+  wire           tb_block_ready;
+  reg            tb_flush;
+  wire           tb_ready;
+  wire [127 : 0] tb_y;
+
+
+  //----------------------------------------------------------------
+  // Device Under Test.
+  //----------------------------------------------------------------
+  ghash_core dut(
+                 .clk(tb_clk),
+                 .reset_n(tb_reset_n),
+                 .init(tb_init),
+                 .clear(tb_clear),
+                 .h(tb_h),
+                 .block_valid(tb_block_valid),
+                 .block(tb_block),
+                 .block_ready(tb_block_ready),
+                 .flush(tb_flush),
+                 .ready(tb_ready),
+                 .y(tb_y)
+                );
+
+
+  //----------------------------------------------------------------
+  // clk_gen
+  //
+  // Always running clock generator process.
+  //----------------------------------------------------------------
+  always
+    begin : clk_gen
+      #CLK_HALF_PERIOD;
+      tb_clk = !tb_clk;
+    end // clk_gen
+
+
+  //----------------------------------------------------------------
+  // sys_monitor()
+  //
+  // An always running process that creates a cycle counter and
+  // conditionally displays information about the DUT.
+  //----------------------------------------------------------------
+  always
+    begin : sys_monitor
+      cycle_ctr = cycle_ctr + 1;
+
+      #(CLK_PERIOD);
+
+      if (DEBUG)
+        begin
+          dump_dut_state();
+        end
+    end
+
+
+  //----------------------------------------------------------------
+  // dump_dut_state()
+  //
+  // Dump the state of the dump when needed.
+  //----------------------------------------------------------------
+  task dump_dut_state;
+    begin
+      $display("cycle: 0x%016x", cycle_ctr);
+      $display("ctrl: 0x%01x, digit: 0x%02x, grp_cnt: 0x%01x, flush: 0x%01x",
+               dut.ghash_ctrl_reg, dut.digit_ctr_reg, dut.grp_cnt_reg, dut.flush_reg);
+      $display("y:    0x%032x", dut.y_reg);
+      $display("z0:   0x%032x, v0: 0x%032x", dut.z_reg[0], dut.v_reg[0]);
+      $display("");
+    end
+  endtask // dump_dut_state
+
+
+  //----------------------------------------------------------------
+  // reset_dut()
+  //
+  // Toggle reset to put the DUT into a well known state.
+  //----------------------------------------------------------------
+  task reset_dut;
+    begin
+      $display("*** Toggle reset.");
+      tb_reset_n = 0;
+
+      #(2 * CLK_PERIOD);
+      tb_reset_n = 1;
+      $display("");
+    end
+  endtask // reset_dut
+
+
+  //----------------------------------------------------------------
+  // display_test_results()
+  //
+  // Display the accumulated test results.
+  //----------------------------------------------------------------
+  task display_test_results;
+    begin
+      if (error_ctr == 0)
+        begin
+          $display("*** All %02d test cases completed successfully", tc_ctr);
+        end
+      else
+        begin
+          $display("*** %02d tests completed - %02d test cases did not complete successfully.",
+                   tc_ctr, error_ctr);
+        end
+    end
+  endtask // display_test_results
+
+
+  //----------------------------------------------------------------
+  // init_sim()
+  //
+  // Initialize all counters and testbed functionality as well
+  // as setting the DUT inputs to defined values.
+  //----------------------------------------------------------------
+  task init_sim;
+    begin
+      cycle_ctr      = 0;
+      error_ctr      = 0;
+      tc_ctr         = 0;
+
+      tb_clk         = 0;
+      tb_reset_n     = 1;
+
+      tb_init        = 0;
+      tb_clear       = 0;
+      tb_h           = 128'h0;
+      tb_block_valid = 0;
+      tb_block       = 128'h0;
+      tb_flush       = 0;
+    end
+  endtask // init_sim
+
+
+  //----------------------------------------------------------------
+  // wait_ready()
+  //
+  // Wait for the ready flag in the DUT to be set.
+  //----------------------------------------------------------------
+  task wait_ready;
+    begin
+      #(CLK_PERIOD);
+      while (!tb_ready)
+        begin
+          #(CLK_PERIOD);
+        end
+    end
+  endtask // wait_ready
+
+
+  //----------------------------------------------------------------
+  // init_h()
+  //
+  // Load the hash subkey and wait for the powers to be computed.
+  //----------------------------------------------------------------
+  task init_h(input [127 : 0] h);
+    begin
+      tb_h    = h;
+      tb_init = 1;
+      #(CLK_PERIOD);
+      tb_init = 0;
+      wait_ready();
+    end
+  endtask // init_h
+
+
+  //----------------------------------------------------------------
+  // give_block()
+  //
+  // Hold the block valid until the DUT has taken it.
+  //----------------------------------------------------------------
+  task give_block(input [127 : 0] block);
+    begin : give_block
+      reg taken;
+
+      tb_block       = block;
+      tb_block_valid = 1;
+      taken          = 0;
+
+      while (!taken)
+        begin
+          taken = tb_block_ready;
+          #(CLK_PERIOD);
+        end
+
+      tb_block_valid = 0;
+    end
+  endtask // give_block
+
+
+  //----------------------------------------------------------------
+  // flush_and_check()
+  //
+  // Flush the DUT and compare the hash with the expected value.
+  //----------------------------------------------------------------
+  task flush_and_check(input [7 : 0] tc_number, input [127 : 0] expected);
+    begin
+      tb_flush = 1;
+      #(CLK_PERIOD);
+      tb_flush = 0;
+      wait_ready();
+
+      if (tb_y == expected)
+        $display("*** TC %0d successful.", tc_number);
+      else
+        begin
+          $display("*** ERROR: TC %0d NOT successful.", tc_number);
+          $display("Expected: 0x%032x", expected);
+          $display("Got:      0x%032x", tb_y);
+          error_ctr = error_ctr + 1;
+        end
+      $display("");
+    end
+  endtask // flush_and_check
+
+
+  //----------------------------------------------------------------
+  // gcm_tc2_test()
+  //
+  // GCM test case 2: one block of ciphertext and the length block,
+  // a single partial group.
+  //----------------------------------------------------------------
+  task gcm_tc2_test;
+    begin
+      tc_ctr = tc_ctr + 1;
+      $display("*** TC 1: GCM test case 2 started.");
+
+      init_h(128'h66e94bd4ef8a2c3b884cfa59ca342b2e);
+      give_block(128'h0388dace60b6a392f328c2b971b2fe78);
+      give_block(128'h00000000000000000000000000000080);
+      flush_and_check(8'h01, 128'hf38cbb1ad69223dcc3457ae5b6b0f885);
+    end
+  endtask // gcm_tc2_test
+
+
+  //----------------------------------------------------------------
+  // gcm_tc4_test()
+  //
+  // GCM test case 4: two blocks of AAD, four of ciphertext and the
+  // length block, one full group and one partial. Run twice, the
+  // second time after a clear, to check that clear leaves the
+  // hash subkey powers in place.
+  //----------------------------------------------------------------
+  task gcm_tc4_test(input [7 : 0] tc_number, input do_init);
+    begin : gcm_tc4_test
+      reg [31 : 0] start_cycle;
+
+      tc_ctr = tc_ctr + 1;
+      $display("*** TC %0d: GCM test case 4 started.", tc_number);
+
+      if (do_init)
+        begin
+          start_cycle = cycle_ctr;
+          init_h(128'hb83b533708bf535d0aa6e52980d53b78);
+          $display("*** Computing the powers of H took %0d cycles.",
+                   cycle_ctr - start_cycle);
+        end
+      else
+        begin
+          tb_clear = 1;
+          #(CLK_PERIOD);
+          tb_clear = 0;
+        end
+
+      start_cycle = cycle_ctr;
+      give_block(128'hfeedfacedeadbeeffeedfacedeadbeef);
+      give_block(128'habaddad2000000000000000000000000);
+      give_block(128'h42831ec2217774244b7221b784d0d49c);
+      give_block(128'he3aa212f2c02a4e035c17e2329aca12e);
+      give_block(128'h21d514b25466931c7d8f6a5aac84aa05);
+      give_block(128'h1ba30b396a0aac973d58e09100000000);
+      give_block(128'h00000000000000a000000000000001e0);
+      flush_and_check(tc_number, 128'h698e57f70e6ecc7fd9463b7260a9ae5f);
+      $display("*** Seven blocks took %0d cycles.", cycle_ctr - start_cycle);
+      $display("");
+    end
+  endtask // gcm_tc4_test
+
+
+  //----------------------------------------------------------------
+  // ghash_core_test
+  //
+  // The main test functionality.
+  //----------------------------------------------------------------
+  initial
+    begin : ghash_core_test
+      $display("   -= Testbench for GHASH core started =-");
+      $display("     ==================================");
+      $display("");
+
+      init_sim();
+      reset_dut();
+
+      gcm_tc2_test();
+      gcm_tc4_test(8'h02, 1'b1);
+      gcm_tc4_test(8'h03, 1'b0);
+
+      display_test_results();
+
+      $display("");
+      $display("*** GHASH core simulation done. ***");
+      $finish;
+    end // ghash_core_test
+endmodule // tb_ghash_core
+
+//======================================================================
+// EOF tb_ghash_core.v
+//======================================================================
@@ -0,0 +1,469 @@
+//======================================================================
+//
+// aes_pipe.v
+// ----------
+// Top level wrapper for the pipelined AES encipher core. The host
+// fills an input buffer with up to 64 blocks, starts a run and reads
+// the results from an output buffer. The buffers are block memories
+// with a 128 bit wide port towards the core so that one block per
+// cycle can be fed to the pipeline and collected from it.
+//
+// Address map (address[9:8]):
+//   00: registers
+//   01: input buffer,  address[7:2] is the block, address[1:0] the word
+//   10: output buffer, address[7:2] is the block, address[1:0] the word
+//
+//
+// Copyright (c) 2016, NORDUnet A/S
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// - Neither the name of the NORDUnet nor the names of its contributors may
+//   be used to endorse or promote products derived from this software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+module aes_pipe(
+                // Clock and reset.
+                input wire           clk,
+                input wire           reset_n,
+
+                // Control.
+                input wire           cs,
+                input wire           we,
+
+                // Data ports.
+                input wire  [9 : 0]  address,
+                input wire  [31 : 0] write_data,
+                output wire [31 : 0] read_data
+               );
+
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  localparam AREA_REGS       = 2'h0;
+  localparam AREA_IN_BUF     = 2'h1;
+  localparam AREA_OUT_BUF    = 2'h2;
+
+  localparam ADDR_NAME0      = 8'h00;
+  localparam ADDR_NAME1      = 8'h01;
+  localparam ADDR_VERSION    = 8'h02;
+
+  localparam ADDR_CTRL       = 8'h08;
+  localparam CTRL_INIT_BIT   = 0;
+  localparam CTRL_NEXT_BIT   = 1;
+
+  localparam ADDR_STATUS     = 8'h09;
+  localparam STATUS_READY_BIT = 0;
+  localparam STATUS_VALID_BIT = 1;
+
+  localparam ADDR_CONFIG     = 8'h0a;
+  localparam CTRL_KEYLEN_BIT = 1;
+
+  localparam ADDR_NUM_BLOCKS = 8'h0b;
+  localparam ADDR_CYCLES     = 8'h0c;
+
+  localparam ADDR_KEY0       = 8'h10;
+  localparam ADDR_KEY7       = 8'h17;
+
+  localparam MAX_BLOCKS      = 7'h40;
+
+  localparam CORE_NAME0      = 32'h61657370; // "aesp"
+  localparam CORE_NAME1      = 32'h69706520; // "ipe "
+  localparam CORE_VERSION    = 32'h302e3130; // "0.10"
+
+  localparam ENG_IDLE        = 1'b0;
+  localparam ENG_RUN         = 1'b1;
+
+
+  //----------------------------------------------------------------
+  // Registers including update variables and write enable.
+  //----------------------------------------------------------------
+  reg init_reg;
+  reg init_new;
+
+  reg next_reg;
+  reg next_new;
+
+  reg keylen_reg;
+  reg config_we;
+
+  reg [6 : 0] num_blocks_reg;
+  reg         num_blocks_we;
+
+  reg [31 : 0] key_reg [0 : 7];
+  reg          key_we;
+
+  reg [31 : 0] in_buf0 [0 : 63];
+  reg [31 : 0] in_buf1 [0 : 63];
+  reg [31 : 0] in_buf2 [0 : 63];
+  reg [31 : 0] in_buf3 [0 : 63];
+  reg          in_buf_we;
+
+  reg [31 : 0] out_buf0 [0 : 63];
+  reg [31 : 0] out_buf1 [0 : 63];
+  reg [31 : 0] out_buf2 [0 : 63];
+  reg [31 : 0] out_buf3 [0 : 63];
+
+  reg [127 : 0] in_block_reg;
+  reg           in_block_valid_reg;
+  reg           in_block_valid_new;
+
+  reg [6 : 0]   in_ptr_reg;
+  reg [6 : 0]   in_ptr_new;
+  reg           in_ptr_we;
+
+  reg [6 : 0]   out_ptr_reg;
+  reg [6 : 0]   out_ptr_new;
+  reg           out_ptr_we;
+
+  reg [31 : 0]  cycles_reg;
+  reg [31 : 0]  cycles_new;
+  reg           cycles_we;
+
+  reg           valid_reg;
+  reg           valid_new;
+  reg           valid_we;
+
+  reg           eng_ctrl_reg;
+  reg           eng_ctrl_new;
+  reg           eng_ctrl_we;
+
+  reg [31 : 0]  read_data_reg;
+
+
+  //----------------------------------------------------------------
+  // Wires.
+  //----------------------------------------------------------------
+  reg [31 : 0]   tmp_read_data;
+
+  reg            in_rd;
+
+  wire [1 : 0]   area;
+  wire [7 : 0]   reg_addr;
+  wire [5 : 0]   buf_addr;
+
+  wire [255 : 0] core_key;
+  wire           core_ready;
+  wire           core_out_valid;
+  wire [127 : 0] core_out_block;
+
+  wire           busy;
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity for ports etc.
+  //----------------------------------------------------------------
+  assign read_data = read_data_reg;
+
+  assign area     = address[9 : 8];
+  assign reg_addr = address[7 : 0];
+  assign buf_addr = address[7 : 2];
+
+  assign core_key = {key_reg[0], key_reg[1], key_reg[2], key_reg[3],
+                     key_reg[4], key_reg[5], key_reg[6], key_reg[7]};
+
+  assign busy = eng_ctrl_reg == ENG_RUN;
+
+
+  //----------------------------------------------------------------
+  // core instantiation.
+  //----------------------------------------------------------------
+  aes_pipe_core core(
+                     .clk(clk),
+                     .reset_n(reset_n),
+
+                     .init(init_reg),
+                     .ready(core_ready),
+
+                     .key(core_key),
+                     .keylen(keylen_reg),
+
+                     .in_valid(in_block_valid_reg),
+                     .in_block(in_block_reg),
+
+                     .out_valid(core_out_valid),
+                     .out_block(core_out_block)
+                    );
+
+
+  //----------------------------------------------------------------
+  // reg_update
+  // Update functionality for all registers in the core.
+  // All registers are positive edge triggered with asynchronous
+  // active low reset.
+  //----------------------------------------------------------------
+  always @ (posedge clk or negedge reset_n)
+    begin : reg_update
+      integer i;
+
+      if (!reset_n)
+        begin
+          for (i = 0 ; i < 8 ; i = i + 1)
+            key_reg[i] <= 32'h0;
+
+          init_reg           <= 1'b0;
+          next_reg           <= 1'b0;
+          keylen_reg         <= 1'b0;
+          num_blocks_reg     <= 7'h1;
+          in_block_valid_reg <= 1'b0;
+          in_ptr_reg         <= 7'h0;
+          out_ptr_reg        <= 7'h0;
+          cycles_reg         <= 32'h0;
+          valid_reg          <= 1'b0;
+          eng_ctrl_reg       <= ENG_IDLE;
+        end
+      else
+        begin
+          init_reg           <= init_new;
+          next_reg           <= next_new;
+          in_block_valid_reg <= in_block_valid_new;
+
+          if (config_we)
+            keylen_reg <= write_data[CTRL_KEYLEN_BIT];
+
+          if (num_blocks_we)
+            num_blocks_reg <= write_data[6 : 0];
+
+          if (key_we)
+            key_reg[reg_addr[2 : 0]] <= write_data;
+
+          if (in_ptr_we)
+            in_ptr_reg <= in_ptr_new;
+
+          if (out_ptr_we)
+            out_ptr_reg <= out_ptr_new;
+
+          if (cycles_we)
+            cycles_reg <= cycles_new;
+
+          if (valid_we)
+            valid_reg <= valid_new;
+
+          if (eng_ctrl_we)
+            eng_ctrl_reg <= eng_ctrl_new;
+        end
+    end // reg_update
+
+
+  //----------------------------------------------------------------
+  // buf_update
+  //
+  // The input and output buffers. Each buffer is four block
+  // memories, one per word of a block, with one port towards the
+  // bus and one 128 bit wide port towards the pipeline.
+  //----------------------------------------------------------------
+  always @ (posedge clk)
+    begin : buf_update
+      if (in_buf_we)
+        case (address[1 : 0])
+          2'h0: in_buf0[buf_addr] <= write_data;
+          2'h1: in_buf1[buf_addr] <= write_data;
+          2'h2: in_buf2[buf_addr] <= write_data;
+          2'h3: in_buf3[buf_addr] <= write_data;
+        endcase // case (address[1 : 0])
+
+      if (in_rd)
+        in_block_reg <= {in_buf0[in_ptr_reg[5 : 0]], in_buf1[in_ptr_reg[5 : 0]],
+                         in_buf2[in_ptr_reg[5 : 0]], in_buf3[in_ptr_reg[5 : 0]]};
+
+      if (busy && core_out_valid)
+        begin
+          out_buf0[out_ptr_reg[5 : 0]] <= core_out_block[127 : 096];
+          out_buf1[out_ptr_reg[5 : 0]] <= core_out_block[095 : 064];
+          out_buf2[out_ptr_reg[5 : 0]] <= core_out_block[063 : 032];
+          out_buf3[out_ptr_reg[5 : 0]] <= core_out_block[031 : 000];
+        end
+
+      if (cs && !we)
+        read_data_reg <= tmp_read_data;
+    end // buf_update
+
+
+  //----------------------------------------------------------------
+  // api
+  //
+  // The interface command decoding logic. Reads are registered,
+  // the data is available the cycle after cs.
+  //----------------------------------------------------------------
+  always @*
+    begin : api
+      init_new      = 1'b0;
+      next_new      = 1'b0;
+      config_we     = 1'b0;
+      num_blocks_we = 1'b0;
+      key_we        = 1'b0;
+      in_buf_we     = 1'b0;
+      tmp_read_data = 32'h0;
+
+      if (cs)
+        begin
+          if (we)
+            begin
+              if ((area == AREA_REGS) && !busy)
+                begin
+                  if (reg_addr == ADDR_CTRL)
+                    begin
+                      init_new = write_data[CTRL_INIT_BIT];
+                      next_new = write_data[CTRL_NEXT_BIT];
+                    end
+
+                  if (reg_addr == ADDR_CONFIG)
+                    config_we = 1'b1;
+
+                  if ((reg_addr == ADDR_NUM_BLOCKS) &&
+                      (write_data[6 : 0] != 7'h0) &&
+                      (write_data[6 : 0] <= MAX_BLOCKS))
+                    num_blocks_we = 1'b1;
+
+                  if ((reg_addr >= ADDR_KEY0) && (reg_addr <= ADDR_KEY7))
+                    key_we = 1'b1;
+                end
+
+              if ((area == AREA_IN_BUF) && !busy)
+                in_buf_we = 1'b1;
+            end // if (we)
+
+          else
+            begin
+              case (area)
+                AREA_REGS:
+                  case (reg_addr)
+                    ADDR_NAME0:      tmp_read_data = CORE_NAME0;
+                    ADDR_NAME1:      tmp_read_data = CORE_NAME1;
+                    ADDR_VERSION:    tmp_read_data = CORE_VERSION;
+                    ADDR_CTRL:       tmp_read_data = {30'h0, next_reg, init_reg};
+                    ADDR_STATUS:     tmp_read_data = {30'h0, valid_reg, core_ready && !busy};
+                    ADDR_CONFIG:     tmp_read_data = {30'h0, keylen_reg, 1'b0};
+                    ADDR_NUM_BLOCKS: tmp_read_data = {25'h0, num_blocks_reg};
+                    ADDR_CYCLES:     tmp_read_data = cycles_reg;
+                    default:
+                      begin
+                      end
+                  endcase // case (reg_addr)
+
+                AREA_OUT_BUF:
+                  case (address[1 : 0])
+                    2'h0: tmp_read_data = out_buf0[buf_addr];
+                    2'h1: tmp_read_data = out_buf1[buf_addr];
+                    2'h2: tmp_read_data = out_buf2[buf_addr];
+                    2'h3: tmp_read_data = out_buf3[buf_addr];
+                  endcase // case (address[1 : 0])
+
+                default:
+                  begin
+                  end
+              endcase // case (area)
+            end
+        end
+    end // api
+
+
+  //----------------------------------------------------------------
+  // eng_ctrl
+  //
+  // Streams num_blocks blocks from the input buffer through the
+  // pipeline, one per cycle, and collects the results in the
+  // output buffer. The input buffer read takes one cycle, so a
+  // block reaches the pipeline the cycle after it has been read.
+  //----------------------------------------------------------------
+  always @*
+    begin : eng_ctrl
+      in_rd              = 1'b0;
+      in_block_valid_new = 1'b0;
+      in_ptr_new         = 7'h0;
+      in_ptr_we          = 1'b0;
+      out_ptr_new        = 7'h0;
+      out_ptr_we         = 1'b0;
+      cycles_new         = 32'h0;
+      cycles_we          = 1'b0;
+      valid_new          = 1'b0;
+      valid_we           = 1'b0;
+      eng_ctrl_new       = ENG_IDLE;
+      eng_ctrl_we        = 1'b0;
+
+      case (eng_ctrl_reg)
+        ENG_IDLE:
+          begin
+            if (init_reg)
+              begin
+                valid_new = 1'b0;
+                valid_we  = 1'b1;
+              end
+
+            if (next_reg && core_ready)
+              begin
+                in_ptr_new   = 7'h0;
+                in_ptr_we    = 1'b1;
+                out_ptr_new  = 7'h0;
+                out_ptr_we   = 1'b1;
+                cycles_new   = 32'h0;
+                cycles_we    = 1'b1;
+                valid_new    = 1'b0;
+                valid_we     = 1'b1;
+                eng_ctrl_new = ENG_RUN;
+                eng_ctrl_we  = 1'b1;
+              end
+          end
+
+        ENG_RUN:
+          begin
+            cycles_new = cycles_reg + 1'b1;
+            cycles_we  = 1'b1;
+
+            if (in_ptr_reg < num_blocks_reg)
+              begin
+                in_rd              = 1'b1;
+                in_block_valid_new = 1'b1;
+                in_ptr_new         = in_ptr_reg + 1'b1;
+                in_ptr_we          = 1'b1;
+              end
+
+            if (core_out_valid)
+              begin
+                out_ptr_new = out_ptr_reg + 1'b1;
+                out_ptr_we  = 1'b1;
+
+                if (out_ptr_new == num_blocks_reg)
+                  begin
+                    valid_new    = 1'b1;
+                    valid_we     = 1'b1;
+                    eng_ctrl_new = ENG_IDLE;
+                    eng_ctrl_we  = 1'b1;
+                  end
+              end
+          end
+
+        default:
+          begin
+          end
+      endcase // case (eng_ctrl_reg)
+    end // eng_ctrl
+endmodule // aes_pipe
+
+//======================================================================
+// EOF aes_pipe.v
+//======================================================================
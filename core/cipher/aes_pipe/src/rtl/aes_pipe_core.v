@@ -0,0 +1,314 @@
+//======================================================================
+//
+// aes_pipe_core.v
+// ---------------
+// Fully pipelined AES encipher core. The round keys are expanded once
+// by the key memory of the iterative AES core and then held in
+// registers, one per round, so that every round has its own stage and
+// a new block can enter the pipeline every cycle.
+//
+// The pipeline has an initial AddRoundKey stage, 13 full rounds and a
+// final round. For 128 bit keys the final round takes its input from
+// after the ninth full round, for 256 bit keys from after the
+// thirteenth. The latency from in_valid to out_valid is thus 11 cycles
+// for AES-128 and 15 cycles for AES-256.
+//
+// Only enciphering is supported. This is what the CTR and GCM modes
+// need, ECB decryption has to use the iterative core.
+//
+//
+// Copyright (c) 2016, NORDUnet A/S
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// - Neither the name of the NORDUnet nor the names of its contributors may
+//   be used to endorse or promote products derived from this software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+module aes_pipe_core(
+                     input wire            clk,
+                     input wire            reset_n,
+
+                     input wire            init,
+                     output wire           ready,
+
+                     input wire [255 : 0]  key,
+                     input wire            keylen,
+
+                     input wire            in_valid,
+                     input wire [127 : 0]  in_block,
+
+                     output wire           out_valid,
+                     output wire [127 : 0] out_block
+                    );
+
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  localparam AES_128_NUM_ROUNDS = 4'ha;
+  localparam AES_256_NUM_ROUNDS = 4'he;
+
+  localparam NUM_STAGES = 14;
+
+  localparam CTRL_IDLE  = 2'h0;
+  localparam CTRL_INIT  = 2'h1;
+  localparam CTRL_COPY  = 2'h2;
+
+
+  //----------------------------------------------------------------
+  // Registers including update variables and write enable.
+  //----------------------------------------------------------------
+  reg [127 : 0] rkey_reg [0 : NUM_STAGES];
+  reg           rkey_we;
+
+  reg [3 : 0]   round_ctr_reg;
+  reg [3 : 0]   round_ctr_new;
+  reg           round_ctr_we;
+
+  reg [127 : 0] stage_reg [0 : (NUM_STAGES - 1)];
+  reg           stage_valid_reg [0 : (NUM_STAGES - 1)];
+
+  reg [127 : 0] out_block_reg;
+  reg           out_valid_reg;
+
+  reg           ready_reg;
+  reg           ready_new;
+  reg           ready_we;
+
+  reg [1 : 0]   pipe_ctrl_reg;
+  reg [1 : 0]   pipe_ctrl_new;
+  reg           pipe_ctrl_we;
+
+
+  //----------------------------------------------------------------
+  // Wires.
+  //----------------------------------------------------------------
+  reg            key_init;
+
+  wire [127 : 0] round_key;
+  wire           key_ready;
+  wire [31 : 0]  keymem_sboxw;
+  wire [31 : 0]  keymem_new_sboxw;
+
+  wire [127 : 0] round_block [1 : (NUM_STAGES - 1)];
+  wire [127 : 0] final_block;
+
+  wire [127 : 0] final_in;
+  wire [127 : 0] final_key;
+  wire           final_valid;
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity for ports etc.
+  //----------------------------------------------------------------
+  assign ready     = ready_reg;
+  assign out_valid = out_valid_reg;
+  assign out_block = out_block_reg;
+
+  // Tap for the final round.
+  assign final_in    = keylen ? stage_reg[13] : stage_reg[9];
+  assign final_key   = keylen ? rkey_reg[14] : rkey_reg[10];
+  assign final_valid = keylen ? stage_valid_reg[13] : stage_valid_reg[9];
+
+
+  //----------------------------------------------------------------
+  // Instantiations.
+  //----------------------------------------------------------------
+  aes_key_mem #(.SLOT_BITS(1))
+              keymem(
+                     .clk(clk),
+                     .reset_n(reset_n),
+
+                     .key(key),
+                     .keylen(keylen),
+                     .init(key_init),
+                     .erase(1'b0),
+                     .slot(1'b0),
+
+                     .round(round_ctr_reg),
+                     .round_key(round_key),
+                     .ready(key_ready),
+
+                     .sboxw(keymem_sboxw),
+                     .new_sboxw(keymem_new_sboxw)
+                    );
+
+  aes_sbox keymem_sbox(.sboxw(keymem_sboxw), .new_sboxw(keymem_new_sboxw));
+
+  genvar i;
+  generate
+    for (i = 1 ; i < NUM_STAGES ; i = i + 1)
+      begin : rounds
+        aes_pipe_round #(.FINAL(0)) round(
+                                          .block(stage_reg[i - 1]),
+                                          .round_key(rkey_reg[i]),
+                                          .new_block(round_block[i])
+                                         );
+      end
+  endgenerate
+
+  aes_pipe_round #(.FINAL(1)) final_round(
+                                          .block(final_in),
+                                          .round_key(final_key),
+                                          .new_block(final_block)
+                                         );
+
+
+  //----------------------------------------------------------------
+  // reg_update
+  //
+  // Update functionality for all registers in the core.
+  // All registers are positive edge triggered with asynchronous
+  // active low reset. The pipeline data registers have no reset
+  // since only the valid bits matter.
+  //----------------------------------------------------------------
+  always @ (posedge clk or negedge reset_n)
+    begin: reg_update
+      integer j;
+
+      if (!reset_n)
+        begin
+          for (j = 0 ; j < NUM_STAGES ; j = j + 1)
+            stage_valid_reg[j] <= 1'b0;
+
+          out_valid_reg <= 1'b0;
+          round_ctr_reg <= 4'h0;
+          ready_reg     <= 1'b0;
+          pipe_ctrl_reg <= CTRL_IDLE;
+        end
+      else
+        begin
+          stage_valid_reg[0] <= in_valid;
+          for (j = 1 ; j < NUM_STAGES ; j = j + 1)
+            stage_valid_reg[j] <= stage_valid_reg[j - 1];
+
+          out_valid_reg <= final_valid;
+
+          if (round_ctr_we)
+            round_ctr_reg <= round_ctr_new;
+
+          if (ready_we)
+            ready_reg <= ready_new;
+
+          if (pipe_ctrl_we)
+            pipe_ctrl_reg <= pipe_ctrl_new;
+        end
+    end // reg_update
+
+
+  //----------------------------------------------------------------
+  // pipe_update
+  //
+  // The pipeline itself and the round key registers.
+  //----------------------------------------------------------------
+  always @ (posedge clk)
+    begin: pipe_update
+      integer j;
+
+      stage_reg[0] <= in_block ^ rkey_reg[0];
+      for (j = 1 ; j < NUM_STAGES ; j = j + 1)
+        stage_reg[j] <= round_block[j];
+
+      out_block_reg <= final_block;
+
+      if (rkey_we)
+        rkey_reg[round_ctr_reg] <= round_key;
+    end // pipe_update
+
+
+  //----------------------------------------------------------------
+  // pipe_ctrl
+  //
+  // Key setup. Runs the key expansion and then copies the round
+  // keys out of the key memory, one per cycle. Blocks must not be
+  // fed to the pipeline until ready is set.
+  //----------------------------------------------------------------
+  always @*
+    begin : pipe_ctrl
+      key_init      = 1'b0;
+      rkey_we       = 1'b0;
+      round_ctr_new = 4'h0;
+      round_ctr_we  = 1'b0;
+      ready_new     = 1'b0;
+      ready_we      = 1'b0;
+      pipe_ctrl_new = CTRL_IDLE;
+      pipe_ctrl_we  = 1'b0;
+
+      case (pipe_ctrl_reg)
+        CTRL_IDLE:
+          begin
+            if (init)
+              begin
+                key_init      = 1'b1;
+                ready_new     = 1'b0;
+                ready_we      = 1'b1;
+                pipe_ctrl_new = CTRL_INIT;
+                pipe_ctrl_we  = 1'b1;
+              end
+          end
+
+        CTRL_INIT:
+          begin
+            if (key_ready)
+              begin
+                round_ctr_new = 4'h0;
+                round_ctr_we  = 1'b1;
+                pipe_ctrl_new = CTRL_COPY;
+                pipe_ctrl_we  = 1'b1;
+              end
+          end
+
+        CTRL_COPY:
+          begin
+            rkey_we = 1'b1;
+
+            if (round_ctr_reg == (keylen ? AES_256_NUM_ROUNDS : AES_128_NUM_ROUNDS))
+              begin
+                ready_new     = 1'b1;
+                ready_we      = 1'b1;
+                pipe_ctrl_new = CTRL_IDLE;
+                pipe_ctrl_we  = 1'b1;
+              end
+            else
+              begin
+                round_ctr_new = round_ctr_reg + 1'b1;
+                round_ctr_we  = 1'b1;
+              end
+          end
+
+        default:
+          begin
+            pipe_ctrl_new = CTRL_IDLE;
+            pipe_ctrl_we  = 1'b1;
+          end
+      endcase // case (pipe_ctrl_reg)
+    end // pipe_ctrl
+endmodule // aes_pipe_core
+
+//======================================================================
+// EOF aes_pipe_core.v
+//======================================================================
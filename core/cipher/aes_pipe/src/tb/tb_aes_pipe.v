@@ -0,0 +1,547 @@
+//======================================================================
+//
+// tb_aes_pipe.v
+// -------------
+// Testbench for the pipelined AES core top level wrapper. Checks the
+// NIST ECB vectors through the block buffers and measures the
+// sustained throughput and latency of the pipeline.
+//
+//
+// Copyright (c) 2016, NORDUnet A/S
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// - Neither the name of the NORDUnet nor the names of its contributors may
+//   be used to endorse or promote products derived from this software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+//------------------------------------------------------------------
+// Test module.
+//------------------------------------------------------------------
+module tb_aes_pipe();
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  parameter DEBUG     = 0;
+
+  parameter CLK_HALF_PERIOD = 1;
+  parameter CLK_PERIOD      = 2 * CLK_HALF_PERIOD;
+
+  // The DUT address map.
+  parameter ADDR_NAME0       = 10'h000;
+  parameter ADDR_NAME1       = 10'h001;
+  parameter ADDR_VERSION     = 10'h002;
+
+  parameter ADDR_CTRL        = 10'h008;
+  parameter CTRL_INIT_BIT    = 0;
+  parameter CTRL_NEXT_BIT    = 1;
+
+  parameter ADDR_STATUS      = 10'h009;
+  parameter STATUS_READY_BIT = 0;
+  parameter STATUS_VALID_BIT = 1;
+
+  parameter ADDR_CONFIG      = 10'h00a;
+  parameter CTRL_KEYLEN_BIT  = 1;
+
+  parameter ADDR_NUM_BLOCKS  = 10'h00b;
+  parameter ADDR_CYCLES      = 10'h00c;
+
+  parameter ADDR_KEY0        = 10'h010;
+
+  parameter ADDR_IN_BUF      = 10'h100;
+  parameter ADDR_OUT_BUF     = 10'h200;
+
+  parameter MAX_BLOCKS       = 64;
+
+  parameter AES_128_BIT_KEY = 0;
+  parameter AES_256_BIT_KEY = 1;
+
+
+  //----------------------------------------------------------------
+  // Register and Wire declarations.
+  //----------------------------------------------------------------
+  reg [31 : 0]  cycle_ctr;
+  reg [31 : 0]  error_ctr;
+  reg [31 : 0]  tc_ctr;
+
+  reg [31 : 0]  read_data;
+  reg [127 : 0] result_data;
+
+  reg [31 : 0]  first_in_cycle;
+  reg [31 : 0]  first_out_cycle;
+  reg [31 : 0]  last_out_cycle;
+  reg           first_in_seen;
+  reg           first_out_seen;
+
+  reg           tb_clk;
+  reg           tb_reset_n;
+  reg           tb_cs;
+  reg           tb_we;
+  reg [9 : 0]   tb_address;
+  reg [31 : 0]  tb_write_data;
+  wire [31 : 0] tb_read_data;
+
+
+  //----------------------------------------------------------------
+  // Device Under Test.
+  //----------------------------------------------------------------
+  aes_pipe dut(
+               .clk(tb_clk),
+               .reset_n(tb_reset_n),
+               .cs(tb_cs),
+               .we(tb_we),
+               .address(tb_address),
+               .write_data(tb_write_data),
+               .read_data(tb_read_data)
+              );
+
+
+  //----------------------------------------------------------------
+  // clk_gen
+  //
+  // Always running clock generator process.
+  //----------------------------------------------------------------
+  always
+    begin : clk_gen
+      #CLK_HALF_PERIOD;
+      tb_clk = !tb_clk;
+    end // clk_gen
+
+
+  //----------------------------------------------------------------
+  // sys_monitor()
+  //
+  // An always running process that creates a cycle counter and
+  // conditionally displays information about the DUT.
+  //----------------------------------------------------------------
+  always
+    begin : sys_monitor
+      cycle_ctr = cycle_ctr + 1;
+
+      #(CLK_PERIOD);
+
+      if (DEBUG)
+        begin
+          dump_dut_state();
+        end
+    end
+
+
+  //----------------------------------------------------------------
+  // pipe_monitor
+  //
+  // Records the cycles when the first block enters the pipeline
+  // and when the first and last blocks leave it.
+  //----------------------------------------------------------------
+  always @ (posedge tb_clk)
+    begin : pipe_monitor
+      if (dut.in_block_valid_reg && !first_in_seen)
+        begin
+          first_in_cycle = cycle_ctr;
+          first_in_seen  = 1;
+        end
+
+      if (dut.busy && dut.core_out_valid)
+        begin
+          if (!first_out_seen)
+            begin
+              first_out_cycle = cycle_ctr;
+              first_out_seen  = 1;
+            end
+          last_out_cycle = cycle_ctr;
+        end
+    end // pipe_monitor
+
+
+  //----------------------------------------------------------------
+  // dump_dut_state()
+  //
+  // Dump the state of the dump when needed.
+  //----------------------------------------------------------------
+  task dump_dut_state;
+    begin
+      $display("cycle: 0x%016x", cycle_ctr);
+      $display("State of DUT");
+      $display("------------");
+      $display("ctrl_reg: init = 0x%01x, next = 0x%01x, keylen = 0x%01x",
+               dut.init_reg, dut.next_reg, dut.keylen_reg);
+      $display("engine:   state = 0x%01x, in_ptr = 0x%02x, out_ptr = 0x%02x",
+               dut.eng_ctrl_reg, dut.in_ptr_reg, dut.out_ptr_reg);
+      $display("core:     ready = 0x%01x, in_valid = 0x%01x, out_valid = 0x%01x",
+               dut.core_ready, dut.in_block_valid_reg, dut.core_out_valid);
+      $display("");
+    end
+  endtask // dump_dut_state
+
+
+  //----------------------------------------------------------------
+  // reset_dut()
+  //
+  // Toggle reset to put the DUT into a well known state.
+  //----------------------------------------------------------------
+  task reset_dut;
+    begin
+      $display("*** Toggle reset.");
+      tb_reset_n = 0;
+
+      #(2 * CLK_PERIOD);
+      tb_reset_n = 1;
+      $display("");
+    end
+  endtask // reset_dut
+
+
+  //----------------------------------------------------------------
+  // display_test_results()
+  //
+  // Display the accumulated test results.
+  //----------------------------------------------------------------
+  task display_test_results;
+    begin
+      if (error_ctr == 0)
+        begin
+          $display("*** All %02d test cases completed successfully", tc_ctr);
+        end
+      else
+        begin
+          $display("*** %02d tests completed - %02d test cases did not complete successfully.",
+                   tc_ctr, error_ctr);
+        end
+    end
+  endtask // display_test_results
+
+
+  //----------------------------------------------------------------
+  // init_sim()
+  //
+  // Initialize all counters and testbed functionality as well
+  // as setting the DUT inputs to defined values.
+  //----------------------------------------------------------------
+  task init_sim;
+    begin
+      cycle_ctr     = 0;
+      error_ctr     = 0;
+      tc_ctr        = 0;
+
+      tb_clk        = 0;
+      tb_reset_n    = 1;
+
+      tb_cs         = 0;
+      tb_we         = 0;
+      tb_address    = 10'h0;
+      tb_write_data = 32'h0;
+    end
+  endtask // init_sim
+
+
+  //----------------------------------------------------------------
+  // write_word()
+  //
+  // Write the given word to the DUT using the DUT interface.
+  //----------------------------------------------------------------
+  task write_word(input [9 : 0]  address,
+                  input [31 : 0] word);
+    begin
+      if (DEBUG)
+        begin
+          $display("*** Writing 0x%08x to 0x%03x.", word, address);
+          $display("");
+        end
+
+      tb_address = address;
+      tb_write_data = word;
+      tb_cs = 1;
+      tb_we = 1;
+      #(2 * CLK_PERIOD);
+      tb_cs = 0;
+      tb_we = 0;
+    end
+  endtask // write_word
+
+
+  //----------------------------------------------------------------
+  // read_word()
+  //
+  // Read a data word from the given address in the DUT.
+  // The read is registered in the DUT, the word is available
+  // after one cycle in the global variable read_data.
+  //----------------------------------------------------------------
+  task read_word(input [9 : 0]  address);
+    begin
+      tb_address = address;
+      tb_cs = 1;
+      tb_we = 0;
+      #(CLK_PERIOD);
+      read_data = tb_read_data;
+      tb_cs = 0;
+
+      if (DEBUG)
+        begin
+          $display("*** Reading 0x%08x from 0x%03x.", read_data, address);
+          $display("");
+        end
+    end
+  endtask // read_word
+
+
+  //----------------------------------------------------------------
+  // write_in_block()
+  //
+  // Write the given block to the given slot in the input buffer.
+  //----------------------------------------------------------------
+  task write_in_block(input [5 : 0] slot, input [127 : 0] block);
+    begin
+      write_word(ADDR_IN_BUF + {slot, 2'h0},        block[127 : 096]);
+      write_word(ADDR_IN_BUF + {slot, 2'h0} + 2'h1, block[095 : 064]);
+      write_word(ADDR_IN_BUF + {slot, 2'h0} + 2'h2, block[063 : 032]);
+      write_word(ADDR_IN_BUF + {slot, 2'h0} + 2'h3, block[031 : 000]);
+    end
+  endtask // write_in_block
+
+
+  //----------------------------------------------------------------
+  // read_out_block()
+  //
+  // Read the block in the given slot of the output buffer into
+  // result_data.
+  //----------------------------------------------------------------
+  task read_out_block(input [5 : 0] slot);
+    begin
+      read_word(ADDR_OUT_BUF + {slot, 2'h0});
+      result_data[127 : 096] = read_data;
+      read_word(ADDR_OUT_BUF + {slot, 2'h0} + 2'h1);
+      result_data[095 : 064] = read_data;
+      read_word(ADDR_OUT_BUF + {slot, 2'h0} + 2'h2);
+      result_data[063 : 032] = read_data;
+      read_word(ADDR_OUT_BUF + {slot, 2'h0} + 2'h3);
+      result_data[031 : 000] = read_data;
+    end
+  endtask // read_out_block
+
+
+  //----------------------------------------------------------------
+  // wait_status()
+  //
+  // Wait for the given status bit to be set.
+  //----------------------------------------------------------------
+  task wait_status(input integer bit_no);
+    begin : wait_status
+      reg done;
+      done = 1'b0;
+
+      while (done != 1'b1)
+        begin
+          read_word(ADDR_STATUS);
+          done = read_data[bit_no];
+        end
+    end
+  endtask // wait_status
+
+
+  //----------------------------------------------------------------
+  // init_key()
+  //
+  // Init the key in the dut by writing the given key and
+  // key length and then trigger init processing.
+  //----------------------------------------------------------------
+  task init_key(input [255 : 0] key, input key_length);
+    begin
+      write_word(ADDR_KEY0 + 0, key[255 : 224]);
+      write_word(ADDR_KEY0 + 1, key[223 : 192]);
+      write_word(ADDR_KEY0 + 2, key[191 : 160]);
+      write_word(ADDR_KEY0 + 3, key[159 : 128]);
+      write_word(ADDR_KEY0 + 4, key[127 :  96]);
+      write_word(ADDR_KEY0 + 5, key[95  :  64]);
+      write_word(ADDR_KEY0 + 6, key[63  :  32]);
+      write_word(ADDR_KEY0 + 7, key[31  :   0]);
+
+      write_word(ADDR_CONFIG, {30'h0, key_length, 1'b0});
+      write_word(ADDR_CTRL, 32'h00000001);
+      wait_status(STATUS_READY_BIT);
+    end
+  endtask // init_key
+
+
+  //----------------------------------------------------------------
+  // run_blocks()
+  //
+  // Process the given number of blocks from the input buffer
+  // and wait for the result.
+  //----------------------------------------------------------------
+  task run_blocks(input [6 : 0] num_blocks);
+    begin
+      first_in_seen  = 0;
+      first_out_seen = 0;
+
+      write_word(ADDR_NUM_BLOCKS, {25'h0, num_blocks});
+      write_word(ADDR_CTRL, 32'h00000002);
+      wait_status(STATUS_VALID_BIT);
+    end
+  endtask // run_blocks
+
+
+  //----------------------------------------------------------------
+  // ecb_run_test()
+  //
+  // Fill the input buffer with num_blocks blocks, cycling through
+  // the four given plaintext blocks, run them through the pipeline
+  // and check every result. Report sustained throughput and
+  // latency for the run.
+  //----------------------------------------------------------------
+  task ecb_run_test(input [7 : 0]   tc_number,
+                    input [255 : 0] key,
+                    input           key_length,
+                    input [6 : 0]   num_blocks,
+                    input [511 : 0] plaintext,
+                    input [511 : 0] expected);
+    begin : ecb_run_test
+      integer i;
+      integer tc_errors;
+      reg [127 : 0] expected_block;
+
+      tc_errors = 0;
+      $display("*** TC %0d ECB mode run of %0d blocks started.", tc_number, num_blocks);
+      tc_ctr = tc_ctr + 1;
+
+      init_key(key, key_length);
+
+      for (i = 0 ; i < num_blocks ; i = i + 1)
+        write_in_block(i, plaintext[(511 - 128 * (i % 4)) -: 128]);
+
+      run_blocks(num_blocks);
+
+      for (i = 0 ; i < num_blocks ; i = i + 1)
+        begin
+          read_out_block(i);
+          expected_block = expected[(511 - 128 * (i % 4)) -: 128];
+          if (result_data != expected_block)
+            begin
+              $display("Error in block %0d:", i);
+              $display("Expected: 0x%032x", expected_block);
+              $display("Got:      0x%032x", result_data);
+              tc_errors = tc_errors + 1;
+            end
+        end
+
+      read_word(ADDR_CYCLES);
+
+      $display("*** Run took %0d cycles, latency %0d cycles.",
+               read_data, first_out_cycle - first_in_cycle);
+      $display("*** Sustained rate %0d blocks in %0d cycles (%0d.%02d blocks/cycle).",
+               num_blocks, last_out_cycle - first_out_cycle + 1,
+               num_blocks / (last_out_cycle - first_out_cycle + 1),
+               ((100 * num_blocks) / (last_out_cycle - first_out_cycle + 1)) % 100);
+
+      if (tc_errors == 0)
+        $display("*** TC %0d successful.", tc_number);
+      else
+        begin
+          $display("*** ERROR: TC %0d NOT successful.", tc_number);
+          error_ctr = error_ctr + 1;
+        end
+      $display("");
+    end
+  endtask // ecb_run_test
+
+
+  //----------------------------------------------------------------
+  // nist_ecb_tests()
+  //
+  // NIST SP 800-38A F.1.1 and F.1.5 ECB encrypt vectors, first
+  // as a short four block run and then filling the whole buffer.
+  //----------------------------------------------------------------
+  task nist_ecb_tests;
+    reg [255 : 0] nist_aes128_key;
+    reg [255 : 0] nist_aes256_key;
+
+    reg [511 : 0] nist_plaintext;
+    reg [511 : 0] nist_ecb_128_enc_expected;
+    reg [511 : 0] nist_ecb_256_enc_expected;
+
+    begin
+      nist_aes128_key = 256'h2b7e151628aed2a6abf7158809cf4f3c00000000000000000000000000000000;
+      nist_aes256_key = 256'h603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4;
+
+      nist_plaintext = {128'h6bc1bee22e409f96e93d7e117393172a,
+                        128'hae2d8a571e03ac9c9eb76fac45af8e51,
+                        128'h30c81c46a35ce411e5fbc1191a0a52ef,
+                        128'hf69f2445df4f9b17ad2b417be66c3710};
+
+      nist_ecb_128_enc_expected = {128'h3ad77bb40d7a3660a89ecaf32466ef97,
+                                   128'hf5d3d58503b9699de785895a96fdbaaf,
+                                   128'h43b1cd7f598ece23881b00e3ed030688,
+                                   128'h7b0c785e27e8ad3f8223207104725dd4};
+
+      nist_ecb_256_enc_expected = {128'hf3eed1bdb5d2a03c064b5a7e3db181f8,
+                                   128'h591ccb10d410ed26dc5ba74a31362870,
+                                   128'hb6ed21b99ca6f4f9f153e7b1beafed1d,
+                                   128'h23304b7a39f9f3ff067d8d8f9e24ecc7};
+
+      $display("NIST SP 800-38A ECB 128 bit key tests");
+      $display("-------------------------------------");
+      ecb_run_test(8'h01, nist_aes128_key, AES_128_BIT_KEY, 7'd4,
+                   nist_plaintext, nist_ecb_128_enc_expected);
+      ecb_run_test(8'h02, nist_aes128_key, AES_128_BIT_KEY, MAX_BLOCKS,
+                   nist_plaintext, nist_ecb_128_enc_expected);
+
+      $display("NIST SP 800-38A ECB 256 bit key tests");
+      $display("-------------------------------------");
+      ecb_run_test(8'h03, nist_aes256_key, AES_256_BIT_KEY, 7'd4,
+                   nist_plaintext, nist_ecb_256_enc_expected);
+      ecb_run_test(8'h04, nist_aes256_key, AES_256_BIT_KEY, MAX_BLOCKS,
+                   nist_plaintext, nist_ecb_256_enc_expected);
+    end
+  endtask // nist_ecb_tests
+
+
+  //----------------------------------------------------------------
+  // main
+  //
+  // The main test functionality.
+  //----------------------------------------------------------------
+  initial
+    begin : main
+      $display("   -= Testbench for pipelined AES started =-");
+      $display("    ========================================");
+      $display("");
+
+      init_sim();
+      reset_dut();
+
+      nist_ecb_tests();
+
+      display_test_results();
+
+      $display("");
+      $display("*** Pipelined AES simulation done. ***");
+      $finish;
+    end // main
+endmodule // tb_aes_pipe
+
+//======================================================================
+// EOF tb_aes_pipe.v
+//======================================================================
@@ -5,6 +5,9 @@
 // Top level wrapper for the ChaCha stream, cipher core providing
 // a simple memory like interface with 32 bit data access.
 //
+// The block counter that init starts from is in the counter
+// registers, so that a host can start the keystream at any block.
+//
 //
 // Author: Joachim Strombergson
 // Copyright (c) 2011, NORDUnet A/S All rights reserved.
@@ -74,6 +77,10 @@ module chacha(
   localparam ADDR_IV0         = 8'h20;
   localparam ADDR_IV1         = 8'h21;
 
+  // Block counter loaded by init, low word first.
+  localparam ADDR_CTR0        = 8'h30;
+  localparam ADDR_CTR1        = 8'h31;
+
   localparam ADDR_DATA_IN0    = 8'h40;
   localparam ADDR_DATA_IN15   = 8'h4f;
 
@@ -82,9 +89,7 @@ module chacha(
 
   localparam CORE_NAME0       = 32'h63686163; // "chac"
   localparam CORE_NAME1       = 32'h68612020; // "ha  "
-  localparam CORE_VERSION     = 32'h302e3831; // "0.81"
-
-  localparam DEFAULT_CTR_INIT = 64'h0;
+  localparam CORE_VERSION     = 32'h302e3832; // "0.82"
 
 
   //----------------------------------------------------------------
@@ -106,6 +111,9 @@ module chacha(
   reg [31 : 0] iv_reg[0 : 1];
   reg          iv_we;
 
+  reg [31 : 0] ctr_reg[0 : 1];
+  reg          ctr_we;
+
   reg [31 : 0] data_in_reg [0 : 15];
   reg          data_in_we;
 
@@ -115,6 +123,7 @@ module chacha(
   //----------------------------------------------------------------
   wire [255 : 0] core_key;
   wire [63 : 0]  core_iv;
+  wire [63 : 0]  core_ctr;
   wire           core_ready;
   wire [511 : 0] core_data_in;
   wire [511 : 0] core_data_out;
@@ -131,6 +140,8 @@ module chacha(
 
   assign core_iv      = {iv_reg[0], iv_reg[1]};
 
+  assign core_ctr     = {ctr_reg[1], ctr_reg[0]};
+
   assign core_data_in = {data_in_reg[00], data_in_reg[01], data_in_reg[02], data_in_reg[03],
                          data_in_reg[04], data_in_reg[05], data_in_reg[06], data_in_reg[07],
                          data_in_reg[08], data_in_reg[09], data_in_reg[10], data_in_reg[11],
@@ -152,7 +163,7 @@ module chacha(
                     .key(core_key),
                     .keylen(keylen_reg),
                     .iv(core_iv),
-                    .ctr(DEFAULT_CTR_INIT),
+                    .ctr(core_ctr),
                     .rounds(rounds_reg),
                     .data_in(core_data_in),
                     .ready(core_ready),
@@ -179,6 +190,8 @@ module chacha(
           rounds_reg <= 5'h0;
           iv_reg[0]  <= 32'h0;
           iv_reg[1]  <= 32'h0;
+          ctr_reg[0] <= 32'h0;
+          ctr_reg[1] <= 32'h0;
 
           for (i = 0 ; i < 8 ; i = i + 1)
             key_reg[i] <= 32'h0;
@@ -206,6 +219,9 @@ module chacha(
           if (iv_we)
             iv_reg[address[0]] <= write_data;
 
+          if (ctr_we)
+            ctr_reg[address[0]] <= write_data;
+
           if (data_in_we)
             data_in_reg[address[3 : 0]] <= write_data;
         end
@@ -222,6 +238,7 @@ module chacha(
       rounds_we     = 0;
       key_we        = 0;
       iv_we         = 0;
+      ctr_we        = 0;
       data_in_we    = 0;
       tmp_read_data = 32'h0;
 
@@ -244,6 +261,9 @@ module chacha(
               if ((address >= ADDR_IV0) && (address <= ADDR_IV1))
                 iv_we = 1;
 
+              if ((address >= ADDR_CTR0) && (address <= ADDR_CTR1))
+                ctr_we = 1;
+
               if ((address >= ADDR_DATA_IN0) && (address <= ADDR_DATA_IN15))
                 data_in_we = 1;
             end // if (we)
@@ -266,6 +286,8 @@ module chacha(
                 ADDR_ROUNDS:  tmp_read_data = {27'h0, rounds_reg};
                 ADDR_IV0:     tmp_read_data = iv_reg[0];
                 ADDR_IV1:     tmp_read_data = iv_reg[1];
+                ADDR_CTR0:    tmp_read_data = ctr_reg[0];
+                ADDR_CTR1:    tmp_read_data = ctr_reg[1];
 
                 default:
                   begin
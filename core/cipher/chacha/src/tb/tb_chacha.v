@@ -106,6 +106,9 @@ module tb_chacha();
   localparam ADDR_IV0         = 8'h20;
   localparam ADDR_IV1         = 8'h21;
 
+  localparam ADDR_CTR0        = 8'h30;
+  localparam ADDR_CTR1        = 8'h31;
+
   localparam ADDR_DATA_IN0    = 8'h40;
   localparam ADDR_DATA_IN15   = 8'h4f;
 
@@ -480,6 +483,19 @@ module tb_chacha();
   endtask // write_parameters
 
 
+  //----------------------------------------------------------------
+  // write_ctr()
+  //
+  // Write the block counter that init starts from.
+  //----------------------------------------------------------------
+  task write_ctr(input [63 : 0] ctr);
+    begin
+      write_reg(ADDR_CTR0, ctr[31 : 0]);
+      write_reg(ADDR_CTR1, ctr[63 : 32]);
+    end
+  endtask // write_ctr
+
+
   //----------------------------------------------------------------
   // start_init_block()
   //
@@ -776,6 +792,29 @@ module tb_chacha();
                                  512'hfe882395601ce8aded444867fe62ed8741420002e5d28bb573113a418c1f4008e954c188f38ec4f26bb8555e2b7c92bf4380e2ea9e553187fdd42821794416de);
 
 
+      $display("TC7-4: Increasing, decreasing sequences in key and IV. 256 bit key, 8 rounds.");
+      $display("TC7-4: Testing init directly on the second block.");
+      write_ctr(64'h1);
+      run_test_vector(TC7, FOUR,
+                      256'h00112233445566778899aabbccddeeffffeeddccbbaa99887766554433221100,
+                      KEY_256_BITS,
+                      64'h0f1e2d3c4b596877,
+                      EIGHT_ROUNDS,
+                      512'hfe882395601ce8aded444867fe62ed8741420002e5d28bb573113a418c1f4008e954c188f38ec4f26bb8555e2b7c92bf4380e2ea9e553187fdd42821794416de);
+
+
+      $display("TC7-5: Increasing, decreasing sequences in key and IV. 256 bit key, 8 rounds.");
+      $display("TC7-5: Testing init on block 0x0000000100000005, using both CTR words.");
+      write_ctr(64'h0000000100000005);
+      run_test_vector(TC7, FIVE,
+                      256'h00112233445566778899aabbccddeeffffeeddccbbaa99887766554433221100,
+                      KEY_256_BITS,
+                      64'h0f1e2d3c4b596877,
+                      EIGHT_ROUNDS,
+                      512'h41650c4596adc63132dedb31d645674dcf8195e589321bdc5f672fb524f45215e1fd96e27058fa10784e4eb3de338500ae129057654fd9f5b79c3d6a02d51250);
+      write_ctr(64'h0);
+
+
       display_test_result();
       $display("*** chacha simulation done.");
       $finish;
@@ -0,0 +1,322 @@
+//======================================================================
+//
+// chacha20_poly1305.v
+// -------------------
+// Top level wrapper for the ChaCha20-Poly1305 AEAD engine, providing
+// a simple memory like interface with 32 bit data access.
+//
+// Register map:
+//   0x08 CTRL:     bit 0 init, bit 1 next, bit 2 finish.
+//   0x09 STATUS:   bit 0 ready, bit 1 tag valid.
+//   0x0a CONFIG:   bit 0 encrypt (1) or decrypt (0), bit 1 AAD block.
+//   0x0b DATA_LEN: bytes in the block, 1..64.
+//   0x10-0x17:     key.
+//   0x18-0x1a:     nonce.
+//   0x20-0x23:     tag.
+//   0x40-0x4f:     data in.
+//   0x80-0x8f:     data out.
+//
+// Nothing but CTRL can be written while the engine is busy.
+//
+//
+// Copyright (c) 2016, NORDUnet A/S
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// - Neither the name of the NORDUnet nor the names of its contributors may
+//   be used to endorse or promote products derived from this software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+module chacha20_poly1305(
+                         input wire           clk,
+                         input wire           reset_n,
+                         input wire           cs,
+                         input wire           we,
+                         input wire  [7 : 0]  address,
+                         input wire  [31 : 0] write_data,
+                         output wire [31 : 0] read_data,
+                         output wire          error
+                        );
+
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  localparam ADDR_NAME0        = 8'h00;
+  localparam ADDR_NAME1        = 8'h01;
+  localparam ADDR_VERSION      = 8'h02;
+
+  localparam ADDR_CTRL         = 8'h08;
+  localparam CTRL_INIT_BIT     = 0;
+  localparam CTRL_NEXT_BIT     = 1;
+  localparam CTRL_FINISH_BIT   = 2;
+
+  localparam ADDR_STATUS       = 8'h09;
+  localparam STATUS_READY_BIT  = 0;
+  localparam STATUS_VALID_BIT  = 1;
+
+  localparam ADDR_CONFIG       = 8'h0a;
+  localparam CONFIG_ENCDEC_BIT = 0;
+  localparam CONFIG_AAD_BIT    = 1;
+
+  localparam ADDR_DATA_LEN     = 8'h0b;
+
+  localparam ADDR_KEY0         = 8'h10;
+  localparam ADDR_KEY7         = 8'h17;
+
+  localparam ADDR_NONCE0       = 8'h18;
+  localparam ADDR_NONCE2       = 8'h1a;
+
+  localparam ADDR_TAG0         = 8'h20;
+  localparam ADDR_TAG3         = 8'h23;
+
+  localparam ADDR_DATA_IN0     = 8'h40;
+  localparam ADDR_DATA_IN15    = 8'h4f;
+
+  localparam ADDR_DATA_OUT0    = 8'h80;
+  localparam ADDR_DATA_OUT15   = 8'h8f;
+
+  localparam CORE_NAME0        = 32'h63323070; // "c20p"
+  localparam CORE_NAME1        = 32'h31333035; // "1305"
+  localparam CORE_VERSION      = 32'h302e3130; // "0.10"
+
+
+  //----------------------------------------------------------------
+  // Registers including update variables and write enable.
+  //----------------------------------------------------------------
+  reg          init_reg;
+  reg          init_new;
+
+  reg          next_reg;
+  reg          next_new;
+
+  reg          finish_reg;
+  reg          finish_new;
+
+  reg          encdec_reg;
+  reg          aad_reg;
+  reg          config_we;
+
+  reg [6 : 0]  data_len_reg;
+  reg          data_len_we;
+
+  reg [31 : 0] key_reg [0 : 7];
+  reg          key_we;
+
+  reg [31 : 0] nonce_reg [0 : 2];
+  reg          nonce_we;
+
+  reg [31 : 0] data_in_reg [0 : 15];
+  reg          data_in_we;
+
+
+  //----------------------------------------------------------------
+  // Wires.
+  //----------------------------------------------------------------
+  wire [255 : 0] core_key;
+  wire [95 : 0]  core_nonce;
+  wire [511 : 0] core_data_in;
+  wire [511 : 0] core_data_out;
+  wire [127 : 0] core_tag;
+  wire           core_ready;
+  wire           core_tag_valid;
+
+  reg [31 : 0]   tmp_read_data;
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity for ports etc.
+  //----------------------------------------------------------------
+  assign core_key     = {key_reg[0], key_reg[1], key_reg[2], key_reg[3],
+                         key_reg[4], key_reg[5], key_reg[6], key_reg[7]};
+
+  assign core_nonce   = {nonce_reg[0], nonce_reg[1], nonce_reg[2]};
+
+  assign core_data_in = {data_in_reg[00], data_in_reg[01], data_in_reg[02], data_in_reg[03],
+                         data_in_reg[04], data_in_reg[05], data_in_reg[06], data_in_reg[07],
+                         data_in_reg[08], data_in_reg[09], data_in_reg[10], data_in_reg[11],
+                         data_in_reg[12], data_in_reg[13], data_in_reg[14], data_in_reg[15]};
+
+  assign read_data    = tmp_read_data;
+
+  assign error        = 1'b0;
+
+
+  //----------------------------------------------------------------
+  // core instantiation.
+  //----------------------------------------------------------------
+  chacha20_poly1305_core core(
+                              .clk(clk),
+                              .reset_n(reset_n),
+
+                              .init(init_reg),
+                              .next(next_reg),
+                              .finish(finish_reg),
+                              .encdec(encdec_reg),
+                              .aad(aad_reg),
+                              .ready(core_ready),
+                              .tag_valid(core_tag_valid),
+
+                              .key(core_key),
+                              .nonce(core_nonce),
+
+                              .data_in(core_data_in),
+                              .data_len(data_len_reg),
+                              .data_out(core_data_out),
+
+                              .tag(core_tag)
+                             );
+
+
+  //----------------------------------------------------------------
+  // reg_update
+  //
+  // Update functionality for all registers in the core.
+  // All registers are positive edge triggered with asynchronous
+  // active low reset.
+  //----------------------------------------------------------------
+  always @ (posedge clk or negedge reset_n)
+    begin : reg_update
+      integer i;
+
+      if (!reset_n)
+        begin
+          init_reg     <= 1'b0;
+          next_reg     <= 1'b0;
+          finish_reg   <= 1'b0;
+          encdec_reg   <= 1'b0;
+          aad_reg      <= 1'b0;
+          data_len_reg <= 7'h0;
+
+          for (i = 0 ; i < 8 ; i = i + 1)
+            key_reg[i] <= 32'h0;
+
+          for (i = 0 ; i < 3 ; i = i + 1)
+            nonce_reg[i] <= 32'h0;
+
+          for (i = 0 ; i < 16 ; i = i + 1)
+            data_in_reg[i] <= 32'h0;
+        end
+      else
+        begin
+          init_reg   <= init_new;
+          next_reg   <= next_new;
+          finish_reg <= finish_new;
+
+          if (config_we)
+            begin
+              encdec_reg <= write_data[CONFIG_ENCDEC_BIT];
+              aad_reg    <= write_data[CONFIG_AAD_BIT];
+            end
+
+          if (data_len_we)
+            data_len_reg <= write_data[6 : 0];
+
+          if (key_we)
+            key_reg[address[2 : 0]] <= write_data;
+
+          if (nonce_we)
+            nonce_reg[address[1 : 0]] <= write_data;
+
+          if (data_in_we)
+            data_in_reg[address[3 : 0]] <= write_data;
+        end
+    end // reg_update
+
+
+  //----------------------------------------------------------------
+  // Address decoder logic.
+  //----------------------------------------------------------------
+  always @*
+    begin : addr_decoder
+      init_new      = 1'b0;
+      next_new      = 1'b0;
+      finish_new    = 1'b0;
+      config_we     = 1'b0;
+      data_len_we   = 1'b0;
+      key_we        = 1'b0;
+      nonce_we      = 1'b0;
+      data_in_we    = 1'b0;
+      tmp_read_data = 32'h0;
+
+      if (cs)
+        begin
+          if (we)
+            begin
+              if (address == ADDR_CTRL)
+                begin
+                  init_new   = write_data[CTRL_INIT_BIT];
+                  next_new   = write_data[CTRL_NEXT_BIT];
+                  finish_new = write_data[CTRL_FINISH_BIT];
+                end
+
+              if (core_ready)
+                begin
+                  if (address == ADDR_CONFIG)
+                    config_we = 1'b1;
+
+                  if (address == ADDR_DATA_LEN)
+                    data_len_we = 1'b1;
+
+                  if ((address >= ADDR_KEY0) && (address <= ADDR_KEY7))
+                    key_we = 1'b1;
+
+                  if ((address >= ADDR_NONCE0) && (address <= ADDR_NONCE2))
+                    nonce_we = 1'b1;
+
+                  if ((address >= ADDR_DATA_IN0) && (address <= ADDR_DATA_IN15))
+                    data_in_we = 1'b1;
+                end
+            end // if (we)
+
+          else
+            begin
+              if ((address >= ADDR_TAG0) && (address <= ADDR_TAG3))
+                tmp_read_data = core_tag[(3 - (address - ADDR_TAG0)) * 32 +: 32];
+
+              if ((address >= ADDR_DATA_OUT0) && (address <= ADDR_DATA_OUT15))
+                tmp_read_data = core_data_out[(15 - (address - ADDR_DATA_OUT0)) * 32 +: 32];
+
+              case (address)
+                ADDR_NAME0:    tmp_read_data = CORE_NAME0;
+                ADDR_NAME1:    tmp_read_data = CORE_NAME1;
+                ADDR_VERSION:  tmp_read_data = CORE_VERSION;
+                ADDR_STATUS:   tmp_read_data = {30'h0, core_tag_valid, core_ready};
+                ADDR_CONFIG:   tmp_read_data = {30'h0, aad_reg, encdec_reg};
+                ADDR_DATA_LEN: tmp_read_data = {25'h0, data_len_reg};
+
+                default:
+                  begin
+                  end
+              endcase // case (address)
+            end
+        end
+    end // addr_decoder
+endmodule // chacha20_poly1305
+
+//======================================================================
+// EOF chacha20_poly1305.v
+//======================================================================
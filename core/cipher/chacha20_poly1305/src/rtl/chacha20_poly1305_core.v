@@ -0,0 +1,466 @@
+//======================================================================
+//
+// chacha20_poly1305_core.v
+// ------------------------
+// ChaCha20-Poly1305 AEAD engine (RFC 8439, section 2.8), built from
+// the ChaCha core and the Poly1305 core.
+//
+// init sets up the one-time Poly1305 key from ChaCha20 block 0 for
+// the given key and nonce. Each next then takes up to 64 bytes of
+// either AAD, which is only authenticated, or data, which is XORed
+// with the keystream and authenticated as ciphertext, in one pass.
+// finish authenticates the lengths and produces the tag.
+//
+// The keystream for the next block is computed while the current one
+// is being authenticated, so the ChaCha rounds are hidden behind the
+// Poly1305 work.
+//
+// All AAD has to come before the data, and every block of AAD or
+// data but the last one has to be 64 bytes, since each block is
+// zero padded to a multiple of 16 bytes.
+//
+//
+// Copyright (c) 2016, NORDUnet A/S
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// - Neither the name of the NORDUnet nor the names of its contributors may
+//   be used to endorse or promote products derived from this software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+module chacha20_poly1305_core(
+                              input wire            clk,
+                              input wire            reset_n,
+
+                              input wire            init,
+                              input wire            next,
+                              input wire            finish,
+                              input wire            encdec,
+                              input wire            aad,
+                              output wire           ready,
+                              output wire           tag_valid,
+
+                              input wire [255 : 0]  key,
+                              input wire [95 : 0]   nonce,
+
+                              input wire [511 : 0]  data_in,
+                              input wire [6 : 0]    data_len,
+                              output wire [511 : 0] data_out,
+
+                              output wire [127 : 0] tag
+                             );
+
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  localparam CHACHA_ROUNDS  = 5'h14;
+
+  localparam CTRL_IDLE      = 4'h0;
+  localparam CTRL_INIT_SYNC = 4'h1;
+  localparam CTRL_INIT_WAIT = 4'h2;
+  localparam CTRL_INIT_KEY  = 4'h3;
+  localparam CTRL_KS        = 4'h4;
+  localparam CTRL_POLY      = 4'h5;
+  localparam CTRL_POLY_WAIT = 4'h6;
+  localparam CTRL_LEN_WAIT  = 4'h7;
+  localparam CTRL_TAG_WAIT  = 4'h8;
+
+
+  //----------------------------------------------------------------
+  // Functions.
+  //----------------------------------------------------------------
+  // Byte string, first byte in the MSBs, to little endian integer.
+  function [127 : 0] le128(input [127 : 0] op);
+    integer i;
+    begin
+      for (i = 0 ; i < 16 ; i = i + 1)
+        le128[i * 8 +: 8] = op[(15 - i) * 8 +: 8];
+    end
+  endfunction // le128
+
+  function [31 : 0] l2b(input [31 : 0] op);
+    begin
+      l2b = {op[7 : 0], op[15 : 8], op[23 : 16], op[31 : 24]};
+    end
+  endfunction // l2b
+
+
+  //----------------------------------------------------------------
+  // Registers including update variables and write enable.
+  //----------------------------------------------------------------
+  reg [511 : 0] data_out_reg;
+  reg [511 : 0] data_out_new;
+  reg           data_out_we;
+
+  reg [511 : 0] mac_data_reg;
+  reg [511 : 0] mac_data_new;
+  reg           mac_data_we;
+
+  reg [1 : 0]   chunk_reg;
+  reg [1 : 0]   chunk_new;
+  reg           chunk_we;
+
+  reg [63 : 0]  aad_len_reg;
+  reg [63 : 0]  aad_len_new;
+  reg           aad_len_we;
+
+  reg [63 : 0]  ct_len_reg;
+  reg [63 : 0]  ct_len_new;
+  reg           ct_len_we;
+
+  reg           ready_reg;
+  reg           ready_new;
+  reg           ready_we;
+
+  reg           tag_valid_reg;
+  reg           tag_valid_new;
+  reg           tag_valid_we;
+
+  reg [3 : 0]   aead_ctrl_reg;
+  reg [3 : 0]   aead_ctrl_new;
+  reg           aead_ctrl_we;
+
+
+  //----------------------------------------------------------------
+  // Wires.
+  //----------------------------------------------------------------
+  reg            chacha_init;
+  reg            chacha_next;
+  wire           chacha_ready;
+  wire [511 : 0] chacha_ks;
+  wire [63 : 0]  chacha_ctr;
+  wire [63 : 0]  chacha_iv;
+
+  reg            poly_init;
+  reg            poly_next;
+  reg            poly_finish;
+  wire           poly_ready;
+  reg [128 : 0]  poly_block;
+  wire [127 : 0] poly_tag;
+
+  wire [511 : 0] data_mask;
+  wire [1 : 0]   last_chunk;
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity for ports etc.
+  //----------------------------------------------------------------
+  assign ready     = ready_reg;
+  assign tag_valid = tag_valid_reg;
+  assign data_out  = data_out_reg;
+  assign tag       = le128(poly_tag);
+
+  // RFC 8439 state words 12..15 are the 32 bit block counter and the
+  // 96 bit nonce. The ChaCha core has a 64 bit counter in words 12
+  // and 13 and a 64 bit IV, so the first nonce word goes in the top
+  // half of the counter, which the core takes as is.
+  assign chacha_ctr = {l2b(nonce[95 : 64]), 32'h0};
+  assign chacha_iv  = nonce[63 : 0];
+
+  // The first data_len bytes of the block are used.
+  assign data_mask  = {512{1'b1}} << (10'd512 - {data_len, 3'b000});
+  assign last_chunk = (data_len - 1'b1) >> 4;
+
+
+  //----------------------------------------------------------------
+  // core instantiations.
+  //----------------------------------------------------------------
+  chacha_core chacha(
+                     .clk(clk),
+                     .reset_n(reset_n),
+                     .init(chacha_init),
+                     .next(chacha_next),
+                     .key(key),
+                     .keylen(1'b1),
+                     .iv(chacha_iv),
+                     .ctr(chacha_ctr),
+                     .rounds(CHACHA_ROUNDS),
+                     .data_in(512'h0),
+                     .ready(chacha_ready),
+                     .data_out(chacha_ks),
+                     .data_out_valid()
+                    );
+
+  poly1305_core poly1305(
+                         .clk(clk),
+                         .reset_n(reset_n),
+                         .init(poly_init),
+                         .next(poly_next),
+                         .finish(poly_finish),
+                         .ready(poly_ready),
+                         .r(le128(chacha_ks[511 : 384])),
+                         .s(le128(chacha_ks[383 : 256])),
+                         .block(poly_block),
+                         .tag(poly_tag)
+                        );
+
+
+  //----------------------------------------------------------------
+  // reg_update
+  //
+  // Update functionality for all registers in the core.
+  // All registers are positive edge triggered with asynchronous
+  // active low reset.
+  //----------------------------------------------------------------
+  always @ (posedge clk or negedge reset_n)
+    begin : reg_update
+      if (!reset_n)
+        begin
+          data_out_reg  <= 512'h0;
+          mac_data_reg  <= 512'h0;
+          chunk_reg     <= 2'h0;
+          aad_len_reg   <= 64'h0;
+          ct_len_reg    <= 64'h0;
+          ready_reg     <= 1'b1;
+          tag_valid_reg <= 1'b0;
+          aead_ctrl_reg <= CTRL_IDLE;
+        end
+      else
+        begin
+          if (data_out_we)
+            data_out_reg <= data_out_new;
+
+          if (mac_data_we)
+            mac_data_reg <= mac_data_new;
+
+          if (chunk_we)
+            chunk_reg <= chunk_new;
+
+          if (aad_len_we)
+            aad_len_reg <= aad_len_new;
+
+          if (ct_len_we)
+            ct_len_reg <= ct_len_new;
+
+          if (ready_we)
+            ready_reg <= ready_new;
+
+          if (tag_valid_we)
+            tag_valid_reg <= tag_valid_new;
+
+          if (aead_ctrl_we)
+            aead_ctrl_reg <= aead_ctrl_new;
+        end
+    end // reg_update
+
+
+  //----------------------------------------------------------------
+  // aead_ctrl
+  //
+  // Control FSM. The ChaCha core is always one block ahead: its
+  // output is taken when a data block comes in, and it is started on
+  // the following block right away.
+  //----------------------------------------------------------------
+  always @*
+    begin : aead_ctrl
+      chacha_init   = 1'b0;
+      chacha_next   = 1'b0;
+      poly_init     = 1'b0;
+      poly_next     = 1'b0;
+      poly_finish   = 1'b0;
+      poly_block    = {1'b1, le128(mac_data_reg[(3 - chunk_reg) * 128 +: 128])};
+      data_out_new  = 512'h0;
+      data_out_we   = 1'b0;
+      mac_data_new  = 512'h0;
+      mac_data_we   = 1'b0;
+      chunk_new     = 2'h0;
+      chunk_we      = 1'b0;
+      aad_len_new   = 64'h0;
+      aad_len_we    = 1'b0;
+      ct_len_new    = 64'h0;
+      ct_len_we     = 1'b0;
+      ready_new     = 1'b0;
+      ready_we      = 1'b0;
+      tag_valid_new = 1'b0;
+      tag_valid_we  = 1'b0;
+      aead_ctrl_new = CTRL_IDLE;
+      aead_ctrl_we  = 1'b0;
+
+      case (aead_ctrl_reg)
+        CTRL_IDLE:
+          begin
+            if (init)
+              begin
+                aad_len_new   = 64'h0;
+                aad_len_we    = 1'b1;
+                ct_len_new    = 64'h0;
+                ct_len_we     = 1'b1;
+                ready_new     = 1'b0;
+                ready_we      = 1'b1;
+                tag_valid_new = 1'b0;
+                tag_valid_we  = 1'b1;
+                aead_ctrl_new = CTRL_INIT_SYNC;
+                aead_ctrl_we  = 1'b1;
+              end
+
+            else if (next)
+              begin
+                ready_new = 1'b0;
+                ready_we  = 1'b1;
+                chunk_new = 2'h0;
+                chunk_we  = 1'b1;
+
+                if (aad)
+                  begin
+                    mac_data_new  = data_in & data_mask;
+                    mac_data_we   = 1'b1;
+                    aad_len_new   = aad_len_reg + data_len;
+                    aad_len_we    = 1'b1;
+                    aead_ctrl_new = CTRL_POLY;
+                    aead_ctrl_we  = 1'b1;
+                  end
+                else
+                  begin
+                    aead_ctrl_new = CTRL_KS;
+                    aead_ctrl_we  = 1'b1;
+                  end
+              end
+
+            else if (finish)
+              begin
+                // The lengths block, le64(aad_len) || le64(ct_len).
+                poly_block    = {1'b1, ct_len_reg, aad_len_reg};
+                poly_next     = 1'b1;
+                ready_new     = 1'b0;
+                ready_we      = 1'b1;
+                aead_ctrl_new = CTRL_LEN_WAIT;
+                aead_ctrl_we  = 1'b1;
+              end
+          end
+
+        CTRL_INIT_SYNC:
+          begin
+            // The ChaCha core may still be on a prefetched block.
+            if (chacha_ready)
+              begin
+                chacha_init   = 1'b1;
+                aead_ctrl_new = CTRL_INIT_WAIT;
+                aead_ctrl_we  = 1'b1;
+              end
+          end
+
+        CTRL_INIT_WAIT:
+          begin
+            aead_ctrl_new = CTRL_INIT_KEY;
+            aead_ctrl_we  = 1'b1;
+          end
+
+        CTRL_INIT_KEY:
+          begin
+            // Block 0 gives r and s, then start on block 1.
+            if (chacha_ready)
+              begin
+                poly_init     = 1'b1;
+                chacha_next   = 1'b1;
+                ready_new     = 1'b1;
+                ready_we      = 1'b1;
+                aead_ctrl_new = CTRL_IDLE;
+                aead_ctrl_we  = 1'b1;
+              end
+          end
+
+        CTRL_KS:
+          begin
+            if (chacha_ready)
+              begin
+                data_out_new = (data_in ^ chacha_ks) & data_mask;
+                data_out_we  = 1'b1;
+                mac_data_we  = 1'b1;
+                if (encdec)
+                  mac_data_new = (data_in ^ chacha_ks) & data_mask;
+                else
+                  mac_data_new = data_in & data_mask;
+                ct_len_new    = ct_len_reg + data_len;
+                ct_len_we     = 1'b1;
+                chacha_next   = 1'b1;
+                aead_ctrl_new = CTRL_POLY;
+                aead_ctrl_we  = 1'b1;
+              end
+          end
+
+        CTRL_POLY:
+          begin
+            poly_next     = 1'b1;
+            aead_ctrl_new = CTRL_POLY_WAIT;
+            aead_ctrl_we  = 1'b1;
+          end
+
+        CTRL_POLY_WAIT:
+          begin
+            if (poly_ready)
+              begin
+                if (chunk_reg == last_chunk)
+                  begin
+                    ready_new     = 1'b1;
+                    ready_we      = 1'b1;
+                    aead_ctrl_new = CTRL_IDLE;
+                    aead_ctrl_we  = 1'b1;
+                  end
+                else
+                  begin
+                    chunk_new     = chunk_reg + 1'b1;
+                    chunk_we      = 1'b1;
+                    aead_ctrl_new = CTRL_POLY;
+                    aead_ctrl_we  = 1'b1;
+                  end
+              end
+          end
+
+        CTRL_LEN_WAIT:
+          begin
+            if (poly_ready)
+              begin
+                poly_finish   = 1'b1;
+                aead_ctrl_new = CTRL_TAG_WAIT;
+                aead_ctrl_we  = 1'b1;
+              end
+          end
+
+        CTRL_TAG_WAIT:
+          begin
+            if (poly_ready)
+              begin
+                ready_new     = 1'b1;
+                ready_we      = 1'b1;
+                tag_valid_new = 1'b1;
+                tag_valid_we  = 1'b1;
+                aead_ctrl_new = CTRL_IDLE;
+                aead_ctrl_we  = 1'b1;
+              end
+          end
+
+        default:
+          begin
+          end
+      endcase // case (aead_ctrl_reg)
+    end // aead_ctrl
+
+endmodule // chacha20_poly1305_core
+
+//======================================================================
+// EOF chacha20_poly1305_core.v
+//======================================================================
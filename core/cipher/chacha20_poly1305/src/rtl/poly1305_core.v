@@ -0,0 +1,383 @@
+//======================================================================
+//
+// poly1305_core.v
+// ---------------
+// Poly1305 one-time authenticator core (RFC 8439, section 2.5).
+//
+// The core keeps the accumulator, r and s. Each next adds a 16 byte
+// message block, given as a little endian integer including the pad
+// bit, to the accumulator and multiplies the sum by r modulo
+// 2^130 - 5. finish does the final reduction and adds s.
+//
+// The multiplication uses sixteen 16x16 bit multiply-accumulate
+// units, one per 16 bit column of the product. The sum is fed to all
+// of them one limb per cycle while each gets the limb of r that lands
+// in its column, so the whole product takes nine cycles. The column
+// sums are then carried into 16 bit limbs, one per cycle, and the
+// bits above 2^130 are folded back in times five. The accumulator is
+// kept only partially reduced, below 2^131, between blocks.
+//
+//
+// Copyright (c) 2016, NORDUnet A/S
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// - Neither the name of the NORDUnet nor the names of its contributors may
+//   be used to endorse or promote products derived from this software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+module poly1305_core(
+                     input wire            clk,
+                     input wire            reset_n,
+
+                     input wire            init,
+                     input wire            next,
+                     input wire            finish,
+                     output wire           ready,
+
+                     input wire [127 : 0]  r,
+                     input wire [127 : 0]  s,
+                     input wire [128 : 0]  block,
+
+                     output wire [127 : 0] tag
+                    );
+
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  localparam R_CLAMP     = 128'h0ffffffc0ffffffc0ffffffc0fffffff;
+
+  localparam NUM_COLUMNS = 16;
+  localparam NUM_LIMBS   = 9;
+
+  localparam CTRL_IDLE   = 3'h0;
+  localparam CTRL_MAC    = 3'h1;
+  localparam CTRL_CARRY  = 3'h2;
+  localparam CTRL_REDUCE = 3'h3;
+  localparam CTRL_FINAL  = 3'h4;
+
+
+  //----------------------------------------------------------------
+  // Registers including update variables and write enable.
+  //----------------------------------------------------------------
+  reg [127 : 0] r_reg;
+  reg [127 : 0] s_reg;
+  reg           key_we;
+
+  reg [130 : 0] acc_reg;
+  reg [130 : 0] acc_new;
+  reg           acc_we;
+
+  reg [143 : 0] h_reg;
+  reg [143 : 0] h_new;
+  reg           h_we;
+
+  reg [255 : 0] prod_reg;
+  reg [255 : 0] prod_new;
+  reg           prod_we;
+
+  reg [31 : 0]  carry_reg;
+  reg [31 : 0]  carry_new;
+  reg           carry_we;
+
+  reg [3 : 0]   cnt_reg;
+  reg [3 : 0]   cnt_new;
+  reg           cnt_we;
+
+  reg [127 : 0] tag_reg;
+  reg [127 : 0] tag_new;
+  reg           tag_we;
+
+  reg           ready_reg;
+  reg           ready_new;
+  reg           ready_we;
+
+  reg [2 : 0]   poly1305_ctrl_reg;
+  reg [2 : 0]   poly1305_ctrl_new;
+  reg           poly1305_ctrl_we;
+
+
+  //----------------------------------------------------------------
+  // Wires.
+  //----------------------------------------------------------------
+  reg                               mac_ce;
+  reg [(NUM_COLUMNS * 16 - 1) : 0]  mac_b;
+  wire [(NUM_COLUMNS * 47 - 1) : 0] mac_s;
+
+  reg [46 : 0]                      carry_sum;
+  reg [130 : 0]                     final_acc;
+  reg [130 : 0]                     final_sub;
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity for ports etc.
+  //----------------------------------------------------------------
+  assign ready = ready_reg;
+  assign tag   = tag_reg;
+
+
+  //----------------------------------------------------------------
+  // Multiply-accumulate units, one per column of the product.
+  // All get the same limb of the sum in a given cycle.
+  //----------------------------------------------------------------
+  genvar col;
+  generate
+    for (col = 0 ; col < NUM_COLUMNS ; col = col + 1)
+      begin : mac_columns
+        mac16_generic mac(
+                          .clk(clk),
+                          .clr(cnt_reg == 4'h0),
+                          .ce(mac_ce),
+                          .a(h_reg[15 : 0]),
+                          .b(mac_b[col * 16 +: 16]),
+                          .s(mac_s[col * 47 +: 47])
+                         );
+      end
+  endgenerate
+
+
+  //----------------------------------------------------------------
+  // reg_update
+  //
+  // Update functionality for all registers in the core.
+  // All registers are positive edge triggered with asynchronous
+  // active low reset.
+  //----------------------------------------------------------------
+  always @ (posedge clk or negedge reset_n)
+    begin : reg_update
+      if (!reset_n)
+        begin
+          r_reg             <= 128'h0;
+          s_reg             <= 128'h0;
+          acc_reg           <= 131'h0;
+          h_reg             <= 144'h0;
+          prod_reg          <= 256'h0;
+          carry_reg         <= 32'h0;
+          cnt_reg           <= 4'h0;
+          tag_reg           <= 128'h0;
+          ready_reg         <= 1'b1;
+          poly1305_ctrl_reg <= CTRL_IDLE;
+        end
+      else
+        begin
+          if (key_we)
+            begin
+              r_reg <= r & R_CLAMP;
+              s_reg <= s;
+            end
+
+          if (acc_we)
+            acc_reg <= acc_new;
+
+          if (h_we)
+            h_reg <= h_new;
+
+          if (prod_we)
+            prod_reg <= prod_new;
+
+          if (carry_we)
+            carry_reg <= carry_new;
+
+          if (cnt_we)
+            cnt_reg <= cnt_new;
+
+          if (tag_we)
+            tag_reg <= tag_new;
+
+          if (ready_we)
+            ready_reg <= ready_new;
+
+          if (poly1305_ctrl_we)
+            poly1305_ctrl_reg <= poly1305_ctrl_new;
+        end
+    end // reg_update
+
+
+  //----------------------------------------------------------------
+  // mac_operands
+  //
+  // In cycle i column k gets limb i of the sum times limb k - i of
+  // r, or zero when there is no such limb.
+  //----------------------------------------------------------------
+  always @*
+    begin : mac_operands
+      integer k;
+
+      mac_b = {(NUM_COLUMNS * 16){1'b0}};
+
+      for (k = 0 ; k < NUM_COLUMNS ; k = k + 1)
+        if ((k >= cnt_reg) && (k < cnt_reg + 8))
+          mac_b[k * 16 +: 16] = r_reg[(k - cnt_reg) * 16 +: 16];
+    end // mac_operands
+
+
+  //----------------------------------------------------------------
+  // arith_logic
+  //
+  // The carry step and the final reduction.
+  //----------------------------------------------------------------
+  always @*
+    begin : arith_logic
+      carry_sum = mac_s[cnt_reg * 47 +: 47] + {15'h0, carry_reg};
+
+      // acc < 2^131, so after folding the top bit back in the value
+      // is below 2^130 + 5, and at most one p has to be subtracted.
+      final_acc = {1'b0, acc_reg[129 : 0]} + {128'h0, acc_reg[130], 2'b00} +
+                  {130'h0, acc_reg[130]};
+      final_sub = final_acc + 131'h5;
+    end // arith_logic
+
+
+  //----------------------------------------------------------------
+  // poly1305_ctrl
+  //----------------------------------------------------------------
+  always @*
+    begin : poly1305_ctrl
+      key_we            = 1'b0;
+      acc_new           = 131'h0;
+      acc_we            = 1'b0;
+      h_new             = 144'h0;
+      h_we              = 1'b0;
+      prod_new          = 256'h0;
+      prod_we           = 1'b0;
+      carry_new         = 32'h0;
+      carry_we          = 1'b0;
+      cnt_new           = 4'h0;
+      cnt_we            = 1'b0;
+      tag_new           = 128'h0;
+      tag_we            = 1'b0;
+      mac_ce            = 1'b0;
+      ready_new         = 1'b0;
+      ready_we          = 1'b0;
+      poly1305_ctrl_new = CTRL_IDLE;
+      poly1305_ctrl_we  = 1'b0;
+
+      case (poly1305_ctrl_reg)
+        CTRL_IDLE:
+          begin
+            if (init)
+              begin
+                key_we  = 1'b1;
+                acc_new = 131'h0;
+                acc_we  = 1'b1;
+              end
+
+            else if (next)
+              begin
+                h_new             = {13'h0, acc_reg} + {15'h0, block};
+                h_we              = 1'b1;
+                cnt_new           = 4'h0;
+                cnt_we            = 1'b1;
+                ready_new         = 1'b0;
+                ready_we          = 1'b1;
+                poly1305_ctrl_new = CTRL_MAC;
+                poly1305_ctrl_we  = 1'b1;
+              end
+
+            else if (finish)
+              begin
+                ready_new         = 1'b0;
+                ready_we          = 1'b1;
+                poly1305_ctrl_new = CTRL_FINAL;
+                poly1305_ctrl_we  = 1'b1;
+              end
+          end
+
+        CTRL_MAC:
+          begin
+            // One limb of the sum per cycle, lowest first.
+            mac_ce  = 1'b1;
+            h_new   = {16'h0, h_reg[143 : 16]};
+            h_we    = 1'b1;
+            cnt_new = cnt_reg + 1'b1;
+            cnt_we  = 1'b1;
+
+            if (cnt_reg == (NUM_LIMBS - 1))
+              begin
+                cnt_new           = 4'h0;
+                carry_new         = 32'h0;
+                carry_we          = 1'b1;
+                poly1305_ctrl_new = CTRL_CARRY;
+                poly1305_ctrl_we  = 1'b1;
+              end
+          end
+
+        CTRL_CARRY:
+          begin
+            // Column sums are below 2^36. The limbs are shifted in
+            // from the top, so limb 0 ends up at the bottom.
+            prod_new  = {carry_sum[15 : 0], prod_reg[255 : 16]};
+            prod_we   = 1'b1;
+            carry_new = carry_sum[46 : 16];
+            carry_we  = 1'b1;
+            cnt_new   = cnt_reg + 1'b1;
+            cnt_we    = 1'b1;
+
+            if (cnt_reg == (NUM_COLUMNS - 1))
+              begin
+                poly1305_ctrl_new = CTRL_REDUCE;
+                poly1305_ctrl_we  = 1'b1;
+              end
+          end
+
+        CTRL_REDUCE:
+          begin
+            // 2^130 = 5 mod p.
+            acc_new           = {1'b0, prod_reg[129 : 0]} +
+                                {3'h0, prod_reg[255 : 130], 2'b00} +
+                                {5'h0, prod_reg[255 : 130]};
+            acc_we            = 1'b1;
+            ready_new         = 1'b1;
+            ready_we          = 1'b1;
+            poly1305_ctrl_new = CTRL_IDLE;
+            poly1305_ctrl_we  = 1'b1;
+          end
+
+        CTRL_FINAL:
+          begin
+            if (final_sub[130])
+              tag_new = final_sub[127 : 0] + s_reg;
+            else
+              tag_new = final_acc[127 : 0] + s_reg;
+            tag_we            = 1'b1;
+            ready_new         = 1'b1;
+            ready_we          = 1'b1;
+            poly1305_ctrl_new = CTRL_IDLE;
+            poly1305_ctrl_we  = 1'b1;
+          end
+
+        default:
+          begin
+          end
+      endcase // case (poly1305_ctrl_reg)
+    end // poly1305_ctrl
+
+endmodule // poly1305_core
+
+//======================================================================
+// EOF poly1305_core.v
+//======================================================================
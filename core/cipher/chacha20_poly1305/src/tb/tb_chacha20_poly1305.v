@@ -0,0 +1,494 @@
+//======================================================================
+//
+// tb_chacha20_poly1305.v
+// ----------------------
+// Testbench for the ChaCha20-Poly1305 AEAD engine top level wrapper,
+// using the AEAD test vector in RFC 8439, section 2.8.2.
+//
+//
+// Copyright (c) 2016, NORDUnet A/S
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// - Neither the name of the NORDUnet nor the names of its contributors may
+//   be used to endorse or promote products derived from this software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+//------------------------------------------------------------------
+// Test module.
+//------------------------------------------------------------------
+module tb_chacha20_poly1305();
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  parameter DEBUG = 0;
+
+  parameter CLK_HALF_PERIOD = 1;
+  parameter CLK_PERIOD      = 2 * CLK_HALF_PERIOD;
+
+  // The DUT address map.
+  parameter ADDR_NAME0       = 8'h00;
+  parameter ADDR_NAME1       = 8'h01;
+  parameter ADDR_VERSION     = 8'h02;
+
+  parameter ADDR_CTRL        = 8'h08;
+  parameter CTRL_INIT        = 32'h1;
+  parameter CTRL_NEXT        = 32'h2;
+  parameter CTRL_FINISH      = 32'h4;
+
+  parameter ADDR_STATUS      = 8'h09;
+  parameter STATUS_READY_BIT = 0;
+  parameter STATUS_VALID_BIT = 1;
+
+  parameter ADDR_CONFIG      = 8'h0a;
+  parameter CONFIG_DECRYPT   = 32'h0;
+  parameter CONFIG_ENCRYPT   = 32'h1;
+  parameter CONFIG_AAD       = 32'h2;
+
+  parameter ADDR_DATA_LEN    = 8'h0b;
+  parameter ADDR_KEY0        = 8'h10;
+  parameter ADDR_NONCE0      = 8'h18;
+  parameter ADDR_TAG0        = 8'h20;
+  parameter ADDR_DATA_IN0    = 8'h40;
+  parameter ADDR_DATA_OUT0   = 8'h80;
+
+
+  //----------------------------------------------------------------
+  // Register and Wire declarations.
+  //----------------------------------------------------------------
+  reg [31 : 0]  cycle_ctr;
+  reg [31 : 0]  error_ctr;
+  reg [31 : 0]  tc_ctr;
+
+  reg [31 : 0]  read_data;
+
+  reg           tb_clk;
+  reg           tb_reset_n;
+  reg           tb_cs;
+  reg           tb_we;
+  reg [7 : 0]   tb_address;
+  reg [31 : 0]  tb_write_data;
+  wire [31 : 0] tb_read_data;
+  wire          tb_error;
+
+
+  //----------------------------------------------------------------
+  // Device Under Test.
+  //----------------------------------------------------------------
+  chacha20_poly1305 dut(
+                        .clk(tb_clk),
+                        .reset_n(tb_reset_n),
+                        .cs(tb_cs),
+                        .we(tb_we),
+                        .address(tb_address),
+                        .write_data(tb_write_data),
+                        .read_data(tb_read_data),
+                        .error(tb_error)
+                       );
+
+
+  //----------------------------------------------------------------
+  // clk_gen
+  //
+  // Always running clock generator process.
+  //----------------------------------------------------------------
+  always
+    begin : clk_gen
+      #CLK_HALF_PERIOD;
+      tb_clk = !tb_clk;
+    end // clk_gen
+
+
+  //----------------------------------------------------------------
+  // sys_monitor()
+  //
+  // An always running process that creates a cycle counter and
+  // conditionally displays information about the DUT.
+  //----------------------------------------------------------------
+  always
+    begin : sys_monitor
+      cycle_ctr = cycle_ctr + 1;
+
+      #(CLK_PERIOD);
+
+      if (DEBUG)
+        begin
+          dump_dut_state();
+        end
+    end
+
+
+  //----------------------------------------------------------------
+  // dump_dut_state()
+  //
+  // Dump the state of the dump when needed.
+  //----------------------------------------------------------------
+  task dump_dut_state;
+    begin
+      $display("cycle: 0x%016x", cycle_ctr);
+      $display("aead ctrl: 0x%01x, chunk: 0x%01x, ready: 0x%01x",
+               dut.core.aead_ctrl_reg, dut.core.chunk_reg, dut.core.ready_reg);
+      $display("aad_len: 0x%016x, ct_len: 0x%016x",
+               dut.core.aad_len_reg, dut.core.ct_len_reg);
+      $display("poly ctrl: 0x%01x, acc: 0x%033x",
+               dut.core.poly1305.poly1305_ctrl_reg, dut.core.poly1305.acc_reg);
+      $display("");
+    end
+  endtask // dump_dut_state
+
+
+  //----------------------------------------------------------------
+  // reset_dut()
+  //
+  // Toggle reset to put the DUT into a well known state.
+  //----------------------------------------------------------------
+  task reset_dut;
+    begin
+      $display("*** Toggle reset.");
+      tb_reset_n = 0;
+
+      #(2 * CLK_PERIOD);
+      tb_reset_n = 1;
+      $display("");
+    end
+  endtask // reset_dut
+
+
+  //----------------------------------------------------------------
+  // display_test_results()
+  //
+  // Display the accumulated test results.
+  //----------------------------------------------------------------
+  task display_test_results;
+    begin
+      if (error_ctr == 0)
+        begin
+          $display("*** All %02d test cases completed successfully", tc_ctr);
+        end
+      else
+        begin
+          $display("*** %02d tests completed - %02d test cases did not complete successfully.",
+                   tc_ctr, error_ctr);
+        end
+    end
+  endtask // display_test_results
+
+
+  //----------------------------------------------------------------
+  // init_sim()
+  //
+  // Initialize all counters and testbed functionality as well
+  // as setting the DUT inputs to defined values.
+  //----------------------------------------------------------------
+  task init_sim;
+    begin
+      cycle_ctr     = 0;
+      error_ctr     = 0;
+      tc_ctr        = 0;
+
+      tb_clk        = 0;
+      tb_reset_n    = 1;
+
+      tb_cs         = 0;
+      tb_we         = 0;
+      tb_address    = 8'h0;
+      tb_write_data = 32'h0;
+    end
+  endtask // init_sim
+
+
+  //----------------------------------------------------------------
+  // write_word()
+  //
+  // Write the given word to the DUT using the DUT interface.
+  //----------------------------------------------------------------
+  task write_word(input [7 : 0]  address,
+                  input [31 : 0] word);
+    begin
+      if (DEBUG)
+        begin
+          $display("*** Writing 0x%08x to 0x%02x.", word, address);
+          $display("");
+        end
+
+      tb_address = address;
+      tb_write_data = word;
+      tb_cs = 1;
+      tb_we = 1;
+      #(2 * CLK_PERIOD);
+      tb_cs = 0;
+      tb_we = 0;
+    end
+  endtask // write_word
+
+
+  //----------------------------------------------------------------
+  // read_word()
+  //
+  // Read a data word from the given address in the DUT.
+  // the word read will be available in the global variable
+  // read_data.
+  //----------------------------------------------------------------
+  task read_word(input [7 : 0] address);
+    begin
+      tb_address = address;
+      tb_cs = 1;
+      tb_we = 0;
+      #(CLK_PERIOD);
+      read_data = tb_read_data;
+      tb_cs = 0;
+
+      if (DEBUG)
+        begin
+          $display("*** Reading 0x%08x from 0x%02x.", read_data, address);
+          $display("");
+        end
+    end
+  endtask // read_word
+
+
+  //----------------------------------------------------------------
+  // wait_status()
+  //
+  // Wait for the given status bit to be set.
+  //----------------------------------------------------------------
+  task wait_status(input integer bit_no);
+    begin : wait_status
+      reg done;
+      done = 1'b0;
+
+      while (done != 1'b1)
+        begin
+          read_word(ADDR_STATUS);
+          done = read_data[bit_no];
+        end
+    end
+  endtask // wait_status
+
+
+  //----------------------------------------------------------------
+  // init_aead()
+  //
+  // Write key and nonce and let the engine derive the Poly1305 key.
+  //----------------------------------------------------------------
+  task init_aead(input [255 : 0] key, input [95 : 0] nonce);
+    begin : init_aead
+      integer i;
+
+      for (i = 0 ; i < 8 ; i = i + 1)
+        write_word(ADDR_KEY0 + i, key[(255 - 32 * i) -: 32]);
+
+      for (i = 0 ; i < 3 ; i = i + 1)
+        write_word(ADDR_NONCE0 + i, nonce[(95 - 32 * i) -: 32]);
+
+      write_word(ADDR_CTRL, CTRL_INIT);
+      wait_status(STATUS_READY_BIT);
+    end
+  endtask // init_aead
+
+
+  //----------------------------------------------------------------
+  // process_block()
+  //
+  // Run len bytes, first byte in the MSBs, through the engine in
+  // the given mode and read back the result in the global variable
+  // block_out.
+  //----------------------------------------------------------------
+  reg [511 : 0] block_out;
+
+  task process_block(input [31 : 0]  config_word,
+                     input [6 : 0]   len,
+                     input [511 : 0] block);
+    begin : process_block
+      integer i;
+
+      for (i = 0 ; i < 16 ; i = i + 1)
+        write_word(ADDR_DATA_IN0 + i, block[(511 - 32 * i) -: 32]);
+
+      write_word(ADDR_CONFIG, config_word);
+      write_word(ADDR_DATA_LEN, {25'h0, len});
+      write_word(ADDR_CTRL, CTRL_NEXT);
+      wait_status(STATUS_READY_BIT);
+
+      for (i = 0 ; i < 16 ; i = i + 1)
+        begin
+          read_word(ADDR_DATA_OUT0 + i);
+          block_out[(511 - 32 * i) -: 32] = read_data;
+        end
+    end
+  endtask // process_block
+
+
+  //----------------------------------------------------------------
+  // finish_aead()
+  //
+  // Get the tag into the global variable tag_out.
+  //----------------------------------------------------------------
+  reg [127 : 0] tag_out;
+
+  task finish_aead;
+    begin : finish_aead
+      integer i;
+
+      write_word(ADDR_CTRL, CTRL_FINISH);
+      wait_status(STATUS_VALID_BIT);
+
+      for (i = 0 ; i < 4 ; i = i + 1)
+        begin
+          read_word(ADDR_TAG0 + i);
+          tag_out[(127 - 32 * i) -: 32] = read_data;
+        end
+    end
+  endtask // finish_aead
+
+
+  //----------------------------------------------------------------
+  // rfc8439_test()
+  //
+  // The AEAD example in RFC 8439, section 2.8.2: 12 bytes of AAD
+  // and a 114 byte message, as one full and one partial block.
+  // Encrypts when encdec is set, otherwise decrypts the ciphertext.
+  //----------------------------------------------------------------
+  task rfc8439_test(input [7 : 0] tc_number, input encdec);
+    begin : rfc8439_test
+      integer tc_errors;
+      reg [31 : 0]  start_cycle;
+      reg [255 : 0] key;
+      reg [95 : 0]  nonce;
+      reg [95 : 0]  aad;
+      reg [911 : 0] plaintext;
+      reg [911 : 0] ciphertext;
+      reg [911 : 0] data_in;
+      reg [911 : 0] expected;
+      reg [911 : 0] result;
+      reg [127 : 0] expected_tag;
+
+      key          = 256'h808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f;
+      nonce        = 96'h070000004041424344454647;
+      aad          = 96'h50515253c0c1c2c3c4c5c6c7;
+      expected_tag = 128'h1ae10b594f09e26a7e902ecbd0600691;
+
+      plaintext = {256'h4c616469657320616e642047656e746c656d656e206f662074686520636c6173,
+                   256'h73206f66202739393a204966204920636f756c64206f6666657220796f75206f,
+                   256'h6e6c79206f6e652074697020666f7220746865206675747572652c2073756e73,
+                   144'h637265656e20776f756c642062652069742e};
+      ciphertext = {256'hd31a8d34648e60db7b86afbc53ef7ec2a4aded51296e08fea9e2b5a736ee62d6,
+                   256'h3dbea45e8ca9671282fafb69da92728b1a71de0a9e060b2905d6a5b67ecd3b36,
+                   256'h92ddbd7f2d778b8c9803aee328091b58fab324e4fad675945585808b4831d7bc,
+                   144'h3ff4def08e4b7a9de576d26586cec64b6116};
+
+      if (encdec)
+        begin
+          data_in  = plaintext;
+          expected = ciphertext;
+        end
+      else
+        begin
+          data_in  = ciphertext;
+          expected = plaintext;
+        end
+
+      tc_errors = 0;
+      tc_ctr = tc_ctr + 1;
+      $display("*** TC %0d RFC 8439 2.8.2 %0s started.", tc_number,
+               encdec ? "encryption" : "decryption");
+
+      init_aead(key, nonce);
+
+      process_block(CONFIG_AAD, 7'd12, {aad, 416'h0});
+
+      start_cycle = cycle_ctr;
+      process_block({31'h0, encdec}, 7'd64, data_in[911 : 400]);
+      $display("*** One 64 byte block took %0d cycles, including the bus transfers.",
+               cycle_ctr - start_cycle);
+      result[911 : 400] = block_out;
+
+      process_block({31'h0, encdec}, 7'd50, {data_in[399 : 0], 112'h0});
+      result[399 : 0] = block_out[511 : 112];
+
+      if (block_out[111 : 0] != 112'h0)
+        begin
+          $display("Error: bytes past the end of the data are not zero.");
+          tc_errors = tc_errors + 1;
+        end
+
+      finish_aead();
+
+      if (result != expected)
+        begin
+          $display("Error in data.");
+          $display("Expected: 0x%0228x", expected);
+          $display("Got:      0x%0228x", result);
+          tc_errors = tc_errors + 1;
+        end
+
+      if (tag_out != expected_tag)
+        begin
+          $display("Error in tag. Expected 0x%032x, got 0x%032x", expected_tag, tag_out);
+          tc_errors = tc_errors + 1;
+        end
+
+      if (tc_errors == 0)
+        $display("*** TC %0d successful.", tc_number);
+      else
+        begin
+          $display("*** ERROR: TC %0d NOT successful.", tc_number);
+          error_ctr = error_ctr + 1;
+        end
+      $display("");
+    end
+  endtask // rfc8439_test
+
+
+  //----------------------------------------------------------------
+  // chacha20_poly1305_test
+  //
+  // The main test functionality.
+  //----------------------------------------------------------------
+  initial
+    begin : chacha20_poly1305_test
+      $display("   -= Testbench for ChaCha20-Poly1305 started =-");
+      $display("     ========================================");
+      $display("");
+
+      init_sim();
+      reset_dut();
+
+      rfc8439_test(8'h01, 1'b1);
+      rfc8439_test(8'h02, 1'b0);
+
+      display_test_results();
+
+      $display("");
+      $display("*** ChaCha20-Poly1305 simulation done. ***");
+      $finish;
+    end // chacha20_poly1305_test
+endmodule // tb_chacha20_poly1305
+
+//======================================================================
+// EOF tb_chacha20_poly1305.v
+//======================================================================
@@ -0,0 +1,406 @@
+//======================================================================
+//
+// tb_poly1305_core.v
+// ------------------
+// Testbench for the Poly1305 core, using the test vector in
+// RFC 8439, section 2.5.2.
+//
+//
+// Copyright (c) 2016, NORDUnet A/S
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// - Neither the name of the NORDUnet nor the names of its contributors may
+//   be used to endorse or promote products derived from this software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+//------------------------------------------------------------------
+// Test module.
+//------------------------------------------------------------------
+module tb_poly1305_core();
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  parameter DEBUG = 0;
+
+  parameter CLK_HALF_PERIOD = 1;
+  parameter CLK_PERIOD      = 2 * CLK_HALF_PERIOD;
+
+
+  //----------------------------------------------------------------
+  // Register and Wire declarations.
+  //----------------------------------------------------------------
+  reg [31 : 0]   cycle_ctr;
+  reg [31 : 0]   error_ctr;
+  reg [31 : 0]   tc_ctr;
+
+  reg            tb_clk;
+  reg            tb_reset_n;
+  reg            tb_init;
+  reg            tb_next;
+  reg            tb_finish;
+  wire           tb_ready;
+  reg [127 : 0]  tb_r;
+  reg [127 : 0]  tb_s;
+  reg [128 : 0]  tb_block;
+  wire [127 : 0] tb_tag;
+
+
+  //----------------------------------------------------------------
+  // Device Under Test.
+  //----------------------------------------------------------------
+  poly1305_core dut(
+                    .clk(tb_clk),
+                    .reset_n(tb_reset_n),
+                    .init(tb_init),
+                    .next(tb_next),
+                    .finish(tb_finish),
+                    .ready(tb_ready),
+                    .r(tb_r),
+                    .s(tb_s),
+                    .block(tb_block),
+                    .tag(tb_tag)
+                   );
+
+
+  //----------------------------------------------------------------
+  // clk_gen
+  //
+  // Always running clock generator process.
+  //----------------------------------------------------------------
+  always
+    begin : clk_gen
+      #CLK_HALF_PERIOD;
+      tb_clk = !tb_clk;
+    end // clk_gen
+
+
+  //----------------------------------------------------------------
+  // sys_monitor()
+  //
+  // An always running process that creates a cycle counter and
+  // conditionally displays information about the DUT.
+  //----------------------------------------------------------------
+  always
+    begin : sys_monitor
+      cycle_ctr = cycle_ctr + 1;
+
+      #(CLK_PERIOD);
+
+      if (DEBUG)
+        begin
+          dump_dut_state();
+        end
+    end
+
+
+  //----------------------------------------------------------------
+  // dump_dut_state()
+  //
+  // Dump the state of the dump when needed.
+  //----------------------------------------------------------------
+  task dump_dut_state;
+    begin
+      $display("cycle: 0x%016x", cycle_ctr);
+      $display("ctrl: 0x%01x, cnt: 0x%01x, ready: 0x%01x",
+               dut.poly1305_ctrl_reg, dut.cnt_reg, dut.ready_reg);
+      $display("acc:   0x%033x", dut.acc_reg);
+      $display("h:     0x%036x", dut.h_reg);
+      $display("prod:  0x%064x", dut.prod_reg);
+      $display("");
+    end
+  endtask // dump_dut_state
+
+
+  //----------------------------------------------------------------
+  // reset_dut()
+  //
+  // Toggle reset to put the DUT into a well known state.
+  //----------------------------------------------------------------
+  task reset_dut;
+    begin
+      $display("*** Toggle reset.");
+      tb_reset_n = 0;
+
+      #(2 * CLK_PERIOD);
+      tb_reset_n = 1;
+      $display("");
+    end
+  endtask // reset_dut
+
+
+  //----------------------------------------------------------------
+  // display_test_results()
+  //
+  // Display the accumulated test results.
+  //----------------------------------------------------------------
+  task display_test_results;
+    begin
+      if (error_ctr == 0)
+        begin
+          $display("*** All %02d test cases completed successfully", tc_ctr);
+        end
+      else
+        begin
+          $display("*** %02d tests completed - %02d test cases did not complete successfully.",
+                   tc_ctr, error_ctr);
+        end
+    end
+  endtask // display_test_results
+
+
+  //----------------------------------------------------------------
+  // init_sim()
+  //
+  // Initialize all counters and testbed functionality as well
+  // as setting the DUT inputs to defined values.
+  //----------------------------------------------------------------
+  task init_sim;
+    begin
+      cycle_ctr  = 0;
+      error_ctr  = 0;
+      tc_ctr     = 0;
+
+      tb_clk     = 0;
+      tb_reset_n = 1;
+
+      tb_init    = 0;
+      tb_next    = 0;
+      tb_finish  = 0;
+      tb_r       = 128'h0;
+      tb_s       = 128'h0;
+      tb_block   = 129'h0;
+    end
+  endtask // init_sim
+
+
+  //----------------------------------------------------------------
+  // wait_ready()
+  //
+  // Wait for the ready flag in the DUT to be set.
+  //----------------------------------------------------------------
+  task wait_ready;
+    begin
+      #(2 * CLK_PERIOD);
+      while (!tb_ready)
+        begin
+          #(CLK_PERIOD);
+        end
+    end
+  endtask // wait_ready
+
+
+  //----------------------------------------------------------------
+  // process_block()
+  //
+  // Feed one block to the DUT and wait for it to be processed.
+  //----------------------------------------------------------------
+  task process_block(input [128 : 0] block);
+    begin
+      tb_block = block;
+      tb_next  = 1;
+      #(CLK_PERIOD);
+      tb_next  = 0;
+      wait_ready();
+    end
+  endtask // process_block
+
+
+  //----------------------------------------------------------------
+  // rfc8439_test()
+  //
+  // The Poly1305 example in RFC 8439, section 2.5.2. The key and
+  // the tag are given as little endian integers, and the message
+  // "Cryptographic Forum Research Group" as three blocks including
+  // the pad bit.
+  //----------------------------------------------------------------
+  task rfc8439_test;
+    begin : rfc8439_test
+      reg [31 : 0]  start_cycle;
+      reg [127 : 0] expected;
+
+      expected = 128'ha927010caf8b2bc2c6365130c11d06a8;
+
+      tc_ctr = tc_ctr + 1;
+      $display("*** TC 1: RFC 8439 2.5.2 started.");
+
+      tb_r    = 128'ha806d542fe52447f336d555778bed685;
+      tb_s    = 128'h1bf54941aff6bf4afdb20dfb8a800301;
+      tb_init = 1;
+      #(CLK_PERIOD);
+      tb_init = 0;
+      wait_ready();
+
+      start_cycle = cycle_ctr;
+      process_block(129'h16f4620636968706172676f7470797243);
+      $display("*** One block took %0d cycles.", cycle_ctr - start_cycle);
+      process_block(129'h16f7247206863726165736552206d7572);
+      process_block(129'h000000000000000000000000000017075);
+
+      tb_finish = 1;
+      #(CLK_PERIOD);
+      tb_finish = 0;
+      wait_ready();
+
+      if (tb_tag == expected)
+        $display("*** TC 1 successful.");
+      else
+        begin
+          $display("*** ERROR: TC 1 NOT successful.");
+          $display("Expected: 0x%032x", expected);
+          $display("Got:      0x%032x", tb_tag);
+          error_ctr = error_ctr + 1;
+        end
+      $display("");
+    end
+  endtask // rfc8439_test
+
+
+  //----------------------------------------------------------------
+  // poly1305_test()
+  //
+  // Run up to four blocks, first block in the MSBs and each with
+  // its pad bit, through the DUT and check the tag.
+  //----------------------------------------------------------------
+  task poly1305_test(input [7 : 0]   tc_number,
+                     input [127 : 0] r,
+                     input [127 : 0] s,
+                     input [2 : 0]   num_blocks,
+                     input [515 : 0] blocks,
+                     input [127 : 0] expected);
+    begin : poly1305_test
+      integer i;
+
+      tc_ctr = tc_ctr + 1;
+      $display("*** TC %0d: RFC 8439 A.3 vector %0d started.", tc_number, tc_number + 3);
+
+      tb_r    = r;
+      tb_s    = s;
+      tb_init = 1;
+      #(CLK_PERIOD);
+      tb_init = 0;
+      wait_ready();
+
+      for (i = 0 ; i < num_blocks ; i = i + 1)
+        process_block(blocks[(515 - 129 * i) -: 129]);
+
+      tb_finish = 1;
+      #(CLK_PERIOD);
+      tb_finish = 0;
+      wait_ready();
+
+      if (tb_tag == expected)
+        $display("*** TC %0d successful.", tc_number);
+      else
+        begin
+          $display("*** ERROR: TC %0d NOT successful.", tc_number);
+          $display("Expected: 0x%032x", expected);
+          $display("Got:      0x%032x", tb_tag);
+          error_ctr = error_ctr + 1;
+        end
+      $display("");
+    end
+  endtask // poly1305_test
+
+
+  //----------------------------------------------------------------
+  // rfc8439_a3_tests()
+  //
+  // The Poly1305 test vectors 5 to 11 in RFC 8439, appendix A.3.
+  // They hit the corner cases of the reduction modulo 2^130 - 5 and
+  // of the final addition of s.
+  //----------------------------------------------------------------
+  task rfc8439_a3_tests;
+    begin
+      poly1305_test(8'd2, 128'h2, 128'h0, 3'd1,
+                    {129'h1ffffffffffffffffffffffffffffffff, 387'h0},
+                    128'h3);
+
+      poly1305_test(8'd3, 128'h2, 128'hffffffffffffffffffffffffffffffff, 3'd1,
+                    {129'h100000000000000000000000000000002, 387'h0},
+                    128'h3);
+
+      poly1305_test(8'd4, 128'h1, 128'h0, 3'd3,
+                    {129'h1ffffffffffffffffffffffffffffffff,
+                     129'h1fffffffffffffffffffffffffffffff0,
+                     129'h100000000000000000000000000000011, 129'h0},
+                    128'h5);
+
+      poly1305_test(8'd5, 128'h1, 128'h0, 3'd3,
+                    {129'h1ffffffffffffffffffffffffffffffff,
+                     129'h1fefefefefefefefefefefefefefefefb,
+                     129'h101010101010101010101010101010101, 129'h0},
+                    128'h0);
+
+      poly1305_test(8'd6, 128'h2, 128'h0, 3'd1,
+                    {129'h1fffffffffffffffffffffffffffffffd, 387'h0},
+                    128'hfffffffffffffffffffffffffffffffa);
+
+      poly1305_test(8'd7, 128'h00000000000000040000000000000001, 128'h0, 3'd4,
+                    {129'h10000000000000000b9435e50d79435e3,
+                     129'h10000000000000001cd79435e50d79433,
+                     129'h100000000000000000000000000000000,
+                     129'h100000000000000000000000000000001},
+                    128'h00000000000000550000000000000014);
+
+      poly1305_test(8'd8, 128'h00000000000000040000000000000001, 128'h0, 3'd3,
+                    {129'h10000000000000000b9435e50d79435e3,
+                     129'h10000000000000001cd79435e50d79433,
+                     129'h100000000000000000000000000000000, 129'h0},
+                    128'h13);
+    end
+  endtask // rfc8439_a3_tests
+
+
+  //----------------------------------------------------------------
+  // poly1305_core_test
+  //
+  // The main test functionality.
+  //----------------------------------------------------------------
+  initial
+    begin : poly1305_core_test
+      $display("   -= Testbench for Poly1305 core started =-");
+      $display("     =====================================");
+      $display("");
+
+      init_sim();
+      reset_dut();
+
+      rfc8439_test();
+      rfc8439_a3_tests();
+
+      display_test_results();
+
+      $display("");
+      $display("*** Poly1305 core simulation done. ***");
+      $finish;
+    end // poly1305_core_test
+endmodule // tb_poly1305_core
+
+//======================================================================
+// EOF tb_poly1305_core.v
+//======================================================================
@@ -0,0 +1,306 @@
+//======================================================================
+//
+// keywrap.v
+// ---------
+// Top level wrapper for the AES key wrap core. The host loads the
+// KEK, the data to wrap or unwrap into the data memory and the initial
+// value of A, starts the core once and reads back A and the memory
+// when it is done.
+//
+// Address map (address[10]):
+//   0: registers
+//   1: data memory, address[9:1] is the 64 bit block, address[0]
+//      selects the high (0) or low (1) word of the block
+//
+//
+// Copyright (c) 2016, NORDUnet A/S
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// - Neither the name of the NORDUnet nor the names of its contributors may
+//   be used to endorse or promote products derived from this software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+module keywrap(
+               // Clock and reset.
+               input wire           clk,
+               input wire           reset_n,
+
+               // Control.
+               input wire           cs,
+               input wire           we,
+
+               // Data ports.
+               input wire  [10 : 0] address,
+               input wire  [31 : 0] write_data,
+               output wire [31 : 0] read_data
+              );
+
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  localparam MEM_BITS         = 9;
+
+  localparam ADDR_NAME0       = 8'h00;
+  localparam ADDR_NAME1       = 8'h01;
+  localparam ADDR_VERSION     = 8'h02;
+
+  localparam ADDR_CTRL        = 8'h08;
+  localparam CTRL_INIT_BIT    = 0;
+  localparam CTRL_NEXT_BIT    = 1;
+
+  localparam ADDR_STATUS      = 8'h09;
+  localparam STATUS_READY_BIT = 0;
+  localparam STATUS_VALID_BIT = 1;
+
+  localparam ADDR_CONFIG      = 8'h0a;
+  localparam CTRL_ENCDEC_BIT  = 0;
+  localparam CTRL_KEYLEN_BIT  = 1;
+
+  localparam ADDR_RLEN        = 8'h0b;
+  localparam ADDR_A0          = 8'h0c;
+  localparam ADDR_A1          = 8'h0d;
+
+  localparam ADDR_KEY0        = 8'h10;
+  localparam ADDR_KEY7        = 8'h17;
+
+  localparam CORE_NAME0       = 32'h6b657920; // "key "
+  localparam CORE_NAME1       = 32'h77726170; // "wrap"
+  localparam CORE_VERSION     = 32'h302e3130; // "0.10"
+
+
+  //----------------------------------------------------------------
+  // Registers including update variables and write enable.
+  //----------------------------------------------------------------
+  reg init_reg;
+  reg init_new;
+
+  reg next_reg;
+  reg next_new;
+
+  reg encdec_reg;
+  reg keylen_reg;
+  reg config_we;
+
+  reg [MEM_BITS : 0] rlen_reg;
+  reg                rlen_we;
+
+  reg [31 : 0] a_reg [0 : 1];
+  reg          a_we;
+
+  reg [31 : 0] key_reg [0 : 7];
+  reg          key_we;
+
+  reg [31 : 0] read_data_reg;
+  reg          mem_read_reg;
+
+
+  //----------------------------------------------------------------
+  // Wires.
+  //----------------------------------------------------------------
+  reg [31 : 0]   tmp_read_data;
+  reg            mem_we;
+
+  wire           core_ready;
+  wire           core_valid;
+  wire           core_busy;
+  wire [255 : 0] core_key;
+  wire [63 : 0]  core_a_init;
+  wire [63 : 0]  core_a_result;
+  wire [31 : 0]  core_api_rd_data;
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity for ports etc.
+  //----------------------------------------------------------------
+  assign read_data = mem_read_reg ? core_api_rd_data : read_data_reg;
+
+  assign core_key = {key_reg[0], key_reg[1], key_reg[2], key_reg[3],
+                     key_reg[4], key_reg[5], key_reg[6], key_reg[7]};
+
+  assign core_a_init = {a_reg[0], a_reg[1]};
+
+
+  //----------------------------------------------------------------
+  // core instantiation.
+  //----------------------------------------------------------------
+  keywrap_core #(.MEM_BITS(MEM_BITS))
+               core(
+                    .clk(clk),
+                    .reset_n(reset_n),
+
+                    .init(init_reg),
+                    .next(next_reg),
+                    .encdec(encdec_reg),
+                    .ready(core_ready),
+                    .valid(core_valid),
+                    .busy(core_busy),
+
+                    .key(core_key),
+                    .keylen(keylen_reg),
+
+                    .rlen(rlen_reg),
+
+                    .a_init(core_a_init),
+                    .a_result(core_a_result),
+
+                    .api_we(mem_we),
+                    .api_addr(address[MEM_BITS : 0]),
+                    .api_wr_data(write_data),
+                    .api_rd_data(core_api_rd_data)
+                   );
+
+
+  //----------------------------------------------------------------
+  // reg_update
+  // Update functionality for all registers in the core.
+  // All registers are positive edge triggered with asynchronous
+  // active low reset.
+  //----------------------------------------------------------------
+  always @ (posedge clk or negedge reset_n)
+    begin : reg_update
+      integer i;
+
+      if (!reset_n)
+        begin
+          for (i = 0 ; i < 8 ; i = i + 1)
+            key_reg[i] <= 32'h0;
+
+          a_reg[0]      <= 32'h0;
+          a_reg[1]      <= 32'h0;
+          init_reg      <= 1'b0;
+          next_reg      <= 1'b0;
+          encdec_reg    <= 1'b0;
+          keylen_reg    <= 1'b0;
+          rlen_reg      <= 1;
+          read_data_reg <= 32'h0;
+          mem_read_reg  <= 1'b0;
+        end
+      else
+        begin
+          init_reg     <= init_new;
+          next_reg     <= next_new;
+          mem_read_reg <= cs && !we && address[10];
+
+          if (cs && !we)
+            read_data_reg <= tmp_read_data;
+
+          if (config_we)
+            begin
+              encdec_reg <= write_data[CTRL_ENCDEC_BIT];
+              keylen_reg <= write_data[CTRL_KEYLEN_BIT];
+            end
+
+          if (rlen_we)
+            rlen_reg <= write_data[MEM_BITS : 0];
+
+          if (a_we)
+            a_reg[address[0]] <= write_data;
+
+          if (key_we)
+            key_reg[address[2 : 0]] <= write_data;
+        end
+    end // reg_update
+
+
+  //----------------------------------------------------------------
+  // api
+  //
+  // The interface command decoding logic. Reads are registered,
+  // the data is available the cycle after cs. Nothing can be
+  // written while the core is running.
+  //----------------------------------------------------------------
+  always @*
+    begin : api
+      init_new      = 1'b0;
+      next_new      = 1'b0;
+      config_we     = 1'b0;
+      rlen_we       = 1'b0;
+      a_we          = 1'b0;
+      key_we        = 1'b0;
+      mem_we        = 1'b0;
+      tmp_read_data = 32'h0;
+
+      if (cs)
+        begin
+          if (we)
+            begin
+              if (!core_busy)
+                begin
+                  if (address[10])
+                    mem_we = 1'b1;
+
+                  else
+                    begin
+                      if (address[7 : 0] == ADDR_CTRL)
+                        begin
+                          init_new = write_data[CTRL_INIT_BIT];
+                          next_new = write_data[CTRL_NEXT_BIT];
+                        end
+
+                      if (address[7 : 0] == ADDR_CONFIG)
+                        config_we = 1'b1;
+
+                      if ((address[7 : 0] == ADDR_RLEN) &&
+                          (write_data[31 : MEM_BITS + 1] == 0) &&
+                          (write_data[MEM_BITS : 0] != 0))
+                        rlen_we = 1'b1;
+
+                      if ((address[7 : 0] == ADDR_A0) || (address[7 : 0] == ADDR_A1))
+                        a_we = 1'b1;
+
+                      if ((address[7 : 0] >= ADDR_KEY0) && (address[7 : 0] <= ADDR_KEY7))
+                        key_we = 1'b1;
+                    end
+                end
+            end // if (we)
+
+          else
+            begin
+              case (address[7 : 0])
+                ADDR_NAME0:   tmp_read_data = CORE_NAME0;
+                ADDR_NAME1:   tmp_read_data = CORE_NAME1;
+                ADDR_VERSION: tmp_read_data = CORE_VERSION;
+                ADDR_CTRL:    tmp_read_data = {30'h0, next_reg, init_reg};
+                ADDR_STATUS:  tmp_read_data = {30'h0, core_valid, core_ready};
+                ADDR_CONFIG:  tmp_read_data = {30'h0, keylen_reg, encdec_reg};
+                ADDR_RLEN:    tmp_read_data = rlen_reg;
+                ADDR_A0:      tmp_read_data = core_a_result[63 : 32];
+                ADDR_A1:      tmp_read_data = core_a_result[31 : 0];
+
+                default:
+                  begin
+                  end
+              endcase // case (address[7 : 0])
+            end
+        end
+    end // api
+endmodule // keywrap
+
+//======================================================================
+// EOF keywrap.v
+//======================================================================
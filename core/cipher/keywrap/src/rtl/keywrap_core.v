@@ -0,0 +1,434 @@
+//======================================================================
+//
+// keywrap_core.v
+// --------------
+// AES key wrap core. Runs the wrapping function W and its inverse
+// from RFC 3394, which RFC 5649 builds on, over data held in the
+// core's memory, using an AES core for the block operations.
+//
+// The data is n 64 bit blocks R[1..n] in memory plus the 64 bit
+// integrity check register A. Wrapping does 6n block encryptions,
+// unwrapping 6n decryptions. With n == 1 a single block operation on
+// A | R[1] is done, as RFC 5649 specifies for short keys.
+//
+// Padding, the alternative IV and the integrity check of the result
+// are left to the host, which knows the length of the key.
+//
+//
+// Copyright (c) 2016, NORDUnet A/S
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// - Neither the name of the NORDUnet nor the names of its contributors may
+//   be used to endorse or promote products derived from this software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+module keywrap_core #(parameter MEM_BITS = 9)
+                    (
+                     input wire                      clk,
+                     input wire                      reset_n,
+
+                     input wire                      init,
+                     input wire                      next,
+                     input wire                      encdec,
+                     output wire                     ready,
+                     output wire                     valid,
+                     output wire                     busy,
+
+                     input wire [255 : 0]            key,
+                     input wire                      keylen,
+
+                     input wire [MEM_BITS : 0]       rlen,
+
+                     input wire [63 : 0]             a_init,
+                     output wire [63 : 0]            a_result,
+
+                     input wire                      api_we,
+                     input wire [MEM_BITS : 0]       api_addr,
+                     input wire [31 : 0]             api_wr_data,
+                     output wire [31 : 0]            api_rd_data
+                    );
+
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  localparam MEM_SIZE   = 1 << MEM_BITS;
+
+  localparam CTRL_IDLE  = 3'h0;
+  localparam CTRL_INIT  = 3'h1;
+  localparam CTRL_READ  = 3'h2;
+  localparam CTRL_LOAD  = 3'h3;
+  localparam CTRL_NEXT  = 3'h4;
+  localparam CTRL_WAIT  = 3'h5;
+
+
+  //----------------------------------------------------------------
+  // Registers including update variables and write enable.
+  //----------------------------------------------------------------
+  reg [31 : 0]  mem_hi [0 : (MEM_SIZE - 1)];
+  reg [31 : 0]  mem_lo [0 : (MEM_SIZE - 1)];
+  reg [31 : 0]  mem_hi_rd_reg;
+  reg [31 : 0]  mem_lo_rd_reg;
+  reg           api_lo_reg;
+
+  reg [63 : 0]  a_reg;
+  reg [63 : 0]  a_new;
+  reg           a_we;
+
+  reg [127 : 0] block_reg;
+  reg [127 : 0] block_new;
+  reg           block_we;
+
+  reg [(MEM_BITS - 1) : 0] idx_reg;
+  reg [(MEM_BITS - 1) : 0] idx_new;
+  reg                      idx_we;
+
+  reg [(MEM_BITS + 3) : 0] t_reg;
+  reg [(MEM_BITS + 3) : 0] t_new;
+  reg                      t_we;
+
+  reg           ready_reg;
+  reg           ready_new;
+  reg           ready_we;
+
+  reg           valid_reg;
+  reg           valid_new;
+  reg           valid_we;
+
+  reg [2 : 0]   keywrap_ctrl_reg;
+  reg [2 : 0]   keywrap_ctrl_new;
+  reg           keywrap_ctrl_we;
+
+
+  //----------------------------------------------------------------
+  // Wires.
+  //----------------------------------------------------------------
+  reg                      core_init;
+  reg                      core_next;
+  wire                     core_ready;
+  wire [127 : 0]           core_result;
+
+  reg                      mem_we;
+  reg [(MEM_BITS - 1) : 0] mem_addr;
+  reg [31 : 0]             mem_hi_wr_data;
+  reg [31 : 0]             mem_lo_wr_data;
+  reg                      mem_hi_we;
+  reg                      mem_lo_we;
+
+  wire [(MEM_BITS + 3) : 0] t_max;
+  wire [(MEM_BITS - 1) : 0] idx_last;
+  wire                      single;
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity for ports etc.
+  //----------------------------------------------------------------
+  assign ready       = ready_reg;
+  assign valid       = valid_reg;
+  assign a_result    = a_reg;
+  assign api_rd_data = api_lo_reg ? mem_lo_rd_reg : mem_hi_rd_reg;
+
+  // 6n steps, from t = 1 to t = 6n.
+  assign t_max    = {rlen, 2'b00} + {rlen, 1'b0};
+  assign idx_last = rlen - 1'b1;
+  assign single   = (rlen == 1);
+  assign busy     = (keywrap_ctrl_reg != CTRL_IDLE);
+
+
+  //----------------------------------------------------------------
+  // core instantiation.
+  //----------------------------------------------------------------
+  aes_core #(.SLOT_BITS(1))
+           aes(
+               .clk(clk),
+               .reset_n(reset_n),
+
+               .encdec(encdec),
+               .init(core_init),
+               .next(core_next),
+               .erase(1'b0),
+               .ready(core_ready),
+
+               .key(key),
+               .keylen(keylen),
+               .key_slot(1'b0),
+
+               .block(block_reg),
+               .result(core_result),
+               .result_valid()
+              );
+
+
+  //----------------------------------------------------------------
+  // reg_update
+  //
+  // Update functionality for all registers in the core.
+  // All registers are positive edge triggered with asynchronous
+  // active low reset.
+  //----------------------------------------------------------------
+  always @ (posedge clk or negedge reset_n)
+    begin : reg_update
+      if (!reset_n)
+        begin
+          a_reg            <= 64'h0;
+          block_reg        <= 128'h0;
+          idx_reg          <= {MEM_BITS{1'b0}};
+          t_reg            <= {(MEM_BITS + 4){1'b0}};
+          ready_reg        <= 1'b0;
+          valid_reg        <= 1'b0;
+          keywrap_ctrl_reg <= CTRL_IDLE;
+        end
+      else
+        begin
+          if (a_we)
+            a_reg <= a_new;
+
+          if (block_we)
+            block_reg <= block_new;
+
+          if (idx_we)
+            idx_reg <= idx_new;
+
+          if (t_we)
+            t_reg <= t_new;
+
+          if (ready_we)
+            ready_reg <= ready_new;
+
+          if (valid_we)
+            valid_reg <= valid_new;
+
+          if (keywrap_ctrl_we)
+            keywrap_ctrl_reg <= keywrap_ctrl_new;
+        end
+    end // reg_update
+
+
+  //----------------------------------------------------------------
+  // mem_update
+  //
+  // The data memory, as two 32 bit wide banks holding the high and
+  // low halves of every 64 bit block. Each bank has a single port,
+  // used by the host when the core is idle and by the FSM when
+  // it is running.
+  //----------------------------------------------------------------
+  always @ (posedge clk)
+    begin : mem_update
+      if (mem_hi_we)
+        mem_hi[mem_addr] <= mem_hi_wr_data;
+
+      if (mem_lo_we)
+        mem_lo[mem_addr] <= mem_lo_wr_data;
+
+      mem_hi_rd_reg <= mem_hi[mem_addr];
+      mem_lo_rd_reg <= mem_lo[mem_addr];
+      api_lo_reg    <= api_addr[0];
+    end // mem_update
+
+
+  //----------------------------------------------------------------
+  // mem_mux
+  //
+  // Gives the memory port to the host or to the FSM.
+  //----------------------------------------------------------------
+  always @*
+    begin : mem_mux
+      if (busy)
+        begin
+          mem_addr       = idx_reg;
+          mem_hi_wr_data = core_result[63 : 32];
+          mem_lo_wr_data = core_result[31 : 0];
+          mem_hi_we      = mem_we;
+          mem_lo_we      = mem_we;
+        end
+      else
+        begin
+          mem_addr       = api_addr[MEM_BITS : 1];
+          mem_hi_wr_data = api_wr_data;
+          mem_lo_wr_data = api_wr_data;
+          mem_hi_we      = api_we && !api_addr[0];
+          mem_lo_we      = api_we && api_addr[0];
+        end
+    end // mem_mux
+
+
+  //----------------------------------------------------------------
+  // keywrap_ctrl
+  //
+  // The wrapping loop. Each step reads R[i] from memory, runs
+  // A | R[i] through the AES core and writes the low half of the
+  // result back to R[i]. The step counter t is XORed into A after
+  // encryption when wrapping and before decryption when unwrapping.
+  //----------------------------------------------------------------
+  always @*
+    begin : keywrap_ctrl
+      core_init        = 1'b0;
+      core_next        = 1'b0;
+      mem_we           = 1'b0;
+      a_new            = 64'h0;
+      a_we             = 1'b0;
+      block_new        = 128'h0;
+      block_we         = 1'b0;
+      idx_new          = {MEM_BITS{1'b0}};
+      idx_we           = 1'b0;
+      t_new            = {(MEM_BITS + 4){1'b0}};
+      t_we             = 1'b0;
+      ready_new        = 1'b0;
+      ready_we         = 1'b0;
+      valid_new        = 1'b0;
+      valid_we         = 1'b0;
+      keywrap_ctrl_new = CTRL_IDLE;
+      keywrap_ctrl_we  = 1'b0;
+
+      case (keywrap_ctrl_reg)
+        CTRL_IDLE:
+          begin
+            if (init)
+              begin
+                core_init        = 1'b1;
+                ready_new        = 1'b0;
+                ready_we         = 1'b1;
+                valid_new        = 1'b0;
+                valid_we         = 1'b1;
+                keywrap_ctrl_new = CTRL_INIT;
+                keywrap_ctrl_we  = 1'b1;
+              end
+
+            else if (next && ready_reg)
+              begin
+                a_new            = a_init;
+                a_we             = 1'b1;
+                ready_new        = 1'b0;
+                ready_we         = 1'b1;
+                valid_new        = 1'b0;
+                valid_we         = 1'b1;
+                keywrap_ctrl_new = CTRL_READ;
+                keywrap_ctrl_we  = 1'b1;
+
+                if (encdec)
+                  begin
+                    idx_new = {MEM_BITS{1'b0}};
+                    t_new   = 1;
+                  end
+                else
+                  begin
+                    idx_new = idx_last;
+                    t_new   = t_max;
+                  end
+                idx_we = 1'b1;
+                t_we   = 1'b1;
+              end
+          end
+
+        CTRL_INIT:
+          begin
+            if (core_ready)
+              begin
+                ready_new        = 1'b1;
+                ready_we         = 1'b1;
+                keywrap_ctrl_new = CTRL_IDLE;
+                keywrap_ctrl_we  = 1'b1;
+              end
+          end
+
+        CTRL_READ:
+          begin
+            // Memory read of R[i] in progress.
+            keywrap_ctrl_new = CTRL_LOAD;
+            keywrap_ctrl_we  = 1'b1;
+          end
+
+        CTRL_LOAD:
+          begin
+            if (encdec || single)
+              block_new = {a_reg, mem_hi_rd_reg, mem_lo_rd_reg};
+            else
+              block_new = {a_reg ^ t_reg, mem_hi_rd_reg, mem_lo_rd_reg};
+            block_we         = 1'b1;
+            keywrap_ctrl_new = CTRL_NEXT;
+            keywrap_ctrl_we  = 1'b1;
+          end
+
+        CTRL_NEXT:
+          begin
+            core_next        = 1'b1;
+            keywrap_ctrl_new = CTRL_WAIT;
+            keywrap_ctrl_we  = 1'b1;
+          end
+
+        CTRL_WAIT:
+          begin
+            if (core_ready)
+              begin
+                mem_we = 1'b1;
+                a_we   = 1'b1;
+                if (encdec && !single)
+                  a_new = core_result[127 : 64] ^ t_reg;
+                else
+                  a_new = core_result[127 : 64];
+
+                if (single || (encdec && (t_reg == t_max)) || (!encdec && (t_reg == 1)))
+                  begin
+                    ready_new        = 1'b1;
+                    ready_we         = 1'b1;
+                    valid_new        = 1'b1;
+                    valid_we         = 1'b1;
+                    keywrap_ctrl_new = CTRL_IDLE;
+                    keywrap_ctrl_we  = 1'b1;
+                  end
+                else
+                  begin
+                    t_we   = 1'b1;
+                    idx_we = 1'b1;
+                    if (encdec)
+                      begin
+                        t_new   = t_reg + 1'b1;
+                        idx_new = (idx_reg == idx_last) ? {MEM_BITS{1'b0}} : idx_reg + 1'b1;
+                      end
+                    else
+                      begin
+                        t_new   = t_reg - 1'b1;
+                        idx_new = (idx_reg == 0) ? idx_last : idx_reg - 1'b1;
+                      end
+                    keywrap_ctrl_new = CTRL_READ;
+                    keywrap_ctrl_we  = 1'b1;
+                  end
+              end
+          end
+
+        default:
+          begin
+            keywrap_ctrl_new = CTRL_IDLE;
+            keywrap_ctrl_we  = 1'b1;
+          end
+      endcase // case (keywrap_ctrl_reg)
+    end // keywrap_ctrl
+endmodule // keywrap_core
+
+//======================================================================
+// EOF keywrap_core.v
+//======================================================================
@@ -0,0 +1,474 @@
+//======================================================================
+//
+// tb_keywrap.v
+// ------------
+// Testbench for the AES key wrap core top level wrapper, using the
+// RFC 3394 test vectors.
+//
+//
+// Copyright (c) 2016, NORDUnet A/S
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// - Neither the name of the NORDUnet nor the names of its contributors may
+//   be used to endorse or promote products derived from this software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+//------------------------------------------------------------------
+// Test module.
+//------------------------------------------------------------------
+module tb_keywrap();
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  parameter DEBUG     = 0;
+
+  parameter CLK_HALF_PERIOD = 1;
+  parameter CLK_PERIOD      = 2 * CLK_HALF_PERIOD;
+
+  // The DUT address map.
+  parameter ADDR_NAME0       = 11'h000;
+  parameter ADDR_NAME1       = 11'h001;
+  parameter ADDR_VERSION     = 11'h002;
+
+  parameter ADDR_CTRL        = 11'h008;
+  parameter CTRL_INIT        = 32'h1;
+  parameter CTRL_NEXT        = 32'h2;
+
+  parameter ADDR_STATUS      = 11'h009;
+  parameter STATUS_READY_BIT = 0;
+  parameter STATUS_VALID_BIT = 1;
+
+  parameter ADDR_CONFIG      = 11'h00a;
+  parameter ADDR_RLEN        = 11'h00b;
+  parameter ADDR_A0          = 11'h00c;
+  parameter ADDR_A1          = 11'h00d;
+
+  parameter ADDR_KEY0        = 11'h010;
+
+  parameter ADDR_MEM         = 11'h400;
+
+  parameter AES_128_BIT_KEY  = 0;
+  parameter AES_256_BIT_KEY  = 1;
+
+  parameter UNWRAP           = 0;
+  parameter WRAP             = 1;
+
+
+  //----------------------------------------------------------------
+  // Register and Wire declarations.
+  //----------------------------------------------------------------
+  reg [31 : 0]  cycle_ctr;
+  reg [31 : 0]  error_ctr;
+  reg [31 : 0]  tc_ctr;
+
+  reg [31 : 0]  read_data;
+
+  reg           tb_clk;
+  reg           tb_reset_n;
+  reg           tb_cs;
+  reg           tb_we;
+  reg [10 : 0]  tb_address;
+  reg [31 : 0]  tb_write_data;
+  wire [31 : 0] tb_read_data;
+
+
+  //----------------------------------------------------------------
+  // Device Under Test.
+  //----------------------------------------------------------------
+  keywrap dut(
+              .clk(tb_clk),
+              .reset_n(tb_reset_n),
+              .cs(tb_cs),
+              .we(tb_we),
+              .address(tb_address),
+              .write_data(tb_write_data),
+              .read_data(tb_read_data)
+             );
+
+
+  //----------------------------------------------------------------
+  // clk_gen
+  //
+  // Always running clock generator process.
+  //----------------------------------------------------------------
+  always
+    begin : clk_gen
+      #CLK_HALF_PERIOD;
+      tb_clk = !tb_clk;
+    end // clk_gen
+
+
+  //----------------------------------------------------------------
+  // sys_monitor()
+  //
+  // An always running process that creates a cycle counter and
+  // conditionally displays information about the DUT.
+  //----------------------------------------------------------------
+  always
+    begin : sys_monitor
+      cycle_ctr = cycle_ctr + 1;
+
+      #(CLK_PERIOD);
+
+      if (DEBUG)
+        begin
+          dump_dut_state();
+        end
+    end
+
+
+  //----------------------------------------------------------------
+  // dump_dut_state()
+  //
+  // Dump the state of the dump when needed.
+  //----------------------------------------------------------------
+  task dump_dut_state;
+    begin
+      $display("cycle: 0x%016x", cycle_ctr);
+      $display("State of DUT");
+      $display("------------");
+      $display("ctrl: 0x%01x, idx: 0x%03x, t: 0x%04x",
+               dut.core.keywrap_ctrl_reg, dut.core.idx_reg, dut.core.t_reg);
+      $display("a:     0x%016x", dut.core.a_reg);
+      $display("block: 0x%032x", dut.core.block_reg);
+      $display("");
+    end
+  endtask // dump_dut_state
+
+
+  //----------------------------------------------------------------
+  // reset_dut()
+  //
+  // Toggle reset to put the DUT into a well known state.
+  //----------------------------------------------------------------
+  task reset_dut;
+    begin
+      $display("*** Toggle reset.");
+      tb_reset_n = 0;
+
+      #(2 * CLK_PERIOD);
+      tb_reset_n = 1;
+      $display("");
+    end
+  endtask // reset_dut
+
+
+  //----------------------------------------------------------------
+  // display_test_results()
+  //
+  // Display the accumulated test results.
+  //----------------------------------------------------------------
+  task display_test_results;
+    begin
+      if (error_ctr == 0)
+        begin
+          $display("*** All %02d test cases completed successfully", tc_ctr);
+        end
+      else
+        begin
+          $display("*** %02d tests completed - %02d test cases did not complete successfully.",
+                   tc_ctr, error_ctr);
+        end
+    end
+  endtask // display_test_results
+
+
+  //----------------------------------------------------------------
+  // init_sim()
+  //
+  // Initialize all counters and testbed functionality as well
+  // as setting the DUT inputs to defined values.
+  //----------------------------------------------------------------
+  task init_sim;
+    begin
+      cycle_ctr     = 0;
+      error_ctr     = 0;
+      tc_ctr        = 0;
+
+      tb_clk        = 0;
+      tb_reset_n    = 1;
+
+      tb_cs         = 0;
+      tb_we         = 0;
+      tb_address    = 11'h0;
+      tb_write_data = 32'h0;
+    end
+  endtask // init_sim
+
+
+  //----------------------------------------------------------------
+  // write_word()
+  //
+  // Write the given word to the DUT using the DUT interface.
+  //----------------------------------------------------------------
+  task write_word(input [10 : 0] address,
+                  input [31 : 0] word);
+    begin
+      if (DEBUG)
+        begin
+          $display("*** Writing 0x%08x to 0x%03x.", word, address);
+          $display("");
+        end
+
+      tb_address = address;
+      tb_write_data = word;
+      tb_cs = 1;
+      tb_we = 1;
+      #(2 * CLK_PERIOD);
+      tb_cs = 0;
+      tb_we = 0;
+    end
+  endtask // write_word
+
+
+  //----------------------------------------------------------------
+  // read_word()
+  //
+  // Read a data word from the given address in the DUT.
+  // The read is registered in the DUT, the word is available
+  // after one cycle in the global variable read_data.
+  //----------------------------------------------------------------
+  task read_word(input [10 : 0] address);
+    begin
+      tb_address = address;
+      tb_cs = 1;
+      tb_we = 0;
+      #(CLK_PERIOD);
+      read_data = tb_read_data;
+      tb_cs = 0;
+
+      if (DEBUG)
+        begin
+          $display("*** Reading 0x%08x from 0x%03x.", read_data, address);
+          $display("");
+        end
+    end
+  endtask // read_word
+
+
+  //----------------------------------------------------------------
+  // wait_status()
+  //
+  // Wait for the given status bit to be set.
+  //----------------------------------------------------------------
+  task wait_status(input integer bit_no);
+    begin : wait_status
+      reg done;
+      done = 1'b0;
+
+      while (done != 1'b1)
+        begin
+          read_word(ADDR_STATUS);
+          done = read_data[bit_no];
+        end
+    end
+  endtask // wait_status
+
+
+  //----------------------------------------------------------------
+  // init_key()
+  //
+  // Write the KEK and let the core expand it.
+  //----------------------------------------------------------------
+  task init_key(input [255 : 0] key, input key_length);
+    begin
+      write_word(ADDR_KEY0 + 0, key[255 : 224]);
+      write_word(ADDR_KEY0 + 1, key[223 : 192]);
+      write_word(ADDR_KEY0 + 2, key[191 : 160]);
+      write_word(ADDR_KEY0 + 3, key[159 : 128]);
+      write_word(ADDR_KEY0 + 4, key[127 :  96]);
+      write_word(ADDR_KEY0 + 5, key[95  :  64]);
+      write_word(ADDR_KEY0 + 6, key[63  :  32]);
+      write_word(ADDR_KEY0 + 7, key[31  :   0]);
+
+      write_word(ADDR_CONFIG, {30'h0, key_length, 1'b0});
+      write_word(ADDR_CTRL, CTRL_INIT);
+      wait_status(STATUS_READY_BIT);
+    end
+  endtask // init_key
+
+
+  //----------------------------------------------------------------
+  // keywrap_test()
+  //
+  // Load A and n 64 bit blocks, run the core in the given
+  // direction and check A and the blocks against the expected
+  // values. Up to four blocks, most significant block first.
+  //----------------------------------------------------------------
+  task keywrap_test(input [7 : 0]   tc_number,
+                    input           encdec,
+                    input [255 : 0] key,
+                    input           key_length,
+                    input [2 : 0]   n,
+                    input [63 : 0]  a,
+                    input [255 : 0] data,
+                    input [63 : 0]  expected_a,
+                    input [255 : 0] expected_data);
+    begin : keywrap_test
+      integer i;
+      integer tc_errors;
+      reg [31 : 0]  start_cycle;
+      reg [63 : 0]  result_a;
+      reg [255 : 0] result_data;
+
+      tc_errors = 0;
+      tc_ctr = tc_ctr + 1;
+      $display("*** TC %0d %0s of %0d blocks started.", tc_number,
+               encdec ? "wrap" : "unwrap", n);
+
+      init_key(key, key_length);
+
+      write_word(ADDR_RLEN, n);
+      write_word(ADDR_A0, a[63 : 32]);
+      write_word(ADDR_A1, a[31 : 0]);
+      for (i = 0 ; i < n ; i = i + 1)
+        begin
+          write_word(ADDR_MEM + 2 * i,     data[(255 - 64 * i) -: 32]);
+          write_word(ADDR_MEM + 2 * i + 1, data[(223 - 64 * i) -: 32]);
+        end
+
+      write_word(ADDR_CONFIG, {30'h0, key_length, encdec});
+      start_cycle = cycle_ctr;
+      write_word(ADDR_CTRL, CTRL_NEXT);
+      wait_status(STATUS_VALID_BIT);
+      $display("*** Done after %0d cycles.", cycle_ctr - start_cycle);
+
+      read_word(ADDR_A0);
+      result_a[63 : 32] = read_data;
+      read_word(ADDR_A1);
+      result_a[31 : 0] = read_data;
+
+      result_data = 256'h0;
+      for (i = 0 ; i < n ; i = i + 1)
+        begin
+          read_word(ADDR_MEM + 2 * i);
+          result_data[(255 - 64 * i) -: 32] = read_data;
+          read_word(ADDR_MEM + 2 * i + 1);
+          result_data[(223 - 64 * i) -: 32] = read_data;
+        end
+
+      if (result_a != expected_a)
+        begin
+          $display("Error in A. Expected 0x%016x, got 0x%016x", expected_a, result_a);
+          tc_errors = tc_errors + 1;
+        end
+
+      if (result_data != expected_data)
+        begin
+          $display("Error in data.");
+          $display("Expected: 0x%064x", expected_data);
+          $display("Got:      0x%064x", result_data);
+          tc_errors = tc_errors + 1;
+        end
+
+      if (tc_errors == 0)
+        $display("*** TC %0d successful.", tc_number);
+      else
+        begin
+          $display("*** ERROR: TC %0d NOT successful.", tc_number);
+          error_ctr = error_ctr + 1;
+        end
+      $display("");
+    end
+  endtask // keywrap_test
+
+
+  //----------------------------------------------------------------
+  // rfc3394_tests()
+  //
+  // RFC 3394 4.1 and 4.6, wrap and unwrap, plus a single block
+  // operation as used by RFC 5649 for keys of up to 64 bits.
+  //----------------------------------------------------------------
+  task rfc3394_tests;
+    reg [255 : 0] kek128;
+    reg [255 : 0] kek256;
+    reg [63 : 0]  iv;
+
+    begin
+      kek128 = 256'h000102030405060708090a0b0c0d0e0f00000000000000000000000000000000;
+      kek256 = 256'h000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f;
+      iv     = 64'ha6a6a6a6a6a6a6a6;
+
+      $display("RFC 3394 key wrap tests");
+      $display("-----------------------");
+      keywrap_test(8'h01, WRAP, kek128, AES_128_BIT_KEY, 3'h2, iv,
+                   {128'h00112233445566778899aabbccddeeff, 128'h0},
+                   64'h1fa68b0a8112b447,
+                   {128'haef34bd8fb5a7b829d3e862371d2cfe5, 128'h0});
+
+      keywrap_test(8'h02, UNWRAP, kek128, AES_128_BIT_KEY, 3'h2, 64'h1fa68b0a8112b447,
+                   {128'haef34bd8fb5a7b829d3e862371d2cfe5, 128'h0},
+                   iv,
+                   {128'h00112233445566778899aabbccddeeff, 128'h0});
+
+      keywrap_test(8'h03, WRAP, kek256, AES_256_BIT_KEY, 3'h4, iv,
+                   256'h00112233445566778899aabbccddeeff000102030405060708090a0b0c0d0e0f,
+                   64'h28c9f404c4b810f4,
+                   256'hcbccb35cfb87f8263f5786e2d80ed326cbc7f0e71a99f43bfb988b9b7a02dd21);
+
+      keywrap_test(8'h04, UNWRAP, kek256, AES_256_BIT_KEY, 3'h4, 64'h28c9f404c4b810f4,
+                   256'hcbccb35cfb87f8263f5786e2d80ed326cbc7f0e71a99f43bfb988b9b7a02dd21,
+                   iv,
+                   256'h00112233445566778899aabbccddeeff000102030405060708090a0b0c0d0e0f);
+
+      keywrap_test(8'h05, WRAP, 256'hc03db3cc1416dcd1c069a195a8d77e3d00000000000000000000000000000000,
+                   AES_128_BIT_KEY, 3'h1, 64'ha65959a60000001f,
+                   {64'h46f87f58cdda4200, 192'h0},
+                   64'hd1bac797ff82fa4b,
+                   {64'hde9f7490729fd0a7, 192'h0});
+    end
+  endtask // rfc3394_tests
+
+
+  //----------------------------------------------------------------
+  // main
+  //
+  // The main test functionality.
+  //----------------------------------------------------------------
+  initial
+    begin : main
+      $display("   -= Testbench for keywrap started =-");
+      $display("    ==================================");
+      $display("");
+
+      init_sim();
+      reset_dut();
+
+      rfc3394_tests();
+
+      display_test_results();
+
+      $display("");
+      $display("*** Keywrap simulation done. ***");
+      $finish;
+    end // main
+endmodule // tb_keywrap
+
+//======================================================================
+// EOF tb_keywrap.v
+//======================================================================
@@ -0,0 +1,300 @@
+//======================================================================
+//
+// streebog.v
+// ----------
+// Top level wrapper for the GOST R 34.11-2012 (Streebog) hash
+// function providing a simple memory like interface with 32 bit
+// data access.
+//
+// The final block is given with the last control bit. The block
+// must already be padded by the host, and the number of message
+// bits in it must be written to ADDR_LAST_LEN first.
+//
+//
+// Copyright (c) 2016, NORDUnet A/S
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// - Neither the name of the NORDUnet nor the names of its contributors may
+//   be used to endorse or promote products derived from this software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+module streebog(
+                // Clock and reset.
+                input wire           clk,
+                input wire           reset_n,
+
+                // Control.
+                input wire           cs,
+                input wire           we,
+
+                // Data ports.
+                input wire  [7 : 0]  address,
+                input wire  [31 : 0] write_data,
+                output wire [31 : 0] read_data,
+                output wire          error
+               );
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  parameter ADDR_NAME0       = 8'h00;
+  parameter ADDR_NAME1       = 8'h01;
+  parameter ADDR_VERSION     = 8'h02;
+
+  parameter ADDR_CTRL        = 8'h08;
+  parameter CTRL_INIT_BIT    = 0;
+  parameter CTRL_NEXT_BIT    = 1;
+  parameter CTRL_LAST_BIT    = 2;
+  parameter CTRL_MODE_BIT    = 3;
+
+  parameter ADDR_STATUS      = 8'h09;
+  parameter STATUS_READY_BIT = 0;
+  parameter STATUS_VALID_BIT = 1;
+
+  parameter ADDR_LAST_LEN    = 8'h0a;
+
+  parameter ADDR_BLOCK0      = 8'h10;
+  parameter ADDR_BLOCK15     = 8'h1f;
+
+  parameter ADDR_DIGEST0     = 8'h40;
+  parameter ADDR_DIGEST15    = 8'h4f;
+
+  parameter CORE_NAME0       = 32'h73747265; // "stre"
+  parameter CORE_NAME1       = 32'h65626f67; // "ebog"
+  parameter CORE_VERSION     = 32'h302e3130; // "0.10"
+
+  parameter MODE_512         = 1'h0;
+  parameter MODE_256         = 1'h1;
+
+
+  //----------------------------------------------------------------
+  // Registers including update variables and write enable.
+  //----------------------------------------------------------------
+  reg init_reg;
+  reg init_new;
+
+  reg next_reg;
+  reg next_new;
+
+  reg last_reg;
+  reg last_new;
+
+  reg mode_reg;
+  reg mode_new;
+  reg mode_we;
+
+  reg [8 : 0] last_len_reg;
+  reg         last_len_we;
+
+  reg ready_reg;
+
+  reg [31 : 0] block_reg [0 : 15];
+  reg          block_we;
+
+  reg [511 : 0] digest_reg;
+  reg           digest_valid_reg;
+
+
+  //----------------------------------------------------------------
+  // Wires.
+  //----------------------------------------------------------------
+  wire           core_ready;
+  wire [511 : 0] core_block;
+  wire [511 : 0] core_digest;
+  wire           core_digest_valid;
+
+  reg [31 : 0]   tmp_read_data;
+  reg            tmp_error;
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity for ports etc.
+  //----------------------------------------------------------------
+  assign core_block = {block_reg[00], block_reg[01], block_reg[02], block_reg[03],
+                       block_reg[04], block_reg[05], block_reg[06], block_reg[07],
+                       block_reg[08], block_reg[09], block_reg[10], block_reg[11],
+                       block_reg[12], block_reg[13], block_reg[14], block_reg[15]};
+
+  assign read_data = tmp_read_data;
+  assign error     = tmp_error;
+
+
+  //----------------------------------------------------------------
+  // core instantiation.
+  //----------------------------------------------------------------
+  streebog_core core(
+                     .clk(clk),
+                     .reset_n(reset_n),
+
+                     .init(init_reg),
+                     .next(next_reg),
+                     .last(last_reg),
+                     .mode(mode_reg),
+
+                     .last_len(last_len_reg),
+                     .block(core_block),
+
+                     .ready(core_ready),
+
+                     .digest(core_digest),
+                     .digest_valid(core_digest_valid)
+                    );
+
+
+  //----------------------------------------------------------------
+  // reg_update
+  //
+  // Update functionality for all registers in the core.
+  // All registers are positive edge triggered with asynchronous
+  // active low reset. All registers have write enable.
+  //----------------------------------------------------------------
+  always @ (posedge clk or negedge reset_n)
+    begin : reg_update
+      integer i;
+
+      if (!reset_n)
+        begin
+          for (i = 0 ; i < 16 ; i = i + 1)
+            block_reg[i] <= 32'h0;
+
+          init_reg         <= 1'h0;
+          next_reg         <= 1'h0;
+          last_reg         <= 1'h0;
+          mode_reg         <= MODE_512;
+          last_len_reg     <= 9'h0;
+          ready_reg        <= 1'h0;
+          digest_reg       <= 512'h0;
+          digest_valid_reg <= 1'h0;
+        end
+      else
+        begin
+          ready_reg        <= core_ready;
+          digest_valid_reg <= core_digest_valid;
+          init_reg         <= init_new;
+          next_reg         <= next_new;
+          last_reg         <= last_new;
+
+          if (mode_we)
+            mode_reg <= mode_new;
+
+          if (last_len_we)
+            last_len_reg <= write_data[8 : 0];
+
+          if (core_digest_valid)
+            digest_reg <= core_digest;
+
+          if (block_we)
+            block_reg[address[3 : 0]] <= write_data;
+        end
+    end // reg_update
+
+
+  //----------------------------------------------------------------
+  // api_logic
+  //
+  // Implementation of the api logic. If cs is enabled will either
+  // try to write to or read from the internal registers.
+  //----------------------------------------------------------------
+  always @*
+    begin : api_logic
+      init_new      = 1'h0;
+      next_new      = 1'h0;
+      last_new      = 1'h0;
+      mode_new      = MODE_512;
+      mode_we       = 1'h0;
+      last_len_we   = 1'h0;
+      block_we      = 1'h0;
+      tmp_read_data = 32'h00000000;
+      tmp_error     = 1'h0;
+
+      if (cs)
+        begin
+          if (we)
+            begin
+              if (core_ready)
+                begin
+                  if ((address >= ADDR_BLOCK0) && (address <= ADDR_BLOCK15))
+                    block_we = 1'h1;
+
+                  case (address)
+                    ADDR_CTRL:
+                      begin
+                        init_new = write_data[CTRL_INIT_BIT];
+                        next_new = write_data[CTRL_NEXT_BIT];
+                        last_new = write_data[CTRL_LAST_BIT];
+                        mode_new = write_data[CTRL_MODE_BIT];
+                        mode_we  = 1'h1;
+                      end
+
+                    ADDR_LAST_LEN:
+                      last_len_we = 1'h1;
+
+                    default:
+                      if (!block_we)
+                        tmp_error = 1'h1;
+                  endcase // case (address)
+                end // if (core_ready)
+            end // if (we)
+
+          else
+            begin
+              if ((address >= ADDR_DIGEST0) && (address <= ADDR_DIGEST15))
+                tmp_read_data = digest_reg[(15 - (address - ADDR_DIGEST0)) * 32 +: 32];
+
+              else if ((address >= ADDR_BLOCK0) && (address <= ADDR_BLOCK15))
+                tmp_read_data = block_reg[address[3 : 0]];
+
+              else
+                case (address)
+                  ADDR_NAME0:
+                    tmp_read_data = CORE_NAME0;
+
+                  ADDR_NAME1:
+                    tmp_read_data = CORE_NAME1;
+
+                  ADDR_VERSION:
+                    tmp_read_data = CORE_VERSION;
+
+                  ADDR_CTRL:
+                    tmp_read_data = {28'h0000000, mode_reg, last_reg, next_reg, init_reg};
+
+                  ADDR_STATUS:
+                    tmp_read_data = {30'h00000000, digest_valid_reg, ready_reg};
+
+                  ADDR_LAST_LEN:
+                    tmp_read_data = {23'h000000, last_len_reg};
+
+                  default:
+                    tmp_error = 1'h1;
+                endcase // case (address)
+            end
+        end
+    end // api_logic
+endmodule // streebog
+
+//======================================================================
+// EOF streebog.v
+//======================================================================
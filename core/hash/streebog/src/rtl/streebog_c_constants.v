@@ -0,0 +1,121 @@
+//======================================================================
+//
+// streebog_c_constants.v
+// ----------------------
+// The iteration constants C1..C12 used in the key schedule
+// of the GOST R 34.11-2012 (Streebog) hash function. The constants
+// are given as little endian 512 bit integers, i.e. byte i of
+// the constant is bits [8i + 7 : 8i].
+//
+//
+// Copyright (c) 2016, NORDUnet A/S
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// - Neither the name of the NORDUnet nor the names of its contributors may
+//   be used to endorse or promote products derived from this software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+module streebog_c_constants(
+                            input wire  [3 : 0]   addr,
+                            output wire [511 : 0] C
+                           );
+
+  //----------------------------------------------------------------
+  // Wires.
+  //----------------------------------------------------------------
+  reg [511 : 0] tmp_C;
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity for ports etc.
+  //----------------------------------------------------------------
+  assign C = tmp_C;
+
+
+  //----------------------------------------------------------------
+  // addr_mux
+  //----------------------------------------------------------------
+  always @*
+    begin : addr_mux
+      case(addr)
+        0:
+          tmp_C = {256'hb1085bda1ecadae9ebcb2f81c0657c1f2f6a76432e45d016714eb88d7585c4fc,
+                   256'h4b7ce09192676901a2422a08a460d31505767436cc744d23dd806559f2a64507};
+
+        1:
+          tmp_C = {256'h6fa3b58aa99d2f1a4fe39d460f70b5d7f3feea720a232b9861d55e0f16b50131,
+                   256'h9ab5176b12d699585cb561c2db0aa7ca55dda21bd7cbcd56e679047021b19bb7};
+
+        2:
+          tmp_C = {256'hf574dcac2bce2fc70a39fc286a3d843506f15e5f529c1f8bf2ea7514b1297b7b,
+                   256'hd3e20fe490359eb1c1c93a376062db09c2b6f443867adb31991e96f50aba0ab2};
+
+        3:
+          tmp_C = {256'hef1fdfb3e81566d2f948e1a05d71e4dd488e857e335c3c7d9d721cad685e353f,
+                   256'ha9d72c82ed03d675d8b71333935203be3453eaa193e837f1220cbebc84e3d12e};
+
+        4:
+          tmp_C = {256'h4bea6bacad4747999a3f410c6ca923637f151c1f1686104a359e35d7800fffbd,
+                   256'hbfcd1747253af5a3dfff00b723271a167a56a27ea9ea63f5601758fd7c6cfe57};
+
+        5:
+          tmp_C = {256'hae4faeae1d3ad3d96fa4c33b7a3039c02d66c4f95142a46c187f9ab49af08ec6,
+                   256'hcffaa6b71c9ab7b40af21f66c2bec6b6bf71c57236904f35fa68407a46647d6e};
+
+        6:
+          tmp_C = {256'hf4c70e16eeaac5ec51ac86febf240954399ec6c7e6bf87c9d3473e33197a93c9,
+                   256'h0992abc52d822c3706476983284a05043517454ca23c4af38886564d3a14d493};
+
+        7:
+          tmp_C = {256'h9b1f5b424d93c9a703e7aa020c6e41414eb7f8719c36de1e89b4443b4ddbc49a,
+                   256'hf4892bcb929b069069d18d2bd1a5c42f36acc2355951a8d9a47f0dd4bf02e71e};
+
+        8:
+          tmp_C = {256'h378f5a541631229b944c9ad8ec165fde3a7d3a1b258942243cd955b7e00d0984,
+                   256'h800a440bdbb2ceb17b2b8a9aa6079c540e38dc92cb1f2a607261445183235adb};
+
+        9:
+          tmp_C = {256'habbedea680056f52382ae548b2e4f3f38941e71cff8a78db1fffe18a1b336103,
+                   256'h9fe76702af69334b7a1e6c303b7652f43698fad1153bb6c374b4c7fb98459ced};
+
+        10:
+          tmp_C = {256'h7bcd9ed0efc889fb3002c6cd635afe94d8fa6bbbebab07612001802114846679,
+                   256'h8a1d71efea48b9caefbacd1d7d476e98dea2594ac06fd85d6bcaa4cd81f32d1b};
+
+        11:
+          tmp_C = {256'h378ee767f11631bad21380b00449b17acda43c32bcdf1d77f82012d430219f9b,
+                   256'h5d80ef9d1891cc86e71da4aa88e12852faf417d5d9b21b9948bc924af11bd720};
+
+        default:
+          tmp_C = 512'h0;
+      endcase // case (addr)
+    end // addr_mux
+endmodule // streebog_c_constants
+
+//======================================================================
+// EOF streebog_c_constants.v
+//======================================================================
@@ -0,0 +1,549 @@
+//======================================================================
+//
+// streebog_core.v
+// ---------------
+// The GOST R 34.11-2012 (Streebog) hash function core. Supports
+// both the 256 and 512 bit digest variants.
+//
+// The core processes one 512 bit block at a time. The compression
+// function g_N(h, m) is computed with two LPS units, one for the
+// key schedule and one for the data path, which means that each of
+// the 12 rounds takes one cycle. A full block takes 14 cycles. The
+// final block triggers two more compressions, one for the length
+// counter N and one for the checksum Sigma.
+//
+// The block and digest ports use the same byte order as the bus:
+// the first byte of the block is in bits [511 : 504]. Internally
+// all values are kept as little endian integers, which is how the
+// standard defines the arithmetic on N and Sigma.
+//
+// The caller is responsible for padding the final block (a 0x01
+// byte following the message bytes, then zeros) and for giving
+// the number of message bits in the final block on last_len.
+//
+//
+// Copyright (c) 2016, NORDUnet A/S
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// - Neither the name of the NORDUnet nor the names of its contributors may
+//   be used to endorse or promote products derived from this software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+module streebog_core(
+                     input wire            clk,
+                     input wire            reset_n,
+
+                     input wire            init,
+                     input wire            next,
+                     input wire            last,
+                     input wire            mode,
+
+                     input wire [8 : 0]    last_len,
+                     input wire [511 : 0]  block,
+
+                     output wire           ready,
+
+                     output wire [511 : 0] digest,
+                     output wire           digest_valid
+                    );
+
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  localparam MODE_512 = 1'h0;
+  localparam MODE_256 = 1'h1;
+
+  localparam IV_512 = 512'h0;
+  localparam IV_256 = {64{8'h01}};
+
+  localparam NUM_ROUNDS = 12;
+
+  localparam PHASE_BLOCK = 2'h0;
+  localparam PHASE_N     = 2'h1;
+  localparam PHASE_SIGMA = 2'h2;
+
+  localparam CTRL_IDLE   = 2'h0;
+  localparam CTRL_KEY    = 2'h1;
+  localparam CTRL_ROUNDS = 2'h2;
+  localparam CTRL_FINISH = 2'h3;
+
+
+  //----------------------------------------------------------------
+  // Functions.
+  //----------------------------------------------------------------
+
+  // Reverse the byte order of a 512 bit word. Converts between
+  // the bus byte order and the internal little endian integers.
+  function [511 : 0] bswap512(input [511 : 0] x);
+    integer i;
+    begin
+      for (i = 0 ; i < 64 ; i = i + 1)
+        bswap512[i * 8 +: 8] = x[(63 - i) * 8 +: 8];
+    end
+  endfunction // bswap512
+
+
+  //----------------------------------------------------------------
+  // Registers including update variables and write enable.
+  //----------------------------------------------------------------
+  reg [511 : 0] h_reg;
+  reg [511 : 0] h_new;
+  reg           h_we;
+
+  reg [511 : 0] N_reg;
+  reg [511 : 0] N_new;
+  reg           N_we;
+
+  reg [511 : 0] sigma_reg;
+  reg [511 : 0] sigma_new;
+  reg           sigma_we;
+
+  reg [511 : 0] m_reg;
+  reg [511 : 0] m_new;
+  reg           m_we;
+
+  reg [511 : 0] K_reg;
+  reg [511 : 0] K_new;
+  reg           K_we;
+
+  reg [511 : 0] t_reg;
+  reg [511 : 0] t_new;
+  reg           t_we;
+
+  reg [9 : 0]   nbits_reg;
+  reg [9 : 0]   nbits_new;
+  reg           nbits_we;
+
+  reg           mode_reg;
+  reg           mode_we;
+
+  reg           last_reg;
+  reg           last_we;
+
+  reg [1 : 0]   phase_reg;
+  reg [1 : 0]   phase_new;
+  reg           phase_we;
+
+  reg [3 : 0]   round_ctr_reg;
+  reg [3 : 0]   round_ctr_new;
+  reg           round_ctr_we;
+  reg           round_ctr_inc;
+  reg           round_ctr_rst;
+
+  reg           ready_reg;
+  reg           ready_new;
+  reg           ready_we;
+
+  reg           digest_valid_reg;
+  reg           digest_valid_new;
+  reg           digest_valid_we;
+
+  reg [1 : 0]   streebog_ctrl_reg;
+  reg [1 : 0]   streebog_ctrl_new;
+  reg           streebog_ctrl_we;
+
+
+  //----------------------------------------------------------------
+  // Wires.
+  //----------------------------------------------------------------
+  reg            state_init;
+  reg            block_load;
+  reg            key_init;
+  reg            round_update;
+  reg            h_update;
+  reg            phase_update;
+
+  reg [511 : 0]  key_lps_x;
+  wire [511 : 0] key_lps_y;
+  wire [511 : 0] data_lps_y;
+  wire [511 : 0] c_data;
+
+  reg [511 : 0]  tmp_digest;
+
+
+  //----------------------------------------------------------------
+  // Module instantiantions.
+  //----------------------------------------------------------------
+  streebog_c_constants c_constants_inst(
+                                        .addr(round_ctr_reg),
+                                        .C(c_data)
+                                       );
+
+  streebog_lps key_lps_inst(
+                            .x(key_lps_x),
+                            .y(key_lps_y)
+                           );
+
+  streebog_lps data_lps_inst(
+                             .x(t_reg ^ K_reg),
+                             .y(data_lps_y)
+                            );
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity for ports etc.
+  //----------------------------------------------------------------
+  assign ready        = ready_reg;
+  assign digest       = tmp_digest;
+  assign digest_valid = digest_valid_reg;
+
+
+  //----------------------------------------------------------------
+  // reg_update
+  // Update functionality for all registers in the core.
+  // All registers are positive edge triggered with
+  // asynchronous active low reset.
+  //----------------------------------------------------------------
+  always @ (posedge clk or negedge reset_n)
+    begin : reg_update
+      if (!reset_n)
+        begin
+          h_reg             <= 512'h0;
+          N_reg             <= 512'h0;
+          sigma_reg         <= 512'h0;
+          m_reg             <= 512'h0;
+          K_reg             <= 512'h0;
+          t_reg             <= 512'h0;
+          nbits_reg         <= 10'h0;
+          mode_reg          <= MODE_512;
+          last_reg          <= 1'h0;
+          phase_reg         <= PHASE_BLOCK;
+          round_ctr_reg     <= 4'h0;
+          ready_reg         <= 1'h1;
+          digest_valid_reg  <= 1'h0;
+          streebog_ctrl_reg <= CTRL_IDLE;
+        end
+      else
+        begin
+          if (h_we)
+            h_reg <= h_new;
+
+          if (N_we)
+            N_reg <= N_new;
+
+          if (sigma_we)
+            sigma_reg <= sigma_new;
+
+          if (m_we)
+            m_reg <= m_new;
+
+          if (K_we)
+            K_reg <= K_new;
+
+          if (t_we)
+            t_reg <= t_new;
+
+          if (nbits_we)
+            nbits_reg <= nbits_new;
+
+          if (mode_we)
+            mode_reg <= mode;
+
+          if (last_we)
+            last_reg <= last;
+
+          if (phase_we)
+            phase_reg <= phase_new;
+
+          if (round_ctr_we)
+            round_ctr_reg <= round_ctr_new;
+
+          if (ready_we)
+            ready_reg <= ready_new;
+
+          if (digest_valid_we)
+            digest_valid_reg <= digest_valid_new;
+
+          if (streebog_ctrl_we)
+            streebog_ctrl_reg <= streebog_ctrl_new;
+        end
+    end // reg_update
+
+
+  //----------------------------------------------------------------
+  // digest_logic
+  //
+  // The 512 bit digest is all of h, the 256 bit digest is the
+  // most significant half of h. Both are given in bus byte order
+  // starting at the most significant bits of the port.
+  //----------------------------------------------------------------
+  always @*
+    begin : digest_logic
+      reg [511 : 0] h_bytes;
+
+      h_bytes = bswap512(h_reg);
+
+      if (mode_reg == MODE_256)
+        tmp_digest = {h_bytes[255 : 0], 256'h0};
+      else
+        tmp_digest = h_bytes;
+    end // digest_logic
+
+
+  //----------------------------------------------------------------
+  // state_logic
+  //
+  // Update logic for the chaining value h, the length counter N
+  // and the checksum Sigma.
+  //----------------------------------------------------------------
+  always @*
+    begin : state_logic
+      h_new     = 512'h0;
+      h_we      = 1'h0;
+      N_new     = 512'h0;
+      N_we      = 1'h0;
+      sigma_new = 512'h0;
+      sigma_we  = 1'h0;
+
+      if (state_init)
+        begin
+          if (mode == MODE_256)
+            h_new = IV_256;
+          else
+            h_new = IV_512;
+          h_we      = 1'h1;
+          N_we      = 1'h1;
+          sigma_we  = 1'h1;
+        end
+
+      // N and Sigma are only updated for message blocks,
+      // not for the compressions done during finalization.
+      if (key_init && (phase_reg == PHASE_BLOCK))
+        begin
+          N_new     = N_reg + {502'h0, nbits_reg};
+          N_we      = 1'h1;
+          sigma_new = sigma_reg + m_reg;
+          sigma_we  = 1'h1;
+        end
+
+      if (h_update)
+        begin
+          h_new = t_reg ^ K_reg ^ h_reg ^ m_reg;
+          h_we  = 1'h1;
+        end
+    end // state_logic
+
+
+  //----------------------------------------------------------------
+  // compress_logic
+  //
+  // The datapath for the compression function g_N(h, m):
+  //   K1 = LPS(h ^ N), t = m
+  //   for i in 1..12: t = LPS(t ^ Ki), Ki+1 = LPS(Ki ^ Ci)
+  //   h = t ^ K13 ^ h ^ m
+  // N is zero for the compressions done during finalization.
+  //----------------------------------------------------------------
+  always @*
+    begin : compress_logic
+      m_new     = 512'h0;
+      m_we      = 1'h0;
+      K_new     = 512'h0;
+      K_we      = 1'h0;
+      t_new     = 512'h0;
+      t_we      = 1'h0;
+      nbits_new = 10'h0;
+      nbits_we  = 1'h0;
+      phase_new = PHASE_BLOCK;
+      phase_we  = 1'h0;
+
+      if (key_init)
+        begin
+          if (phase_reg == PHASE_BLOCK)
+            key_lps_x = h_reg ^ N_reg;
+          else
+            key_lps_x = h_reg;
+        end
+      else
+        key_lps_x = K_reg ^ c_data;
+
+      if (block_load)
+        begin
+          m_new     = bswap512(block);
+          m_we      = 1'h1;
+          nbits_new = last ? {1'h0, last_len} : 10'd512;
+          nbits_we  = 1'h1;
+          phase_new = PHASE_BLOCK;
+          phase_we  = 1'h1;
+        end
+
+      if (key_init)
+        begin
+          K_new = key_lps_y;
+          K_we  = 1'h1;
+          t_new = m_reg;
+          t_we  = 1'h1;
+        end
+
+      if (round_update)
+        begin
+          K_new = key_lps_y;
+          K_we  = 1'h1;
+          t_new = data_lps_y;
+          t_we  = 1'h1;
+        end
+
+      if (phase_update)
+        begin
+          if (phase_reg == PHASE_BLOCK)
+            begin
+              m_new     = N_reg;
+              phase_new = PHASE_N;
+            end
+          else
+            begin
+              m_new     = sigma_reg;
+              phase_new = PHASE_SIGMA;
+            end
+          m_we     = 1'h1;
+          phase_we = 1'h1;
+        end
+    end // compress_logic
+
+
+  //----------------------------------------------------------------
+  // round_ctr
+  //
+  // Update logic for the round counter, a monotonically
+  // increasing counter with reset.
+  //----------------------------------------------------------------
+  always @*
+    begin : round_ctr
+      round_ctr_new = 4'h0;
+      round_ctr_we  = 1'h0;
+
+      if (round_ctr_rst)
+        begin
+          round_ctr_new = 4'h0;
+          round_ctr_we  = 1'h1;
+        end
+
+      if (round_ctr_inc)
+        begin
+          round_ctr_new = round_ctr_reg + 1'b1;
+          round_ctr_we  = 1'h1;
+        end
+    end // round_ctr
+
+
+  //----------------------------------------------------------------
+  // streebog_ctrl_fsm
+  //
+  // Logic for the state machine controlling the core behaviour.
+  //----------------------------------------------------------------
+  always @*
+    begin : streebog_ctrl_fsm
+      state_init        = 1'h0;
+      block_load        = 1'h0;
+      key_init          = 1'h0;
+      round_update      = 1'h0;
+      h_update          = 1'h0;
+      phase_update      = 1'h0;
+      mode_we           = 1'h0;
+      last_we           = 1'h0;
+      round_ctr_inc     = 1'h0;
+      round_ctr_rst     = 1'h0;
+      ready_new         = 1'h0;
+      ready_we          = 1'h0;
+      digest_valid_new  = 1'h0;
+      digest_valid_we   = 1'h0;
+      streebog_ctrl_new = CTRL_IDLE;
+      streebog_ctrl_we  = 1'h0;
+
+      case (streebog_ctrl_reg)
+        CTRL_IDLE:
+          begin
+            if (init || next || last)
+              begin
+                if (init)
+                  begin
+                    state_init = 1'h1;
+                    mode_we    = 1'h1;
+                  end
+
+                block_load        = 1'h1;
+                last_we           = 1'h1;
+                ready_new         = 1'h0;
+                ready_we          = 1'h1;
+                digest_valid_new  = 1'h0;
+                digest_valid_we   = 1'h1;
+                streebog_ctrl_new = CTRL_KEY;
+                streebog_ctrl_we  = 1'h1;
+              end
+          end
+
+        CTRL_KEY:
+          begin
+            key_init          = 1'h1;
+            round_ctr_rst     = 1'h1;
+            streebog_ctrl_new = CTRL_ROUNDS;
+            streebog_ctrl_we  = 1'h1;
+          end
+
+        CTRL_ROUNDS:
+          begin
+            round_update  = 1'h1;
+            round_ctr_inc = 1'h1;
+
+            if (round_ctr_reg == (NUM_ROUNDS - 1))
+              begin
+                streebog_ctrl_new = CTRL_FINISH;
+                streebog_ctrl_we  = 1'h1;
+              end
+          end
+
+        CTRL_FINISH:
+          begin
+            h_update = 1'h1;
+
+            if (last_reg && (phase_reg != PHASE_SIGMA))
+              begin
+                phase_update      = 1'h1;
+                streebog_ctrl_new = CTRL_KEY;
+                streebog_ctrl_we  = 1'h1;
+              end
+            else
+              begin
+                ready_new         = 1'h1;
+                ready_we          = 1'h1;
+                digest_valid_new  = last_reg;
+                digest_valid_we   = 1'h1;
+                streebog_ctrl_new = CTRL_IDLE;
+                streebog_ctrl_we  = 1'h1;
+              end
+          end
+
+        default:
+          begin
+          end
+      endcase // case (streebog_ctrl_reg)
+    end // streebog_ctrl_fsm
+
+endmodule // streebog_core
+
+//======================================================================
+// EOF streebog_core.v
+//======================================================================
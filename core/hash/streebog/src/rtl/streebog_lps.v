@@ -0,0 +1,196 @@
+//======================================================================
+//
+// streebog_lps.v
+// --------------
+// The combined LPS transform in the GOST R 34.11-2012 (Streebog)
+// hash function. Combinational logic that performs the byte
+// substitution (S), byte transposition (P) and linear transform
+// (L) on a 512 bit little endian value in one go.
+//
+//
+// Copyright (c) 2016, NORDUnet A/S
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// - Neither the name of the NORDUnet nor the names of its contributors may
+//   be used to endorse or promote products derived from this software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+module streebog_lps(
+                    input wire [511 : 0]  x,
+                    output wire [511 : 0] y
+                   );
+
+
+  //----------------------------------------------------------------
+  // Functions.
+  //----------------------------------------------------------------
+
+  // Row i of the binary matrix A used by the L transform.
+  function [63 : 0] a_row(input [5 : 0] i);
+    begin
+      case (i)
+        6'd00: a_row = 64'h8e20faa72ba0b470;
+        6'd01: a_row = 64'h47107ddd9b505a38;
+        6'd02: a_row = 64'had08b0e0c3282d1c;
+        6'd03: a_row = 64'hd8045870ef14980e;
+        6'd04: a_row = 64'h6c022c38f90a4c07;
+        6'd05: a_row = 64'h3601161cf205268d;
+        6'd06: a_row = 64'h1b8e0b0e798c13c8;
+        6'd07: a_row = 64'h83478b07b2468764;
+        6'd08: a_row = 64'ha011d380818e8f40;
+        6'd09: a_row = 64'h5086e740ce47c920;
+        6'd10: a_row = 64'h2843fd2067adea10;
+        6'd11: a_row = 64'h14aff010bdd87508;
+        6'd12: a_row = 64'h0ad97808d06cb404;
+        6'd13: a_row = 64'h05e23c0468365a02;
+        6'd14: a_row = 64'h8c711e02341b2d01;
+        6'd15: a_row = 64'h46b60f011a83988e;
+        6'd16: a_row = 64'h90dab52a387ae76f;
+        6'd17: a_row = 64'h486dd4151c3dfdb9;
+        6'd18: a_row = 64'h24b86a840e90f0d2;
+        6'd19: a_row = 64'h125c354207487869;
+        6'd20: a_row = 64'h092e94218d243cba;
+        6'd21: a_row = 64'h8a174a9ec8121e5d;
+        6'd22: a_row = 64'h4585254f64090fa0;
+        6'd23: a_row = 64'haccc9ca9328a8950;
+        6'd24: a_row = 64'h9d4df05d5f661451;
+        6'd25: a_row = 64'hc0a878a0a1330aa6;
+        6'd26: a_row = 64'h60543c50de970553;
+        6'd27: a_row = 64'h302a1e286fc58ca7;
+        6'd28: a_row = 64'h18150f14b9ec46dd;
+        6'd29: a_row = 64'h0c84890ad27623e0;
+        6'd30: a_row = 64'h0642ca05693b9f70;
+        6'd31: a_row = 64'h0321658cba93c138;
+        6'd32: a_row = 64'h86275df09ce8aaa8;
+        6'd33: a_row = 64'h439da0784e745554;
+        6'd34: a_row = 64'hafc0503c273aa42a;
+        6'd35: a_row = 64'hd960281e9d1d5215;
+        6'd36: a_row = 64'he230140fc0802984;
+        6'd37: a_row = 64'h71180a8960409a42;
+        6'd38: a_row = 64'hb60c05ca30204d21;
+        6'd39: a_row = 64'h5b068c651810a89e;
+        6'd40: a_row = 64'h456c34887a3805b9;
+        6'd41: a_row = 64'hac361a443d1c8cd2;
+        6'd42: a_row = 64'h561b0d22900e4669;
+        6'd43: a_row = 64'h2b838811480723ba;
+        6'd44: a_row = 64'h9bcf4486248d9f5d;
+        6'd45: a_row = 64'hc3e9224312c8c1a0;
+        6'd46: a_row = 64'heffa11af0964ee50;
+        6'd47: a_row = 64'hf97d86d98a327728;
+        6'd48: a_row = 64'he4fa2054a80b329c;
+        6'd49: a_row = 64'h727d102a548b194e;
+        6'd50: a_row = 64'h39b008152acb8227;
+        6'd51: a_row = 64'h9258048415eb419d;
+        6'd52: a_row = 64'h492c024284fbaec0;
+        6'd53: a_row = 64'haa16012142f35760;
+        6'd54: a_row = 64'h550b8e9e21f7a530;
+        6'd55: a_row = 64'ha48b474f9ef5dc18;
+        6'd56: a_row = 64'h70a6a56e2440598e;
+        6'd57: a_row = 64'h3853dc371220a247;
+        6'd58: a_row = 64'h1ca76e95091051ad;
+        6'd59: a_row = 64'h0edd37c48a08a6d8;
+        6'd60: a_row = 64'h07e095624504536c;
+        6'd61: a_row = 64'h8d70c431ac02a736;
+        6'd62: a_row = 64'hc83862965601dd1b;
+        6'd63: a_row = 64'h641c314b2b8ee083;
+      endcase // case (i)
+    end
+  endfunction // a_row
+
+  // The L transform of one 64 bit word. Bit k of the word
+  // selects row (63 - k) of A.
+  function [63 : 0] l_word(input [63 : 0] w);
+    integer k;
+    begin
+      l_word = 64'h0;
+      for (k = 0 ; k < 64 ; k = k + 1)
+        if (w[k])
+          l_word = l_word ^ a_row(63 - k);
+    end
+  endfunction // l_word
+
+
+  //----------------------------------------------------------------
+  // Wires.
+  //----------------------------------------------------------------
+  wire [511 : 0] s_data;
+  reg [511 : 0]  p_data;
+  reg [511 : 0]  l_data;
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity for ports etc.
+  //----------------------------------------------------------------
+  assign y = l_data;
+
+
+  //----------------------------------------------------------------
+  // Eight sbox instances, each doing eight parallel substitutions.
+  //----------------------------------------------------------------
+  streebog_sbox sbox0(.sboxw(x[063 : 000]), .new_sboxw(s_data[063 : 000]));
+  streebog_sbox sbox1(.sboxw(x[127 : 064]), .new_sboxw(s_data[127 : 064]));
+  streebog_sbox sbox2(.sboxw(x[191 : 128]), .new_sboxw(s_data[191 : 128]));
+  streebog_sbox sbox3(.sboxw(x[255 : 192]), .new_sboxw(s_data[255 : 192]));
+  streebog_sbox sbox4(.sboxw(x[319 : 256]), .new_sboxw(s_data[319 : 256]));
+  streebog_sbox sbox5(.sboxw(x[383 : 320]), .new_sboxw(s_data[383 : 320]));
+  streebog_sbox sbox6(.sboxw(x[447 : 384]), .new_sboxw(s_data[447 : 384]));
+  streebog_sbox sbox7(.sboxw(x[511 : 448]), .new_sboxw(s_data[511 : 448]));
+
+
+  //----------------------------------------------------------------
+  // p_logic
+  //
+  // The P transform transposes the 64 bytes seen as an 8x8 byte
+  // matrix, i.e. byte i of the result is byte 8 * (i % 8) + i / 8.
+  //----------------------------------------------------------------
+  always @*
+    begin : p_logic
+      integer i;
+
+      for (i = 0 ; i < 64 ; i = i + 1)
+        p_data[i * 8 +: 8] = s_data[(8 * (i % 8) + (i / 8)) * 8 +: 8];
+    end // p_logic
+
+
+  //----------------------------------------------------------------
+  // l_logic
+  //
+  // The L transform is applied to each 64 bit word separately.
+  //----------------------------------------------------------------
+  always @*
+    begin : l_logic
+      integer j;
+
+      for (j = 0 ; j < 8 ; j = j + 1)
+        l_data[j * 64 +: 64] = l_word(p_data[j * 64 +: 64]);
+    end // l_logic
+
+endmodule // streebog_lps
+
+//======================================================================
+// EOF streebog_lps.v
+//======================================================================
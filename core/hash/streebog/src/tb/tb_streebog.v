@@ -0,0 +1,455 @@
+//======================================================================
+//
+// tb_streebog.v
+// -------------
+// Testbench for the Streebog top level wrapper. Hashes the
+// RFC 6986 test messages through the register interface in both
+// 512 and 256 bit mode and reports the number of cycles used.
+//
+//
+// Copyright (c) 2016, NORDUnet A/S
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// - Neither the name of the NORDUnet nor the names of its contributors may
+//   be used to endorse or promote products derived from this software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+//------------------------------------------------------------------
+// Test module.
+//------------------------------------------------------------------
+module tb_streebog();
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  parameter DEBUG = 0;
+
+  parameter CLK_HALF_PERIOD = 2;
+  parameter CLK_PERIOD = 2 * CLK_HALF_PERIOD;
+
+  // The address map.
+  parameter ADDR_NAME0       = 8'h00;
+  parameter ADDR_NAME1       = 8'h01;
+  parameter ADDR_VERSION     = 8'h02;
+
+  parameter ADDR_CTRL        = 8'h08;
+  parameter CTRL_INIT_VALUE  = 8'h01;
+  parameter CTRL_NEXT_VALUE  = 8'h02;
+  parameter CTRL_LAST_VALUE  = 8'h04;
+  parameter CTRL_MODE_256    = 8'h08;
+
+  parameter ADDR_STATUS      = 8'h09;
+  parameter STATUS_READY_BIT = 0;
+  parameter STATUS_VALID_BIT = 1;
+
+  parameter ADDR_LAST_LEN    = 8'h0a;
+
+  parameter ADDR_BLOCK0      = 8'h10;
+  parameter ADDR_DIGEST0     = 8'h40;
+
+  parameter MODE_512         = 1'h0;
+  parameter MODE_256         = 1'h1;
+
+
+  //----------------------------------------------------------------
+  // Register and Wire declarations.
+  //----------------------------------------------------------------
+  reg [31 : 0] cycle_ctr;
+  reg [31 : 0] error_ctr;
+  reg [31 : 0] tc_ctr;
+
+  reg           tb_clk;
+  reg           tb_reset_n;
+  reg           tb_cs;
+  reg           tb_we;
+  reg [7 : 0]   tb_address;
+  reg [31 : 0]  tb_write_data;
+  wire [31 : 0] tb_read_data;
+  wire          tb_error;
+
+  reg [31 : 0]  read_data;
+  reg [511 : 0] digest_data;
+
+
+  //----------------------------------------------------------------
+  // Device Under Test.
+  //----------------------------------------------------------------
+  streebog dut(
+               .clk(tb_clk),
+               .reset_n(tb_reset_n),
+
+               .cs(tb_cs),
+               .we(tb_we),
+
+               .address(tb_address),
+               .write_data(tb_write_data),
+               .read_data(tb_read_data),
+               .error(tb_error)
+              );
+
+
+  //----------------------------------------------------------------
+  // clk_gen
+  //
+  // Clock generator process.
+  //----------------------------------------------------------------
+  always
+    begin : clk_gen
+      #CLK_HALF_PERIOD tb_clk = !tb_clk;
+    end // clk_gen
+
+
+  //----------------------------------------------------------------
+  // sys_monitor
+  //
+  // Generates a cycle counter.
+  //----------------------------------------------------------------
+  always
+    begin : sys_monitor
+      #(CLK_PERIOD);
+      cycle_ctr = cycle_ctr + 1;
+    end
+
+
+  //----------------------------------------------------------------
+  // reset_dut()
+  //----------------------------------------------------------------
+  task reset_dut;
+    begin
+      tb_reset_n = 0;
+      #(4 * CLK_HALF_PERIOD);
+      tb_reset_n = 1;
+    end
+  endtask // reset_dut
+
+
+  //----------------------------------------------------------------
+  // init_sim()
+  //
+  // Set the input to the DUT to defined values.
+  //----------------------------------------------------------------
+  task init_sim;
+    begin
+      cycle_ctr     = 0;
+      error_ctr     = 0;
+      tc_ctr        = 0;
+
+      tb_clk        = 0;
+      tb_reset_n    = 0;
+      tb_cs         = 0;
+      tb_we         = 0;
+      tb_address    = 8'h00;
+      tb_write_data = 32'h00000000;
+    end
+  endtask // init_sim
+
+
+  //----------------------------------------------------------------
+  // display_test_result()
+  //
+  // Display the accumulated test results.
+  //----------------------------------------------------------------
+  task display_test_result;
+    begin
+      if (error_ctr == 0)
+        begin
+          $display("*** All %02d test cases completed successfully.", tc_ctr);
+        end
+      else
+        begin
+          $display("*** %02d test cases completed.", tc_ctr);
+          $display("*** %02d errors detected during testing.", error_ctr);
+        end
+    end
+  endtask // display_test_result
+
+
+  //----------------------------------------------------------------
+  // write_word()
+  //
+  // Write the given word to the DUT using the DUT interface.
+  //----------------------------------------------------------------
+  task write_word(input [7 : 0]  address,
+                  input [31 : 0] word);
+    begin
+      if (DEBUG)
+        begin
+          $display("*** Writing 0x%08x to 0x%02x.", word, address);
+          $display("");
+        end
+
+      tb_address = address;
+      tb_write_data = word;
+      tb_cs = 1;
+      tb_we = 1;
+      #(CLK_PERIOD);
+      tb_cs = 0;
+      tb_we = 0;
+    end
+  endtask // write_word
+
+
+  //----------------------------------------------------------------
+  // read_word()
+  //
+  // Read a data word from the given address in the DUT.
+  // the word read will be available in the global variable
+  // read_data.
+  //----------------------------------------------------------------
+  task read_word(input [7 : 0]  address);
+    begin
+      tb_address = address;
+      tb_cs = 1;
+      tb_we = 0;
+      #(CLK_PERIOD);
+      read_data = tb_read_data;
+      tb_cs = 0;
+
+      if (DEBUG)
+        begin
+          $display("*** Reading 0x%08x from 0x%02x.", read_data, address);
+          $display("");
+        end
+    end
+  endtask // read_word
+
+
+  //----------------------------------------------------------------
+  // wait_ready()
+  //
+  // Wait for the ready flag in the dut to be set. The control
+  // pulse and the status register are both registered, so we
+  // give the core a few cycles to drop ready before polling.
+  //----------------------------------------------------------------
+  task wait_ready;
+    begin
+      #(3 * CLK_PERIOD);
+      read_data = 0;
+
+      while (read_data[STATUS_READY_BIT] == 0)
+        begin
+          read_word(ADDR_STATUS);
+        end
+    end
+  endtask // wait_ready
+
+
+  //----------------------------------------------------------------
+  // write_block()
+  //
+  // Write the given block to the dut.
+  //----------------------------------------------------------------
+  task write_block(input [511 : 0] block);
+    integer i;
+    begin
+      for (i = 0 ; i < 16 ; i = i + 1)
+        write_word(ADDR_BLOCK0 + i, block[(15 - i) * 32 +: 32]);
+    end
+  endtask // write_block
+
+
+  //----------------------------------------------------------------
+  // read_digest()
+  //
+  // Read the digest in the dut. The resulting digest will be
+  // available in the global variable digest_data.
+  //----------------------------------------------------------------
+  task read_digest;
+    integer i;
+    begin
+      for (i = 0 ; i < 16 ; i = i + 1)
+        begin
+          read_word(ADDR_DIGEST0 + i);
+          digest_data[(15 - i) * 32 +: 32] = read_data;
+        end
+    end
+  endtask // read_digest
+
+
+  //----------------------------------------------------------------
+  // check_name_version()
+  //
+  // Read the name and version from the DUT.
+  //----------------------------------------------------------------
+  task check_name_version;
+    reg [31 : 0] name0;
+    reg [31 : 0] name1;
+    reg [31 : 0] version;
+    begin
+
+      read_word(ADDR_NAME0);
+      name0 = read_data;
+      read_word(ADDR_NAME1);
+      name1 = read_data;
+      read_word(ADDR_VERSION);
+      version = read_data;
+
+      $display("DUT name: %c%c%c%c%c%c%c%c",
+               name0[31 : 24], name0[23 : 16], name0[15 : 8], name0[7 : 0],
+               name1[31 : 24], name1[23 : 16], name1[15 : 8], name1[7 : 0]);
+      $display("DUT version: %c%c%c%c",
+               version[31 : 24], version[23 : 16], version[15 : 8], version[7 : 0]);
+    end
+  endtask // check_name_version
+
+
+  //----------------------------------------------------------------
+  // process_block()
+  //
+  // Write a block and start processing of it. If last is set the
+  // block is the padded final block with len message bits.
+  //----------------------------------------------------------------
+  task process_block(input           init,
+                     input           last,
+                     input           mode,
+                     input [8 : 0]   len,
+                     input [511 : 0] block);
+    reg [31 : 0] ctrl;
+    begin
+      write_block(block);
+
+      if (last)
+        write_word(ADDR_LAST_LEN, {23'h0, len});
+
+      ctrl = init ? CTRL_INIT_VALUE : CTRL_NEXT_VALUE;
+      if (last)
+        ctrl = ctrl | CTRL_LAST_VALUE;
+      if (mode == MODE_256)
+        ctrl = ctrl | CTRL_MODE_256;
+
+      write_word(ADDR_CTRL, ctrl);
+      wait_ready;
+    end
+  endtask // process_block
+
+
+  //----------------------------------------------------------------
+  // check_digest()
+  //----------------------------------------------------------------
+  task check_digest(input [7 : 0]   tc_number,
+                    input [31 : 0]  start_cycle,
+                    input [511 : 0] expected);
+    reg [31 : 0] status;
+    begin
+      tc_ctr = tc_ctr + 1;
+
+      read_word(ADDR_STATUS);
+      status = read_data;
+      read_digest;
+
+      if (status[STATUS_VALID_BIT] && (digest_data == expected))
+        begin
+          $display("TC%0d: OK, %0d cycles including register access.",
+                   tc_number, cycle_ctr - start_cycle);
+        end
+      else
+        begin
+          $display("TC%0d: ERROR.", tc_number);
+          $display("TC%0d: Expected: 0x%0128x", tc_number, expected);
+          $display("TC%0d: Got:      0x%0128x", tc_number, digest_data);
+          error_ctr = error_ctr + 1;
+        end
+      $display("");
+    end
+  endtask // check_digest
+
+
+  //----------------------------------------------------------------
+  // The main test functionality.
+  //----------------------------------------------------------------
+  initial
+    begin : main
+      reg [31 : 0] start_cycle;
+
+      reg [511 : 0] m1_block;
+      reg [511 : 0] m2_block0;
+      reg [511 : 0] m2_block1;
+      reg [511 : 0] empty_block;
+
+      m1_block = {256'h3031323334353637383930313233343536373839303132333435363738393031,
+                  256'h3233343536373839303132333435363738393031323334353637383930313201};
+
+      m2_block0 = {256'hd1e520e2e5f2f0e82c20d1f2f0e8e1eee6e820e2edf3f6e82c20e2e5fef2fa20,
+                   256'hf120eceef0ff20f1f2f0e5ebe0ece820ede020f5f0e0e1f0fbff20efebfaeafb};
+      m2_block1 = {256'h20c8e3eef0e5e2fb010000000000000000000000000000000000000000000000,
+                   256'h0000000000000000000000000000000000000000000000000000000000000000};
+
+      empty_block = {8'h01, 504'h0};
+
+      $display("   -- Testbench for streebog started --");
+
+      init_sim;
+      reset_dut;
+      check_name_version;
+      $display("");
+
+      start_cycle = cycle_ctr;
+      process_block(1, 1, MODE_512, 9'd504, m1_block);
+      check_digest(1, start_cycle,
+                   {256'h1b54d01a4af5b9d5cc3d86d68d285462b19abc2475222f35c085122be4ba1ffa,
+                    256'h00ad30f8767b3a82384c6574f024c311e2a481332b08ef7f41797891c1646f48});
+
+      start_cycle = cycle_ctr;
+      process_block(1, 1, MODE_256, 9'd504, m1_block);
+      check_digest(2, start_cycle,
+                   {256'h9d151eefd8590b89daa6ba6cb74af9275dd051026bb149a452fd84e5e57b5500,
+                    256'h0});
+
+      start_cycle = cycle_ctr;
+      process_block(1, 0, MODE_512, 9'd0, m2_block0);
+      process_block(0, 1, MODE_512, 9'd64, m2_block1);
+      check_digest(3, start_cycle,
+                   {256'h1e88e62226bfca6f9994f1f2d51569e0daf8475a3b0fe61a5300eee46d961376,
+                    256'h035fe83549ada2b8620fcd7c496ce5b33f0cb9dddc2b6460143b03dabac9fb28});
+
+      start_cycle = cycle_ctr;
+      process_block(1, 0, MODE_256, 9'd0, m2_block0);
+      process_block(0, 1, MODE_256, 9'd64, m2_block1);
+      check_digest(4, start_cycle,
+                   {256'h9dd2fe4e90409e5da87f53976d7405b0c0cac628fc669a741d50063c557e8f50,
+                    256'h0});
+
+      start_cycle = cycle_ctr;
+      process_block(1, 1, MODE_512, 9'd0, empty_block);
+      check_digest(5, start_cycle,
+                   {256'h8e945da209aa869f0455928529bcae4679e9873ab707b55315f56ceb98bef0a7,
+                    256'h362f715528356ee83cda5f2aac4c6ad2ba3a715c1bcd81cb8e9f90bf4c1c1a8a});
+
+      start_cycle = cycle_ctr;
+      process_block(1, 1, MODE_256, 9'd0, empty_block);
+      check_digest(6, start_cycle,
+                   {256'h3f539a213e97c802cc229d474c6aa32a825a360b2a933a949fd925208d9ce1bb,
+                    256'h0});
+
+      display_test_result;
+      $display("   -- Testbench for streebog done. --");
+      $finish;
+    end // main
+endmodule // tb_streebog
+
+//======================================================================
+// EOF tb_streebog.v
+//======================================================================
@@ -0,0 +1,376 @@
+//======================================================================
+//
+// tb_streebog_core.v
+// ------------------
+// Testbench for the Streebog hash function core. Runs the
+// GOST R 34.11-2012 (RFC 6986) test vectors M1 and M2 plus the
+// empty message in both 512 and 256 bit mode, and reports the
+// number of cycles needed for each message.
+//
+//
+// Copyright (c) 2016, NORDUnet A/S
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// - Neither the name of the NORDUnet nor the names of its contributors may
+//   be used to endorse or promote products derived from this software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+//------------------------------------------------------------------
+// Test module.
+//------------------------------------------------------------------
+module tb_streebog_core();
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  parameter DEBUG = 0;
+
+  parameter CLK_HALF_PERIOD = 2;
+  parameter CLK_PERIOD = 2 * CLK_HALF_PERIOD;
+
+  parameter MODE_512 = 1'h0;
+  parameter MODE_256 = 1'h1;
+
+
+  //----------------------------------------------------------------
+  // Register and Wire declarations.
+  //----------------------------------------------------------------
+  reg [31 : 0] cycle_ctr;
+  reg [31 : 0] error_ctr;
+  reg [31 : 0] tc_ctr;
+
+  reg            tb_clk;
+  reg            tb_reset_n;
+  reg            tb_init;
+  reg            tb_next;
+  reg            tb_last;
+  reg            tb_mode;
+  reg [8 : 0]    tb_last_len;
+  reg [511 : 0]  tb_block;
+  wire           tb_ready;
+  wire [511 : 0] tb_digest;
+  wire           tb_digest_valid;
+
+
+  //----------------------------------------------------------------
+  // Device Under Test.
+  //----------------------------------------------------------------
+  streebog_core dut(
+                    .clk(tb_clk),
+                    .reset_n(tb_reset_n),
+
+                    .init(tb_init),
+                    .next(tb_next),
+                    .last(tb_last),
+                    .mode(tb_mode),
+
+                    .last_len(tb_last_len),
+                    .block(tb_block),
+
+                    .ready(tb_ready),
+
+                    .digest(tb_digest),
+                    .digest_valid(tb_digest_valid)
+                   );
+
+
+  //----------------------------------------------------------------
+  // clk_gen
+  //
+  // Always running clock generator process.
+  //----------------------------------------------------------------
+  always
+    begin : clk_gen
+      #CLK_HALF_PERIOD;
+      tb_clk = !tb_clk;
+    end // clk_gen
+
+
+  //----------------------------------------------------------------
+  // sys_monitor()
+  //
+  // An always running process that creates a cycle counter and
+  // conditionally displays information about the DUT.
+  //----------------------------------------------------------------
+  always
+    begin : sys_monitor
+      cycle_ctr = cycle_ctr + 1;
+      #(CLK_PERIOD);
+      if (DEBUG)
+        begin
+          dump_dut_state;
+        end
+    end
+
+
+  //----------------------------------------------------------------
+  // dump_dut_state()
+  //
+  // Dump the state of the dut when needed.
+  //----------------------------------------------------------------
+  task dump_dut_state;
+    begin
+      $display("State of DUT");
+      $display("------------");
+      $display("init = 0x%01x, next = 0x%01x, last = 0x%01x, mode = 0x%01x",
+               dut.init, dut.next, dut.last, dut.mode);
+      $display("ready = 0x%01x, valid = 0x%01x", dut.ready, dut.digest_valid);
+      $display("ctrl = 0x%01x, phase = 0x%01x, round_ctr = 0x%02x",
+               dut.streebog_ctrl_reg, dut.phase_reg, dut.round_ctr_reg);
+      $display("h     = 0x%0128x", dut.h_reg);
+      $display("N     = 0x%0128x", dut.N_reg);
+      $display("Sigma = 0x%0128x", dut.sigma_reg);
+      $display("K     = 0x%0128x", dut.K_reg);
+      $display("t     = 0x%0128x", dut.t_reg);
+      $display("");
+    end
+  endtask // dump_dut_state
+
+
+  //----------------------------------------------------------------
+  // reset_dut()
+  //
+  // Toggle reset to put the DUT into a well known state.
+  //----------------------------------------------------------------
+  task reset_dut;
+    begin
+      $display("*** Toggle reset.");
+      tb_reset_n = 0;
+      #(4 * CLK_HALF_PERIOD);
+      tb_reset_n = 1;
+    end
+  endtask // reset_dut
+
+
+  //----------------------------------------------------------------
+  // init_sim()
+  //
+  // Initialize all counters and testbed functionality as well
+  // as setting the DUT inputs to defined values.
+  //----------------------------------------------------------------
+  task init_sim;
+    begin
+      cycle_ctr   = 0;
+      error_ctr   = 0;
+      tc_ctr      = 0;
+
+      tb_clk      = 0;
+      tb_reset_n  = 1;
+
+      tb_init     = 0;
+      tb_next     = 0;
+      tb_last     = 0;
+      tb_mode     = MODE_512;
+      tb_last_len = 9'h0;
+      tb_block    = 512'h0;
+    end
+  endtask // init_sim
+
+
+  //----------------------------------------------------------------
+  // display_test_result()
+  //
+  // Display the accumulated test results.
+  //----------------------------------------------------------------
+  task display_test_result;
+    begin
+      if (error_ctr == 0)
+        begin
+          $display("*** All %02d test cases completed successfully", tc_ctr);
+        end
+      else
+        begin
+          $display("*** %02d test cases did not complete successfully.", error_ctr);
+        end
+    end
+  endtask // display_test_result
+
+
+  //----------------------------------------------------------------
+  // wait_ready()
+  //
+  // Wait for the ready flag in the dut to be set.
+  //----------------------------------------------------------------
+  task wait_ready;
+    begin
+      #(CLK_PERIOD);
+      while (!tb_ready)
+        begin
+          #(CLK_PERIOD);
+        end
+    end
+  endtask // wait_ready
+
+
+  //----------------------------------------------------------------
+  // process_block()
+  //
+  // Process one block. If last is set the block is the padded
+  // final block containing len message bits.
+  //----------------------------------------------------------------
+  task process_block(input           init,
+                     input           last,
+                     input           mode,
+                     input [8 : 0]   len,
+                     input [511 : 0] block);
+    begin
+      tb_block    = block;
+      tb_mode     = mode;
+      tb_last_len = len;
+      tb_init     = init;
+      tb_next     = !init;
+      tb_last     = last;
+      #(CLK_PERIOD);
+      tb_init     = 0;
+      tb_next     = 0;
+      tb_last     = 0;
+      wait_ready;
+    end
+  endtask // process_block
+
+
+  //----------------------------------------------------------------
+  // check_digest()
+  //----------------------------------------------------------------
+  task check_digest(input [7 : 0]   tc_number,
+                    input [31 : 0]  start_cycle,
+                    input [511 : 0] expected);
+    begin
+      tc_ctr = tc_ctr + 1;
+
+      if (tb_digest_valid && (tb_digest == expected))
+        begin
+          $display("*** TC %0d successful, %0d cycles.", tc_number,
+                   cycle_ctr - start_cycle);
+          $display("");
+        end
+      else
+        begin
+          $display("*** ERROR: TC %0d NOT successful.", tc_number);
+          $display("Expected: 0x%0128x", expected);
+          $display("Got:      0x%0128x", tb_digest);
+          $display("");
+          error_ctr = error_ctr + 1;
+        end
+    end
+  endtask // check_digest
+
+
+  //----------------------------------------------------------------
+  // streebog_core_test
+  //
+  // The main test functionality.
+  //----------------------------------------------------------------
+  initial
+    begin : streebog_core_test
+      reg [31 : 0] start_cycle;
+
+      reg [511 : 0] m1_block;
+      reg [511 : 0] m2_block0;
+      reg [511 : 0] m2_block1;
+      reg [511 : 0] empty_block;
+
+      reg [511 : 0] m1_512_expected;
+      reg [511 : 0] m1_256_expected;
+      reg [511 : 0] m2_512_expected;
+      reg [511 : 0] m2_256_expected;
+      reg [511 : 0] empty_512_expected;
+      reg [511 : 0] empty_256_expected;
+
+      // RFC 6986 M1: the 63 byte string "0123...012", padded.
+      m1_block = {256'h3031323334353637383930313233343536373839303132333435363738393031,
+                  256'h3233343536373839303132333435363738393031323334353637383930313201};
+
+      // RFC 6986 M2: 72 bytes, one full block and one padded 8 byte block.
+      m2_block0 = {256'hd1e520e2e5f2f0e82c20d1f2f0e8e1eee6e820e2edf3f6e82c20e2e5fef2fa20,
+                   256'hf120eceef0ff20f1f2f0e5ebe0ece820ede020f5f0e0e1f0fbff20efebfaeafb};
+      m2_block1 = {256'h20c8e3eef0e5e2fb010000000000000000000000000000000000000000000000,
+                   256'h0000000000000000000000000000000000000000000000000000000000000000};
+
+      empty_block = {8'h01, 504'h0};
+
+      m1_512_expected = {256'h1b54d01a4af5b9d5cc3d86d68d285462b19abc2475222f35c085122be4ba1ffa,
+                         256'h00ad30f8767b3a82384c6574f024c311e2a481332b08ef7f41797891c1646f48};
+      m1_256_expected = {256'h9d151eefd8590b89daa6ba6cb74af9275dd051026bb149a452fd84e5e57b5500,
+                         256'h0};
+
+      m2_512_expected = {256'h1e88e62226bfca6f9994f1f2d51569e0daf8475a3b0fe61a5300eee46d961376,
+                         256'h035fe83549ada2b8620fcd7c496ce5b33f0cb9dddc2b6460143b03dabac9fb28};
+      m2_256_expected = {256'h9dd2fe4e90409e5da87f53976d7405b0c0cac628fc669a741d50063c557e8f50,
+                         256'h0};
+
+      empty_512_expected = {256'h8e945da209aa869f0455928529bcae4679e9873ab707b55315f56ceb98bef0a7,
+                            256'h362f715528356ee83cda5f2aac4c6ad2ba3a715c1bcd81cb8e9f90bf4c1c1a8a};
+      empty_256_expected = {256'h3f539a213e97c802cc229d474c6aa32a825a360b2a933a949fd925208d9ce1bb,
+                            256'h0};
+
+      $display("   -- Testbench for streebog core started --");
+
+      init_sim;
+      reset_dut;
+
+      $display("TC1: Streebog-512, M1 (one final block).");
+      start_cycle = cycle_ctr;
+      process_block(1, 1, MODE_512, 9'd504, m1_block);
+      check_digest(1, start_cycle, m1_512_expected);
+
+      $display("TC2: Streebog-256, M1 (one final block).");
+      start_cycle = cycle_ctr;
+      process_block(1, 1, MODE_256, 9'd504, m1_block);
+      check_digest(2, start_cycle, m1_256_expected);
+
+      $display("TC3: Streebog-512, M2 (one full block, one final block).");
+      start_cycle = cycle_ctr;
+      process_block(1, 0, MODE_512, 9'd0, m2_block0);
+      $display("*** TC3 full block done after %0d cycles.", cycle_ctr - start_cycle);
+      process_block(0, 1, MODE_512, 9'd64, m2_block1);
+      check_digest(3, start_cycle, m2_512_expected);
+
+      $display("TC4: Streebog-256, M2 (one full block, one final block).");
+      start_cycle = cycle_ctr;
+      process_block(1, 0, MODE_256, 9'd0, m2_block0);
+      process_block(0, 1, MODE_256, 9'd64, m2_block1);
+      check_digest(4, start_cycle, m2_256_expected);
+
+      $display("TC5: Streebog-512, empty message.");
+      start_cycle = cycle_ctr;
+      process_block(1, 1, MODE_512, 9'd0, empty_block);
+      check_digest(5, start_cycle, empty_512_expected);
+
+      $display("TC6: Streebog-256, empty message.");
+      start_cycle = cycle_ctr;
+      process_block(1, 1, MODE_256, 9'd0, empty_block);
+      check_digest(6, start_cycle, empty_256_expected);
+
+      display_test_result;
+      $display("*** Simulation done.");
+      $finish;
+    end // streebog_core_test
+endmodule // tb_streebog_core
+
+//======================================================================
+// EOF tb_streebog_core.v
+//======================================================================
@@ -13,7 +13,11 @@ C_SRCS += \
 ../src/autogenerated_tests.c \
 ../src/bignum_uint32_t.c \
 ../src/montgomery_array.c \
-../src/montgomery_array_test.c
+../src/montgomery_array_bench.c \
+../src/montgomery_array_test.c \
+../src/rsa_crt_test.c \
+../src/test_runner.c \
+../src/thread_pool.c
 
 OBJS += \
 ./src/ModExpTestBench.o \
@@ -21,7 +25,11 @@ OBJS += \
 ./src/autogenerated_tests.o \
 ./src/bignum_uint32_t.o \
 ./src/montgomery_array.o \
-./src/montgomery_array_test.o
+./src/montgomery_array_bench.o \
+./src/montgomery_array_test.o \
+./src/rsa_crt_test.o \
+./src/test_runner.o \
+./src/thread_pool.o
 
 C_DEPS += \
 ./src/ModExpTestBench.d \
@@ -29,7 +37,11 @@ C_DEPS += \
 ./src/autogenerated_tests.d \
 ./src/bignum_uint32_t.d \
 ./src/montgomery_array.d \
-./src/montgomery_array_test.d
+./src/montgomery_array_bench.d \
+./src/montgomery_array_test.d \
+./src/rsa_crt_test.d \
+./src/test_runner.d \
+./src/thread_pool.d
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -1,16 +1,62 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include "test_runner.h"
 #include "simple_tests.h"
 #include "autogenerated_tests.h"
 #include "montgomery_array_test.h"
+#include "montgomery_array_bench.h"
+#include "rsa_crt_test.h"
 #include "bignum_uint32_t.h"
 
-int main(void) {
-  simple_tests();
-  autogenerated_tests();
-  montgomery_array_tests(0);
+int main(int argc, char *argv[]) {
+  // -b runs the benchmark instead of the tests.
+  if ((argc > 1) && (strcmp(argv[1], "-b") == 0)) {
+    montgomery_array_bench();
+    rsa_crt_bench();
+    return EXIT_SUCCESS;
+  }
+
+  // -v prints the RSA CRT test vectors for the hardware.
+  if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) {
+    rsa_crt_vectors();
+    return EXIT_SUCCESS;
+  }
+
+  // -j N runs the tests on N threads, default one per processor.
+  long threads = sysconf(_SC_NPROCESSORS_ONLN);
+  if ((argc > 2) && (strcmp(argv[1], "-j") == 0)) {
+    threads = strtol(argv[2], NULL, 10);
+  } else if (argc > 1) {
+    printf("usage: %s [-b | -v | -j threads]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  if (threads < 1)
+    threads = 1;
+
+  const test_case rsa_crt_test_cases[] = { TEST_CASE(rsa_crt_tests) };
+  const uint32_t count = simple_test_case_count + autogenerated_test_case_count
+      + montgomery_array_test_case_count + 1;
+  test_case *cases = malloc(count * sizeof(test_case));
+  if (cases == NULL)
+    return EXIT_FAILURE;
+  uint32_t n = 0;
+  memcpy(cases + n, simple_test_cases, simple_test_case_count * sizeof(test_case));
+  n += simple_test_case_count;
+  memcpy(cases + n, autogenerated_test_cases,
+      autogenerated_test_case_count * sizeof(test_case));
+  n += autogenerated_test_case_count;
+  memcpy(cases + n, montgomery_array_test_cases,
+      montgomery_array_test_case_count * sizeof(test_case));
+  n += montgomery_array_test_case_count;
+  cases[n] = rsa_crt_test_cases[0];
+
+  uint32_t failed = run_test_cases_timed(cases, count, (uint32_t) threads);
+  free(cases);
 
   print_assert_array_stats();
 
-  return EXIT_SUCCESS;
+  return (failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
 }
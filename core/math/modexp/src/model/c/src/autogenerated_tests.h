@@ -3,4 +3,7 @@
 
 void autogenerated_tests(void);
 
+extern const test_case autogenerated_test_cases[];
+extern const uint32_t autogenerated_test_case_count;
+
 #endif /* AUTOGENERATED_TESTS_H_ */
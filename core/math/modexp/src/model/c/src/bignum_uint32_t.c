@@ -2,33 +2,58 @@
 #include <stdlib.h>
 #include "bignum_uint32_t.h"
 
-int assert_array_total = 0;
-int assert_array_error = 0;
+// The assert counts over all threads, and those of this thread for the
+// test runner to attribute them to a test.
+static _Atomic int assert_array_total = 0;
+static _Atomic int assert_array_error = 0;
+static _Thread_local int assert_array_thread_total = 0;
+static _Thread_local int assert_array_thread_error = 0;
+
+// Where the tests and asserts of this thread print, stdout if not set.
+static _Thread_local FILE *assert_array_out = NULL;
+
+void assert_array_set_output(FILE *out) {
+	assert_array_out = out;
+}
+
+FILE *assert_array_output(void) {
+	return (assert_array_out != NULL) ? assert_array_out : stdout;
+}
+
 void assertArrayEquals(uint32_t length, uint32_t *expected, uint32_t *actual) { //needed in tests
+	FILE *out = assert_array_output();
 	int equals = 1;
 	for (uint32_t i = 0; i < length; i++)
 		equals &= expected[i] == actual[i];
-	printf("%s expected: \n[", equals ? "PASS" : "FAIL");
+	fprintf(out, "%s expected: \n[", equals ? "PASS" : "FAIL");
 	for (uint32_t i = 0; i < length - 1; i++) {
           if ((i > 0) && (!(i % 4)))
-            printf("\n ");
-          printf("0x%08x, ", expected[i]);
+            fprintf(out, "\n ");
+          fprintf(out, "0x%08x, ", expected[i]);
         }
-        printf("0x%08x]", expected[length - 1]);
+        fprintf(out, "0x%08x]", expected[length - 1]);
 
-        printf("\n\n");
-        printf("actual:\n[");
+        fprintf(out, "\n\n");
+        fprintf(out, "actual:\n[");
 	for (uint32_t i = 0; i < length - 1; i++) {
           if ((i > 0) && (!(i % 4)))
-            printf("\n ");
-          printf("0x%08x, ", actual[i]);
+            fprintf(out, "\n ");
+          fprintf(out, "0x%08x, ", actual[i]);
         }
-	printf("0x%08x]\n", actual[length - 1]);
+	fprintf(out, "0x%08x]\n", actual[length - 1]);
 
-        printf("\n");
+        fprintf(out, "\n");
 	assert_array_total++;
-	if (!equals)
+	assert_array_thread_total++;
+	if (!equals) {
 		assert_array_error++;
+		assert_array_thread_error++;
+	}
+}
+
+void assert_array_thread_stats(int *total, int *error) {
+	*total = assert_array_thread_total;
+	*error = assert_array_thread_error;
 }
 
 void print_assert_array_stats(void) {
@@ -87,11 +112,12 @@ void shift_left_1_array(uint32_t length, uint32_t *a, uint32_t *result) {
 }
 
 void debugArray(char *msg, uint32_t length, uint32_t *array) {
-	printf("%s ", msg);
+	FILE *out = assert_array_output();
+	fprintf(out, "%s ", msg);
 	for (uint32_t i = 0; i < length; i++) {
-		printf("%8x ", array[i]);
+		fprintf(out, "%8x ", array[i]);
 	}
-	printf("\n");
+	fprintf(out, "\n");
 }
 
 void modulus_array(uint32_t length, uint32_t *a, uint32_t *modulus, uint32_t *temp,
@@ -124,3 +150,206 @@ int greater_than_array(uint32_t length, uint32_t *a, uint32_t *b) {
 	}
 	return 0;
 }
+
+// result := a * b, schoolbook, alength + blength words. result may not
+// alias a or b.
+void mul_array(uint32_t alength, uint32_t *a, uint32_t blength, uint32_t *b,
+		uint32_t *result) {
+	zero_array(alength + blength, result);
+	for (int32_t i = ((int32_t) alength) - 1; i >= 0; i--) {
+		uint64_t carry = 0;
+		for (int32_t j = ((int32_t) blength) - 1; j >= 0; j--) {
+			uint64_t p = (uint64_t) a[i] * b[j] + result[i + j + 1] + carry;
+			result[i + j + 1] = (uint32_t) p;
+			carry = p >> 32;
+		}
+		result[i] = (uint32_t) carry;
+	}
+}
+
+// The number of significant words of a, at least one.
+static uint32_t significant_words(uint32_t length, uint32_t *a) {
+	uint32_t n = length;
+	while ((n > 1) && (a[length - n] == 0))
+		n--;
+	return n;
+}
+
+// Knuth's Algorithm D (TAOCP vol 2, 4.3.1). q := a / m, r := a mod m.
+// The divisor and the dividend are normalized so that the top bit of
+// the divisor is set, which makes each estimated quotient word at most
+// two too large. The arithmetic is on the little endian copies in temp.
+void divide_array(uint32_t alength, uint32_t *a, uint32_t mlength, uint32_t *m,
+		uint32_t *temp, uint32_t *q, uint32_t *r) {
+	const uint32_t n = significant_words(mlength, m);
+	const uint32_t an = significant_words(alength, a);
+	uint32_t *un = temp;              // an + 1 words
+	uint32_t *vn = temp + an + 1;     // n words
+
+	if (q != NULL)
+		zero_array(alength, q);
+
+	if (an < n) {
+		copy_array(alength, a, un);
+		zero_array(mlength, r);
+		for (uint32_t i = 0; (i < an) && (i < mlength); i++)
+			r[mlength - 1 - i] = un[alength - 1 - i];
+		return;
+	}
+
+	// Normalize: shift both left until the top bit of the divisor is set.
+	uint32_t s = 0;
+	while (((m[mlength - n] << s) & 0x80000000) == 0)
+		s++;
+	for (uint32_t i = n - 1; i > 0; i--)
+		vn[i] = (m[mlength - 1 - i] << s)
+				| (uint32_t) ((uint64_t) m[mlength - i] >> (32 - s));
+	vn[0] = m[mlength - 1] << s;
+	un[an] = (uint32_t) ((uint64_t) a[alength - an] >> (32 - s));
+	for (uint32_t i = an - 1; i > 0; i--)
+		un[i] = (a[alength - 1 - i] << s)
+				| (uint32_t) ((uint64_t) a[alength - i] >> (32 - s));
+	un[0] = a[alength - 1] << s;
+
+	for (int32_t j = (int32_t) (an - n); j >= 0; j--) {
+		// Estimate the quotient word from the top two words of the
+		// remainder and the top word of the divisor, then correct it
+		// with the next word.
+		uint64_t num = ((uint64_t) un[(uint32_t) j + n] << 32) | un[(uint32_t) j + n - 1];
+		uint64_t qhat = num / vn[n - 1];
+		uint64_t rhat = num - qhat * vn[n - 1];
+		while ((qhat >> 32) || ((n > 1)
+				&& (qhat * vn[n - 2] > ((rhat << 32) | un[(uint32_t) j + n - 2])))) {
+			qhat--;
+			rhat += vn[n - 1];
+			if (rhat >> 32)
+				break;
+		}
+
+		// Multiply and subtract.
+		uint64_t carry = 0;
+		uint64_t borrow = 0;
+		for (uint32_t i = 0; i < n; i++) {
+			uint64_t p = qhat * vn[i] + carry;
+			carry = p >> 32;
+			uint64_t t = (uint64_t) un[i + (uint32_t) j] - (uint32_t) p - borrow;
+			un[i + (uint32_t) j] = (uint32_t) t;
+			borrow = t >> 63;
+		}
+		uint64_t t = (uint64_t) un[(uint32_t) j + n] - carry - borrow;
+		un[(uint32_t) j + n] = (uint32_t) t;
+
+		// The estimate was one too large, add the divisor back.
+		if (t >> 63) {
+			qhat--;
+			carry = 0;
+			for (uint32_t i = 0; i < n; i++) {
+				uint64_t sum = (uint64_t) un[i + (uint32_t) j] + vn[i] + carry;
+				un[i + (uint32_t) j] = (uint32_t) sum;
+				carry = sum >> 32;
+			}
+			un[(uint32_t) j + n] += (uint32_t) carry;
+		}
+
+		if (q != NULL)
+			q[alength - 1 - (uint32_t) j] = (uint32_t) qhat;
+	}
+
+	// Unnormalize the remainder.
+	zero_array(mlength, r);
+	for (uint32_t i = 0; i < n; i++)
+		r[mlength - 1 - i] = (un[i] >> s)
+				| (uint32_t) (((uint64_t) un[i + 1] << (32 - s)) & 0xFFFFFFFFul);
+}
+
+// mu := 2 ** (64 k) / m, for the Barrett reduction. k is the number of
+// significant words of m.
+void barrett_mu_array(uint32_t length, uint32_t *m, uint32_t *temp, uint32_t *mu) {
+	const uint32_t k = significant_words(length, m);
+	const uint32_t alength = 2 * length + 1;
+	uint32_t *a = temp;
+	uint32_t *q = temp + alength;
+	uint32_t *r = q + alength;
+	uint32_t *t = r + length;
+
+	zero_array(alength, a);
+	a[alength - 1 - 2 * k] = 1;
+	divide_array(alength, a, length, m, t, q, r);
+	copy_array(length + 1, q + alength - (length + 1), mu);
+}
+
+// Barrett reduction (HAC 14.42). r := x mod m for x of 2 * length words
+// below 2 ** (64 k), using mu from barrett_mu_array. The quotient
+// estimate is at most two too small, so at most two subtractions are
+// needed at the end. The arithmetic is little endian in temp.
+void barrett_reduce_array(uint32_t length, uint32_t *x, uint32_t *m, uint32_t *mu,
+		uint32_t *temp, uint32_t *r) {
+	const uint32_t k = significant_words(length, m);
+	const uint32_t xlength = 2 * length;
+	uint32_t *q2 = temp;               // 2k + 2 words
+	uint32_t *r1 = q2 + 2 * k + 2;     // k + 1 words
+	uint32_t *r2 = r1 + k + 1;         // k + 1 words
+
+	// q2 := floor(x / b^(k - 1)) * mu, only the words that reach q3.
+	for (uint32_t i = 0; i < 2 * k + 2; i++)
+		q2[i] = 0;
+	for (uint32_t i = 0; i <= k; i++) {
+		uint32_t q1 = x[xlength - k - i];
+		uint64_t carry = 0;
+		for (uint32_t j = 0; j <= k; j++) {
+			uint64_t p = (uint64_t) q1 * mu[length - j] + q2[i + j] + carry;
+			q2[i + j] = (uint32_t) p;
+			carry = p >> 32;
+		}
+		q2[i + k + 1] = (uint32_t) carry;
+	}
+	uint32_t *q3 = q2 + k + 1;         // k + 1 words
+
+	// r1 := x mod b^(k + 1), r2 := q3 * m mod b^(k + 1).
+	for (uint32_t i = 0; i <= k; i++) {
+		r1[i] = x[xlength - 1 - i];
+		r2[i] = 0;
+	}
+	for (uint32_t i = 0; i <= k; i++) {
+		uint64_t carry = 0;
+		for (uint32_t j = 0; i + j <= k; j++) {
+			uint32_t mj = (j < k) ? m[length - 1 - j] : 0;
+			uint64_t p = (uint64_t) q3[i] * mj + r2[i + j] + carry;
+			r2[i + j] = (uint32_t) p;
+			carry = p >> 32;
+		}
+	}
+
+	// r1 := r1 - r2 mod b^(k + 1), then subtract m while r1 >= m.
+	uint64_t borrow = 0;
+	for (uint32_t i = 0; i <= k; i++) {
+		uint64_t t = (uint64_t) r1[i] - r2[i] - borrow;
+		r1[i] = (uint32_t) t;
+		borrow = t >> 63;
+	}
+	for (;;) {
+		int less = 0;
+		if (r1[k] == 0) {
+			for (int32_t i = (int32_t) k - 1; i >= 0; i--) {
+				uint32_t mi = m[length - 1 - (uint32_t) i];
+				if (r1[i] != mi) {
+					less = r1[i] < mi;
+					break;
+				}
+			}
+		}
+		if (less)
+			break;
+		borrow = 0;
+		for (uint32_t i = 0; i <= k; i++) {
+			uint32_t mi = (i < k) ? m[length - 1 - i] : 0;
+			uint64_t t = (uint64_t) r1[i] - mi - borrow;
+			r1[i] = (uint32_t) t;
+			borrow = t >> 63;
+		}
+	}
+
+	zero_array(length, r);
+	for (uint32_t i = 0; i < k; i++)
+		r[length - 1 - i] = r1[i];
+}
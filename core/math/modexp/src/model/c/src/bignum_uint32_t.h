@@ -8,6 +8,8 @@
 #ifndef BIGNUM_UINT32_T_H_
 #define BIGNUM_UINT32_T_H_
 
+#include <stdio.h>
+
 void modulus_array(uint32_t length, uint32_t *a, uint32_t *modulus, uint32_t *temp,
 		uint32_t *reminder);
 int greater_than_array(uint32_t length, uint32_t *a, uint32_t *b);
@@ -20,5 +22,25 @@ void copy_array(uint32_t length, uint32_t *src, uint32_t *dst);
 void debugArray(char *msg, uint32_t length, uint32_t *array);
 void assertArrayEquals(uint32_t length, uint32_t *expected, uint32_t *actual);
 void print_assert_array_stats(void);
+void assert_array_thread_stats(int *total, int *error);
+void assert_array_set_output(FILE *out);
+FILE *assert_array_output(void);
+void mul_array(uint32_t alength, uint32_t *a, uint32_t blength, uint32_t *b,
+		uint32_t *result);
+
+// Word based division. q, of alength words, may be NULL; r has mlength
+// words and may alias a, q may not. m must not be zero.
+#define DIVIDE_ARRAY_TEMP(alength, mlength) ((alength) + (mlength) + 1)
+void divide_array(uint32_t alength, uint32_t *a, uint32_t mlength, uint32_t *m,
+		uint32_t *temp, uint32_t *q, uint32_t *r);
+
+// Barrett reduction of 2 * length word values modulo m of length words,
+// with mu of length + 1 words computed once per modulus. The top
+// significant word of m must not be its only nonzero word.
+#define BARRETT_MU_TEMP(length) (8 * (length) + 4)
+#define BARRETT_REDUCE_TEMP(length) (4 * (length) + 4)
+void barrett_mu_array(uint32_t length, uint32_t *m, uint32_t *temp, uint32_t *mu);
+void barrett_reduce_array(uint32_t length, uint32_t *x, uint32_t *m, uint32_t *mu,
+		uint32_t *temp, uint32_t *r);
 
 #endif /* BIGNUM_UINT32_T_H_ */
@@ -2,8 +2,12 @@
 #include <stdlib.h>
 #include "bignum_uint32_t.h"
 #include "montgomery_array.h"
+#include "thread_pool.h"
 
-void mont_prod_array(uint32_t length, uint32_t *A, uint32_t *B, uint32_t *M, uint32_t *s) {
+// Bit serial reference version of the Montgomery product. The result
+// is not fully reduced, and the sum wraps if M + A does not fit in
+// length words.
+void mont_prod_array_bitserial(uint32_t length, uint32_t *A, uint32_t *B, uint32_t *M, uint32_t *s) {
 	zero_array(length, s);
 	for (int32_t wordIndex = ((int32_t) length) - 1; wordIndex >= 0; wordIndex--) {
 		for (int i = 0; i < 32; i++) {
@@ -31,7 +35,245 @@ void mont_prod_array(uint32_t length, uint32_t *A, uint32_t *B, uint32_t *M, uin
 	}
 }
 
-void m_residue_2_2N_array(uint32_t length, uint32_t N, uint32_t *M, uint32_t *temp,
+// Number of word level products on this thread since it started, for
+// the benchmarks and tests.
+static _Thread_local uint64_t mont_prod_counter = 0;
+
+uint64_t mont_prod_count(void) {
+	return mont_prod_counter;
+}
+
+// Number of heap allocations on this thread since it started, to show
+// that the workspace entry points do none.
+static _Thread_local uint64_t mont_alloc_counter = 0;
+
+uint64_t mont_alloc_count(void) {
+	return mont_alloc_counter;
+}
+
+static void *mont_calloc(size_t count, size_t size) {
+	mont_alloc_counter++;
+	return calloc(count, size);
+}
+
+// n0 = -M^-1 mod 2^32 for the least significant word of an odd
+// modulus, by Newton iteration. m0 is its own inverse mod 8, and each
+// step doubles the number of correct bits.
+uint32_t mont_n0_array(uint32_t length, uint32_t *M) {
+	uint32_t m0 = M[length - 1];
+	uint32_t inv = m0;
+	for (int i = 0; i < 4; i++)
+		inv *= 2 - m0 * inv;
+	return 0 - inv;
+}
+
+#ifdef MONT_PROD_FIXED
+__extension__ typedef unsigned __int128 uint128_t;
+
+// Use the fixed size kernels where there is one, see
+// mont_prod_fixed_kernels(). Per thread, so that a test turning them
+// off does not change the products of the others.
+static _Thread_local int mont_prod_fixed = 1;
+
+// The CIOS product on 64 bit limbs for arrays of 2 * limbs + 1 words
+// with the top word zero. limbs is a constant in each caller, so the
+// loops have fixed bounds and unroll.
+//
+// The limbs only give R = 2^(64 * limbs), a word short of the R of the
+// 32 bit version, so a last half step with the 32 bit n0 divides by
+// the remaining 2^32 to give the same result.
+static inline __attribute__((always_inline)) void mont_prod_cios_64(
+		const uint32_t limbs, uint32_t *A, uint32_t *B, uint32_t *M,
+		uint32_t n0, uint64_t *w, uint32_t *s) {
+	const uint32_t length = 2 * limbs + 1;
+	uint64_t *a = w;
+	uint64_t *b = a + limbs;
+	uint64_t *m = b + limbs;
+	uint64_t *t = m + limbs;         // limbs + 2
+	uint128_t p;
+
+	// Limbs least significant first.
+	for (uint32_t j = 0; j < limbs; j++) {
+		a[j] = A[length - 1 - 2 * j] | ((uint64_t) A[length - 2 - 2 * j] << 32);
+		b[j] = B[length - 1 - 2 * j] | ((uint64_t) B[length - 2 - 2 * j] << 32);
+		m[j] = M[length - 1 - 2 * j] | ((uint64_t) M[length - 2 - 2 * j] << 32);
+	}
+	for (uint32_t j = 0; j < limbs + 2; j++)
+		t[j] = 0;
+
+	// -M^-1 mod 2^64, one Newton step up from the 32 bit n0.
+	uint64_t inv = (uint32_t) (0 - n0);
+	inv *= 2 - m[0] * inv;
+	const uint64_t n0_64 = 0 - inv;
+
+	for (uint32_t i = 0; i < limbs; i++) {
+		uint64_t c = 0;
+
+		// t += A * b
+		for (uint32_t j = 0; j < limbs; j++) {
+			p = (uint128_t) a[j] * b[i] + t[j] + c;
+			t[j] = (uint64_t) p;
+			c = (uint64_t) (p >> 64);
+		}
+		p = (uint128_t) t[limbs] + c;
+		t[limbs] = (uint64_t) p;
+		t[limbs + 1] = (uint64_t) (p >> 64);
+
+		// t = (t + q * M) / 2^64
+		uint64_t q = t[0] * n0_64;
+		p = (uint128_t) q * m[0] + t[0];
+		c = (uint64_t) (p >> 64);
+		for (uint32_t j = 1; j < limbs; j++) {
+			p = (uint128_t) q * m[j] + t[j] + c;
+			t[j - 1] = (uint64_t) p;
+			c = (uint64_t) (p >> 64);
+		}
+		p = (uint128_t) t[limbs] + c;
+		t[limbs - 1] = (uint64_t) p;
+		t[limbs] = t[limbs + 1] + (uint64_t) (p >> 64);
+	}
+
+	// t = (t + q * M) / 2^32 for the top word, t stays below 2M.
+	uint64_t q = (uint32_t) ((uint32_t) t[0] * n0);
+	uint64_t c = 0;
+	for (uint32_t j = 0; j < limbs; j++) {
+		p = (uint128_t) q * m[j] + t[j] + c;
+		t[j] = (uint64_t) p;
+		c = (uint64_t) (p >> 64);
+	}
+	p = (uint128_t) t[limbs] + c;
+	t[limbs] = (uint64_t) p;
+	t[limbs + 1] = (uint64_t) (p >> 64);
+	for (uint32_t j = 0; j <= limbs; j++)
+		t[j] = (t[j] >> 32) | (t[j + 1] << 32);
+
+	// s = t - M, then put t back if that borrowed.
+	uint64_t borrow = 0;
+	for (uint32_t j = 0; j < limbs; j++) {
+		uint128_t d = (uint128_t) t[j] - m[j] - borrow;
+		a[j] = (uint64_t) d;
+		borrow = (uint64_t) (d >> 127);
+	}
+	uint64_t keep = 0 - ((t[limbs] - borrow) >> 63);
+	for (uint32_t j = 0; j < limbs; j++) {
+		uint64_t r = (t[j] & keep) | (a[j] & ~keep);
+		s[length - 1 - 2 * j] = (uint32_t) r;
+		s[length - 2 - 2 * j] = (uint32_t) (r >> 32);
+	}
+	s[0] = 0;
+}
+
+#define MONT_PROD_CIOS_FIXED(bits) \
+	static void mont_prod_cios_##bits(uint32_t *A, uint32_t *B, uint32_t *M, \
+			uint32_t n0, uint32_t *s) { \
+		uint64_t w[4 * ((bits) / 64) + 2]; \
+		mont_prod_cios_64((bits) / 64, A, B, M, n0, w, s); \
+	}
+
+MONT_PROD_CIOS_FIXED(512)
+MONT_PROD_CIOS_FIXED(1024)
+MONT_PROD_CIOS_FIXED(2048)
+MONT_PROD_CIOS_FIXED(4096)
+MONT_PROD_CIOS_FIXED(8192)
+#endif
+
+void mont_prod_fixed_kernels(int enable) {
+#ifdef MONT_PROD_FIXED
+	mont_prod_fixed = enable;
+#else
+	(void) enable;
+#endif
+}
+
+// Word level Montgomery product s = A * B * 2^(-32 * length) mod M, as
+// CIOS (Koc, Acar and Kaliski) with 64 bit intermediates. Each word of
+// B costs two passes over the array instead of up to 96 add and shift
+// passes in the bit serial version. n0 is from mont_n0_array() and t
+// is scratch space of length + 2 words.
+//
+// B must be less than M. The result is fully reduced, the final
+// subtraction done without a branch, and s may be the same array as A
+// or B.
+void mont_prod_cios_array(uint32_t length, uint32_t *A, uint32_t *B, uint32_t *M,
+		uint32_t n0, uint32_t *t, uint32_t *s) {
+	mont_prod_counter++;
+
+#ifdef MONT_PROD_FIXED
+	// The common RSA sizes, with the top word zero as in the tests.
+	if (mont_prod_fixed && (A[0] == 0) && (B[0] == 0) && (M[0] == 0)) {
+		switch (length) {
+		case 512 / 32 + 1:
+			mont_prod_cios_512(A, B, M, n0, s);
+			return;
+		case 1024 / 32 + 1:
+			mont_prod_cios_1024(A, B, M, n0, s);
+			return;
+		case 2048 / 32 + 1:
+			mont_prod_cios_2048(A, B, M, n0, s);
+			return;
+		case 4096 / 32 + 1:
+			mont_prod_cios_4096(A, B, M, n0, s);
+			return;
+		case 8192 / 32 + 1:
+			mont_prod_cios_8192(A, B, M, n0, s);
+			return;
+		}
+	}
+#endif
+
+	// t is kept least significant word first.
+	for (uint32_t j = 0; j < length + 2; j++)
+		t[j] = 0;
+
+	for (int32_t wordIndex = ((int32_t) length) - 1; wordIndex >= 0; wordIndex--) {
+		uint64_t b = B[wordIndex];
+		uint64_t c = 0;
+
+		// t += A * b
+		for (uint32_t j = 0; j < length; j++) {
+			c += t[j] + A[length - 1 - j] * b;
+			t[j] = (uint32_t) c;
+			c >>= 32;
+		}
+		c += t[length];
+		t[length] = (uint32_t) c;
+		t[length + 1] = (uint32_t) (c >> 32);
+
+		// t = (t + q * M) / 2^32, q chosen so that the low word is zero
+		uint64_t q = (uint32_t) (t[0] * n0);
+		c = (t[0] + q * M[length - 1]) >> 32;
+		for (uint32_t j = 1; j < length; j++) {
+			c += t[j] + q * M[length - 1 - j];
+			t[j - 1] = (uint32_t) c;
+			c >>= 32;
+		}
+		c += t[length];
+		t[length - 1] = (uint32_t) c;
+		t[length] = t[length + 1] + (uint32_t) (c >> 32);
+	}
+
+	// t < 2M here. s = t - M, then put t back if that borrowed.
+	uint64_t borrow = 0;
+	for (uint32_t j = 0; j < length; j++) {
+		uint64_t d = (uint64_t) t[j] - M[length - 1 - j] - borrow;
+		s[length - 1 - j] = (uint32_t) d;
+		borrow = d >> 63;
+	}
+	uint32_t keep = 0 - (uint32_t) ((t[length] - borrow) >> 63);
+	for (uint32_t j = 0; j < length; j++)
+		s[length - 1 - j] = (t[j] & keep) | (s[length - 1 - j] & ~keep);
+}
+
+int mont_prod_array(uint32_t length, uint32_t *A, uint32_t *B, uint32_t *M, uint32_t *s) {
+	uint32_t *t = mont_calloc(length + 2, sizeof(uint32_t));
+	if (t == NULL)
+		return -1;
+	mont_prod_cios_array(length, A, B, M, mont_n0_array(length, M), t, s);
+	free(t);
+	return 0;
+}
+
+void m_residue_2_2N_array_bitserial(uint32_t length, uint32_t N, uint32_t *M, uint32_t *temp,
 		uint32_t *Nr) {
 	zero_array(length, Nr);
 	Nr[length - 1] = 1; // Nr = 1 == 2**(2N-2N)
@@ -43,6 +285,16 @@ void m_residue_2_2N_array(uint32_t length, uint32_t N, uint32_t *M, uint32_t *te
 	// Nr = (2 ** 2N) mod M
 }
 
+// Nr := 2 ** 2N mod M with one word based division. temp holds
+// M_RESIDUE_TEMP(length, N) words.
+void m_residue_2_2N_array(uint32_t length, uint32_t N, uint32_t *M, uint32_t *temp,
+		uint32_t *Nr) {
+	const uint32_t alength = (2 * N) / 32 + 1;
+	zero_array(alength, temp);
+	temp[0] = 1u << ((2 * N) % 32);
+	divide_array(alength, temp, length, M, temp + alength, NULL, Nr);
+}
+
 uint32_t findN(uint32_t length, uint32_t *E) {
 	uint32_t n = 0;
 	for (uint32_t i = 0; i < 32 * length; i++) {
@@ -55,140 +307,424 @@ uint32_t findN(uint32_t length, uint32_t *E) {
 	return n;
 }
 
-void mont_exp_array(uint32_t length, uint32_t *X, uint32_t *E, uint32_t *M,
-		uint32_t *Nr, uint32_t *P, uint32_t *ONE, uint32_t *temp,
-		uint32_t *temp2, uint32_t *Z) {
+// Words of workspace for a context: M, Nr, ONE, P and D of length
+// words, T of length + 2, the scratch space for the residue and a
+// table for windows of up to max_window bits, none for 0.
+uint32_t mont_ctx_words(uint32_t length, uint32_t max_window) {
+	uint32_t words = 5 * length + (length + 2) + M_RESIDUE_TEMP(length, 32 * length);
+	if ((max_window > 0) && (max_window <= MONT_EXP_MAX_WINDOW))
+		words += (1u << max_window) * length;
+	return words;
+}
+
+// Set up a context for the modulus M of length words in the caller's
+// workspace: a copy of M, Nr = 2 ** 2N mod M and n0. Nothing is
+// allocated, and nothing needs to be freed.
+int mont_ctx_init(mont_ctx *ctx, uint32_t length, uint32_t *M,
+		uint32_t max_window, uint32_t *work, uint32_t words) {
+	if (max_window > MONT_EXP_MAX_WINDOW)
+		return -1;
+	if (words < mont_ctx_words(length, max_window))
+		return -1;
+	zero_array(mont_ctx_words(length, max_window), work);
+
+	ctx->length = length;
+	ctx->M = work;
+	ctx->Nr = ctx->M + length;
+	ctx->ONE = ctx->Nr + length;
+	ctx->P = ctx->ONE + length;
+	ctx->D = ctx->P + length;
+	ctx->T = ctx->D + length;
+	ctx->scratch = ctx->T + length + 2;
+	ctx->table = ctx->scratch + M_RESIDUE_TEMP(length, 32 * length);
+	ctx->table_count = (max_window > 0) ? 1u << max_window : 0;
+	ctx->work = NULL;
+	ctx->heap_table = NULL;
+
+	copy_array(length, M, ctx->M);
+	// Nr := 2 ** 2N mod M
+	m_residue_2_2N_array(length, 32 * length, ctx->M, ctx->scratch, ctx->Nr);
+	ctx->n0 = mont_n0_array(length, ctx->M);
+	ctx->ONE[length - 1] = 1;
+	return 0;
+}
+
+// The same on the heap, with the window table allocated when first
+// needed. NULL if out of memory.
+mont_ctx *mont_ctx_new(uint32_t length, uint32_t *M) {
+	const uint32_t words = mont_ctx_words(length, 0);
+	mont_ctx *ctx = mont_calloc(1, sizeof(mont_ctx));
+	uint32_t *work = mont_calloc(words, sizeof(uint32_t));
+	if ((ctx == NULL) || (work == NULL)) {
+		free(ctx);
+		free(work);
+		return NULL;
+	}
+	mont_ctx_init(ctx, length, M, 0, work, words);
+	ctx->work = work;
+	return ctx;
+}
+
+// Frees a context from mont_ctx_new().
+void mont_ctx_free(mont_ctx *ctx) {
+	if (ctx == NULL)
+		return;
+	free(ctx->heap_table);
+	free(ctx->work);
+	free(ctx);
+}
+
+// The window table, with room for at least count entries. A context
+// from mont_ctx_new() grows it on the heap, one in the caller's
+// workspace has the table it was set up with. NULL if neither fits.
+static uint32_t *mont_ctx_table(mont_ctx *ctx, uint32_t count) {
+	if (count <= ctx->table_count)
+		return ctx->table;
+	if (ctx->work == NULL)
+		return NULL;
+	uint32_t *table = mont_calloc(count * ctx->length, sizeof(uint32_t));
+	if (table == NULL)
+		return NULL;
+	free(ctx->heap_table);
+	ctx->heap_table = table;
+	ctx->table = table;
+	ctx->table_count = count;
+	return table;
+}
+
+// Binary right to left exponentiation of X, of the context length,
+// to the low n bits of E, of explength words.
+static void mod_exp_ctx_bits(mont_ctx *ctx, uint32_t explength, uint32_t n,
+		uint32_t *X, uint32_t *E, uint32_t *Z) {
+	const uint32_t length = ctx->length;
+	const uint32_t n0 = ctx->n0;
+	uint32_t *M = ctx->M;
+	uint32_t *P = ctx->P;
+	uint32_t *T = ctx->T;
 	//debugArray("X ", length, X);
-	//debugArray("E ", length, E);
+	//debugArray("E ", explength, E);
 	//debugArray("M ", length, M);
 
-	// 1. Nr := 2 ** 2N mod M
-	const uint32_t N = 32 * length;
-	m_residue_2_2N_array(length, N, M, temp, Nr);
-	//debugArray("Nr", length, Nr);
+	// 1. Nr := 2 ** 2N mod M, from the context
 
 	// 2. Z0 := MontProd( 1, Nr, M )
-	zero_array(length, ONE);
-	ONE[length - 1] = 1;
-	mont_prod_array(length, ONE, Nr, M, Z);
+	mont_prod_cios_array(length, ctx->ONE, ctx->Nr, M, n0, T, Z);
 	//debugArray("Z0", length, Z);
 
 	// 3. P0 := MontProd( X, Nr, M );
-	mont_prod_array(length, X, Nr, M, P);
+	mont_prod_cios_array(length, X, ctx->Nr, M, n0, T, P);
 	//debugArray("P0", length, P);
 
 	// 4. for i = 0 to n-1 loop
-	const uint32_t n = findN(length, E); //loop optimization for low values of E. Not necessary.
 	for (uint32_t i = 0; i < n; i++) {
-		uint32_t ei_ = E[length - 1 - (i / 32)];
+		uint32_t ei_ = E[explength - 1 - (i / 32)];
 		uint32_t ei = (ei_ >> (i % 32)) & 1;
 		// 6. if (ei = 1) then Zi+1 := MontProd ( Zi, Pi, M) else Zi+1 := Zi
 		if (ei == 1) {
-			mont_prod_array(length, Z, P, M, temp2);
-			copy_array(length, temp2, Z);
+			mont_prod_cios_array(length, Z, P, M, n0, T, Z);
 			//debugArray("Z ", length, Z);
 		}
 		// 5. Pi+1 := MontProd( Pi, Pi, M );
-		mont_prod_array(length, P, P, M, temp2);
-		copy_array(length, temp2, P);
+		mont_prod_cios_array(length, P, P, M, n0, T, P);
 		//debugArray("P ", length, P);
 		// 7. end for
 	}
 	// 8. Zn := MontProd( 1, Zn, M );
-	mont_prod_array(length, ONE, Z, M, temp2);
-	copy_array(length, temp2, Z);
+	mont_prod_cios_array(length, ctx->ONE, Z, M, n0, T, Z);
 	//debugArray("Z ", length, Z);
 	// 9. RETURN Zn
 
 }
 
-// Experimental version where we add explicit lengths.
-void mont_exp_array2(uint32_t explength, uint32_t modlength, uint32_t *X, uint32_t *E, uint32_t *M,
-		uint32_t *Nr, uint32_t *P, uint32_t *ONE, uint32_t *temp,
-		uint32_t *temp2, uint32_t *Z) {
-	//debugArray("X ", length, X);
-	//debugArray("E ", length, E);
-	//debugArray("M ", length, M);
+// Stops after the highest set bit of E.
+void mod_exp_ctx(mont_ctx *ctx, uint32_t explength, uint32_t *X, uint32_t *E, uint32_t *Z) {
+	mod_exp_ctx_bits(ctx, explength, findN(explength, E), X, E, Z);
+}
 
-	// 1. Nr := 2 ** 2N mod M
-	const uint32_t N = 32 * modlength;
-	m_residue_2_2N_array(modlength, N, M, temp, Nr);
-	//debugArray("Nr", length, Nr);
+// Runs over all 32 * explength bits of E, whatever their value.
+void mod_exp_array2_ctx(mont_ctx *ctx, uint32_t explength, uint32_t *X,
+		uint32_t *E, uint32_t *Z) {
+	mod_exp_ctx_bits(ctx, explength, 32 * explength, X, E, Z);
+}
 
-	// 2. Z0 := MontProd( 1, Nr, M )
-	zero_array(modlength, ONE);
-	ONE[modlength - 1] = 1;
-	mont_prod_array(modlength, ONE, Nr, M, Z);
-	//debugArray("Z0", length, Z);
+int mod_exp_array(uint32_t length, uint32_t *X, uint32_t *E, uint32_t *M, uint32_t *Z) {
+	mont_ctx *ctx = mont_ctx_new(length, M);
+	if (ctx == NULL)
+		return -1;
+	mod_exp_ctx(ctx, length, X, E, Z);
+	mont_ctx_free(ctx);
+	return 0;
+}
 
-	// 3. P0 := MontProd( X, Nr, M );
-	mont_prod_array(modlength, X, Nr, M, P);
-	//debugArray("P0", length, P);
+static void mod_exp_job_run(void *arg, uint32_t index) {
+	mod_exp_job *job = (mod_exp_job *) arg + index;
+	job->result = mod_exp_array(job->length, job->X, job->E, job->M, job->Z);
+}
 
-	// 4. for i = 0 to explength - 1 loop
-	for (uint32_t i = 0; i < (explength * 32); i++) {
-		uint32_t ei_ = E[explength - 1 - (i / 32)];
-		uint32_t ei = (ei_ >> (i % 32)) & 1;
-		// 6. if (ei = 1) then Zi+1 := MontProd ( Zi, Pi, M) else Zi+1 := Zi
-		if (ei == 1) {
-			mont_prod_array(modlength, Z, P, M, temp2);
-			copy_array(modlength, temp2, Z);
-			//debugArray("Z ", length, Z);
+int mod_exp_batch(mod_exp_job *jobs, uint32_t count, uint32_t threads) {
+	thread_pool_run(threads, count, mod_exp_job_run, jobs);
+	for (uint32_t i = 0; i < count; i++)
+		if (jobs[i].result != 0)
+			return -1;
+	return 0;
+}
+
+// Experimental version with explicit explength separate from modlength.
+int mod_exp_array2(uint32_t explength, uint32_t modlength, uint32_t *X, uint32_t *E, uint32_t *M, uint32_t *Z) {
+	mont_ctx *ctx = mont_ctx_new(modlength, M);
+	if (ctx == NULL)
+		return -1;
+	mod_exp_array2_ctx(ctx, explength, X, E, Z);
+	mont_ctx_free(ctx);
+	return 0;
+}
+
+// Bits pos to pos + count - 1 of E, counting from the least
+// significant bit, as an integer. Bits past the end of E are zero.
+static uint32_t exp_bits(uint32_t length, uint32_t *E, uint32_t pos, uint32_t count) {
+	uint32_t bits = 0;
+	for (uint32_t k = 0; k < count; k++) {
+		uint32_t i = pos + k;
+		if (i < 32 * length)
+			bits |= ((E[length - 1 - (i / 32)] >> (i % 32)) & 1) << k;
+	}
+	return bits;
+}
+
+// Z := table[index] for a table of count arrays, reading every entry
+// so that the memory access pattern does not depend on index.
+static void select_array(uint32_t length, uint32_t count, uint32_t *table,
+		uint32_t index, uint32_t *Z) {
+	zero_array(length, Z);
+	for (uint32_t k = 0; k < count; k++) {
+		uint32_t mask = 0 - (uint32_t) (k == index);
+		for (uint32_t j = 0; j < length; j++)
+			Z[j] |= table[k * length + j] & mask;
+	}
+}
+
+// Fixed window exponentiation, for private exponents. All of E is
+// scanned, window bits at a time from the top, with window squarings
+// and one product per window, and the table entry is selected without
+// a data dependent access. The sequence of products thus depends only
+// on the lengths and the window width.
+//
+// The table holds X^0 .. X^(2^window - 1) in Montgomery form, which
+// costs 2^window - 1 products.
+int mod_exp_ctx_fixed_window(mont_ctx *ctx, uint32_t window, uint32_t explength,
+		uint32_t *X, uint32_t *E, uint32_t *Z) {
+	if ((window < 1) || (window > MONT_EXP_MAX_WINDOW))
+		return -1;
+	const uint32_t length = ctx->length;
+	const uint32_t n0 = ctx->n0;
+	const uint32_t count = 1u << window;
+	uint32_t *M = ctx->M;
+	uint32_t *D = ctx->D;
+	uint32_t *T = ctx->T;
+	uint32_t *table = mont_ctx_table(ctx, count);
+	if (table == NULL)
+		return -1;
+
+	// 1. table[k] := MontProd( X^k, Nr, M )
+	mont_prod_cios_array(length, ctx->ONE, ctx->Nr, M, n0, T, table);
+	mont_prod_cios_array(length, X, ctx->Nr, M, n0, T, table + length);
+	for (uint32_t k = 2; k < count; k++)
+		mont_prod_cios_array(length, table + (k - 1) * length,
+				table + length, M, n0, T, table + k * length);
+
+	// 2. for each window from the top: Z := Z^(2^window) * table[digit]
+	const uint32_t windows = (32 * explength + window - 1) / window;
+	for (int32_t w = ((int32_t) windows) - 1; w >= 0; w--) {
+		uint32_t digit = exp_bits(explength, E, (uint32_t) w * window, window);
+		select_array(length, count, table, digit, D);
+		if (w == ((int32_t) windows) - 1) {
+			copy_array(length, D, Z);
+		} else {
+			for (uint32_t k = 0; k < window; k++)
+				mont_prod_cios_array(length, Z, Z, M, n0, T, Z);
+			mont_prod_cios_array(length, Z, D, M, n0, T, Z);
 		}
-		// 5. Pi+1 := MontProd( Pi, Pi, M );
-		mont_prod_array(modlength, P, P, M, temp2);
-		copy_array(modlength, temp2, P);
-		//debugArray("P ", length, P);
-		// 7. end for
 	}
-	// 8. Zn := MontProd( 1, Zn, M );
-	mont_prod_array(modlength, ONE, Z, M, temp2);
-	copy_array(modlength, temp2, Z);
-	//debugArray("Z ", length, Z);
-	// 9. RETURN Zn
 
+	// 3. Z := MontProd( 1, Z, M )
+	mont_prod_cios_array(length, ctx->ONE, Z, M, n0, T, Z);
+	return 0;
 }
 
-void die(const char *c) {
-	printf("Fatal error: %s\n", c);
-	exit(1);
+int mod_exp_array_fixed_window(uint32_t explength, uint32_t modlength,
+		uint32_t window, uint32_t *X, uint32_t *E, uint32_t *M, uint32_t *Z) {
+	mont_ctx *ctx = mont_ctx_new(modlength, M);
+	if (ctx == NULL)
+		return -1;
+	int ret = mod_exp_ctx_fixed_window(ctx, window, explength, X, E, Z);
+	mont_ctx_free(ctx);
+	return ret;
 }
 
-void mod_exp_array(uint32_t length, uint32_t *X, uint32_t *E, uint32_t *M, uint32_t *Z) {
-	uint32_t *Nr = calloc(length, sizeof(uint32_t));
-	uint32_t *P = calloc(length, sizeof(uint32_t));
-	uint32_t *ONE = calloc(length, sizeof(uint32_t));
-	uint32_t *temp = calloc(length, sizeof(uint32_t));
-	uint32_t *temp2 = calloc(length, sizeof(uint32_t));
-	if (Nr == NULL) die("calloc");
-	if (P == NULL) die("calloc");
-	if (ONE == NULL) die("calloc");
-	if (temp == NULL) die("calloc");
-	if (temp2 == NULL) die("calloc");
-	mont_exp_array(length, X, E, M, Nr, P, ONE, temp, temp2, Z);
-	free(Nr);
-	free(P);
-	free(ONE);
-	free(temp);
-	free(temp2);
+// Sliding window exponentiation, for public exponents. Runs of zero
+// bits cost one squaring each, and each window starts and ends with a
+// set bit, so it takes one product per window of up to window bits.
+// The work done depends on E.
+//
+// The table holds the odd powers X^1, X^3 .. X^(2^window - 1) in
+// Montgomery form, which costs 2^(window - 1) products.
+int mod_exp_ctx_sliding_window(mont_ctx *ctx, uint32_t window, uint32_t explength,
+		uint32_t *X, uint32_t *E, uint32_t *Z) {
+	if ((window < 1) || (window > MONT_EXP_MAX_WINDOW))
+		return -1;
+	const uint32_t length = ctx->length;
+	const uint32_t n0 = ctx->n0;
+	const uint32_t count = 1u << (window - 1);
+	uint32_t *M = ctx->M;
+	uint32_t *X2 = ctx->D;
+	uint32_t *T = ctx->T;
+	uint32_t *table = mont_ctx_table(ctx, count);
+	if (table == NULL)
+		return -1;
+
+	// 1. table[k] := MontProd( X^(2k+1), Nr, M )
+	mont_prod_cios_array(length, X, ctx->Nr, M, n0, T, table);
+	if (count > 1)
+		mont_prod_cios_array(length, table, table, M, n0, T, X2);
+	for (uint32_t k = 1; k < count; k++)
+		mont_prod_cios_array(length, table + (k - 1) * length, X2, M,
+				n0, T, table + k * length);
+
+	// 2. from the top bit of E: square for a zero bit, or take the
+	// longest window ending in a set bit and multiply by its power.
+	// The first window is copied instead of multiplied into 1.
+	int started = 0;
+	int32_t i = ((int32_t) findN(explength, E)) - 1;
+	while (i >= 0) {
+		if (exp_bits(explength, E, (uint32_t) i, 1) == 0) {
+			mont_prod_cios_array(length, Z, Z, M, n0, T, Z);
+			i--;
+			continue;
+		}
+		int32_t l = (i - (int32_t) window + 1 > 0) ? i - (int32_t) window + 1 : 0;
+		while (exp_bits(explength, E, (uint32_t) l, 1) == 0)
+			l++;
+		uint32_t width = (uint32_t) (i - l + 1);
+		uint32_t *power = table + (exp_bits(explength, E, (uint32_t) l, width) >> 1) * length;
+		if (started) {
+			for (uint32_t k = 0; k < width; k++)
+				mont_prod_cios_array(length, Z, Z, M, n0, T, Z);
+			mont_prod_cios_array(length, Z, power, M, n0, T, Z);
+		} else {
+			copy_array(length, power, Z);
+			started = 1;
+		}
+		i = l - 1;
+	}
+
+	// 3. Z := MontProd( 1, Z, M ), or 1 mod M for E = 0
+	if (started)
+		mont_prod_cios_array(length, ctx->ONE, Z, M, n0, T, Z);
+	else
+		modulus_array(length, ctx->ONE, M, ctx->P, Z);
+	return 0;
 }
 
-// Experimental version with explicit explength separate from modlength.
-void mod_exp_array2(uint32_t explength, uint32_t modlength, uint32_t *X, uint32_t *E, uint32_t *M, uint32_t *Z) {
-	uint32_t *Nr = calloc(modlength, sizeof(uint32_t));
-	uint32_t *P = calloc(modlength, sizeof(uint32_t));
-	uint32_t *ONE = calloc(modlength, sizeof(uint32_t));
-	uint32_t *temp = calloc(modlength, sizeof(uint32_t));
-	uint32_t *temp2 = calloc(modlength, sizeof(uint32_t));
-	if (Nr == NULL) die("calloc");
-	if (P == NULL) die("calloc");
-	if (ONE == NULL) die("calloc");
-	if (temp == NULL) die("calloc");
-	if (temp2 == NULL) die("calloc");
-	mont_exp_array2(explength, modlength, X, E, M, Nr, P, ONE, temp, temp2, Z);
-	free(Nr);
-	free(P);
-	free(ONE);
-	free(temp);
-	free(temp2);
+int mod_exp_array_sliding_window(uint32_t explength, uint32_t modlength,
+		uint32_t window, uint32_t *X, uint32_t *E, uint32_t *M, uint32_t *Z) {
+	mont_ctx *ctx = mont_ctx_new(modlength, M);
+	if (ctx == NULL)
+		return -1;
+	int ret = mod_exp_ctx_sliding_window(ctx, window, explength, X, E, Z);
+	mont_ctx_free(ctx);
+	return ret;
+}
+
+// One half of a CRT exponentiation, Z := (X mod M)^D mod M for X of
+// xlength words, at most four times the context length, and D of the
+// context length. This is what the hardware computes in CRT mode.
+int mod_exp_crt_half(mont_ctx *ctx, uint32_t xlength, uint32_t *X, uint32_t *D,
+		uint32_t *Z) {
+	if (DIVIDE_ARRAY_TEMP(xlength, ctx->length) > M_RESIDUE_TEMP(ctx->length, 32 * ctx->length))
+		return -1;
+	divide_array(xlength, X, ctx->length, ctx->M, ctx->scratch, NULL, ctx->D);
+	mod_exp_ctx(ctx, ctx->length, ctx->D, D, Z);
+	return 0;
+}
+
+// Words of workspace for a CRT context: the contexts of the two
+// halves, m1, m2 and h of halflength words, the division scratch
+// space and r of 2 * halflength.
+uint32_t mont_crt_ctx_words(uint32_t halflength) {
+	return 2 * mont_ctx_words(halflength, 0) + 3 * halflength
+			+ DIVIDE_ARRAY_TEMP(halflength, halflength) + 2 * halflength;
+}
+
+// Set up a CRT context for the key halves P and Q in the caller's
+// workspace. Nothing is allocated.
+int mont_crt_ctx_init(mont_crt_ctx *ctx, uint32_t halflength, uint32_t *P,
+		uint32_t *Q, uint32_t *work, uint32_t words) {
+	const uint32_t half_words = mont_ctx_words(halflength, 0);
+	if (words < mont_crt_ctx_words(halflength))
+		return -1;
+
+	ctx->halflength = halflength;
+	mont_ctx_init(&ctx->p, halflength, P, 0, work, half_words);
+	mont_ctx_init(&ctx->q, halflength, Q, 0, work + half_words, half_words);
+	ctx->m1 = work + 2 * half_words;
+	ctx->m2 = ctx->m1 + halflength;
+	ctx->h = ctx->m2 + halflength;
+	ctx->temp = ctx->h + halflength;
+	ctx->r = ctx->temp + DIVIDE_ARRAY_TEMP(halflength, halflength);
+	return 0;
+}
+
+// RSA private key operation with the Chinese remainder theorem and
+// Garner's recombination, with U = Q^-1 mod P as in PKCS #1:
+//   m1 := X^DP mod P, m2 := X^DQ mod Q
+//   h := U (m1 - m2) mod P, Z := m2 + h Q
+// X and Z have length words, DP, DQ and U halflength words, and
+// 2 * halflength must be at least length.
+int mod_exp_crt_ctx(mont_crt_ctx *ctx, uint32_t length, uint32_t *X,
+		uint32_t *DP, uint32_t *DQ, uint32_t *U, uint32_t *Z) {
+	const uint32_t halflength = ctx->halflength;
+	uint32_t *P = ctx->p.M;
+	uint32_t *Q = ctx->q.M;
+	uint32_t *h = ctx->h;
+	uint32_t *temp = ctx->temp;
+	uint32_t *r = ctx->r;
+
+	// 1. The two half size exponentiations.
+	if ((mod_exp_crt_half(&ctx->p, length, X, DP, ctx->m1) != 0)
+			|| (mod_exp_crt_half(&ctx->q, length, X, DQ, ctx->m2) != 0))
+		return -1;
+
+	// 2. h := m1 - (m2 mod P) mod P, adding P back on a borrow.
+	divide_array(halflength, ctx->m2, halflength, P, temp, NULL, h);
+	int borrow = greater_than_array(halflength, h, ctx->m1);
+	sub_array(halflength, ctx->m1, h, h);
+	if (borrow)
+		add_array(halflength, h, P, h);
+
+	// 3. h := U h mod P, as MontProd( MontProd( U, h, P ), Nr, P ).
+	mont_prod_cios_array(halflength, U, h, P, ctx->p.n0, ctx->p.T, h);
+	mont_prod_cios_array(halflength, h, ctx->p.Nr, P, ctx->p.n0, ctx->p.T, h);
+
+	// 4. Z := m2 + h Q, which is below P Q.
+	mul_array(halflength, h, halflength, Q, r);
+	zero_array(halflength, temp);
+	copy_array(halflength, ctx->m2, temp + halflength);
+	add_array(2 * halflength, r, temp, r);
+	copy_array(length, r + 2 * halflength - length, Z);
+	return 0;
+}
+
+// The same with a context set up for the call.
+int mod_exp_crt_array(uint32_t length, uint32_t halflength, uint32_t *X,
+		uint32_t *P, uint32_t *Q, uint32_t *DP, uint32_t *DQ, uint32_t *U,
+		uint32_t *Z) {
+	const uint32_t words = mont_crt_ctx_words(halflength);
+	uint32_t *work = mont_calloc(words, sizeof(uint32_t));
+	mont_crt_ctx ctx;
+	if (work == NULL)
+		return -1;
+	mont_crt_ctx_init(&ctx, halflength, P, Q, work, words);
+	int ret = mod_exp_crt_ctx(&ctx, length, X, DP, DQ, U, Z);
+	free(work);
+	return ret;
 }
@@ -8,14 +8,132 @@
 #ifndef MONTGOMERY_ARRAY_H_
 #define MONTGOMERY_ARRAY_H_
 
-void mont_prod_array(uint32_t length, uint32_t *A, uint32_t *B, uint32_t *M,
+int mont_prod_array(uint32_t length, uint32_t *A, uint32_t *B, uint32_t *M,
 		uint32_t *s);
-void mod_exp_array(uint32_t length, uint32_t *X, uint32_t *E, uint32_t *M, uint32_t *Z);
+void mont_prod_array_bitserial(uint32_t length, uint32_t *A, uint32_t *B, uint32_t *M,
+		uint32_t *s);
+uint32_t mont_n0_array(uint32_t length, uint32_t *M);
+void mont_prod_cios_array(uint32_t length, uint32_t *A, uint32_t *B, uint32_t *M,
+		uint32_t n0, uint32_t *t, uint32_t *s);
+// Nr := 2 ** 2N mod M. The bit serial version takes length words of
+// temp, the word based one M_RESIDUE_TEMP.
+#define M_RESIDUE_TEMP(length, N) (2 * ((2 * (N)) / 32 + 1) + (length) + 1)
+void m_residue_2_2N_array(uint32_t length, uint32_t N, uint32_t *M, uint32_t *temp,
+		uint32_t *Nr);
+void m_residue_2_2N_array_bitserial(uint32_t length, uint32_t N, uint32_t *M,
+		uint32_t *temp, uint32_t *Nr);
+// Fixed size product kernels on 64 bit limbs for the 512, 1024, 2048,
+// 4096 and 8192 bit moduli, where the compiler has 128 bit integers. The
+// generic product is the fallback for other sizes, and for all sizes
+// after mont_prod_fixed_kernels(0).
+#if defined(__SIZEOF_INT128__) && !defined(MONT_PROD_NO_FIXED)
+#define MONT_PROD_FIXED
+#endif
+void mont_prod_fixed_kernels(int enable);
+
+// The functions that return int return 0, or -1 if out of memory or
+// given a bad window.
+int mod_exp_array(uint32_t length, uint32_t *X, uint32_t *E, uint32_t *M, uint32_t *Z);
+
+// A batch of independent exponentiations Z = X ** E mod M, run with
+// mod_exp_array on up to threads threads. Each job gets its own result,
+// and the batch returns -1 if any of them failed. The jobs must not
+// share Z.
+typedef struct mod_exp_job {
+	uint32_t length;
+	uint32_t *X;
+	uint32_t *E;
+	uint32_t *M;
+	uint32_t *Z;
+	int result;
+} mod_exp_job;
+
+int mod_exp_batch(mod_exp_job *jobs, uint32_t count, uint32_t threads);
 
 
 void mont_prod_array2(uint32_t explength, uint32_t modlength, uint32_t *A, uint32_t *B, uint32_t *M,
 		uint32_t *s);
 
-void mod_exp_array2(uint32_t explength, uint32_t modlength, uint32_t *X, uint32_t *E, uint32_t *M, uint32_t *Z);
+int mod_exp_array2(uint32_t explength, uint32_t modlength, uint32_t *X, uint32_t *E, uint32_t *M, uint32_t *Z);
+
+// Windowed exponentiation, window is 1 .. MONT_EXP_MAX_WINDOW bits.
+// The fixed window version does the same products for any E of the
+// given length, for private keys.
+#define MONT_EXP_MAX_WINDOW 8
+
+int mod_exp_array_fixed_window(uint32_t explength, uint32_t modlength,
+		uint32_t window, uint32_t *X, uint32_t *E, uint32_t *M, uint32_t *Z);
+int mod_exp_array_sliding_window(uint32_t explength, uint32_t modlength,
+		uint32_t window, uint32_t *X, uint32_t *E, uint32_t *M, uint32_t *Z);
+
+uint64_t mont_prod_count(void);
+uint64_t mont_alloc_count(void);
+
+// A modulus with Nr = 2 ** 2N mod M, n0 and the scratch space for the
+// products, set up once per key and reused for every exponentiation
+// with it. Not safe to share between threads.
+//
+// mont_ctx_init() sets one up in a workspace of mont_ctx_words() words
+// from the caller, with a fixed window table, and the exponentiations
+// on it then touch no heap. mont_ctx_new() allocates it instead.
+typedef struct mont_ctx {
+	uint32_t length;
+	uint32_t *M;
+	uint32_t *Nr;
+	uint32_t *ONE;
+	uint32_t n0;
+	uint32_t *P;
+	uint32_t *D;
+	uint32_t *T;        // length + 2 words
+	uint32_t *scratch;  // M_RESIDUE_TEMP words
+	uint32_t *table;    // window table
+	uint32_t table_count;
+	uint32_t *work;     // from mont_ctx_new(), else NULL
+	uint32_t *heap_table;
+} mont_ctx;
+
+uint32_t mont_ctx_words(uint32_t length, uint32_t max_window);
+int mont_ctx_init(mont_ctx *ctx, uint32_t length, uint32_t *M,
+		uint32_t max_window, uint32_t *work, uint32_t words);
+mont_ctx *mont_ctx_new(uint32_t length, uint32_t *M);
+void mont_ctx_free(mont_ctx *ctx);
+void mod_exp_ctx(mont_ctx *ctx, uint32_t explength, uint32_t *X, uint32_t *E,
+		uint32_t *Z);
+int mod_exp_ctx_fixed_window(mont_ctx *ctx, uint32_t window,
+		uint32_t explength, uint32_t *X, uint32_t *E, uint32_t *Z);
+int mod_exp_ctx_sliding_window(mont_ctx *ctx, uint32_t window,
+		uint32_t explength, uint32_t *X, uint32_t *E, uint32_t *Z);
+// mod_exp_array2 on a context.
+void mod_exp_array2_ctx(mont_ctx *ctx, uint32_t explength, uint32_t *X,
+		uint32_t *E, uint32_t *Z);
+
+// RSA private key operation with the Chinese remainder theorem. U is
+// Q^-1 mod P, X and Z have length words and the key halves halflength.
+//
+// mont_crt_ctx_init() sets up the contexts of the two halves and the
+// temporaries of the recombination in a workspace of
+// mont_crt_ctx_words() words from the caller, and mod_exp_crt_ctx()
+// then touches no heap. mod_exp_crt_array() sets one up per call.
+typedef struct mont_crt_ctx {
+	uint32_t halflength;
+	mont_ctx p;
+	mont_ctx q;
+	uint32_t *m1;
+	uint32_t *m2;
+	uint32_t *h;
+	uint32_t *temp;     // DIVIDE_ARRAY_TEMP(halflength, halflength) words
+	uint32_t *r;        // 2 * halflength words
+} mont_crt_ctx;
+
+int mod_exp_crt_half(mont_ctx *ctx, uint32_t xlength, uint32_t *X, uint32_t *D,
+		uint32_t *Z);
+uint32_t mont_crt_ctx_words(uint32_t halflength);
+int mont_crt_ctx_init(mont_crt_ctx *ctx, uint32_t halflength, uint32_t *P,
+		uint32_t *Q, uint32_t *work, uint32_t words);
+int mod_exp_crt_ctx(mont_crt_ctx *ctx, uint32_t length, uint32_t *X,
+		uint32_t *DP, uint32_t *DQ, uint32_t *U, uint32_t *Z);
+int mod_exp_crt_array(uint32_t length, uint32_t halflength, uint32_t *X,
+		uint32_t *P, uint32_t *Q, uint32_t *DP, uint32_t *DQ, uint32_t *U,
+		uint32_t *Z);
 
 #endif /* MONTGOMERY_ARRAY_H_ */
@@ -0,0 +1,455 @@
+/*
+ * montgomery_array_bench.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+// Benchmark of the Montgomery products in the modexp C model. Times
+// the bit serial and the word level (CIOS) product for a range of
+// operand sizes, and a modexp with e = 65537 using the latter.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include "montgomery_array.h"
+#include "bignum_uint32_t.h"
+#include "montgomery_array_bench.h"
+
+// Run each measurement for at least this long.
+#define BENCH_MIN_SECONDS 0.2
+
+// Window for the repeated signing benchmark.
+#define BENCH_SIGN_WINDOW 5
+#define BENCH_SIGN_ROUNDS 5
+
+typedef void (*mont_prod_fn)(uint32_t length, uint32_t *A, uint32_t *B,
+		uint32_t *M, uint32_t *s);
+
+static uint32_t random_word(void) {
+	return ((uint32_t) rand() << 16) ^ (uint32_t) rand();
+}
+
+// Random operands below a random odd modulus of the given size. The
+// top word is zero, as in the tests, so the bit serial sum does not
+// wrap.
+static void random_operands(uint32_t length, uint32_t *A, uint32_t *B,
+		uint32_t *M, uint32_t *temp) {
+	for (uint32_t i = 0; i < length; i++) {
+		M[i] = random_word();
+		A[i] = random_word();
+		B[i] = random_word();
+	}
+	M[0] = 0;
+	M[1] |= 0x80000000;
+	M[length - 1] |= 1;
+	A[0] = 0;
+	B[0] = 0;
+	modulus_array(length, A, M, temp, A);
+	modulus_array(length, B, M, temp, B);
+}
+
+static void prod_cios(uint32_t length, uint32_t *A, uint32_t *B, uint32_t *M,
+		uint32_t *s) {
+	mont_prod_array(length, A, B, M, s);
+}
+
+typedef void (*reduce_fn)(uint32_t length, uint32_t *X, uint32_t *M,
+		uint32_t *mu, uint32_t *temp, uint32_t *R);
+
+static void reduce_bitserial(uint32_t length, uint32_t *X, uint32_t *M,
+		uint32_t *mu, uint32_t *temp, uint32_t *R) {
+	(void) mu;
+	modulus_array(2 * length, X, M, temp, R);
+}
+
+static void reduce_division(uint32_t length, uint32_t *X, uint32_t *M,
+		uint32_t *mu, uint32_t *temp, uint32_t *R) {
+	(void) mu;
+	divide_array(2 * length, X, length, M + length, temp, NULL, R);
+}
+
+static void reduce_barrett(uint32_t length, uint32_t *X, uint32_t *M,
+		uint32_t *mu, uint32_t *temp, uint32_t *R) {
+	barrett_reduce_array(length, X, M + length, mu, temp, R);
+}
+
+// An operation to time and its operands. Each run function uses the
+// fields it needs.
+typedef struct bench_op {
+	void (*run)(const struct bench_op *op);
+	mont_prod_fn prod;
+	reduce_fn reduce;
+	mont_ctx *ctx;
+	uint32_t length;
+	uint32_t *X, *E, *M, *Z, *mu, *temp;
+} bench_op;
+
+// Seconds per call of the operation, run for at least
+// BENCH_MIN_SECONDS.
+static double time_op(const bench_op *op) {
+	uint32_t n = 0;
+	clock_t start = clock();
+	double secs;
+	do {
+		op->run(op);
+		n++;
+		secs = (double) (clock() - start) / CLOCKS_PER_SEC;
+	} while (secs < BENCH_MIN_SECONDS);
+	return secs / n;
+}
+
+// The product of X and E, as the second operand.
+static void run_prod(const bench_op *op) {
+	op->prod(op->length, op->X, op->E, op->M, op->Z);
+}
+
+static void run_modexp(const bench_op *op) {
+	mod_exp_array(op->length, op->X, op->E, op->M, op->Z);
+}
+
+// A signature, as X^E mod M with a full length private exponent and a
+// fixed window, setting the modulus up for every call.
+static void run_sign_per_call(const bench_op *op) {
+	mod_exp_array_fixed_window(op->length, op->length, BENCH_SIGN_WINDOW,
+			op->X, op->E, op->M, op->Z);
+}
+
+// The same with a context set up once for the key.
+static void run_sign_ctx(const bench_op *op) {
+	mod_exp_ctx_fixed_window(op->ctx, BENCH_SIGN_WINDOW, op->length, op->X,
+			op->E, op->Z);
+}
+
+static void run_ctx_setup(const bench_op *op) {
+	mont_ctx_free(mont_ctx_new(op->length, op->M));
+}
+
+// Reduction of a double length value. M holds the modulus zero
+// extended to 2 * length words.
+static void run_reduce(const bench_op *op) {
+	op->reduce(op->length, op->X, op->M, op->mu, op->temp, op->Z);
+}
+
+// The residue Nr = 2 ** 2N mod M.
+static void run_residue(const bench_op *op) {
+	m_residue_2_2N_array(op->length, 32 * op->length, op->M, op->temp, op->Z);
+}
+
+static void run_residue_bitserial(const bench_op *op) {
+	m_residue_2_2N_array_bitserial(op->length, 32 * op->length, op->M,
+			op->temp, op->Z);
+}
+
+// Reduction of a double length value and the Montgomery residue, bit
+// serial against word based.
+static void bench_reduction(void) {
+	const uint32_t sizes[] = { 512, 1024, 2048, 4096, 8192 };
+
+	printf("=== Reduction, bit serial, division (Knuth D) and Barrett ===\n");
+	printf("# bits  2n mod m: bitserial us  division us  barrett us"
+			"   Nr: bitserial us  division us\n");
+
+	for (uint32_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+		uint32_t length = sizes[i] / 32 + 1;
+		uint32_t *X = calloc(2 * length, sizeof(uint32_t));
+		uint32_t *M = calloc(2 * length, sizeof(uint32_t));
+		uint32_t *R = calloc(2 * length, sizeof(uint32_t));
+		uint32_t *mu = calloc(length + 1, sizeof(uint32_t));
+		uint32_t *temp = calloc(BARRETT_MU_TEMP(length), sizeof(uint32_t));
+		if (X == NULL || M == NULL || R == NULL || mu == NULL || temp == NULL) {
+			printf("calloc failed\n");
+			exit(1);
+		}
+
+		random_operands(length, X, X + length, M + length, R);
+		for (uint32_t j = 2; j < length; j++)
+			X[j] = random_word();
+		barrett_mu_array(length, M + length, temp, mu);
+
+		bench_op op = { .run = run_reduce, .length = length, .X = X, .M = M,
+				.Z = R, .mu = mu, .temp = temp };
+		op.reduce = reduce_bitserial;
+		double bitserial = time_op(&op) * 1e6;
+		op.reduce = reduce_division;
+		double division = time_op(&op) * 1e6;
+		op.reduce = reduce_barrett;
+		double barrett = time_op(&op) * 1e6;
+		op.M = M + length;
+		op.run = run_residue_bitserial;
+		double residue_bitserial = time_op(&op) * 1e6;
+		op.run = run_residue;
+		double residue = time_op(&op) * 1e6;
+
+		printf("%6u %22.2f %12.2f %11.2f %18.2f %12.2f\n", sizes[i], bitserial,
+				division, barrett, residue_bitserial, residue);
+		fflush(stdout);
+
+		free(X);
+		free(M);
+		free(R);
+		free(mu);
+		free(temp);
+	}
+}
+
+// The full modexp with the generic product and with the fixed size
+// kernels.
+static void bench_fixed_kernels(void) {
+	const uint32_t sizes[] = { 512, 1024, 2048, 4096, 8192 };
+
+	printf("=== Modexp, generic and fixed size product kernels ===\n");
+	printf("# bits  generic ms  fixed ms  speedup\n");
+
+	for (uint32_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+		uint32_t length = sizes[i] / 32 + 1;
+		uint32_t *X = calloc(length, sizeof(uint32_t));
+		uint32_t *E = calloc(length, sizeof(uint32_t));
+		uint32_t *M = calloc(length, sizeof(uint32_t));
+		uint32_t *Z = calloc(length, sizeof(uint32_t));
+		if (X == NULL || E == NULL || M == NULL || Z == NULL) {
+			printf("calloc failed\n");
+			exit(1);
+		}
+
+		random_operands(length, X, E, M, Z);
+
+		bench_op op = { .run = run_modexp, .length = length, .X = X, .E = E,
+				.M = M, .Z = Z };
+		mont_prod_fixed_kernels(0);
+		double generic = time_op(&op) * 1e3;
+		mont_prod_fixed_kernels(1);
+		double fixed = time_op(&op) * 1e3;
+
+		printf("%6u %11.2f %9.2f %8.2f\n", sizes[i], generic, fixed,
+				generic / fixed);
+		fflush(stdout);
+
+		free(X);
+		free(E);
+		free(M);
+		free(Z);
+	}
+}
+
+// A batch of public key operations with one modulus and many
+// messages, as in test vector generation, per call and in a workspace
+// set up once. Counts the heap allocations inside each loop.
+static void bench_batch(void) {
+	const uint32_t sizes[] = { 1024, 2048, 4096 };
+	const uint32_t batch = 2000;
+
+	printf("=== Batch of %u modexps e=65537, per call and in a workspace ===\n",
+			batch);
+	printf("# bits  per call ms  allocs  workspace ms  allocs\n");
+
+	for (uint32_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+		uint32_t length = sizes[i] / 32 + 1;
+		uint32_t words = mont_ctx_words(length, 0);
+		uint32_t *X = calloc(length, sizeof(uint32_t));
+		uint32_t *E = calloc(length, sizeof(uint32_t));
+		uint32_t *M = calloc(length, sizeof(uint32_t));
+		uint32_t *Z = calloc(length, sizeof(uint32_t));
+		uint32_t *work = calloc(words, sizeof(uint32_t));
+		if (X == NULL || E == NULL || M == NULL || Z == NULL || work == NULL) {
+			printf("calloc failed\n");
+			exit(1);
+		}
+
+		random_operands(length, X, Z, M, E);
+		zero_array(length, E);
+		E[length - 1] = 65537;
+
+		// Best of a few rounds, interleaved, as the two differ by about
+		// the context setup only.
+		mont_ctx ctx;
+		mont_ctx_init(&ctx, length, M, 0, work, words);
+		double per_call = 0, workspace = 0;
+		uint64_t per_call_allocs = 0, workspace_allocs = 0;
+		for (uint32_t r = 0; r < BENCH_SIGN_ROUNDS; r++) {
+			uint64_t allocs = mont_alloc_count();
+			clock_t start = clock();
+			for (uint32_t k = 0; k < batch; k++) {
+				X[length - 1] = k;
+				mod_exp_array(length, X, E, M, Z);
+			}
+			double t = (double) (clock() - start) * 1e3 / CLOCKS_PER_SEC;
+			if (r == 0 || t < per_call) per_call = t;
+			per_call_allocs = mont_alloc_count() - allocs;
+
+			allocs = mont_alloc_count();
+			start = clock();
+			for (uint32_t k = 0; k < batch; k++) {
+				X[length - 1] = k;
+				mod_exp_ctx(&ctx, length, X, E, Z);
+			}
+			t = (double) (clock() - start) * 1e3 / CLOCKS_PER_SEC;
+			if (r == 0 || t < workspace) workspace = t;
+			workspace_allocs = mont_alloc_count() - allocs;
+		}
+
+		printf("%6u %12.1f %7lu %13.1f %7lu\n", sizes[i], per_call,
+				(unsigned long) per_call_allocs, workspace,
+				(unsigned long) workspace_allocs);
+		fflush(stdout);
+
+		free(X);
+		free(E);
+		free(M);
+		free(Z);
+		free(work);
+	}
+}
+
+// mod_exp_batch on 1, 2 and 4 threads, in wall clock time as the
+// threads share the work.
+static void bench_batch_threads(void) {
+	const uint32_t threads[] = { 1, 2, 4 };
+	const uint32_t bits = 2048;
+	const uint32_t count = 16;
+	const uint32_t length = bits / 32 + 1;
+
+	printf("=== Batch of %u %u bit modexps, full exponent, on threads ===\n",
+			count, bits);
+	printf("# threads  wall ms  speedup\n");
+
+	uint32_t *X = calloc(count * length, sizeof(uint32_t));
+	uint32_t *E = calloc(count * length, sizeof(uint32_t));
+	uint32_t *M = calloc(count * length, sizeof(uint32_t));
+	uint32_t *Z = calloc(count * length, sizeof(uint32_t));
+	mod_exp_job *jobs = calloc(count, sizeof(mod_exp_job));
+	if (X == NULL || E == NULL || M == NULL || Z == NULL || jobs == NULL) {
+		printf("calloc failed\n");
+		exit(1);
+	}
+	for (uint32_t k = 0; k < count; k++) {
+		uint32_t *x = X + k * length, *e = E + k * length, *m = M + k * length;
+		random_operands(length, x, e, m, Z);
+		jobs[k].length = length;
+		jobs[k].X = x;
+		jobs[k].E = e;
+		jobs[k].M = m;
+		jobs[k].Z = Z + k * length;
+	}
+
+	double serial = 0;
+	for (uint32_t i = 0; i < sizeof(threads) / sizeof(threads[0]); i++) {
+		struct timespec start, stop;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		mod_exp_batch(jobs, count, threads[i]);
+		clock_gettime(CLOCK_MONOTONIC, &stop);
+		double wall = (double) (stop.tv_sec - start.tv_sec) * 1e3
+				+ (double) (stop.tv_nsec - start.tv_nsec) / 1e6;
+		if (i == 0)
+			serial = wall;
+		printf("%9u %8.1f %8.2f\n", threads[i], wall, serial / wall);
+		fflush(stdout);
+	}
+
+	free(X);
+	free(E);
+	free(M);
+	free(Z);
+	free(jobs);
+}
+
+// Repeated signing with one key, as a signing server does it.
+static void bench_repeated_signing(void) {
+	const uint32_t sizes[] = { 1024, 2048, 4096 };
+
+	printf("=== Repeated signing, window %u, per call and reused context ===\n",
+			BENCH_SIGN_WINDOW);
+	printf("# bits  setup ms  per call ms    ctx ms  saved\n");
+
+	for (uint32_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+		uint32_t length = sizes[i] / 32 + 1;
+		uint32_t *X = calloc(length, sizeof(uint32_t));
+		uint32_t *E = calloc(length, sizeof(uint32_t));
+		uint32_t *M = calloc(length, sizeof(uint32_t));
+		uint32_t *Z = calloc(length, sizeof(uint32_t));
+		if (X == NULL || E == NULL || M == NULL || Z == NULL) {
+			printf("calloc failed\n");
+			exit(1);
+		}
+
+		random_operands(length, X, E, M, Z);
+		mont_ctx *ctx = mont_ctx_new(length, M);
+
+		bench_op setup_op = { .run = run_ctx_setup, .length = length, .M = M };
+		bench_op per_call_op = { .run = run_sign_per_call, .length = length,
+				.X = X, .E = E, .M = M, .Z = Z };
+		bench_op ctx_op = { .run = run_sign_ctx, .ctx = ctx, .length = length,
+				.X = X, .E = E, .Z = Z };
+
+		// Best of a few rounds, interleaved, as the numbers are close.
+		double setup = 0, per_call = 0, reused = 0;
+		for (uint32_t r = 0; r < BENCH_SIGN_ROUNDS; r++) {
+			double t = time_op(&setup_op) * 1e3;
+			if (r == 0 || t < setup) setup = t;
+			t = time_op(&per_call_op) * 1e3;
+			if (r == 0 || t < per_call) per_call = t;
+			t = time_op(&ctx_op) * 1e3;
+			if (r == 0 || t < reused) reused = t;
+		}
+
+		printf("%6u %9.3f %12.3f %9.3f %5.1f%%\n", sizes[i], setup, per_call,
+				reused, 100.0 * (per_call - reused) / per_call);
+		fflush(stdout);
+
+		mont_ctx_free(ctx);
+		free(X);
+		free(E);
+		free(M);
+		free(Z);
+	}
+}
+
+void montgomery_array_bench(void) {
+	const uint32_t sizes[] = { 512, 1024, 2048, 4096, 8192 };
+
+	printf("=== Montgomery product, bit serial and word level (CIOS) ===\n");
+	printf("# bits  bitserial us   cios us  speedup  modexp e=65537 ms\n");
+
+	srand(4711);
+	for (uint32_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+		uint32_t length = sizes[i] / 32 + 1;
+		uint32_t *A = calloc(length, sizeof(uint32_t));
+		uint32_t *B = calloc(length, sizeof(uint32_t));
+		uint32_t *M = calloc(length, sizeof(uint32_t));
+		uint32_t *E = calloc(length, sizeof(uint32_t));
+		uint32_t *s = calloc(length, sizeof(uint32_t));
+		if (A == NULL || B == NULL || M == NULL || E == NULL || s == NULL) {
+			printf("calloc failed\n");
+			exit(1);
+		}
+
+		random_operands(length, A, B, M, s);
+		E[length - 1] = 65537;
+
+		bench_op op = { .run = run_prod, .length = length, .X = A, .E = B,
+				.M = M, .Z = s };
+		op.prod = mont_prod_array_bitserial;
+		double bitserial = time_op(&op) * 1e6;
+		op.prod = prod_cios;
+		double cios = time_op(&op) * 1e6;
+		op.run = run_modexp;
+		op.E = E;
+		double modexp = time_op(&op) * 1e3;
+
+		printf("%6u %13.2f %9.2f %8.1f %18.2f\n", sizes[i], bitserial, cios,
+				bitserial / cios, modexp);
+		fflush(stdout);
+
+		free(A);
+		free(B);
+		free(M);
+		free(E);
+		free(s);
+	}
+
+	bench_reduction();
+	bench_fixed_kernels();
+	bench_repeated_signing();
+	bench_batch();
+	bench_batch_threads();
+}
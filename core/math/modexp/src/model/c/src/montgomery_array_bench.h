@@ -0,0 +1,14 @@
+/*
+ * montgomery_array_bench.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+// Benchmark of the Montgomery products in the modexp C model.
+
+#ifndef MONTGOMERY_ARRAY_BENCH_H_
+#define MONTGOMERY_ARRAY_BENCH_H_
+
+void montgomery_array_bench(void);
+
+#endif /* MONTGOMERY_ARRAY_BENCH_H_ */
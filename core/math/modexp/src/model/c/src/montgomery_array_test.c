@@ -1,13 +1,16 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 #include "montgomery_array.h"
 #include "bignum_uint32_t.h"
+#include "test_runner.h"
+#include "montgomery_array_test.h"
 
 const uint32_t TEST_CONSTANT_PRIME_15_1 = 65537;
 const uint32_t TEST_CONSTANT_PRIME_31_1 = 2147483647u; // eighth Mersenne prime
 
 void testShiftRight() {
-	printf("=== Test shift right ===\n");
+	test_printf("=== Test shift right ===\n");
 	uint32_t a[] = { 0x01234567, 0x89abcdef };
 	shift_right_1_array(2, a, a);
 	shift_right_1_array(2, a, a);
@@ -18,7 +21,7 @@ void testShiftRight() {
 }
 
 void testAdd() {
-	printf("=== Test add ===\n");
+	test_printf("=== Test add ===\n");
 	uint32_t a[] = { 0x01234567, 0x89abcdef };
 	uint32_t b[] = { 0x12000002, 0x77000001 };
 	uint32_t c[2];
@@ -28,7 +31,7 @@ void testAdd() {
 }
 
 void testSub() {
-	printf("=== Test sub ===\n");
+	test_printf("=== Test sub ===\n");
 	uint32_t a[] = { 0x01234567, 0x89abcdef };
 	uint32_t b[] = { 0x00200000, 0x8a001001 };
 	uint32_t c[2];
@@ -77,13 +80,13 @@ void test_montgomery_a_b_m(uint32_t A, uint32_t B, uint32_t M) {
 	mont_prod_array(1, ONE, s, MM, monProd);
 	uint32_t productModulusMontgomery = monProd[0];
 	uint32_t success = productModulus == productModulusMontgomery;
-	printf("%c A=%3x B=%3x M=%3x A*B=%3x Ar=%3x Br=%3x Ar*Br=%3x A*B=%3x\n",
+	test_printf("%c A=%3x B=%3x M=%3x A*B=%3x Ar=%3x Br=%3x Ar*Br=%3x A*B=%3x\n",
 			success ? '*' : ' ', A, B, M, productModulus, Ar[0], Br[0], s[0],
 			productModulusMontgomery);
 }
 
 void test_montgomery_modulus() {
-	printf("=== Test mod ===\n");
+	test_printf("=== Test mod ===\n");
 	//printf("%lx\n", 2305843009213693951ul % 0x7ffffffful );
 	uint32_t A[] = { 0, (1 << (61 - 32)) - 1, 0xffffffff }; //2^61-1 Ivan Mikheevich Pervushin
 	uint32_t B[] = { (1 << (89 - 64)) - 1, 0xffffffff, 0xffffffff }; //2^89-1 R. E. Powers
@@ -119,7 +122,7 @@ void test_montgomery_modulus() {
  */
 
 void test_montgomery_one_item_array() {
-	printf("=== test_montgomery_one_item_array ===\n");
+	test_printf("=== test_montgomery_one_item_array ===\n");
 	test_montgomery_a_b_m(11, 17, 19);
 	test_montgomery_a_b_m(11, 19, 17);
 	test_montgomery_a_b_m(17, 11, 19);
@@ -148,8 +151,218 @@ void test_montgomery_one_item_array() {
 			TEST_CONSTANT_PRIME_15_1);
 }
 
+// The random test data comes from a generator per thread, so that the
+// tests make the same data when run in parallel.
+static _Thread_local uint64_t test_random_state = 1;
+
+void test_srand(uint32_t seed) {
+	test_random_state = seed;
+}
+
+uint32_t test_random_word(void) {
+	test_random_state = test_random_state * 6364136223846793005ULL
+			+ 1442695040888963407ULL;
+	return (uint32_t) (test_random_state >> 32);
+}
+
+// The word level product against the bit serial one, reduced, for
+// random odd moduli with the top word zero so that the bit serial sum
+// does not wrap.
+void test_montgomery_cios() {
+	test_printf("=== test_montgomery_cios ===\n");
+	const uint32_t lengths[] = { 2, 3, 5, 9, 17, 33 };
+	uint32_t A[33], B[33], M[33], expected[33], actual[33], temp[33];
+	test_srand(4711);
+	for (uint32_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+		uint32_t length = lengths[l];
+		for (int k = 0; k < 4; k++) {
+			for (uint32_t i = 0; i < length; i++) {
+				M[i] = test_random_word();
+				A[i] = test_random_word();
+				B[i] = test_random_word();
+			}
+			M[0] = 0;
+			M[1] |= 0x80000000;
+			M[length - 1] |= 1;
+			A[0] = 0;
+			B[0] = 0;
+			modulus_array(length, A, M, temp, A);
+			modulus_array(length, B, M, temp, B);
+
+			mont_prod_array_bitserial(length, A, B, M, temp);
+			modulus_array(length, temp, M, actual, expected);
+			mont_prod_array(length, A, B, M, actual);
+			assertArrayEquals(length, expected, actual);
+		}
+	}
+}
+
+// The fixed size products against the generic one, for each of the
+// sizes with a kernel, with the modulus normalized and not.
+void test_montgomery_fixed() {
+	test_printf("=== test_montgomery_fixed ===\n");
+	const uint32_t sizes[] = { 512, 1024, 2048, 4096, 8192 };
+	uint32_t A[257], B[257], M[257], expected[257], actual[257], temp[259];
+	test_srand(1414);
+	for (uint32_t l = 0; l < sizeof(sizes) / sizeof(sizes[0]); l++) {
+		uint32_t length = sizes[l] / 32 + 1;
+		for (uint32_t k = 0; k < 2; k++) {
+			for (uint32_t i = 0; i < length; i++) {
+				M[i] = test_random_word();
+				A[i] = test_random_word();
+				B[i] = test_random_word();
+			}
+			M[0] = 0;
+			M[1] = (k == 0) ? M[1] | 0x80000000 : M[1] >> 9;
+			M[length - 1] |= 1;
+			A[0] = 0;
+			B[0] = 0;
+			modulus_array(length, A, M, temp, A);
+			modulus_array(length, B, M, temp, B);
+			uint32_t n0 = mont_n0_array(length, M);
+
+			mont_prod_fixed_kernels(0);
+			mont_prod_cios_array(length, A, B, M, n0, temp, expected);
+			mont_prod_fixed_kernels(1);
+			mont_prod_cios_array(length, A, B, M, n0, temp, actual);
+			assertArrayEquals(length, expected, actual);
+		}
+	}
+}
+
+// The word based division and the Barrett reduction against the bit
+// serial modulus, for random moduli with the top word both normalized
+// and not, and the word based residue against the bit serial one.
+void test_bignum_division() {
+	test_printf("=== test_bignum_division ===\n");
+	const uint32_t lengths[] = { 2, 3, 5, 9, 17, 33 };
+	uint32_t X[66], M[66], mu[34], expected[66], actual[66], temp[66];
+	uint32_t work[BARRETT_MU_TEMP(33)];
+	test_srand(1618);
+	for (uint32_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+		uint32_t length = lengths[l];
+		for (uint32_t k = 0; k < 2; k++) {
+			zero_array(2 * length, M);
+			for (uint32_t i = 0; i < 2 * length; i++)
+				X[i] = test_random_word();
+			for (uint32_t i = length + 1; i < 2 * length; i++)
+				M[i] = test_random_word();
+			M[length + 1] = (k == 0) ? M[length + 1] | 0x80000000
+					: (M[length + 1] >> ((7 * l + 3) % 31)) | 1;
+			M[2 * length - 1] |= 1;
+			X[0] = 0;
+			X[1] = 0;
+
+			modulus_array(2 * length, X, M, temp, expected);
+			divide_array(2 * length, X, length, M + length, work, NULL, actual);
+			assertArrayEquals(length, expected + length, actual);
+
+			barrett_mu_array(length, M + length, work, mu);
+			barrett_reduce_array(length, X, M + length, mu, work, actual);
+			assertArrayEquals(length, expected + length, actual);
+
+			m_residue_2_2N_array_bitserial(length, 32 * length, M + length, temp, expected);
+			m_residue_2_2N_array(length, 32 * length, M + length, work, actual);
+			assertArrayEquals(length, expected, actual);
+		}
+	}
+}
+
+// The windowed exponentiations against the binary one for a random
+// 2048 bit modulus and exponent, with the number of Montgomery products
+// and the time each takes.
+void test_montgomery_windows() {
+	test_printf("=== test_montgomery_windows ===\n");
+	const uint32_t length = 65;
+	uint32_t X[65], E[65], M[65], expected[65], Z[65], temp[65];
+	test_srand(1729);
+	for (uint32_t i = 0; i < length; i++) {
+		X[i] = test_random_word();
+		E[i] = test_random_word();
+		M[i] = test_random_word();
+	}
+	X[0] = 0;
+	E[0] = 0;
+	M[0] = 0;
+	E[1] |= 0x80000000;
+	M[1] |= 0x80000000;
+	M[length - 1] |= 1;
+	modulus_array(length, X, M, temp, X);
+
+	uint64_t count = mont_prod_count();
+	clock_t start = clock();
+	mod_exp_array(length, X, E, M, expected);
+	const double binary_ms = (double) (clock() - start) * 1e3 / CLOCKS_PER_SEC;
+	const uint64_t binary = mont_prod_count() - count;
+
+	double ms[2][6];
+	uint64_t products[2][6];
+	for (uint32_t window = 1; window <= 6; window++) {
+		for (int sliding = 0; sliding < 2; sliding++) {
+			count = mont_prod_count();
+			start = clock();
+			if (sliding)
+				mod_exp_array_sliding_window(length, length, window, X, E, M, Z);
+			else
+				mod_exp_array_fixed_window(length, length, window, X, E, M, Z);
+			ms[sliding][window - 1] = (double) (clock() - start) * 1e3 / CLOCKS_PER_SEC;
+			products[sliding][window - 1] = mont_prod_count() - count;
+			assertArrayEquals(length, expected, Z);
+		}
+	}
+
+	test_printf("# method   window  products  vs binary     ms\n");
+	test_printf("binary          1  %8lu  %8.1f%%  %5.1f\n", (unsigned long) binary,
+			0.0, binary_ms);
+	for (int sliding = 0; sliding < 2; sliding++)
+		for (uint32_t window = 1; window <= 6; window++)
+			test_printf("%-8s  %6u  %8lu  %8.1f%%  %5.1f\n", sliding ? "sliding" : "fixed",
+					window, (unsigned long) products[sliding][window - 1],
+					100.0 * ((double) products[sliding][window - 1] - (double) binary) / (double) binary,
+					ms[sliding][window - 1]);
+	test_printf("\n");
+}
+
+// One context reused for several bases, exponents and windows, in an
+// order that both grows the window table and reuses it, against the
+// per call exponentiation.
+void test_montgomery_ctx() {
+	test_printf("=== test_montgomery_ctx ===\n");
+	const uint32_t length = 17;
+	const uint32_t windows[] = { 0, 4, 1, 6, 0, 3 };
+	uint32_t X[17], E[17], M[17], expected[17], Z[17], temp[17];
+	test_srand(2718);
+	for (uint32_t i = 0; i < length; i++)
+		M[i] = test_random_word();
+	M[0] = 0;
+	M[1] |= 0x80000000;
+	M[length - 1] |= 1;
+	mont_ctx *ctx = mont_ctx_new(length, M);
+	for (uint32_t k = 0; k < sizeof(windows) / sizeof(windows[0]); k++) {
+		for (uint32_t i = 0; i < length; i++) {
+			X[i] = test_random_word();
+			E[i] = test_random_word();
+		}
+		X[0] = 0;
+		E[0] = 0;
+		modulus_array(length, X, M, temp, X);
+		mod_exp_array(length, X, E, M, expected);
+
+		if (windows[k] == 0) {
+			mod_exp_ctx(ctx, length, X, E, Z);
+			assertArrayEquals(length, expected, Z);
+		} else {
+			mod_exp_ctx_fixed_window(ctx, windows[k], length, X, E, Z);
+			assertArrayEquals(length, expected, Z);
+			mod_exp_ctx_sliding_window(ctx, windows[k], length, X, E, Z);
+			assertArrayEquals(length, expected, Z);
+		}
+	}
+	mont_ctx_free(ctx);
+}
+
 void test_montgomery_modexp() {
-	printf("=== test_montgomery_modexp ===\n");
+	test_printf("=== test_montgomery_modexp ===\n");
 	uint32_t X[] = { 0, (1 << (61 - 32)) - 1, 0xffffffff }; //2^61-1 Ivan Mikheevich Pervushin
 	uint32_t M[] = { (1 << (89 - 64)) - 1, 0xffffffff, 0xffffffff }; //2^89-1 R. E. Powers
 	uint32_t E[] = { 0, 0, (1 << 31) - 1 }; //Leonhard Euler
@@ -169,7 +382,7 @@ void test_montgomery_modexp() {
 }
 
 void test_modExp_4096bit_e65537() {
-	printf("=== test_modExp_4096bit_e65537 ===\n");
+	test_printf("=== test_modExp_4096bit_e65537 ===\n");
 	uint32_t M[] = { 0x00000000, 0xecc9307c, 0x57a39970, 0x7e9e2569, 0x872cd790,
 			0x0d4dddcc, 0x704fd131, 0x9395388d, 0x07e63a16, 0x37ea6fae,
 			0x3873a01e, 0x0df4a57b, 0xb90bc708, 0xa05ade61, 0x91ef3868,
@@ -268,7 +481,7 @@ void test_modExp_4096bit_e65537() {
 }
 
 void test_modExp_8192_e65537() {
-	printf(" ----- test_modExp_8192_e65537 -----\n");
+	test_printf(" ----- test_modExp_8192_e65537 -----\n");
 	uint32_t M[] = { 0x00000000, 0x9985a7f5, 0xb471b248, 0xd13838a3, 0x75e22fc7,
 			0x0e0d72b0, 0x6ea72eb3, 0x958b1b8e, 0x431cb10d, 0x72421e7e,
 			0xb0e33fa3, 0xc5b6d437, 0xb7c1ce28, 0xe4960b94, 0x7c36159e,
@@ -457,7 +670,7 @@ void test_modExp_8192_e65537() {
 }
 
 void test_modExp_8192bit() {
-	printf("=== test_modExp_8192bit ===\n");
+	test_printf("=== test_modExp_8192bit ===\n");
 	uint32_t M[] = { 0x00000000, 0x86ad85ba, 0x6b9fa483, 0x25cb106f, 0xcf6cc989,
 			0x911b28f0, 0x1ffd3ef8, 0x30a310db, 0x8851dea4, 0x0b16eba5,
 			0x7cb2e8a5, 0x86729373, 0x37af6f23, 0x81fd1e6c, 0x3372378b,
@@ -676,23 +889,137 @@ void test_modExp_8192bit() {
 	assertArrayEquals(257, expected, Z);
 }
 
-void montgomery_array_tests(int bigtests) {
+// A context in a caller's workspace: refused when the workspace is too
+// small or the window larger than its table, and otherwise the same
+// results as the per call exponentiation with no heap allocations.
+void test_montgomery_workspace() {
+	test_printf("=== test_montgomery_workspace ===\n");
+	const uint32_t length = 17;
+	uint32_t X[17], E[17], M[17], expected[17], Z[17], temp[17];
+	uint32_t work[6 * 17 + 2 + M_RESIDUE_TEMP(17, 32 * 17) + 16 * 17];
+	// Heap allocations and refused calls.
+	uint32_t expected_counts[] = { 0, 3 };
+	uint32_t counts[] = { 0, 0 };
+	mont_ctx ctx;
+	test_srand(3141);
+	for (uint32_t i = 0; i < length; i++) {
+		X[i] = test_random_word();
+		E[i] = test_random_word();
+		M[i] = test_random_word();
+	}
+	X[0] = 0;
+	E[0] = 0;
+	M[0] = 0;
+	M[1] |= 0x80000000;
+	M[length - 1] |= 1;
+	modulus_array(length, X, M, temp, X);
+	mod_exp_array(length, X, E, M, expected);
+
+	const uint32_t words = mont_ctx_words(length, 4);
+	counts[1] += mont_ctx_init(&ctx, length, M, 4, work, words - 1) != 0;
+	counts[1] += mont_ctx_init(&ctx, length, M, MONT_EXP_MAX_WINDOW + 1, work,
+			sizeof(work) / sizeof(work[0])) != 0;
+	mont_ctx_init(&ctx, length, M, 4, work, words);
+
+	uint64_t allocs = mont_alloc_count();
+	mod_exp_ctx(&ctx, length, X, E, Z);
+	assertArrayEquals(length, expected, Z);
+	mod_exp_ctx_fixed_window(&ctx, 4, length, X, E, Z);
+	assertArrayEquals(length, expected, Z);
+	mod_exp_ctx_sliding_window(&ctx, 4, length, X, E, Z);
+	assertArrayEquals(length, expected, Z);
+	mod_exp_array2_ctx(&ctx, length, X, E, Z);
+	assertArrayEquals(length, expected, Z);
+	counts[1] += mod_exp_ctx_fixed_window(&ctx, 5, length, X, E, Z) != 0;
+	counts[0] = (uint32_t) (mont_alloc_count() - allocs);
+	assertArrayEquals(2, expected_counts, counts);
+}
+
+// A batch of mixed length exponentiations on a pool of threads, and on
+// one, against mod_exp_array one at a time.
+#define TEST_BATCH_JOBS 24
+
+void test_mod_exp_batch() {
+	test_printf("=== test_mod_exp_batch ===\n");
+	const uint32_t lengths[] = { 3, 9, 17, 33 };
+	uint32_t X[TEST_BATCH_JOBS * 33], E[TEST_BATCH_JOBS * 33];
+	uint32_t M[TEST_BATCH_JOBS * 33], temp[33];
+	uint32_t expected[TEST_BATCH_JOBS * 33], Z[TEST_BATCH_JOBS * 33];
+	uint32_t expected_results[] = { 0, 0 };
+	uint32_t results[2];
+	mod_exp_job jobs[TEST_BATCH_JOBS];
+	uint32_t words = 0;
+	test_srand(1123);
+	for (uint32_t j = 0; j < TEST_BATCH_JOBS; j++) {
+		uint32_t length = lengths[j % 4];
+		uint32_t *x = X + words, *e = E + words, *m = M + words;
+		for (uint32_t i = 0; i < length; i++) {
+			x[i] = test_random_word();
+			e[i] = test_random_word();
+			m[i] = test_random_word();
+		}
+		x[0] = 0;
+		e[0] = 0;
+		m[0] = 0;
+		m[length - 1] |= 1;
+		modulus_array(length, x, m, temp, x);
+		mod_exp_array(length, x, e, m, expected + words);
+		jobs[j].length = length;
+		jobs[j].X = x;
+		jobs[j].E = e;
+		jobs[j].M = m;
+		jobs[j].Z = Z + words;
+		words += length;
+	}
+
+	zero_array(words, Z);
+	results[0] = (uint32_t) -mod_exp_batch(jobs, TEST_BATCH_JOBS, 4);
+	assertArrayEquals(words, expected, Z);
+	zero_array(words, Z);
+	results[1] = (uint32_t) -mod_exp_batch(jobs, TEST_BATCH_JOBS, 1);
+	assertArrayEquals(words, expected, Z);
+	assertArrayEquals(2, expected_results, results);
+}
+
+const test_case montgomery_array_test_cases[] = {
   // Sub function tests.
-  testShiftRight();
-  testAdd();
-  testSub();
-  test_montgomery_one_item_array();
-  test_montgomery_modulus();
+  TEST_CASE(testShiftRight),
+  TEST_CASE(testAdd),
+  TEST_CASE(testSub),
+  TEST_CASE(test_montgomery_one_item_array),
+  TEST_CASE(test_montgomery_modulus),
+  TEST_CASE(test_montgomery_cios),
+  TEST_CASE(test_montgomery_fixed),
 
   // modexp tests.
-  test_montgomery_modexp();
+  TEST_CASE(test_montgomery_modexp),
+  TEST_CASE(test_bignum_division),
+  TEST_CASE(test_montgomery_windows),
+  TEST_CASE(test_montgomery_ctx),
+  TEST_CASE(test_montgomery_workspace),
+  TEST_CASE(test_mod_exp_batch),
 
   // Fairly big.
-  test_modExp_4096bit_e65537();
-  test_modExp_8192_e65537();
+  TEST_CASE(test_modExp_4096bit_e65537),
+  TEST_CASE(test_modExp_8192_e65537)
+};
+
+const uint32_t montgomery_array_test_case_count =
+    sizeof(montgomery_array_test_cases) / sizeof(test_case);
+
+const test_case montgomery_array_big_test_cases[] = {
+  TEST_CASE(test_modExp_8192bit)
+};
+
+const uint32_t montgomery_array_big_test_case_count =
+    sizeof(montgomery_array_big_test_cases) / sizeof(test_case);
+
+void montgomery_array_tests(int bigtests) {
+  run_test_cases(montgomery_array_test_cases, montgomery_array_test_case_count);
 
   // Bigtests.
   if (bigtests) {
-    test_modExp_8192bit();
+    run_test_cases(montgomery_array_big_test_cases,
+        montgomery_array_big_test_case_count);
   }
 }
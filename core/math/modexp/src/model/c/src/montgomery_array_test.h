@@ -10,4 +10,10 @@
 
 void montgomery_array_tests(int bigtests);
 
+// The tests as cases for the test runner, the big ones apart.
+extern const test_case montgomery_array_test_cases[];
+extern const uint32_t montgomery_array_test_case_count;
+extern const test_case montgomery_array_big_test_cases[];
+extern const uint32_t montgomery_array_big_test_case_count;
+
 #endif /* MONTGOMERY_ARRAY_TEST_H_ */
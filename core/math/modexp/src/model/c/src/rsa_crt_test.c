@@ -0,0 +1,222 @@
+/*
+ * rsa_crt_test.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+// RSA private key operation with and without the Chinese remainder
+// theorem, on the keys in the Novena test-rsa.h. Tests the signatures,
+// benchmarks the two paths and prints the per half vectors for the
+// CRT mode of the hardware.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include "montgomery_array.h"
+#include "bignum_uint32_t.h"
+#include "test_runner.h"
+#include "rsa_crt_test.h"
+#include "../../../../../../platform/novena/sw/test-rsa.h"
+
+// Run each measurement for at least this long.
+#define RSA_BENCH_MIN_SECONDS 0.5
+
+// A key from test-rsa.h as model arrays, with a leading zero word.
+typedef struct {
+	uint32_t size;
+	uint32_t length;     // n, e, d, m and s
+	uint32_t halflength; // p, q, dP, dQ and u
+	uint32_t *n, *e, *d, *m, *s;
+	uint32_t *p, *q, *dP, *dQ, *u;
+} rsa_key;
+
+// A big endian byte string as a length word array.
+static uint32_t *load_array(const rsa_tc_bn_t *bn, uint32_t length) {
+	uint32_t *a = calloc(length, sizeof(uint32_t));
+	if (a == NULL) {
+		printf("calloc failed\n");
+		exit(1);
+	}
+	for (size_t i = 0; i < bn->len; i++)
+		a[length - 1 - i / 4] |= (uint32_t) bn->val[bn->len - 1 - i] << (8 * (i % 4));
+	return a;
+}
+
+static void load_key(const rsa_tc_t *tc, rsa_key *key) {
+	key->size = (uint32_t) tc->size;
+	key->length = key->size / 32 + 1;
+	key->halflength = key->size / 64 + 1;
+	key->n = load_array(&tc->n, key->length);
+	key->e = load_array(&tc->e, key->length);
+	key->d = load_array(&tc->d, key->length);
+	key->m = load_array(&tc->m, key->length);
+	key->s = load_array(&tc->s, key->length);
+	key->p = load_array(&tc->p, key->halflength);
+	key->q = load_array(&tc->q, key->halflength);
+	key->dP = load_array(&tc->dP, key->halflength);
+	key->dQ = load_array(&tc->dQ, key->halflength);
+	key->u = load_array(&tc->u, key->halflength);
+}
+
+static void free_key(rsa_key *key) {
+	free(key->n);
+	free(key->e);
+	free(key->d);
+	free(key->m);
+	free(key->s);
+	free(key->p);
+	free(key->q);
+	free(key->dP);
+	free(key->dQ);
+	free(key->u);
+}
+
+static void sign_crt(rsa_key *key, uint32_t *Z) {
+	mod_exp_crt_array(key->length, key->halflength, key->m, key->p, key->q,
+			key->dP, key->dQ, key->u, Z);
+}
+
+static void sign_plain(rsa_key *key, uint32_t *Z) {
+	mod_exp_array(key->length, key->m, key->d, key->n, Z);
+}
+
+// The CRT and the plain signature against the one in test-rsa.h, and
+// the public operation back to the message. The CRT signature in a
+// workspace is refused when the workspace is too small, and otherwise
+// made with no heap allocation.
+void rsa_crt_tests(void) {
+	test_printf("=== rsa_crt_tests ===\n");
+	for (uint32_t i = 0; i < sizeof(rsa_tc) / sizeof(rsa_tc[0]); i++) {
+		rsa_key key;
+		load_key(&rsa_tc[i], &key);
+		uint32_t *Z = calloc(key.length, sizeof(uint32_t));
+		if (Z == NULL) {
+			printf("calloc failed\n");
+			exit(1);
+		}
+
+		sign_crt(&key, Z);
+		assertArrayEquals(key.length, key.s, Z);
+
+		const uint32_t words = mont_crt_ctx_words(key.halflength);
+		uint32_t *work = calloc(words, sizeof(uint32_t));
+		uint32_t expected_counts[] = { 0, 1 };
+		uint32_t counts[] = { 0, 0 };
+		mont_crt_ctx ctx;
+		if (work == NULL) {
+			printf("calloc failed\n");
+			exit(1);
+		}
+		counts[1] += mont_crt_ctx_init(&ctx, key.halflength, key.p, key.q,
+				work, words - 1) != 0;
+		mont_crt_ctx_init(&ctx, key.halflength, key.p, key.q, work, words);
+		uint64_t allocs = mont_alloc_count();
+		zero_array(key.length, Z);
+		mod_exp_crt_ctx(&ctx, key.length, key.m, key.dP, key.dQ, key.u, Z);
+		counts[0] = (uint32_t) (mont_alloc_count() - allocs);
+		assertArrayEquals(key.length, key.s, Z);
+		assertArrayEquals(2, expected_counts, counts);
+		free(work);
+
+		sign_plain(&key, Z);
+		assertArrayEquals(key.length, key.s, Z);
+		mod_exp_array(key.length, key.s, key.e, key.n, Z);
+		assertArrayEquals(key.length, key.m, Z);
+
+		free(Z);
+		free_key(&key);
+	}
+}
+
+// Milliseconds per signature.
+static double time_sign(void (*sign)(rsa_key *key, uint32_t *Z), rsa_key *key,
+		uint32_t *Z) {
+	uint32_t n = 0;
+	clock_t start = clock();
+	double secs;
+	do {
+		sign(key, Z);
+		n++;
+		secs = (double) (clock() - start) / CLOCKS_PER_SEC;
+	} while (secs < RSA_BENCH_MIN_SECONDS);
+	return secs * 1e3 / n;
+}
+
+void rsa_crt_bench(void) {
+	printf("=== RSA private key operation, plain and CRT ===\n");
+	printf("# bits  plain ms    crt ms  speedup\n");
+	for (uint32_t i = 0; i < sizeof(rsa_tc) / sizeof(rsa_tc[0]); i++) {
+		rsa_key key;
+		load_key(&rsa_tc[i], &key);
+		uint32_t *Z = calloc(key.length, sizeof(uint32_t));
+		if (Z == NULL) {
+			printf("calloc failed\n");
+			exit(1);
+		}
+
+		double plain = time_sign(sign_plain, &key, Z);
+		double crt = time_sign(sign_crt, &key, Z);
+		printf("%6u %9.2f %9.2f %8.2f\n", key.size, plain, crt, plain / crt);
+		fflush(stdout);
+
+		free(Z);
+		free_key(&key);
+	}
+}
+
+// The bits / 32 low words of a as a C initializer, most significant
+// word first, in the format of the modexpa7 test vectors.
+static void print_vector(const char *name, uint32_t bits, uint32_t length,
+		uint32_t *a) {
+	const uint32_t words = bits / 32;
+	printf("#define %s_%u \\\n\t{", name, bits);
+	for (uint32_t i = 0; i < words; i++) {
+		printf("0x%08x", a[length - words + i]);
+		if (i == words - 1)
+			printf("}\n\n");
+		else if ((i % 4) == 3)
+			printf(", \\\n\t ");
+		else
+			printf(", ");
+	}
+}
+
+// Test vectors for the hardware, with the results of the two CRT
+// halves, MP = M^DP mod P and MQ = M^DQ mod Q.
+void rsa_crt_vectors(void) {
+	printf("/* Generated automatically, do not edit. */\n\n");
+	for (uint32_t i = 0; i < sizeof(rsa_tc) / sizeof(rsa_tc[0]); i++) {
+		rsa_key key;
+		load_key(&rsa_tc[i], &key);
+		uint32_t half = key.size / 2;
+		uint32_t *MP = calloc(key.halflength, sizeof(uint32_t));
+		uint32_t *MQ = calloc(key.halflength, sizeof(uint32_t));
+		if (MP == NULL || MQ == NULL) {
+			printf("calloc failed\n");
+			exit(1);
+		}
+
+		mont_ctx *ctx = mont_ctx_new(key.halflength, key.p);
+		mod_exp_crt_half(ctx, key.length, key.m, key.dP, MP);
+		mont_ctx_free(ctx);
+		ctx = mont_ctx_new(key.halflength, key.q);
+		mod_exp_crt_half(ctx, key.length, key.m, key.dQ, MQ);
+		mont_ctx_free(ctx);
+
+		print_vector("N", key.size, key.length, key.n);
+		print_vector("M", key.size, key.length, key.m);
+		print_vector("D", key.size, key.length, key.d);
+		print_vector("S", key.size, key.length, key.s);
+		print_vector("P", half, key.halflength, key.p);
+		print_vector("Q", half, key.halflength, key.q);
+		print_vector("DP", half, key.halflength, key.dP);
+		print_vector("DQ", half, key.halflength, key.dQ);
+		print_vector("MP", half, key.halflength, MP);
+		print_vector("MQ", half, key.halflength, MQ);
+
+		free(MP);
+		free(MQ);
+		free_key(&key);
+	}
+}
@@ -0,0 +1,17 @@
+/*
+ * rsa_crt_test.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+// RSA private key operation with and without the Chinese remainder
+// theorem in the modexp C model: tests, benchmark and test vectors.
+
+#ifndef RSA_CRT_TEST_H_
+#define RSA_CRT_TEST_H_
+
+void rsa_crt_tests(void);
+void rsa_crt_bench(void);
+void rsa_crt_vectors(void);
+
+#endif /* RSA_CRT_TEST_H_ */
@@ -40,9 +40,11 @@
 #include <stdlib.h>
 #include "montgomery_array.h"
 #include "bignum_uint32_t.h"
+#include "test_runner.h"
+#include "simple_tests.h"
 
 void simple_3_7_11(void) {
-  printf("=== Simple test with X = 3, E = 7 and M = 11 ===\n");
+  test_printf("=== Simple test with X = 3, E = 7 and M = 11 ===\n");
   uint32_t X[] = { 0x3 };
   uint32_t E[] = { 0x7 };
   uint32_t M[] = { 0xb };
@@ -53,7 +55,7 @@ void simple_3_7_11(void) {
 }
 
 void simple_251_251_257(void) {
-  printf("=== Simple test with X = 251, E = 251 and M = 257 ===\n");
+  test_printf("=== Simple test with X = 251, E = 251 and M = 257 ===\n");
   uint32_t X[] = { 0xfb };
   uint32_t E[] = { 0xfb };
   uint32_t M[] = { 0x101 };
@@ -66,7 +68,7 @@ void simple_251_251_257(void) {
 
 void bigger_test(void)
 {
-  printf("=== Bigger test with 128 bit operands.\n");
+  test_printf("=== Bigger test with 128 bit operands.\n");
   uint32_t exponent[] = {0x3285c343, 0x2acbcb0f, 0x4d023228, 0x2ecc73db};
   uint32_t modulus[]  = {0x267d2f2e, 0x51c216a7, 0xda752ead, 0x48d22d89};
   uint32_t message[]  = {0x29462882, 0x12caa2d5, 0xb80e1c66, 0x1006807f};
@@ -80,7 +82,7 @@ void bigger_test(void)
 
 void small_e_64_mod(void)
 {
-  printf("=== Simple test with small e and 64 bit modulus  ===\n");
+  test_printf("=== Simple test with small e and 64 bit modulus  ===\n");
   uint32_t X[] = { 0x00000000, 0xdb5a7e09, 0x86b98bfb };
   uint32_t E[] = { 0x00000000, 0x00000000, 0x00010001 };
   uint32_t M[] = { 0x00000000, 0xb3164743, 0xe1de267d };
@@ -91,7 +93,7 @@ void small_e_64_mod(void)
 }
 
 void small_e_256_mod(void) {
-  printf("=== Simple test with small e and 256 bit modulus  ===\n");
+  test_printf("=== Simple test with small e and 256 bit modulus  ===\n");
   uint32_t X[] = {0x00000000, 0xbd589a51, 0x2ba97013,
                   0xc4736649, 0xe233fd5c, 0x39fcc5e5,
                   0x2d60b324, 0x1112f2d0, 0x1177c62b};
@@ -166,7 +168,7 @@ void rob_dec_1024(void)
                        0x00000000, 0x00000000, 0x00000000, 0x00000000,
                        0x00000000, 0x00000000, 0x00000000, 0x00000000};
 
-  printf("=== 1024 bit decipher/sign test from Robs RSA code. ===\n");
+  test_printf("=== 1024 bit decipher/sign test from Robs RSA code. ===\n");
 
   mod_exp_array(33, message, exponent, modulus, target);
   assertArrayEquals(33, expected, target);
@@ -224,22 +226,29 @@ void rob_enc_1024(void)
                        0x00000000, 0x00000000, 0x00000000, 0x00000000,
                        0x00000000, 0x00000000, 0x00000000, 0x00000000};
 
-  printf("=== 1024 bit encipher/verify test from Robs RSA code. ===\n");
+  test_printf("=== 1024 bit encipher/verify test from Robs RSA code. ===\n");
 
   mod_exp_array(33, expected, exponent, modulus, target);
   assertArrayEquals(33, message, target);
 }
 
 
+const test_case simple_test_cases[] = {
+//  TEST_CASE(simple_3_7_11),
+//  TEST_CASE(simple_251_251_257),
+//  TEST_CASE(bigger_test),
+//  TEST_CASE(small_e_256_mod),
+//  TEST_CASE(small_e_64_mod),
+  TEST_CASE(rob_enc_1024),
+  TEST_CASE(rob_dec_1024)
+  //  TEST_CASE(small_e_256_mod2),
+};
+
+const uint32_t simple_test_case_count =
+  sizeof(simple_test_cases) / sizeof(test_case);
+
 void simple_tests(void) {
-//  simple_3_7_11();
-//  simple_251_251_257();
-//  bigger_test();
-//  small_e_256_mod();
-//  small_e_64_mod();
-  rob_enc_1024();
-  rob_dec_1024();
-  //  small_e_256_mod2();
+  run_test_cases(simple_test_cases, simple_test_case_count);
 }
 
 //======================================================================
@@ -41,6 +41,9 @@
 
 void simple_tests(void);
 
+extern const test_case simple_test_cases[];
+extern const uint32_t simple_test_case_count;
+
 #endif // SIMPLE_TESTS_H_
 
 //======================================================================
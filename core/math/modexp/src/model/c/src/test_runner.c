@@ -0,0 +1,111 @@
+/*
+ * test_runner.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+// Runs the test cases of the modexp C model, in parallel on a thread
+// pool, with a per test timing report.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include "bignum_uint32_t.h"
+#include "thread_pool.h"
+#include "test_runner.h"
+
+typedef struct {
+	double ms;
+	int asserts;
+	int failed;
+	FILE *out;      // the buffered output of the case, or NULL
+} test_result;
+
+typedef struct {
+	const test_case *cases;
+	test_result *results;
+	int buffered;   // buffer the output of each case
+} test_run;
+
+static double now_ms(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec * 1e3 + (double) ts.tv_nsec / 1e6;
+}
+
+void run_test_cases(const test_case *cases, uint32_t count) {
+	for (uint32_t i = 0; i < count; i++)
+		cases[i].fn();
+}
+
+// One case, with its wall clock time and the asserts made on this
+// thread while it ran. When buffered the case prints to a temporary
+// file of its own.
+static void run_one(void *arg, uint32_t index) {
+	test_run *run = arg;
+	test_result *result = &run->results[index];
+	int total, error, total_after, error_after;
+	FILE *out = run->buffered ? tmpfile() : NULL;
+	assert_array_set_output(out);
+	assert_array_thread_stats(&total, &error);
+	double start = now_ms();
+	run->cases[index].fn();
+	result->ms = now_ms() - start;
+	assert_array_thread_stats(&total_after, &error_after);
+	assert_array_set_output(NULL);
+	result->asserts = total_after - total;
+	result->failed = error_after - error;
+	result->out = out;
+}
+
+// The buffered output of a case.
+static void print_output(FILE *out) {
+	char buf[4096];
+	size_t n;
+	rewind(out);
+	while ((n = fread(buf, 1, sizeof(buf), out)) > 0)
+		fwrite(buf, 1, n, stdout);
+	fclose(out);
+}
+
+uint32_t run_test_cases_timed(const test_case *cases, uint32_t count,
+		uint32_t threads) {
+	test_run run;
+	run.cases = cases;
+	run.buffered = threads > 1;
+	run.results = calloc(count, sizeof(test_result));
+	if (run.results == NULL) {
+		printf("calloc failed\n");
+		exit(1);
+	}
+
+	double start = now_ms();
+	thread_pool_run(threads, count, run_one, &run);
+	double wall = now_ms() - start;
+
+	for (uint32_t i = 0; i < count; i++)
+		if (run.results[i].out != NULL)
+			print_output(run.results[i].out);
+
+	printf("=== test times, %u threads ===\n", threads);
+	printf("#        ms  asserts  failed  test\n");
+	uint32_t failed = 0;
+	uint32_t longest = 0;
+	double sum = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		printf("%11.2f %8d %7d  %s\n", run.results[i].ms, run.results[i].asserts,
+				run.results[i].failed, cases[i].name);
+		if (run.results[i].failed)
+			failed++;
+		if (run.results[i].ms > run.results[longest].ms)
+			longest = i;
+		sum += run.results[i].ms;
+	}
+	if (count > 0)
+		printf("wall %.2f ms, sum of tests %.2f ms, longest %.2f ms (%s)\n",
+				wall, sum, run.results[longest].ms, cases[longest].name);
+
+	free(run.results);
+	return failed;
+}
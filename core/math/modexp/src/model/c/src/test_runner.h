@@ -0,0 +1,34 @@
+/*
+ * test_runner.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+// Runs the test cases of the modexp C model, in parallel on a thread
+// pool, with a per test timing report.
+
+#ifndef TEST_RUNNER_H_
+#define TEST_RUNNER_H_
+
+typedef struct test_case {
+	const char *name;
+	void (*fn)(void);
+} test_case;
+
+#define TEST_CASE(fn) { #fn, fn }
+
+// What a test case prints goes to the output of its thread, see
+// assert_array_output().
+#define test_printf(...) fprintf(assert_array_output(), __VA_ARGS__)
+
+// Runs the cases one after another, printing as they go.
+void run_test_cases(const test_case *cases, uint32_t count);
+
+// Runs the cases on threads threads and prints the time of each. With
+// more than one thread the output of each case is buffered and printed
+// after the run, in the order of the cases. Returns the number of cases
+// with failed asserts.
+uint32_t run_test_cases_timed(const test_case *cases, uint32_t count,
+		uint32_t threads);
+
+#endif /* TEST_RUNNER_H_ */
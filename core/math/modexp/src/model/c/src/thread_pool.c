@@ -0,0 +1,133 @@
+/*
+ * thread_pool.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+// A small work stealing thread pool for the modexp C model, for batches
+// of exponentiations and for running the tests in parallel.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "thread_pool.h"
+
+// The indexes next .. end - 1 not yet started by one thread. The owner
+// takes from the bottom, thieves from the top.
+typedef struct {
+	pthread_mutex_t lock;
+	uint32_t next;
+	uint32_t end;
+} pool_queue;
+
+typedef struct {
+	pool_queue *queues;
+	uint32_t threads;
+	thread_pool_fn fn;
+	void *arg;
+} pool;
+
+typedef struct {
+	pool *pool;
+	uint32_t id;
+} pool_worker;
+
+static int pool_take(pool_queue *queue, uint32_t *index) {
+	int taken = 0;
+	pthread_mutex_lock(&queue->lock);
+	if (queue->next < queue->end) {
+		*index = queue->next++;
+		taken = 1;
+	}
+	pthread_mutex_unlock(&queue->lock);
+	return taken;
+}
+
+// Moves the upper half of the victim's range to the thief, whose own
+// range is empty.
+static int pool_steal(pool_queue *victim, pool_queue *thief) {
+	pthread_mutex_lock(&victim->lock);
+	uint32_t left = victim->end - victim->next;
+	uint32_t take = (left + 1) / 2;
+	victim->end -= take;
+	uint32_t start = victim->end;
+	pthread_mutex_unlock(&victim->lock);
+	if (take == 0)
+		return 0;
+
+	pthread_mutex_lock(&thief->lock);
+	thief->next = start;
+	thief->end = start + take;
+	pthread_mutex_unlock(&thief->lock);
+	return 1;
+}
+
+// Works through the own range, then steals until every range is empty.
+static void *pool_work(void *arg) {
+	pool_worker *worker = arg;
+	pool *p = worker->pool;
+	pool_queue *own = &p->queues[worker->id];
+	uint32_t index;
+	for (;;) {
+		if (pool_take(own, &index)) {
+			p->fn(p->arg, index);
+			continue;
+		}
+		int stolen = 0;
+		for (uint32_t k = 1; (k < p->threads) && !stolen; k++)
+			stolen = pool_steal(&p->queues[(worker->id + k) % p->threads], own);
+		if (!stolen)
+			break;
+	}
+	return NULL;
+}
+
+void thread_pool_run(uint32_t threads, uint32_t count, thread_pool_fn fn,
+		void *arg) {
+	if (threads > count)
+		threads = count;
+	if (threads < 1)
+		threads = 1;
+
+	pool p;
+	p.queues = calloc(threads, sizeof(pool_queue));
+	pool_worker *workers = calloc(threads, sizeof(pool_worker));
+	pthread_t *ids = calloc(threads, sizeof(pthread_t));
+	int *started = calloc(threads, sizeof(int));
+	if ((p.queues == NULL) || (workers == NULL) || (ids == NULL) || (started == NULL)) {
+		// No pool, run them here.
+		for (uint32_t i = 0; i < count; i++)
+			fn(arg, i);
+		free(p.queues);
+		free(workers);
+		free(ids);
+		free(started);
+		return;
+	}
+	p.threads = threads;
+	p.fn = fn;
+	p.arg = arg;
+
+	for (uint32_t t = 0; t < threads; t++) {
+		pthread_mutex_init(&p.queues[t].lock, NULL);
+		p.queues[t].next = (uint32_t) (((uint64_t) count * t) / threads);
+		p.queues[t].end = (uint32_t) (((uint64_t) count * (t + 1)) / threads);
+		workers[t].pool = &p;
+		workers[t].id = t;
+	}
+
+	for (uint32_t t = 1; t < threads; t++)
+		started[t] = pthread_create(&ids[t], NULL, pool_work, &workers[t]) == 0;
+	pool_work(&workers[0]);
+	for (uint32_t t = 1; t < threads; t++)
+		if (started[t])
+			pthread_join(ids[t], NULL);
+
+	for (uint32_t t = 0; t < threads; t++)
+		pthread_mutex_destroy(&p.queues[t].lock);
+	free(p.queues);
+	free(workers);
+	free(ids);
+	free(started);
+}
@@ -0,0 +1,22 @@
+/*
+ * thread_pool.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+// A small work stealing thread pool for the modexp C model.
+
+#ifndef THREAD_POOL_H_
+#define THREAD_POOL_H_
+
+typedef void (*thread_pool_fn)(void *arg, uint32_t index);
+
+// Runs fn(arg, index) for every index in 0 .. count - 1 on up to
+// threads threads, the calling thread being one of them, and returns
+// when all are done. Each thread starts with an equal range of indexes
+// and steals half of another thread's remaining range when its own
+// runs out. If threads cannot be started the others do their work.
+void thread_pool_run(uint32_t threads, uint32_t count, thread_pool_fn fn,
+		void *arg);
+
+#endif /* THREAD_POOL_H_ */
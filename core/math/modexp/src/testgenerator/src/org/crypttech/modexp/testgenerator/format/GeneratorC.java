@@ -12,6 +12,8 @@ public class GeneratorC extends ModExpTestFormater {
 		out("#include <stdlib.h>");
 		out("#include \"montgomery_array.h\"");
 		out("#include \"bignum_uint32_t.h\"");
+		out("#include \"test_runner.h\"");
+		out("#include \"autogenerated_tests.h\"");
 	}
 
 	StringBuilder footer = new StringBuilder();
@@ -20,10 +22,10 @@ public class GeneratorC extends ModExpTestFormater {
 	public void format(TestVector testVector) {
 		String testname = ("autogenerated_" + testVector.generator + "_" + testVector.seed)
 				.replace("-", "M");
-		footer.append("  ").append(testname).append("();").append((char) 10);
+		footer.append("  TEST_CASE(").append(testname).append("),").append((char) 10);
 
 		out("void %s(void) {", testname);
-		out("  printf(\"=== %s ===\\n\");", testname);
+		out("  test_printf(\"=== %s ===\\n\");", testname);
 		appendCArray("X", testVector.X);
 		appendCArray("E", testVector.E);
 		appendCArray("M", testVector.M);
@@ -47,8 +49,13 @@ public class GeneratorC extends ModExpTestFormater {
 
 	@Override
 	public void close() throws Exception {
-		out("void autogenerated_tests(void) {");
+		out("const test_case autogenerated_test_cases[] = {");
 		out(footer.toString());
+		out("};");
+		out("const uint32_t autogenerated_test_case_count =");
+		out("    sizeof(autogenerated_test_cases) / sizeof(test_case);");
+		out("void autogenerated_tests(void) {");
+		out("  run_test_cases(autogenerated_test_cases, autogenerated_test_case_count);");
 		out("}");
 		super.close();
 	}
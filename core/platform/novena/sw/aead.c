@@ -0,0 +1,210 @@
+/*
+ * aead.c
+ * ------
+ * ChaCha20-Poly1305 AEAD (RFC 8439) on top of the chacha20_poly1305
+ * core, which encrypts and authenticates each block in one pass.
+ *
+ * The core takes the AAD and the data in 64 byte blocks, and only the
+ * last block of each may be short, so a message is run through it in
+ * one call. Only the bytes of a short block that are used are moved
+ * over the bus, and the configuration and length registers are only
+ * written when they change.
+ *
+ * Copyright (c) 2016, NORDUnet A/S All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the NORDUnet nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/types.h>
+
+#include "cryptech.h"
+
+/* RFC 8439 limit: the block counter starts at 1 and is 32 bits */
+#define AEAD_MAX_DATA_LEN       ((((uint64_t)1 << 32) - 1) * AEAD_BLOCK_LEN)
+
+/* ---------------- core access ---------------- */
+
+static int write32(off_t addr, uint32_t val)
+{
+    uint8_t w[4];
+
+    w[0] = val >> 24;
+    w[1] = val >> 16;
+    w[2] = val >> 8;
+    w[3] = val;
+    return tc_write(addr, w, 4);
+}
+
+/* the configuration and length registers, as last written */
+struct regs {
+    uint32_t config;
+    uint32_t len;
+};
+
+static int set_reg(off_t addr, uint32_t val, uint32_t *cur)
+{
+    if (*cur == val)
+        return 0;
+    *cur = ~0;
+    if (write32(addr, val) != 0)
+        return 1;
+    *cur = val;
+    return 0;
+}
+
+static int start(off_t base, const uint8_t *key, const uint8_t *nonce)
+{
+    if (tc_write(base + AEAD_ADDR_KEY0, key, AEAD_KEY_LEN) != 0 ||
+        tc_write(base + AEAD_ADDR_NONCE0, nonce, AEAD_NONCE_LEN) != 0 ||
+        tc_init(base + AEAD_ADDR_CTRL) != 0 ||
+        tc_wait_ready(base + AEAD_ADDR_STATUS) != 0)
+        return 1;
+    return 0;
+}
+
+/* Run one block of 1..64 bytes through the core. out is NULL for AAD. */
+static int run_block(off_t base, struct regs *regs, uint32_t config,
+                     const uint8_t *in, size_t len, uint8_t *out)
+{
+    uint8_t buf[AEAD_BLOCK_LEN];
+    size_t wlen = (len + 3) & ~3;
+    int ret = 1;
+
+    memcpy(buf, in, len);
+    memset(buf + len, 0, wlen - len);
+
+    if (tc_write(base + AEAD_ADDR_DATA_IN0, buf, wlen) != 0 ||
+        set_reg(base + AEAD_ADDR_CONFIG, config, &regs->config) != 0 ||
+        set_reg(base + AEAD_ADDR_DATA_LEN, len, &regs->len) != 0 ||
+        tc_next(base + AEAD_ADDR_CTRL) != 0 ||
+        tc_wait_ready(base + AEAD_ADDR_STATUS) != 0)
+        goto out;
+
+    if (out != NULL) {
+        if (tc_read(base + AEAD_ADDR_DATA_OUT0, buf, wlen) != 0)
+            goto out;
+        memcpy(out, buf, len);
+    }
+    ret = 0;
+
+out:
+    memset(buf, 0, sizeof(buf));
+    return ret;
+}
+
+/* Run the AAD and the data through the core and get the tag. */
+static int run(off_t base, const uint8_t *key, const uint8_t *nonce, int encrypt,
+               const uint8_t *aad, size_t aad_len,
+               const uint8_t *in, size_t len, uint8_t *out, uint8_t *tag)
+{
+    struct regs regs = { ~0, ~0 };
+    uint32_t config = encrypt ? AEAD_CONFIG_ENCRYPT : 0;
+    size_t n;
+
+    if (start(base, key, nonce) != 0)
+        return 1;
+
+    for (; aad_len > 0; aad += n, aad_len -= n) {
+        n = (aad_len < AEAD_BLOCK_LEN) ? aad_len : AEAD_BLOCK_LEN;
+        if (run_block(base, &regs, AEAD_CONFIG_AAD, aad, n, NULL) != 0)
+            return 1;
+    }
+
+    for (; len > 0; in += n, out += n, len -= n) {
+        n = (len < AEAD_BLOCK_LEN) ? len : AEAD_BLOCK_LEN;
+        if (run_block(base, &regs, config, in, n, out) != 0)
+            return 1;
+    }
+
+    if (write32(base + AEAD_ADDR_CTRL, AEAD_CTRL_FINISH) != 0 ||
+        tc_wait_valid(base + AEAD_ADDR_STATUS) != 0 ||
+        tc_read(base + AEAD_ADDR_TAG0, tag, AEAD_TAG_LEN) != 0)
+        return 1;
+
+    return 0;
+}
+
+static int check_args(off_t *base, const uint8_t *key, const uint8_t *nonce,
+                      const uint8_t *aad, size_t aad_len,
+                      const uint8_t *in, size_t len, const uint8_t *out,
+                      const uint8_t *tag)
+{
+    if (key == NULL || nonce == NULL || tag == NULL ||
+        (aad_len > 0 && aad == NULL) ||
+        (len > 0 && (in == NULL || out == NULL)) ||
+        (uint64_t)len > AEAD_MAX_DATA_LEN)
+        return -1;
+
+    if (*base == 0)
+        *base = tc_core_base(AEAD_NAME0 AEAD_NAME1);
+    if (*base == 0)
+        return -1;
+
+    return 0;
+}
+
+/* ---------------- encrypt / decrypt ---------------- */
+
+int aead_encrypt(off_t base, const uint8_t *key, const uint8_t *nonce,
+                 const uint8_t *aad, size_t aad_len,
+                 const uint8_t *pt, size_t len, uint8_t *ct, uint8_t *tag)
+{
+    if (check_args(&base, key, nonce, aad, aad_len, pt, len, ct, tag) != 0)
+        return -1;
+
+    return run(base, key, nonce, 1, aad, aad_len, pt, len, ct, tag);
+}
+
+int aead_decrypt(off_t base, const uint8_t *key, const uint8_t *nonce,
+                 const uint8_t *aad, size_t aad_len,
+                 const uint8_t *ct, size_t len, const uint8_t *tag, uint8_t *pt)
+{
+    uint8_t t[AEAD_TAG_LEN];
+    uint8_t diff = 0;
+    size_t i;
+    int ret;
+
+    if (check_args(&base, key, nonce, aad, aad_len, ct, len, pt, tag) != 0)
+        return -1;
+
+    if ((ret = run(base, key, nonce, 0, aad, aad_len, ct, len, pt, t)) == 0) {
+        /* no early exit, so the time taken does not depend on the tag */
+        for (i = 0; i < AEAD_TAG_LEN; ++i)
+            diff |= t[i] ^ tag[i];
+        if (diff != 0)
+            ret = -1;
+    }
+
+    if (ret != 0 && len > 0)
+        memset(pt, 0, len);
+    memset(t, 0, sizeof(t));
+    return ret;
+}
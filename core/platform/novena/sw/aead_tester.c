@@ -0,0 +1,368 @@
+/*
+ * aead_tester.c
+ * -------------
+ * Checks the ChaCha20-Poly1305 driver against the AEAD test vectors in
+ * RFC 8439 (sections 2.8.2 and A.5), then reports the throughput for
+ * a range of message sizes.
+ *
+ * Copyright (c) 2016, NORDUnet A/S All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the NORDUnet nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <sys/types.h>
+
+#include "cryptech.h"
+
+char *usage =
+"Usage: %s [-h] [-a #] [-n #]\n\
+\n\
+-a      bytes of AAD per message (default 16)\n\
+-n      number of bytes to process per message size (default 65536)\n\
+";
+
+static off_t aead_base;
+
+static inline uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/* ---------------- test vectors ---------------- */
+
+/* RFC 8439, 2.8.2 */
+static const uint8_t key_282[AEAD_KEY_LEN] = {
+    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x8b,
+    0x8c, 0x8d, 0x8e, 0x8f, 0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+    0x98, 0x99, 0x9a, 0x9b, 0x9c, 0x9d, 0x9e, 0x9f,
+};
+
+static const uint8_t nonce_282[AEAD_NONCE_LEN] = {
+    0x07, 0x00, 0x00, 0x00, 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47,
+};
+
+static const uint8_t aad_282[12] = {
+    0x50, 0x51, 0x52, 0x53, 0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7,
+};
+
+static const uint8_t pt_282[114] = {
+    0x4c, 0x61, 0x64, 0x69, 0x65, 0x73, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x47,
+    0x65, 0x6e, 0x74, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x20, 0x6f, 0x66, 0x20,
+    0x74, 0x68, 0x65, 0x20, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x20, 0x6f, 0x66,
+    0x20, 0x27, 0x39, 0x39, 0x3a, 0x20, 0x49, 0x66, 0x20, 0x49, 0x20, 0x63,
+    0x6f, 0x75, 0x6c, 0x64, 0x20, 0x6f, 0x66, 0x66, 0x65, 0x72, 0x20, 0x79,
+    0x6f, 0x75, 0x20, 0x6f, 0x6e, 0x6c, 0x79, 0x20, 0x6f, 0x6e, 0x65, 0x20,
+    0x74, 0x69, 0x70, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20,
+    0x66, 0x75, 0x74, 0x75, 0x72, 0x65, 0x2c, 0x20, 0x73, 0x75, 0x6e, 0x73,
+    0x63, 0x72, 0x65, 0x65, 0x6e, 0x20, 0x77, 0x6f, 0x75, 0x6c, 0x64, 0x20,
+    0x62, 0x65, 0x20, 0x69, 0x74, 0x2e,
+};
+
+static const uint8_t ct_282[114] = {
+    0xd3, 0x1a, 0x8d, 0x34, 0x64, 0x8e, 0x60, 0xdb, 0x7b, 0x86, 0xaf, 0xbc,
+    0x53, 0xef, 0x7e, 0xc2, 0xa4, 0xad, 0xed, 0x51, 0x29, 0x6e, 0x08, 0xfe,
+    0xa9, 0xe2, 0xb5, 0xa7, 0x36, 0xee, 0x62, 0xd6, 0x3d, 0xbe, 0xa4, 0x5e,
+    0x8c, 0xa9, 0x67, 0x12, 0x82, 0xfa, 0xfb, 0x69, 0xda, 0x92, 0x72, 0x8b,
+    0x1a, 0x71, 0xde, 0x0a, 0x9e, 0x06, 0x0b, 0x29, 0x05, 0xd6, 0xa5, 0xb6,
+    0x7e, 0xcd, 0x3b, 0x36, 0x92, 0xdd, 0xbd, 0x7f, 0x2d, 0x77, 0x8b, 0x8c,
+    0x98, 0x03, 0xae, 0xe3, 0x28, 0x09, 0x1b, 0x58, 0xfa, 0xb3, 0x24, 0xe4,
+    0xfa, 0xd6, 0x75, 0x94, 0x55, 0x85, 0x80, 0x8b, 0x48, 0x31, 0xd7, 0xbc,
+    0x3f, 0xf4, 0xde, 0xf0, 0x8e, 0x4b, 0x7a, 0x9d, 0xe5, 0x76, 0xd2, 0x65,
+    0x86, 0xce, 0xc6, 0x4b, 0x61, 0x16,
+};
+
+static const uint8_t tag_282[AEAD_TAG_LEN] = {
+    0x1a, 0xe1, 0x0b, 0x59, 0x4f, 0x09, 0xe2, 0x6a, 0x7e, 0x90, 0x2e, 0xcb,
+    0xd0, 0x60, 0x06, 0x91,
+};
+
+/* RFC 8439, A.5 */
+static const uint8_t key_a5[AEAD_KEY_LEN] = {
+    0x1c, 0x92, 0x40, 0xa5, 0xeb, 0x55, 0xd3, 0x8a, 0xf3, 0x33, 0x88, 0x86,
+    0x04, 0xf6, 0xb5, 0xf0, 0x47, 0x39, 0x17, 0xc1, 0x40, 0x2b, 0x80, 0x09,
+    0x9d, 0xca, 0x5c, 0xbc, 0x20, 0x70, 0x75, 0xc0,
+};
+
+static const uint8_t nonce_a5[AEAD_NONCE_LEN] = {
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+};
+
+static const uint8_t aad_a5[12] = {
+    0xf3, 0x33, 0x88, 0x86, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4e, 0x91,
+};
+
+static const uint8_t pt_a5[265] = {
+    0x49, 0x6e, 0x74, 0x65, 0x72, 0x6e, 0x65, 0x74, 0x2d, 0x44, 0x72, 0x61,
+    0x66, 0x74, 0x73, 0x20, 0x61, 0x72, 0x65, 0x20, 0x64, 0x72, 0x61, 0x66,
+    0x74, 0x20, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x73, 0x20,
+    0x76, 0x61, 0x6c, 0x69, 0x64, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x61, 0x20,
+    0x6d, 0x61, 0x78, 0x69, 0x6d, 0x75, 0x6d, 0x20, 0x6f, 0x66, 0x20, 0x73,
+    0x69, 0x78, 0x20, 0x6d, 0x6f, 0x6e, 0x74, 0x68, 0x73, 0x20, 0x61, 0x6e,
+    0x64, 0x20, 0x6d, 0x61, 0x79, 0x20, 0x62, 0x65, 0x20, 0x75, 0x70, 0x64,
+    0x61, 0x74, 0x65, 0x64, 0x2c, 0x20, 0x72, 0x65, 0x70, 0x6c, 0x61, 0x63,
+    0x65, 0x64, 0x2c, 0x20, 0x6f, 0x72, 0x20, 0x6f, 0x62, 0x73, 0x6f, 0x6c,
+    0x65, 0x74, 0x65, 0x64, 0x20, 0x62, 0x79, 0x20, 0x6f, 0x74, 0x68, 0x65,
+    0x72, 0x20, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x73, 0x20,
+    0x61, 0x74, 0x20, 0x61, 0x6e, 0x79, 0x20, 0x74, 0x69, 0x6d, 0x65, 0x2e,
+    0x20, 0x49, 0x74, 0x20, 0x69, 0x73, 0x20, 0x69, 0x6e, 0x61, 0x70, 0x70,
+    0x72, 0x6f, 0x70, 0x72, 0x69, 0x61, 0x74, 0x65, 0x20, 0x74, 0x6f, 0x20,
+    0x75, 0x73, 0x65, 0x20, 0x49, 0x6e, 0x74, 0x65, 0x72, 0x6e, 0x65, 0x74,
+    0x2d, 0x44, 0x72, 0x61, 0x66, 0x74, 0x73, 0x20, 0x61, 0x73, 0x20, 0x72,
+    0x65, 0x66, 0x65, 0x72, 0x65, 0x6e, 0x63, 0x65, 0x20, 0x6d, 0x61, 0x74,
+    0x65, 0x72, 0x69, 0x61, 0x6c, 0x20, 0x6f, 0x72, 0x20, 0x74, 0x6f, 0x20,
+    0x63, 0x69, 0x74, 0x65, 0x20, 0x74, 0x68, 0x65, 0x6d, 0x20, 0x6f, 0x74,
+    0x68, 0x65, 0x72, 0x20, 0x74, 0x68, 0x61, 0x6e, 0x20, 0x61, 0x73, 0x20,
+    0x2f, 0xe2, 0x80, 0x9c, 0x77, 0x6f, 0x72, 0x6b, 0x20, 0x69, 0x6e, 0x20,
+    0x70, 0x72, 0x6f, 0x67, 0x72, 0x65, 0x73, 0x73, 0x2e, 0x2f, 0xe2, 0x80,
+    0x9d,
+};
+
+static const uint8_t ct_a5[265] = {
+    0x64, 0xa0, 0x86, 0x15, 0x75, 0x86, 0x1a, 0xf4, 0x60, 0xf0, 0x62, 0xc7,
+    0x9b, 0xe6, 0x43, 0xbd, 0x5e, 0x80, 0x5c, 0xfd, 0x34, 0x5c, 0xf3, 0x89,
+    0xf1, 0x08, 0x67, 0x0a, 0xc7, 0x6c, 0x8c, 0xb2, 0x4c, 0x6c, 0xfc, 0x18,
+    0x75, 0x5d, 0x43, 0xee, 0xa0, 0x9e, 0xe9, 0x4e, 0x38, 0x2d, 0x26, 0xb0,
+    0xbd, 0xb7, 0xb7, 0x3c, 0x32, 0x1b, 0x01, 0x00, 0xd4, 0xf0, 0x3b, 0x7f,
+    0x35, 0x58, 0x94, 0xcf, 0x33, 0x2f, 0x83, 0x0e, 0x71, 0x0b, 0x97, 0xce,
+    0x98, 0xc8, 0xa8, 0x4a, 0xbd, 0x0b, 0x94, 0x81, 0x14, 0xad, 0x17, 0x6e,
+    0x00, 0x8d, 0x33, 0xbd, 0x60, 0xf9, 0x82, 0xb1, 0xff, 0x37, 0xc8, 0x55,
+    0x97, 0x97, 0xa0, 0x6e, 0xf4, 0xf0, 0xef, 0x61, 0xc1, 0x86, 0x32, 0x4e,
+    0x2b, 0x35, 0x06, 0x38, 0x36, 0x06, 0x90, 0x7b, 0x6a, 0x7c, 0x02, 0xb0,
+    0xf9, 0xf6, 0x15, 0x7b, 0x53, 0xc8, 0x67, 0xe4, 0xb9, 0x16, 0x6c, 0x76,
+    0x7b, 0x80, 0x4d, 0x46, 0xa5, 0x9b, 0x52, 0x16, 0xcd, 0xe7, 0xa4, 0xe9,
+    0x90, 0x40, 0xc5, 0xa4, 0x04, 0x33, 0x22, 0x5e, 0xe2, 0x82, 0xa1, 0xb0,
+    0xa0, 0x6c, 0x52, 0x3e, 0xaf, 0x45, 0x34, 0xd7, 0xf8, 0x3f, 0xa1, 0x15,
+    0x5b, 0x00, 0x47, 0x71, 0x8c, 0xbc, 0x54, 0x6a, 0x0d, 0x07, 0x2b, 0x04,
+    0xb3, 0x56, 0x4e, 0xea, 0x1b, 0x42, 0x22, 0x73, 0xf5, 0x48, 0x27, 0x1a,
+    0x0b, 0xb2, 0x31, 0x60, 0x53, 0xfa, 0x76, 0x99, 0x19, 0x55, 0xeb, 0xd6,
+    0x31, 0x59, 0x43, 0x4e, 0xce, 0xbb, 0x4e, 0x46, 0x6d, 0xae, 0x5a, 0x10,
+    0x73, 0xa6, 0x72, 0x76, 0x27, 0x09, 0x7a, 0x10, 0x49, 0xe6, 0x17, 0xd9,
+    0x1d, 0x36, 0x10, 0x94, 0xfa, 0x68, 0xf0, 0xff, 0x77, 0x98, 0x71, 0x30,
+    0x30, 0x5b, 0xea, 0xba, 0x2e, 0xda, 0x04, 0xdf, 0x99, 0x7b, 0x71, 0x4d,
+    0x6c, 0x6f, 0x2c, 0x29, 0xa6, 0xad, 0x5c, 0xb4, 0x02, 0x2b, 0x02, 0x70,
+    0x9b,
+};
+
+static const uint8_t tag_a5[AEAD_TAG_LEN] = {
+    0xee, 0xad, 0x9d, 0x67, 0x89, 0x0c, 0xbb, 0x22, 0x39, 0x23, 0x36, 0xfe,
+    0xa1, 0x85, 0x1f, 0x38,
+};
+
+static const struct {
+    const char *name;
+    const uint8_t *key, *nonce, *aad, *pt, *ct, *tag;
+    size_t aad_len, len;
+} vectors[] = {
+    { "RFC 8439 2.8.2", key_282, nonce_282, aad_282, pt_282, ct_282, tag_282,
+      sizeof(aad_282), sizeof(pt_282) },
+    { "RFC 8439 A.5", key_a5, nonce_a5, aad_a5, pt_a5, ct_a5, tag_a5,
+      sizeof(aad_a5), sizeof(pt_a5) },
+};
+
+/* Check the vectors in both directions, and that a message with a
+ * flipped bit in the ciphertext or the tag is rejected and wiped.
+ */
+static int check_vectors(void)
+{
+    uint8_t buf[sizeof(pt_a5)], tag[AEAD_TAG_LEN];
+    size_t v;
+
+    for (v = 0; v < sizeof(vectors) / sizeof(vectors[0]); ++v) {
+        if (aead_encrypt(aead_base, vectors[v].key, vectors[v].nonce,
+                         vectors[v].aad, vectors[v].aad_len,
+                         vectors[v].pt, vectors[v].len, buf, tag) != 0 ||
+            memcmp(buf, vectors[v].ct, vectors[v].len) != 0 ||
+            memcmp(tag, vectors[v].tag, AEAD_TAG_LEN) != 0) {
+            fprintf(stderr, "%s: encryption failed\n", vectors[v].name);
+            return 1;
+        }
+
+        if (aead_decrypt(aead_base, vectors[v].key, vectors[v].nonce,
+                         vectors[v].aad, vectors[v].aad_len,
+                         vectors[v].ct, vectors[v].len, vectors[v].tag, buf) != 0 ||
+            memcmp(buf, vectors[v].pt, vectors[v].len) != 0) {
+            fprintf(stderr, "%s: decryption failed\n", vectors[v].name);
+            return 1;
+        }
+
+        memcpy(buf, vectors[v].ct, vectors[v].len);
+        buf[vectors[v].len - 1] ^= 1;
+        if (aead_decrypt(aead_base, vectors[v].key, vectors[v].nonce,
+                         vectors[v].aad, vectors[v].aad_len,
+                         buf, vectors[v].len, vectors[v].tag, buf) != -1 ||
+            buf[0] != 0) {
+            fprintf(stderr, "%s: modified ciphertext accepted\n", vectors[v].name);
+            return 1;
+        }
+
+        memcpy(tag, vectors[v].tag, AEAD_TAG_LEN);
+        tag[AEAD_TAG_LEN - 1] ^= 0x80;
+        if (aead_decrypt(aead_base, vectors[v].key, vectors[v].nonce,
+                         vectors[v].aad, vectors[v].aad_len,
+                         vectors[v].ct, vectors[v].len, tag, buf) != -1) {
+            fprintf(stderr, "%s: modified tag accepted\n", vectors[v].name);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/* Round trip messages whose AAD and data lengths sit around the 16 byte
+ * padding and the 64 byte block boundaries.
+ */
+static int check_lengths(void)
+{
+    static const size_t lens[] = { 0, 1, 15, 16, 17, 63, 64, 65, 128, 129 };
+    uint8_t msg[129], ct[129], pt[129], tag[AEAD_TAG_LEN];
+    size_t a, d, i;
+
+    for (i = 0; i < sizeof(msg); ++i)
+        msg[i] = 0xa5 ^ i;
+
+    for (a = 0; a < sizeof(lens) / sizeof(lens[0]); ++a)
+        for (d = 0; d < sizeof(lens) / sizeof(lens[0]); ++d) {
+            if (aead_encrypt(aead_base, key_a5, nonce_a5, msg, lens[a],
+                             msg, lens[d], ct, tag) != 0 ||
+                aead_decrypt(aead_base, key_a5, nonce_a5, msg, lens[a],
+                             ct, lens[d], tag, pt) != 0 ||
+                memcmp(pt, msg, lens[d]) != 0) {
+                fprintf(stderr, "%lu bytes AAD, %lu bytes data: round trip failed\n",
+                        (unsigned long)lens[a], (unsigned long)lens[d]);
+                return 1;
+            }
+        }
+
+    return 0;
+}
+
+/* ---------------- benchmark ---------------- */
+
+/* Encrypt len bytes as messages of size bytes and return the time it
+ * took in seconds, or a negative value on error.
+ */
+static double run(const uint8_t *aad, size_t aad_len,
+                  const uint8_t *in, uint8_t *out, size_t len, size_t size)
+{
+    uint8_t tag[AEAD_TAG_LEN];
+    uint64_t start;
+    size_t off, n;
+
+    start = now_ns();
+
+    for (off = 0; off < len; off += n) {
+        n = (len - off < size) ? len - off : size;
+        if (aead_encrypt(aead_base, key_282, nonce_282, aad, aad_len,
+                         in + off, n, out + off, tag) != 0)
+            return -1.0;
+    }
+
+    return (now_ns() - start) / 1e9;
+}
+
+int main(int argc, char *argv[])
+{
+    static const size_t sizes[] = { 64, 256, 1024, 4096, 16384, 65536 };
+    unsigned long nbytes = 65536, aad_len = 16;
+    uint8_t *aad, *in, *out;
+    double secs;
+    int opt, ret = EXIT_SUCCESS;
+    size_t i;
+
+    while ((opt = getopt(argc, argv, "h?a:n:")) != -1) {
+        switch (opt) {
+        case 'h':
+        case '?':
+            printf(usage, argv[0]);
+            return EXIT_SUCCESS;
+        case 'a':
+            aad_len = strtoul(optarg, NULL, 0);
+            break;
+        case 'n':
+            nbytes = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, usage, argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (nbytes == 0) {
+        fprintf(stderr, usage, argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    aead_base = tc_core_base(AEAD_NAME0 AEAD_NAME1);
+    if (aead_base == 0) {
+        fprintf(stderr, "chacha20_poly1305 core not found\n");
+        return EXIT_FAILURE;
+    }
+
+    if (check_vectors() != 0 || check_lengths() != 0)
+        return EXIT_FAILURE;
+    printf("# RFC 8439 vectors and round trips ok\n");
+
+    aad = malloc(aad_len + 1);
+    in = malloc(nbytes);
+    out = malloc(nbytes);
+    if (aad == NULL || in == NULL || out == NULL) {
+        perror("malloc");
+        return EXIT_FAILURE;
+    }
+    memset(aad, 0x5a, aad_len);
+    memset(in, 0xa5, nbytes);
+
+    printf("# ChaCha20-Poly1305 encryption, %lu bytes AAD, %lu bytes per message size\n",
+           aad_len, nbytes);
+    printf("# msg bytes     MB/s  us/msg\n");
+
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]) && sizes[i] <= nbytes; ++i) {
+        if ((secs = run(aad, aad_len, in, out, nbytes, sizes[i])) < 0) {
+            fprintf(stderr, "%lu byte messages failed\n", (unsigned long)sizes[i]);
+            ret = EXIT_FAILURE;
+            break;
+        }
+        printf("%11lu %8.3f %7.2f\n", (unsigned long)sizes[i],
+               secs > 0 ? nbytes / secs / 1e6 : 0.0,
+               secs * 1e6 / ((nbytes + sizes[i] - 1) / sizes[i]));
+        fflush(stdout);
+    }
+
+    free(aad);
+    free(in);
+    free(out);
+    return ret;
+}
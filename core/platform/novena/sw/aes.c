@@ -0,0 +1,488 @@
+/*
+ * aes.c
+ * -----
+ * Bulk ECB, CBC and CTR modes on top of the AES core.
+ *
+ * The key is written and expanded in the core once, when a context is
+ * first used, and then stays there for as long as no other key pushes
+ * it out, so a stream of blocks costs one block write, one start, the
+ * status poll and one result read per block. The CBC chaining value
+ * and the CTR counter are kept on the host.
+ *
+ * Cores with a multi-slot key memory keep up to 16 expanded keys. The
+ * driver remembers which key is in which slot and replaces the least
+ * recently used one on a miss, so alternating between keys only costs
+ * a write to the slot register.
+ *
+ * Cores that can run CTR mode by themselves are given the counter and
+ * the number of blocks with a single start command, and the keystream
+ * is read out of the core's FIFO in bursts.
+ *
+ * Copyright (c) 2016, NORDUnet A/S All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the NORDUnet nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/types.h>
+
+#include "cryptech.h"
+
+/* What the core currently holds. A context only needs to write its
+ * key and run the key expansion when its key is not in any slot.
+ */
+static struct {
+    off_t base;
+    int config;                 /* last value written to CONFIG, or -1 */
+    int slot;                   /* slot selected in the core, or -1 */
+    unsigned long clock;        /* ticks once per key lookup */
+    struct {
+        size_t keylen;          /* 0 if the slot is empty */
+        uint8_t key[AES_KEY_LEN_256];
+        unsigned long used;     /* clock at the last lookup that hit */
+    } slots[AES_MAX_KEY_SLOTS];
+} core = { .config = -1, .slot = -1 };
+
+/* blocks per hardware CTR run, well inside the core's 32-bit count */
+#define AES_CTR_MAX_BLOCKS      0x100000
+
+/* ---------------- register access ---------------- */
+
+static int write32(off_t addr, uint32_t val)
+{
+    uint8_t w[4];
+
+    w[0] = val >> 24;
+    w[1] = val >> 16;
+    w[2] = val >> 8;
+    w[3] = val;
+    return tc_write(addr, w, 4);
+}
+
+static int read32(off_t addr, uint32_t *val)
+{
+    uint8_t r[4];
+
+    if (tc_read(addr, r, 4) != 0)
+        return 1;
+    *val = (uint32_t)r[0] << 24 | (uint32_t)r[1] << 16 | (uint32_t)r[2] << 8 | r[3];
+    return 0;
+}
+
+static int write_config(off_t base, int config)
+{
+    uint8_t w[4] = { 0, 0, 0, config };
+
+    if (core.base == base && core.config == config)
+        return 0;
+
+    if (tc_write(base + AES_ADDR_CONFIG, w, 4) != 0) {
+        core.config = -1;
+        return 1;
+    }
+    core.config = config;
+    return 0;
+}
+
+static int select_slot(aes_ctx_t *ctx, unsigned slot)
+{
+    if (ctx->key_slots == 0 || core.slot == (int)slot)
+        return 0;
+
+    core.slot = -1;
+    if (write32(ctx->base + AES_ADDR_KEY_SLOT, slot) != 0)
+        return 1;
+    core.slot = slot;
+    return 0;
+}
+
+/* Find the slot holding the context's key, or pick the least recently
+ * used one and load the key into it. Cores without slots count as
+ * having one.
+ */
+static int load_key(aes_ctx_t *ctx)
+{
+    int config = (ctx->keylen == AES_KEY_LEN_256) ? AES_CONFIG_KEYLEN : 0;
+    unsigned nslots = ctx->key_slots ? ctx->key_slots : 1;
+    unsigned i, slot = 0;
+
+    if (core.base != ctx->base) {
+        memset(core.slots, 0, sizeof(core.slots));
+        core.base = ctx->base;
+        core.config = -1;
+        core.slot = -1;
+    }
+
+    ++core.clock;
+
+    for (i = 0; i < nslots; ++i)
+        if (core.slots[i].keylen == ctx->keylen &&
+            memcmp(core.slots[i].key, ctx->key, ctx->keylen) == 0) {
+            core.slots[i].used = core.clock;
+            return select_slot(ctx, i);
+        }
+
+    for (i = 0; i < nslots; ++i) {
+        if (core.slots[i].keylen == 0) {
+            slot = i;
+            break;
+        }
+        if (core.slots[i].used < core.slots[slot].used)
+            slot = i;
+    }
+
+    /* forget the old key before we start overwriting it, and write
+     * the config along with the key in case someone else has been
+     * at the core
+     */
+    memset(&core.slots[slot], 0, sizeof(core.slots[slot]));
+    core.config = -1;
+
+    if (select_slot(ctx, slot) != 0 ||
+        tc_write(ctx->base + AES_ADDR_KEY0, ctx->key, ctx->keylen) != 0 ||
+        write_config(ctx->base, config) != 0 ||
+        tc_init(ctx->base + AES_ADDR_CTRL) != 0 ||
+        tc_wait_ready(ctx->base + AES_ADDR_STATUS) != 0)
+        return 1;
+
+    core.slots[slot].keylen = ctx->keylen;
+    memcpy(core.slots[slot].key, ctx->key, ctx->keylen);
+    core.slots[slot].used = core.clock;
+    return 0;
+}
+
+/* Run one block through the core, in the direction given by encdec
+ * (AES_CONFIG_ENCDEC to encipher, 0 to decipher).
+ */
+static int aes_block(aes_ctx_t *ctx, const uint8_t *in, uint8_t *out, int encdec)
+{
+    int config = (ctx->keylen == AES_KEY_LEN_256) ? AES_CONFIG_KEYLEN : 0;
+
+    if (load_key(ctx) != 0)
+        return 1;
+
+    return
+        write_config(ctx->base, config | encdec) ||
+        tc_write(ctx->base + AES_ADDR_BLOCK0, in, AES_BLOCK_LEN) ||
+        tc_next(ctx->base + AES_ADDR_CTRL) ||
+        tc_wait_ready(ctx->base + AES_ADDR_STATUS) ||
+        tc_read(ctx->base + AES_ADDR_RESULT0, out, AES_BLOCK_LEN);
+}
+
+static inline void xor_block(uint8_t *dst, const uint8_t *a, const uint8_t *b, size_t len)
+{
+    size_t i;
+
+    for (i = 0; i < len; ++i)
+        dst[i] = a[i] ^ b[i];
+}
+
+/* ---------------- context ---------------- */
+
+int aes_init(aes_ctx_t *ctx, off_t base, const uint8_t *key, size_t keylen)
+{
+    struct core_info *node;
+    uint32_t nslots;
+
+    if (ctx == NULL || key == NULL ||
+        (keylen != AES_KEY_LEN_128 && keylen != AES_KEY_LEN_256))
+        return -1;
+
+    if (base == 0)
+        base = tc_core_base(AES_CORE_NAME0 AES_CORE_NAME1);
+    if (base == 0)
+        return -1;
+
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->base = base;
+    ctx->keylen = keylen;
+    memcpy(ctx->key, key, keylen);
+    ctx->ks_used = AES_BLOCK_LEN;
+
+    for (node = tc_core_first(AES_CORE_NAME0 AES_CORE_NAME1); node != NULL;
+         node = tc_core_next(node, AES_CORE_NAME0 AES_CORE_NAME1))
+        if (node->base == base) {
+            ctx->hw_ctr = (strncmp(node->version, AES_CORE_VERSION_CTR, 4) >= 0);
+            ctx->hw_erase = (strncmp(node->version, AES_CORE_VERSION_ERASE, 4) >= 0);
+            if (strncmp(node->version, AES_CORE_VERSION_SLOTS, 4) >= 0 &&
+                read32(base + AES_ADDR_KEY_SLOTS, &nslots) == 0 && nslots > 0)
+                ctx->key_slots = (nslots > AES_MAX_KEY_SLOTS) ? AES_MAX_KEY_SLOTS : nslots;
+            break;
+        }
+
+    return 0;
+}
+
+/* Set the CBC initialization vector or the initial CTR counter block. */
+int aes_set_iv(aes_ctx_t *ctx, const uint8_t *iv)
+{
+    if (ctx == NULL || iv == NULL)
+        return -1;
+
+    memcpy(ctx->iv, iv, AES_BLOCK_LEN);
+    ctx->ks_used = AES_BLOCK_LEN;
+    return 0;
+}
+
+/* Abort a CTR run left behind by a caller that gave up, and wait for
+ * the core to stop. The block already in the core is let finish, and
+ * until then the core ignores writes to the key slot, config, counter
+ * and control registers.
+ */
+static int ctr_abort(aes_ctx_t *ctx)
+{
+    uint32_t status;
+    int limit = 1000;
+
+    if (write32(ctx->base + AES_ADDR_CTRL, AES_CTRL_ABORT) != 0)
+        return 1;
+
+    for (;;) {
+        if (read32(ctx->base + AES_ADDR_STATUS, &status) != 0)
+            return 1;
+        if (!(status & AES_STATUS_CTR) && (status & STATUS_READY))
+            return 0;
+        if (--limit == 0) {
+            fprintf(stderr, "aes: timed out waiting for an aborted run\n");
+            return 1;
+        }
+    }
+}
+
+/* Erase a key slot in the core: its expanded key and the key
+ * registers. Cores without the erase command get the slot overwritten
+ * with the schedule of an all-zero key instead.
+ */
+static int erase_slot(aes_ctx_t *ctx, unsigned slot)
+{
+    static const uint8_t zero[AES_KEY_LEN_256];
+
+    core.config = -1;
+    return
+        ctr_abort(ctx) ||
+        select_slot(ctx, slot) ||
+        tc_write(ctx->base + AES_ADDR_KEY0, zero, sizeof(zero)) ||
+        (ctx->hw_erase ?
+         write32(ctx->base + AES_ADDR_CTRL, AES_CTRL_ERASE) :
+         tc_init(ctx->base + AES_ADDR_CTRL)) ||
+        tc_wait_ready(ctx->base + AES_ADDR_STATUS);
+}
+
+/* Wipe the context, and its key from the core and from the host's
+ * slot table.
+ */
+void aes_clear(aes_ctx_t *ctx)
+{
+    unsigned i;
+
+    if (core.base == ctx->base)
+        for (i = 0; i < AES_MAX_KEY_SLOTS; ++i)
+            if (core.slots[i].keylen == ctx->keylen &&
+                memcmp(core.slots[i].key, ctx->key, ctx->keylen) == 0) {
+                memset(&core.slots[i], 0, sizeof(core.slots[i]));
+                if (erase_slot(ctx, i) != 0)
+                    fprintf(stderr, "aes: failed to erase key slot %u\n", i);
+            }
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+/* ---------------- ECB ---------------- */
+
+static int ecb(aes_ctx_t *ctx, const uint8_t *in, uint8_t *out, size_t len, int encdec)
+{
+    if (len % AES_BLOCK_LEN != 0)
+        return -1;
+
+    for (; len > 0; in += AES_BLOCK_LEN, out += AES_BLOCK_LEN, len -= AES_BLOCK_LEN)
+        if (aes_block(ctx, in, out, encdec) != 0)
+            return 1;
+
+    return 0;
+}
+
+int aes_ecb_encrypt(aes_ctx_t *ctx, const uint8_t *in, uint8_t *out, size_t len)
+{
+    return ecb(ctx, in, out, len, AES_CONFIG_ENCDEC);
+}
+
+int aes_ecb_decrypt(aes_ctx_t *ctx, const uint8_t *in, uint8_t *out, size_t len)
+{
+    return ecb(ctx, in, out, len, 0);
+}
+
+/* ---------------- CBC ---------------- */
+
+int aes_cbc_encrypt(aes_ctx_t *ctx, const uint8_t *in, uint8_t *out, size_t len)
+{
+    uint8_t block[AES_BLOCK_LEN];
+
+    if (len % AES_BLOCK_LEN != 0)
+        return -1;
+
+    for (; len > 0; in += AES_BLOCK_LEN, out += AES_BLOCK_LEN, len -= AES_BLOCK_LEN) {
+        xor_block(block, in, ctx->iv, AES_BLOCK_LEN);
+        if (aes_block(ctx, block, ctx->iv, AES_CONFIG_ENCDEC) != 0)
+            return 1;
+        memcpy(out, ctx->iv, AES_BLOCK_LEN);
+    }
+
+    return 0;
+}
+
+int aes_cbc_decrypt(aes_ctx_t *ctx, const uint8_t *in, uint8_t *out, size_t len)
+{
+    uint8_t block[AES_BLOCK_LEN];
+
+    if (len % AES_BLOCK_LEN != 0)
+        return -1;
+
+    /* in and out may be the same buffer, so hold on to the ciphertext */
+    for (; len > 0; in += AES_BLOCK_LEN, out += AES_BLOCK_LEN, len -= AES_BLOCK_LEN) {
+        if (aes_block(ctx, in, block, 0) != 0)
+            return 1;
+        xor_block(block, block, ctx->iv, AES_BLOCK_LEN);
+        memcpy(ctx->iv, in, AES_BLOCK_LEN);
+        memcpy(out, block, AES_BLOCK_LEN);
+    }
+
+    return 0;
+}
+
+/* ---------------- CTR ---------------- */
+
+/* The whole counter block is a 128-bit big-endian counter, as in
+ * NIST SP 800-38A.
+ */
+static void ctr_inc(uint8_t *ctr)
+{
+    int i;
+
+    for (i = AES_BLOCK_LEN - 1; i >= 0; --i)
+        if (++ctr[i] != 0)
+            break;
+}
+
+/* Let the core generate nblocks of keystream from the current counter
+ * and XOR it into the data as it comes out of the FIFO.
+ */
+static int ctr_run(aes_ctx_t *ctx, const uint8_t *in, uint8_t *out, uint32_t nblocks)
+{
+    uint8_t ks[AES_KS_WINDOW * 4];
+    int config = (ctx->keylen == AES_KEY_LEN_256) ? AES_CONFIG_KEYLEN : 0;
+    size_t len = (size_t)nblocks * AES_BLOCK_LEN, n;
+    uint32_t avail;
+    int limit = 1000;
+
+    if (ctr_abort(ctx) != 0 ||
+        load_key(ctx) != 0 ||
+        write_config(ctx->base, config | AES_CONFIG_ENCDEC | AES_CONFIG_CTRW_128) != 0 ||
+        tc_write(ctx->base + AES_ADDR_CTR0, ctx->iv, AES_BLOCK_LEN) != 0 ||
+        write32(ctx->base + AES_ADDR_CTR_BLOCKS, nblocks) != 0 ||
+        write32(ctx->base + AES_ADDR_CTRL, AES_CTRL_CTR) != 0)
+        goto errout;
+
+    while (len > 0) {
+        if (read32(ctx->base + AES_ADDR_KS_AVAIL, &avail) != 0)
+            goto errout;
+        if (avail == 0) {
+            if (--limit == 0) {
+                fprintf(stderr, "aes: timed out waiting for keystream\n");
+                goto errout;
+            }
+            continue;
+        }
+        limit = 1000;
+
+        n = (size_t)avail * 4;
+        if (n > sizeof(ks))
+            n = sizeof(ks);
+        if (n > len)
+            n = len;
+        if (tc_read(ctx->base + AES_ADDR_KS_DATA, ks, n) != 0)
+            goto errout;
+        xor_block(out, in, ks, n);
+        in += n;
+        out += n;
+        len -= n;
+    }
+
+    /* the core has stepped the counter once per block */
+    if (tc_read(ctx->base + AES_ADDR_CTR0, ctx->iv, AES_BLOCK_LEN) != 0)
+        goto errout;
+
+    return 0;
+
+errout:
+    /* stop the run, so the core doesn't keep generating keystream
+     * nobody will read */
+    write32(ctx->base + AES_ADDR_CTRL, AES_CTRL_ABORT);
+    return 1;
+}
+
+/* Encrypt or decrypt len bytes. Any length is allowed; keystream left
+ * over from a partial block is used by the next call.
+ */
+int aes_ctr_crypt(aes_ctx_t *ctx, const uint8_t *in, uint8_t *out, size_t len)
+{
+    size_t n;
+
+    while (len > 0) {
+        if (ctx->hw_ctr && ctx->ks_used == AES_BLOCK_LEN && len >= AES_BLOCK_LEN) {
+            n = len / AES_BLOCK_LEN;
+            if (n > AES_CTR_MAX_BLOCKS)
+                n = AES_CTR_MAX_BLOCKS;
+            if (ctr_run(ctx, in, out, n) != 0)
+                return 1;
+            n *= AES_BLOCK_LEN;
+            in += n;
+            out += n;
+            len -= n;
+            continue;
+        }
+
+        if (ctx->ks_used == AES_BLOCK_LEN) {
+            if (aes_block(ctx, ctx->iv, ctx->ks, AES_CONFIG_ENCDEC) != 0)
+                return 1;
+            ctr_inc(ctx->iv);
+            ctx->ks_used = 0;
+        }
+
+        n = AES_BLOCK_LEN - ctx->ks_used;
+        if (n > len)
+            n = len;
+        xor_block(out, in, ctx->ks + ctx->ks_used, n);
+        ctx->ks_used += n;
+        in += n;
+        out += n;
+        len -= n;
+    }
+
+    return 0;
+}
@@ -0,0 +1,440 @@
+/*
+ * aes_bench.c
+ * -----------
+ * Throughput of the AES driver in ECB, CBC and CTR mode, against the
+ * block-at-a-time pattern of aes_tester, which writes and expands the
+ * key for every block and moves each register word separately.
+ * A second test alternates between a number of keys, one block per
+ * key, with a single key slot and with all the slots the core has.
+ *
+ * Copyright (c) 2016, NORDUnet A/S All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the NORDUnet nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <sys/types.h>
+
+#include "cryptech.h"
+
+char *usage =
+"Usage: %s [-h] [-k 128|256] [-n #] [-s #]\n\
+\n\
+-k      key length in bits (default 128)\n\
+-n      number of bytes to process per mode (default 65536)\n\
+-s      number of keys in the key switching test (default 16)\n\
+";
+
+static off_t aes_base;
+
+static inline uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/* ---------------- NIST SP 800-38A, F.1.1, F.2.1 and F.5.1 ---------------- */
+
+static const uint8_t nist_key[16] = {
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+};
+
+static const uint8_t nist_plaintext[64] = {
+    0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96,
+    0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+    0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c,
+    0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+    0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11,
+    0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+    0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17,
+    0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10
+};
+
+static const uint8_t nist_ecb[64] = {
+    0x3a, 0xd7, 0x7b, 0xb4, 0x0d, 0x7a, 0x36, 0x60,
+    0xa8, 0x9e, 0xca, 0xf3, 0x24, 0x66, 0xef, 0x97,
+    0xf5, 0xd3, 0xd5, 0x85, 0x03, 0xb9, 0x69, 0x9d,
+    0xe7, 0x85, 0x89, 0x5a, 0x96, 0xfd, 0xba, 0xaf,
+    0x43, 0xb1, 0xcd, 0x7f, 0x59, 0x8e, 0xce, 0x23,
+    0x88, 0x1b, 0x00, 0xe3, 0xed, 0x03, 0x06, 0x88,
+    0x7b, 0x0c, 0x78, 0x5e, 0x27, 0xe8, 0xad, 0x3f,
+    0x82, 0x23, 0x20, 0x71, 0x04, 0x72, 0x5d, 0xd4
+};
+
+static const uint8_t nist_cbc_iv[16] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+
+static const uint8_t nist_cbc[64] = {
+    0x76, 0x49, 0xab, 0xac, 0x81, 0x19, 0xb2, 0x46,
+    0xce, 0xe9, 0x8e, 0x9b, 0x12, 0xe9, 0x19, 0x7d,
+    0x50, 0x86, 0xcb, 0x9b, 0x50, 0x72, 0x19, 0xee,
+    0x95, 0xdb, 0x11, 0x3a, 0x91, 0x76, 0x78, 0xb2,
+    0x73, 0xbe, 0xd6, 0xb8, 0xe3, 0xc1, 0x74, 0x3b,
+    0x71, 0x16, 0xe6, 0x9e, 0x22, 0x22, 0x95, 0x16,
+    0x3f, 0xf1, 0xca, 0xa1, 0x68, 0x1f, 0xac, 0x09,
+    0x12, 0x0e, 0xca, 0x30, 0x75, 0x86, 0xe1, 0xa7
+};
+
+static const uint8_t nist_ctr_iv[16] = {
+    0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+    0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff
+};
+
+static const uint8_t nist_ctr[64] = {
+    0x87, 0x4d, 0x61, 0x91, 0xb6, 0x20, 0xe3, 0x26,
+    0x1b, 0xef, 0x68, 0x64, 0x99, 0x0d, 0xb6, 0xce,
+    0x98, 0x06, 0xf6, 0x6b, 0x79, 0x70, 0xfd, 0xff,
+    0x86, 0x17, 0x18, 0x7b, 0xb9, 0xff, 0xfd, 0xff,
+    0x5a, 0xe4, 0xdf, 0x3e, 0xdb, 0xd5, 0xd3, 0x5e,
+    0x5b, 0x4f, 0x09, 0x02, 0x0d, 0xb0, 0x3e, 0xab,
+    0x1e, 0x03, 0x1d, 0xda, 0x2f, 0xbe, 0x03, 0xd1,
+    0x79, 0x21, 0x70, 0xa0, 0xf3, 0x00, 0x9c, 0xee
+};
+
+static int check_result(const char *what, const uint8_t *got, const uint8_t *expected)
+{
+    if (memcmp(got, expected, sizeof(nist_plaintext)) == 0)
+        return 0;
+    fprintf(stderr, "%s: result does not match NIST SP 800-38A\n", what);
+    return 1;
+}
+
+/* Make sure the driver gets the right answers before timing it. CTR
+ * is done in odd-sized pieces to exercise the partial block handling.
+ */
+static int self_test(void)
+{
+    uint8_t buf[64];
+    aes_ctx_t ctx;
+    int ret = 1;
+
+    if (aes_init(&ctx, aes_base, nist_key, sizeof(nist_key)) != 0)
+        return 1;
+
+    if (aes_ecb_encrypt(&ctx, nist_plaintext, buf, 64) != 0 ||
+        check_result("ECB encrypt", buf, nist_ecb) ||
+        aes_ecb_decrypt(&ctx, buf, buf, 64) != 0 ||
+        check_result("ECB decrypt", buf, nist_plaintext))
+        goto out;
+
+    if (aes_set_iv(&ctx, nist_cbc_iv) != 0 ||
+        aes_cbc_encrypt(&ctx, nist_plaintext, buf, 64) != 0 ||
+        check_result("CBC encrypt", buf, nist_cbc) ||
+        aes_set_iv(&ctx, nist_cbc_iv) != 0 ||
+        aes_cbc_decrypt(&ctx, buf, buf, 64) != 0 ||
+        check_result("CBC decrypt", buf, nist_plaintext))
+        goto out;
+
+    if (aes_set_iv(&ctx, nist_ctr_iv) != 0 ||
+        aes_ctr_crypt(&ctx, nist_plaintext, buf, 7) != 0 ||
+        aes_ctr_crypt(&ctx, nist_plaintext + 7, buf + 7, 30) != 0 ||
+        aes_ctr_crypt(&ctx, nist_plaintext + 37, buf + 37, 27) != 0 ||
+        check_result("CTR encrypt", buf, nist_ctr) ||
+        aes_set_iv(&ctx, nist_ctr_iv) != 0 ||
+        aes_ctr_crypt(&ctx, buf, buf, 64) != 0 ||
+        check_result("CTR decrypt", buf, nist_plaintext))
+        goto out;
+
+    ret = 0;
+out:
+    aes_clear(&ctx);
+    return ret;
+}
+
+/* ---------------- the aes_tester pattern ---------------- */
+
+static int w32(off_t addr, uint32_t val)
+{
+    uint8_t w[4];
+
+    w[0] = val >> 24;
+    w[1] = val >> 16;
+    w[2] = val >> 8;
+    w[3] = val;
+    return tc_write(addr, w, 4);
+}
+
+static int r32(off_t addr, uint32_t *val)
+{
+    uint8_t w[4];
+
+    if (tc_read(addr, w, 4) != 0)
+        return 1;
+    *val = (uint32_t)w[0] << 24 | (uint32_t)w[1] << 16 | (uint32_t)w[2] << 8 | w[3];
+    return 0;
+}
+
+static uint32_t get32(const uint8_t *p)
+{
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+/* One block the way single_block_test() does it: key, key expansion,
+ * block and result one word at a time.
+ */
+static int single_block(const uint8_t *key, size_t keylen, const uint8_t *in, uint8_t *out)
+{
+    uint32_t config = (keylen == AES_KEY_LEN_256) ? AES_CONFIG_KEYLEN : 0;
+    uint32_t word;
+    int limit = 10;
+    size_t i;
+
+    for (i = 0; i < keylen / 4; ++i)
+        if (w32(aes_base + AES_ADDR_KEY0 + i, get32(key + 4 * i)) != 0)
+            return 1;
+
+    if (w32(aes_base + AES_ADDR_CONFIG, config) != 0 ||
+        w32(aes_base + AES_ADDR_CTRL, CTRL_INIT) != 0 ||
+        tc_wait(aes_base + AES_ADDR_STATUS, STATUS_READY, &limit) != 0)
+        return 1;
+
+    for (i = 0; i < AES_BLOCK_LEN / 4; ++i)
+        if (w32(aes_base + AES_ADDR_BLOCK0 + i, get32(in + 4 * i)) != 0)
+            return 1;
+
+    limit = 10;
+    if (w32(aes_base + AES_ADDR_CONFIG, config | AES_CONFIG_ENCDEC) != 0 ||
+        w32(aes_base + AES_ADDR_CTRL, CTRL_NEXT) != 0 ||
+        tc_wait(aes_base + AES_ADDR_STATUS, STATUS_READY, &limit) != 0)
+        return 1;
+
+    for (i = 0; i < AES_BLOCK_LEN / 4; ++i) {
+        if (r32(aes_base + AES_ADDR_RESULT0 + i, &word) != 0)
+            return 1;
+        out[4 * i]     = word >> 24;
+        out[4 * i + 1] = word >> 16;
+        out[4 * i + 2] = word >> 8;
+        out[4 * i + 3] = word;
+    }
+
+    return 0;
+}
+
+/* ---------------- benchmark ---------------- */
+
+enum { MODE_SINGLE, MODE_ECB, MODE_CBC, MODE_CTR };
+
+/* Encrypt len bytes in the given mode and return the time it took in
+ * seconds, or a negative value on error.
+ */
+static double run(int mode, const uint8_t *key, size_t keylen,
+                  const uint8_t *in, uint8_t *out, size_t len)
+{
+    static const uint8_t iv[AES_BLOCK_LEN] = { 0 };
+    aes_ctx_t ctx;
+    uint64_t start;
+    size_t i;
+    int ret = 0;
+
+    /* key setup is part of what we are measuring */
+    start = now_ns();
+
+    if (mode == MODE_SINGLE) {
+        for (i = 0; i < len && ret == 0; i += AES_BLOCK_LEN)
+            ret = single_block(key, keylen, in + i, out + i);
+    }
+    else {
+        if (aes_init(&ctx, aes_base, key, keylen) != 0 ||
+            aes_set_iv(&ctx, iv) != 0)
+            return -1.0;
+
+        switch (mode) {
+        case MODE_ECB:
+            ret = aes_ecb_encrypt(&ctx, in, out, len);
+            break;
+        case MODE_CBC:
+            ret = aes_cbc_encrypt(&ctx, in, out, len);
+            break;
+        case MODE_CTR:
+            ret = aes_ctr_crypt(&ctx, in, out, len);
+            break;
+        }
+        aes_clear(&ctx);
+    }
+
+    if (ret != 0)
+        return -1.0;
+
+    return (now_ns() - start) / 1e9;
+}
+
+/* ---------------- key switching ---------------- */
+
+/* Round-robin over nkeys keys, one block per key per turn, the way a
+ * server with many session keys would use the core. With key_slots set
+ * to 1 every switch reloads and expands the key, as a core with a
+ * single key memory has to.
+ */
+static double run_keys(unsigned nkeys, unsigned key_slots, size_t keylen,
+                       const uint8_t *in, uint8_t *out, size_t len)
+{
+    aes_ctx_t *ctx;
+    uint8_t key[AES_KEY_LEN_256];
+    uint64_t start;
+    unsigned k;
+    size_t i;
+    int ret = 0;
+
+    if ((ctx = calloc(nkeys, sizeof(*ctx))) == NULL)
+        return -1.0;
+
+    for (k = 0; k < nkeys && ret == 0; ++k) {
+        memset(key, k + 1, sizeof(key));
+        ret = aes_init(&ctx[k], aes_base, key, keylen);
+        if (ret == 0 && ctx[k].key_slots > key_slots)
+            ctx[k].key_slots = key_slots;
+    }
+
+    start = now_ns();
+
+    for (i = 0; i < len && ret == 0; i += AES_BLOCK_LEN)
+        ret = aes_ecb_encrypt(&ctx[(i / AES_BLOCK_LEN) % nkeys], in + i, out + i, AES_BLOCK_LEN);
+
+    for (k = 0; k < nkeys; ++k)
+        aes_clear(&ctx[k]);
+    free(ctx);
+
+    if (ret != 0)
+        return -1.0;
+
+    return (now_ns() - start) / 1e9;
+}
+
+int main(int argc, char *argv[])
+{
+    static const char *names[] = { "single", "ECB", "CBC", "CTR" };
+    unsigned long nbytes = 65536;
+    unsigned keybits = 128, nkeys = 16;
+    aes_ctx_t probe;
+    uint8_t key[AES_KEY_LEN_256], *in, *out;
+    double secs, base_secs = 0.0;
+    int opt, mode, ret = EXIT_SUCCESS;
+    size_t i;
+
+    while ((opt = getopt(argc, argv, "h?k:n:s:")) != -1) {
+        switch (opt) {
+        case 'h':
+        case '?':
+            printf(usage, argv[0]);
+            return EXIT_SUCCESS;
+        case 'k':
+            keybits = strtoul(optarg, NULL, 0);
+            break;
+        case 'n':
+            nbytes = strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            nkeys = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, usage, argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    nbytes -= nbytes % AES_BLOCK_LEN;
+    if ((keybits != 128 && keybits != 256) || nbytes == 0 || nkeys == 0) {
+        fprintf(stderr, usage, argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    aes_base = tc_core_base(AES_CORE_NAME0 AES_CORE_NAME1);
+    if (aes_base == 0) {
+        fprintf(stderr, "aes core not found\n");
+        return EXIT_FAILURE;
+    }
+
+    if (self_test() != 0)
+        return EXIT_FAILURE;
+
+    in = malloc(nbytes);
+    out = malloc(nbytes);
+    if (in == NULL || out == NULL) {
+        perror("malloc");
+        return EXIT_FAILURE;
+    }
+    for (i = 0; i < sizeof(key); ++i)
+        key[i] = i;
+    memset(in, 0xa5, nbytes);
+
+    printf("# AES-%u, %lu bytes per mode\n", keybits, nbytes);
+    printf("# mode      MB/s  us/block  speedup\n");
+
+    for (mode = MODE_SINGLE; mode <= MODE_CTR; ++mode) {
+        if ((secs = run(mode, key, keybits / 8, in, out, nbytes)) < 0) {
+            fprintf(stderr, "%s failed\n", names[mode]);
+            ret = EXIT_FAILURE;
+            break;
+        }
+        if (mode == MODE_SINGLE)
+            base_secs = secs;
+
+        printf("%-6s  %8.3f  %8.2f  %7.2f\n", names[mode],
+               secs > 0 ? nbytes / secs / 1e6 : 0.0,
+               secs * 1e6 / (nbytes / AES_BLOCK_LEN),
+               secs > 0 ? base_secs / secs : 0.0);
+        fflush(stdout);
+    }
+
+    if (ret == EXIT_SUCCESS && aes_init(&probe, aes_base, key, keybits / 8) == 0) {
+        unsigned slots = probe.key_slots ? probe.key_slots : 1;
+
+        aes_clear(&probe);
+        printf("\n# %u keys round-robin, one block per key, %u key slots in the core\n",
+               nkeys, slots);
+        printf("# slots     MB/s  us/block  speedup\n");
+
+        if ((base_secs = run_keys(nkeys, 1, keybits / 8, in, out, nbytes)) < 0 ||
+            (secs = run_keys(nkeys, slots, keybits / 8, in, out, nbytes)) < 0) {
+            fprintf(stderr, "key switching test failed\n");
+            ret = EXIT_FAILURE;
+        }
+        else {
+            printf("%5u   %8.3f  %8.2f  %7.2f\n", 1,
+                   base_secs > 0 ? nbytes / base_secs / 1e6 : 0.0,
+                   base_secs * 1e6 / (nbytes / AES_BLOCK_LEN), 1.0);
+            printf("%5u   %8.3f  %8.2f  %7.2f\n", slots,
+                   secs > 0 ? nbytes / secs / 1e6 : 0.0,
+                   secs * 1e6 / (nbytes / AES_BLOCK_LEN),
+                   secs > 0 ? base_secs / secs : 0.0);
+        }
+    }
+
+    free(in);
+    free(out);
+    return ret;
+}
@@ -0,0 +1,207 @@
+/*
+ * chacha.c
+ * --------
+ * ChaCha stream cipher on top of the chacha core, with 8, 12 or 20
+ * rounds and 128 or 256 bit keys.
+ *
+ * The core XORs its data input with the keystream. The driver leaves
+ * the data input at zero and reads the keystream, 64 bytes per bus
+ * burst, and does the XOR on the host: that takes the 16 data writes
+ * per block off the bus, and means the core can be started on the
+ * next block as soon as one has been read, so it runs the rounds while
+ * the host is busy with the data and the next call.
+ *
+ * When another context has been using the core, it is taken back to
+ * the right block by loading the block counter before init. Cores
+ * older than 0.82 have no counter register and are run forward from
+ * block zero instead.
+ *
+ * Copyright (c) 2016, NORDUnet A/S All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the NORDUnet nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/types.h>
+
+#include "cryptech.h"
+
+/* Which context the core is running, and the block it is working on
+ * or holds in its output registers.
+ */
+static struct {
+    off_t base;
+    const chacha_ctx_t *owner;
+    uint64_t block;
+} core;
+
+/* ---------------- core access ---------------- */
+
+static int write32(off_t addr, uint32_t val)
+{
+    uint8_t w[4];
+
+    w[0] = val >> 24;
+    w[1] = val >> 16;
+    w[2] = val >> 8;
+    w[3] = val;
+    return tc_write(addr, w, 4);
+}
+
+/* Load the context's key, IV and block counter and start the core on
+ * the block the context is at. Without a counter register the core
+ * starts on block zero and is run forward.
+ */
+static int restart(chacha_ctx_t *ctx)
+{
+    static const uint8_t zero[CHACHA_BLOCK_LEN] = { 0 };
+    uint64_t start = ctx->hw_ctr ? ctx->blocks : 0;
+
+    core.owner = NULL;
+
+    if (tc_write(ctx->base + CHACHA_ADDR_KEY0, ctx->key, ctx->keylen) != 0 ||
+        tc_write(ctx->base + CHACHA_ADDR_IV0, ctx->iv, CHACHA_IV_LEN) != 0 ||
+        write32(ctx->base + CHACHA_ADDR_KEYLEN,
+                (ctx->keylen == CHACHA_KEY_LEN_256) ? CHACHA_KEYLEN : 0) != 0 ||
+        write32(ctx->base + CHACHA_ADDR_ROUNDS, ctx->rounds) != 0 ||
+        tc_write(ctx->base + CHACHA_ADDR_DATA_IN0, zero, sizeof(zero)) != 0 ||
+        (ctx->hw_ctr &&
+         (write32(ctx->base + CHACHA_ADDR_CTR0, (uint32_t)start) != 0 ||
+          write32(ctx->base + CHACHA_ADDR_CTR1, (uint32_t)(start >> 32)) != 0)) ||
+        tc_init(ctx->base + CHACHA_ADDR_CTRL) != 0)
+        return 1;
+
+    for (core.block = start; core.block < ctx->blocks; ++core.block)
+        if (tc_wait_valid(ctx->base + CHACHA_ADDR_STATUS) != 0 ||
+            tc_next(ctx->base + CHACHA_ADDR_CTRL) != 0)
+            return 1;
+
+    core.base = ctx->base;
+    core.owner = ctx;
+    return 0;
+}
+
+/* Read the next keystream block and start the core on the one after. */
+static int next_block(chacha_ctx_t *ctx, uint8_t *ks)
+{
+    if ((core.owner != ctx || core.base != ctx->base || core.block != ctx->blocks) &&
+        restart(ctx) != 0)
+        return 1;
+
+    if (tc_wait_valid(ctx->base + CHACHA_ADDR_STATUS) != 0 ||
+        tc_read(ctx->base + CHACHA_ADDR_DATA_OUT0, ks, CHACHA_BLOCK_LEN) != 0 ||
+        tc_next(ctx->base + CHACHA_ADDR_CTRL) != 0) {
+        core.owner = NULL;
+        return 1;
+    }
+
+    ++core.block;
+    ++ctx->blocks;
+    return 0;
+}
+
+/* ---------------- context ---------------- */
+
+int chacha_init(chacha_ctx_t *ctx, off_t base, const uint8_t *key, size_t keylen,
+                const uint8_t *iv, unsigned rounds)
+{
+    struct core_info *node;
+
+    if (ctx == NULL || key == NULL || iv == NULL ||
+        (keylen != CHACHA_KEY_LEN_128 && keylen != CHACHA_KEY_LEN_256) ||
+        (rounds != 8 && rounds != 12 && rounds != 20))
+        return -1;
+
+    if (base == 0)
+        base = tc_core_base(CHACHA_NAME0 CHACHA_NAME1);
+    if (base == 0)
+        return -1;
+
+    if (core.owner == ctx)
+        core.owner = NULL;
+
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->base = base;
+    ctx->rounds = rounds;
+    ctx->keylen = keylen;
+    memcpy(ctx->key, key, keylen);
+    memcpy(ctx->iv, iv, CHACHA_IV_LEN);
+    ctx->ks_used = CHACHA_BLOCK_LEN;
+
+    for (node = tc_core_first(CHACHA_NAME0 CHACHA_NAME1); node != NULL;
+         node = tc_core_next(node, CHACHA_NAME0 CHACHA_NAME1))
+        if (node->base == base) {
+            ctx->hw_ctr = (strncmp(node->version, CHACHA_VERSION_CTR, 4) >= 0);
+            break;
+        }
+
+    return 0;
+}
+
+void chacha_clear(chacha_ctx_t *ctx)
+{
+    if (core.owner == ctx)
+        core.owner = NULL;
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+/* ---------------- encrypt / decrypt ---------------- */
+
+int chacha_crypt(chacha_ctx_t *ctx, const uint8_t *in, uint8_t *out, size_t len)
+{
+    uint8_t ks[CHACHA_BLOCK_LEN];
+    size_t i, n;
+
+    if (ctx == NULL || ctx->keylen == 0 || (len > 0 && (in == NULL || out == NULL)))
+        return -1;
+
+    /* use up what is left of the last block */
+    for (; len > 0 && ctx->ks_used < CHACHA_BLOCK_LEN; --len)
+        *out++ = *in++ ^ ctx->ks[ctx->ks_used++];
+
+    for (; len >= CHACHA_BLOCK_LEN; in += CHACHA_BLOCK_LEN, out += CHACHA_BLOCK_LEN,
+             len -= CHACHA_BLOCK_LEN) {
+        if (next_block(ctx, ks) != 0)
+            return 1;
+        for (i = 0; i < CHACHA_BLOCK_LEN; ++i)
+            out[i] = in[i] ^ ks[i];
+    }
+
+    if (len > 0) {
+        if (next_block(ctx, ctx->ks) != 0)
+            return 1;
+        for (n = 0; n < len; ++n)
+            out[n] = in[n] ^ ctx->ks[n];
+        ctx->ks_used = len;
+    }
+
+    memset(ks, 0, sizeof(ks));
+    return 0;
+}
@@ -0,0 +1,352 @@
+/*
+ * chacha_tester.c
+ * ---------------
+ * Checks the ChaCha driver against keystream from the Python model in
+ * core/cipher/chacha/src/model/python/chacha.py, then reports the
+ * encryption throughput for 8, 12 and 20 rounds.
+ *
+ * Copyright (c) 2016, NORDUnet A/S All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the NORDUnet nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <sys/types.h>
+
+#include "cryptech.h"
+
+char *usage =
+"Usage: %s [-h] [-k 128|256] [-n #]\n\
+\n\
+-k      key length in bits (default 256)\n\
+-n      number of bytes to process per round count (default 65536)\n\
+";
+
+static off_t chacha_base;
+
+static inline uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/* ---------------- test vectors ---------------- */
+
+/* The first two keystream blocks from the Python model, with key =
+ * 00 01 02 .. (16 or 32 bytes) and the IV below. The model feeds its
+ * output state back in rather than the block counter, so each block
+ * comes from a new ChaCha(key, iv, rounds) with state[12] set to the
+ * block number before next().
+ */
+static const uint8_t test_iv[CHACHA_IV_LEN] = {
+    0x0f, 0x1e, 0x2d, 0x3c, 0x4b, 0x5a, 0x69, 0x78
+};
+
+static const uint8_t ks_128_8[128] = {
+    0xd8, 0x8e, 0x0f, 0x53, 0x96, 0x04, 0xe8, 0x01,
+    0x3e, 0x71, 0xaa, 0x06, 0xdf, 0xb7, 0x6c, 0xb2,
+    0x8f, 0x14, 0x6d, 0x65, 0xd2, 0x0a, 0x7e, 0xc8,
+    0xc0, 0x34, 0xe1, 0xf2, 0xdf, 0x8a, 0xc0, 0xa7,
+    0xb1, 0x19, 0x02, 0x0a, 0x5b, 0x1a, 0x59, 0xb6,
+    0x44, 0x23, 0x47, 0xb6, 0x02, 0x35, 0xf2, 0x75,
+    0x09, 0xc4, 0xf8, 0xf4, 0xd7, 0xbc, 0xbe, 0x61,
+    0x25, 0xc3, 0xfc, 0xbc, 0xc0, 0x38, 0x7e, 0xea,
+    0x61, 0x90, 0x70, 0xd5, 0x14, 0x50, 0xc8, 0x29,
+    0xad, 0xe7, 0x7e, 0xff, 0x0e, 0x0a, 0xe5, 0x36,
+    0x0e, 0x70, 0x55, 0xe3, 0x17, 0xb6, 0x64, 0x89,
+    0xc6, 0x0b, 0x4e, 0xbb, 0x28, 0x78, 0xbc, 0xe4,
+    0xff, 0xbf, 0x2f, 0xa2, 0xbf, 0x81, 0x5b, 0x56,
+    0xfc, 0x4a, 0xdf, 0x82, 0x9e, 0x28, 0x0a, 0x86,
+    0xb7, 0xc3, 0x70, 0x99, 0xeb, 0x05, 0xc8, 0x47,
+    0xdf, 0xb1, 0xd9, 0x56, 0xfe, 0x26, 0xff, 0x1a
+};
+
+static const uint8_t ks_128_12[128] = {
+    0x91, 0x34, 0x8d, 0x03, 0xef, 0xce, 0xd3, 0x0b,
+    0x8a, 0xc2, 0x43, 0x81, 0xbf, 0xee, 0x50, 0x53,
+    0x0a, 0x32, 0x4c, 0xf4, 0x7c, 0x3f, 0x23, 0x74,
+    0xeb, 0x5c, 0xb8, 0xa8, 0xe7, 0xc4, 0xf2, 0xb0,
+    0xab, 0xd3, 0x64, 0x79, 0x2b, 0x32, 0x85, 0x8a,
+    0x05, 0x67, 0x82, 0x39, 0x77, 0x61, 0xd6, 0x3b,
+    0x48, 0x93, 0x6c, 0x4c, 0x08, 0xda, 0x29, 0x23,
+    0x6c, 0x07, 0x1f, 0x56, 0x04, 0xd2, 0xa3, 0x0e,
+    0x63, 0x8d, 0x31, 0x20, 0xa3, 0x13, 0x3e, 0xc5,
+    0xfd, 0xf1, 0x1c, 0x4b, 0x8b, 0x3b, 0x2d, 0x28,
+    0x4c, 0x51, 0x3f, 0x9d, 0x15, 0x73, 0xad, 0x8e,
+    0x79, 0xd7, 0x28, 0x21, 0xd8, 0x86, 0xad, 0xd9,
+    0x68, 0x54, 0xab, 0x3c, 0x8d, 0x22, 0x70, 0x92,
+    0xc7, 0x32, 0x3c, 0x8e, 0x03, 0xa0, 0x5f, 0x74,
+    0x3f, 0xa4, 0x95, 0x71, 0x09, 0x1b, 0xea, 0x4a,
+    0x8a, 0xb4, 0xbf, 0x94, 0xb6, 0x8c, 0x8f, 0x1f
+};
+
+static const uint8_t ks_128_20[128] = {
+    0xce, 0x00, 0x6c, 0x68, 0x3a, 0xff, 0xa4, 0x26,
+    0x3c, 0xf2, 0x7e, 0x4d, 0x8f, 0x69, 0xb9, 0x0e,
+    0xb6, 0xbc, 0x92, 0x5c, 0xda, 0xed, 0x8d, 0xcc,
+    0x8d, 0x21, 0xb7, 0xba, 0xce, 0xd4, 0x7b, 0x6b,
+    0x8a, 0x09, 0xf1, 0x11, 0x6e, 0x6a, 0x84, 0xb3,
+    0xd3, 0xb3, 0x59, 0xbc, 0x7e, 0xa7, 0x30, 0xdb,
+    0x4e, 0x95, 0xe3, 0x47, 0xea, 0xb1, 0xba, 0xc5,
+    0x8e, 0x08, 0x35, 0xf3, 0x2c, 0xf5, 0x1d, 0xb1,
+    0x64, 0xd4, 0x94, 0xce, 0xd4, 0x9e, 0x05, 0xb8,
+    0x0c, 0x7f, 0x22, 0x33, 0x2c, 0xb0, 0x08, 0xae,
+    0x94, 0x52, 0x16, 0x62, 0x28, 0x29, 0x01, 0xbd,
+    0xcf, 0xfd, 0xe5, 0x4f, 0xcb, 0xaf, 0x78, 0x65,
+    0x72, 0x12, 0xeb, 0xea, 0xa1, 0xde, 0xcb, 0x6c,
+    0x26, 0xbf, 0xe4, 0x3f, 0x8e, 0xc4, 0xa4, 0xed,
+    0x09, 0x61, 0x58, 0xb1, 0x67, 0x08, 0x6e, 0x3b,
+    0x2a, 0x7f, 0xed, 0xd1, 0x4d, 0x17, 0xe4, 0xa9
+};
+
+static const uint8_t ks_256_8[128] = {
+    0x71, 0xea, 0x75, 0x53, 0x83, 0x09, 0x49, 0xd1,
+    0x4f, 0x25, 0x93, 0xf6, 0x5a, 0x41, 0x64, 0xec,
+    0x22, 0xe2, 0x4a, 0xe3, 0x3f, 0x35, 0x3b, 0x47,
+    0x3c, 0xcb, 0x79, 0xfc, 0x9a, 0xe0, 0xfc, 0xbc,
+    0x0e, 0xba, 0x20, 0xd5, 0x01, 0x87, 0x9f, 0xdd,
+    0x76, 0x5a, 0xcc, 0x98, 0x79, 0x4e, 0x98, 0x97,
+    0x4a, 0xcf, 0x89, 0x4d, 0xae, 0x5a, 0xc0, 0xdf,
+    0x3f, 0xcc, 0xd6, 0x7b, 0xf8, 0x88, 0xa6, 0x66,
+    0xf4, 0xd2, 0xfc, 0x61, 0x69, 0x65, 0xe8, 0xac,
+    0xfe, 0xa2, 0x17, 0xe3, 0xb4, 0xe6, 0x89, 0xba,
+    0x61, 0xfa, 0x52, 0x4d, 0xd3, 0x4c, 0x2d, 0x1b,
+    0xc8, 0x5b, 0xfc, 0xfd, 0x5b, 0xc6, 0x41, 0x2a,
+    0x23, 0x91, 0x43, 0x6c, 0x53, 0xfc, 0x1d, 0xb9,
+    0x9c, 0xe6, 0xe8, 0x63, 0xfd, 0x45, 0x22, 0x05,
+    0x8d, 0x7b, 0x18, 0xbc, 0x54, 0x34, 0x7f, 0x4c,
+    0xd0, 0x2c, 0xd7, 0x8c, 0x2d, 0x38, 0xce, 0x27
+};
+
+static const uint8_t ks_256_12[128] = {
+    0x18, 0x65, 0xbc, 0x5b, 0x98, 0x96, 0x3f, 0xfc,
+    0x62, 0x60, 0xc8, 0x61, 0x87, 0x07, 0x3a, 0x53,
+    0x5d, 0x11, 0xb1, 0x11, 0xcc, 0x8b, 0x0b, 0x2b,
+    0xcf, 0x67, 0xfe, 0x86, 0x02, 0xd9, 0x6a, 0x09,
+    0x92, 0xe1, 0xe9, 0x78, 0x02, 0x6b, 0x23, 0xc1,
+    0xd8, 0xc5, 0x37, 0xdd, 0xc7, 0xd4, 0x01, 0x66,
+    0xdd, 0x88, 0x9c, 0x63, 0x82, 0x2f, 0x9c, 0x34,
+    0x1a, 0x52, 0xd6, 0x8f, 0x07, 0x39, 0x5e, 0x04,
+    0x22, 0x39, 0x67, 0x2f, 0x4c, 0x86, 0x38, 0xfc,
+    0xe5, 0xba, 0xdd, 0xc1, 0xaa, 0xee, 0xf1, 0x7a,
+    0x45, 0xe2, 0x53, 0x0e, 0xff, 0x06, 0x99, 0x55,
+    0x00, 0xc5, 0x44, 0x45, 0x01, 0x75, 0x6f, 0xb3,
+    0xb5, 0xb4, 0x30, 0x8e, 0xf0, 0xc3, 0x2d, 0xcf,
+    0x54, 0x2b, 0x14, 0x91, 0x6c, 0x39, 0x67, 0x22,
+    0x55, 0xe1, 0xfb, 0x7e, 0x57, 0xc4, 0x31, 0x20,
+    0xaa, 0x2a, 0x6a, 0x4e, 0x19, 0xfb, 0x28, 0x51
+};
+
+static const uint8_t ks_256_20[128] = {
+    0xa5, 0xba, 0x3e, 0x0c, 0xff, 0xc4, 0x53, 0xaf,
+    0xc9, 0x58, 0xec, 0x00, 0x5a, 0x1c, 0x58, 0xe4,
+    0xc1, 0x05, 0x0e, 0x2f, 0xc2, 0xf4, 0x06, 0x64,
+    0x31, 0xbb, 0x4d, 0x2f, 0xb6, 0x1c, 0x14, 0x66,
+    0x28, 0x06, 0x9b, 0x85, 0xa4, 0x1c, 0x0c, 0x40,
+    0xe1, 0xc2, 0xbc, 0x8f, 0x7a, 0x75, 0x10, 0xa4,
+    0x78, 0xbd, 0x92, 0xb1, 0x01, 0x72, 0x95, 0x0f,
+    0x79, 0x9a, 0xaa, 0xd4, 0xd9, 0xc7, 0x27, 0x5f,
+    0xf2, 0x77, 0xee, 0xcc, 0x7f, 0x18, 0x4c, 0xaa,
+    0xc9, 0xb4, 0xa5, 0x68, 0x39, 0x4d, 0x76, 0x7a,
+    0x67, 0xe5, 0xe1, 0x93, 0x0a, 0xc8, 0x5b, 0x5a,
+    0x1d, 0x2f, 0xf2, 0xe3, 0x6e, 0x10, 0xe5, 0xda,
+    0x54, 0x2c, 0x53, 0x54, 0x4b, 0xbd, 0x20, 0x4a,
+    0x56, 0x86, 0xeb, 0x6d, 0xa6, 0x05, 0x95, 0x08,
+    0xf0, 0xa9, 0x14, 0x8b, 0x4b, 0x9a, 0x95, 0x1d,
+    0x7b, 0x70, 0x45, 0x0f, 0xc3, 0x2b, 0x3a, 0xd8
+};
+
+static const struct {
+    size_t keylen;
+    unsigned rounds;
+    const uint8_t *ks;
+} vectors[] = {
+    { CHACHA_KEY_LEN_128,  8, ks_128_8 },
+    { CHACHA_KEY_LEN_128, 12, ks_128_12 },
+    { CHACHA_KEY_LEN_128, 20, ks_128_20 },
+    { CHACHA_KEY_LEN_256,  8, ks_256_8 },
+    { CHACHA_KEY_LEN_256, 12, ks_256_12 },
+    { CHACHA_KEY_LEN_256, 20, ks_256_20 },
+};
+
+/* Encrypt the test message in odd-sized pieces, which exercises the
+ * partial block handling, and decrypt it again in one go. The two
+ * contexts take turns, so the core has to be taken back to the right
+ * block every time.
+ */
+static int self_test(void)
+{
+    uint8_t key[CHACHA_KEY_LEN_256], msg[128], buf[2][128];
+    static const size_t pieces[] = { 1, 30, 64, 33 };
+    chacha_ctx_t ctx[2];
+    size_t i, v, off;
+    int c;
+
+    for (i = 0; i < sizeof(key); ++i)
+        key[i] = i;
+    for (i = 0; i < sizeof(msg); ++i)
+        msg[i] = 0xa5 ^ i;
+
+    for (v = 0; v < sizeof(vectors) / sizeof(vectors[0]); v += 2) {
+        for (c = 0; c < 2; ++c)
+            if (chacha_init(&ctx[c], chacha_base, key, vectors[v + c].keylen,
+                            test_iv, vectors[v + c].rounds) != 0)
+                return 1;
+
+        for (i = 0, off = 0; i < sizeof(pieces) / sizeof(pieces[0]); off += pieces[i++])
+            for (c = 0; c < 2; ++c)
+                if (chacha_crypt(&ctx[c], msg + off, buf[c] + off, pieces[i]) != 0)
+                    return 1;
+
+        for (c = 0; c < 2; ++c) {
+            for (i = 0; i < sizeof(msg); ++i)
+                if ((buf[c][i] ^ msg[i]) != vectors[v + c].ks[i]) {
+                    fprintf(stderr, "%u bit key, %u rounds: keystream does not match the model at byte %lu\n",
+                            (unsigned)vectors[v + c].keylen * 8, vectors[v + c].rounds,
+                            (unsigned long)i);
+                    return 1;
+                }
+
+            if (chacha_init(&ctx[c], chacha_base, key, vectors[v + c].keylen,
+                            test_iv, vectors[v + c].rounds) != 0 ||
+                chacha_crypt(&ctx[c], buf[c], buf[c], sizeof(msg)) != 0 ||
+                memcmp(buf[c], msg, sizeof(msg)) != 0) {
+                fprintf(stderr, "%u bit key, %u rounds: decryption failed\n",
+                        (unsigned)vectors[v + c].keylen * 8, vectors[v + c].rounds);
+                return 1;
+            }
+            chacha_clear(&ctx[c]);
+        }
+    }
+
+    return 0;
+}
+
+/* ---------------- benchmark ---------------- */
+
+/* Encrypt len bytes and return the time it took in seconds, or a
+ * negative value on error.
+ */
+static double run(unsigned rounds, const uint8_t *key, size_t keylen,
+                  const uint8_t *in, uint8_t *out, size_t len)
+{
+    chacha_ctx_t ctx;
+    uint64_t start;
+    int ret;
+
+    start = now_ns();
+
+    if (chacha_init(&ctx, chacha_base, key, keylen, test_iv, rounds) != 0)
+        return -1.0;
+    ret = chacha_crypt(&ctx, in, out, len);
+    chacha_clear(&ctx);
+
+    if (ret != 0)
+        return -1.0;
+
+    return (now_ns() - start) / 1e9;
+}
+
+int main(int argc, char *argv[])
+{
+    static const unsigned rounds[] = { 8, 12, 20 };
+    unsigned long nbytes = 65536;
+    unsigned keybits = 256;
+    uint8_t key[CHACHA_KEY_LEN_256], *in, *out;
+    double secs;
+    int opt, ret = EXIT_SUCCESS;
+    size_t i;
+
+    while ((opt = getopt(argc, argv, "h?k:n:")) != -1) {
+        switch (opt) {
+        case 'h':
+        case '?':
+            printf(usage, argv[0]);
+            return EXIT_SUCCESS;
+        case 'k':
+            keybits = strtoul(optarg, NULL, 0);
+            break;
+        case 'n':
+            nbytes = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, usage, argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if ((keybits != 128 && keybits != 256) || nbytes == 0) {
+        fprintf(stderr, usage, argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    chacha_base = tc_core_base(CHACHA_NAME0 CHACHA_NAME1);
+    if (chacha_base == 0) {
+        fprintf(stderr, "chacha core not found\n");
+        return EXIT_FAILURE;
+    }
+
+    if (self_test() != 0)
+        return EXIT_FAILURE;
+    printf("# keystream matches the model for 8, 12 and 20 rounds\n");
+
+    in = malloc(nbytes);
+    out = malloc(nbytes);
+    if (in == NULL || out == NULL) {
+        perror("malloc");
+        return EXIT_FAILURE;
+    }
+    for (i = 0; i < sizeof(key); ++i)
+        key[i] = i;
+    memset(in, 0xa5, nbytes);
+
+    printf("# ChaCha, %u bit key, %lu bytes per round count\n", keybits, nbytes);
+    printf("# rounds     MB/s  us/block\n");
+
+    for (i = 0; i < sizeof(rounds) / sizeof(rounds[0]); ++i) {
+        if ((secs = run(rounds[i], key, keybits / 8, in, out, nbytes)) < 0) {
+            fprintf(stderr, "%u rounds failed\n", rounds[i]);
+            ret = EXIT_FAILURE;
+            break;
+        }
+        printf("%6u   %8.3f  %8.2f\n", rounds[i],
+               secs > 0 ? nbytes / secs / 1e6 : 0.0,
+               secs * 1e6 / ((nbytes + CHACHA_BLOCK_LEN - 1) / CHACHA_BLOCK_LEN));
+        fflush(stdout);
+    }
+
+    free(in);
+    free(out);
+    return ret;
+}
@@ -166,6 +166,22 @@ in order to map it into a 16-bit address space.
 #define MODE_SHA_384            2 << 2
 #define MODE_SHA_512            3 << 2
 
+// Streebog (GOST R 34.11-2012) core
+#define STREEBOG_ADDR_NAME0     ADDR_NAME0
+#define STREEBOG_ADDR_NAME1     ADDR_NAME1
+#define STREEBOG_ADDR_VERSION   ADDR_VERSION
+#define STREEBOG_ADDR_CTRL      ADDR_CTRL
+#define STREEBOG_CTRL_LAST      4
+#define STREEBOG_ADDR_STATUS    ADDR_STATUS
+#define STREEBOG_ADDR_LAST_LEN  0x0a
+#define STREEBOG_ADDR_BLOCK     ADDR_BLOCK
+#define STREEBOG_ADDR_DIGEST    0x40
+#define STREEBOG_BLOCK_LEN      bitsToBytes(512)
+#define STREEBOG_256_DIGEST_LEN bitsToBytes(256)
+#define STREEBOG_512_DIGEST_LEN bitsToBytes(512)
+#define MODE_STREEBOG_512       (0 << 3)
+#define MODE_STREEBOG_256       (1 << 3)
+
 // current name and version values
 #define SHA1_NAME0              "sha1"
 #define SHA1_NAME1              "    "
@@ -179,6 +195,10 @@ in order to map it into a 16-bit address space.
 #define SHA512_NAME1            "-512"
 #define SHA512_VERSION          "0.80"
 
+#define STREEBOG_NAME0          "stre"
+#define STREEBOG_NAME1          "ebog"
+#define STREEBOG_VERSION        "0.10"
+
 
 //-----------------------------------------------------------------
 // TRNG cores
@@ -187,30 +207,30 @@ in order to map it into a 16-bit address space.
 #define TRNG_ADDR_NAME0         ADDR_NAME0
 #define TRNG_ADDR_NAME1         ADDR_NAME1
 #define TRNG_ADDR_VERSION       ADDR_VERSION
-#define TRNG_ADDR_CTRL          0x10
+#define TRNG_ADDR_CTRL          0x08
 #define TRNG_CTRL_DISCARD       1
 #define TRNG_CTRL_TEST_MODE     2
-#define TRNG_ADDR_STATUS        0x11
+#define TRNG_ADDR_STATUS        0x09
 // no status bits defined (yet)
 #define TRNG_ADDR_DELAY         0x13
 
 #define ENTROPY1_ADDR_NAME0     ADDR_NAME0
 #define ENTROPY1_ADDR_NAME1     ADDR_NAME1
 #define ENTROPY1_ADDR_VERSION   ADDR_VERSION
-#define ENTROPY1_ADDR_CTRL      0x10
+#define ENTROPY1_ADDR_CTRL      0x08
 #define ENTROPY1_CTRL_ENABLE    1
-#define ENTROPY1_ADDR_STATUS    0x11
-#define ENTROPY1_STATUS_VALID   1
+#define ENTROPY1_ADDR_STATUS    0x09
+#define ENTROPY1_STATUS_VALID   2
 #define ENTROPY1_ADDR_ENTROPY   0x20
 #define ENTROPY1_ADDR_DELTA     0x30
 
 #define ENTROPY2_ADDR_NAME0     ADDR_NAME0
 #define ENTROPY2_ADDR_NAME1     ADDR_NAME1
 #define ENTROPY2_ADDR_VERSION   ADDR_VERSION
-#define ENTROPY2_ADDR_CTRL      0x10
+#define ENTROPY2_ADDR_CTRL      0x08
 #define ENTROPY2_CTRL_ENABLE    1
-#define ENTROPY2_ADDR_STATUS    0x11
-#define ENTROPY2_STATUS_VALID   1
+#define ENTROPY2_ADDR_STATUS    0x09
+#define ENTROPY2_STATUS_VALID   2
 #define ENTROPY2_ADDR_OPA       0x18
 #define ENTROPY2_ADDR_OPB       0x19
 #define ENTROPY2_ADDR_ENTROPY   0x20
@@ -220,25 +240,33 @@ in order to map it into a 16-bit address space.
 #define MIXER_ADDR_NAME0        ADDR_NAME0
 #define MIXER_ADDR_NAME1        ADDR_NAME1
 #define MIXER_ADDR_VERSION      ADDR_VERSION
-#define MIXER_ADDR_CTRL         0x10
+#define MIXER_ADDR_CTRL         0x08
 #define MIXER_CTRL_ENABLE       1
 #define MIXER_CTRL_RESTART      2
-#define MIXER_ADDR_STATUS       0x11
+#define MIXER_ADDR_STATUS       0x09
 // no status bits defined (yet)
 #define MIXER_ADDR_TIMEOUT      0x20
 
 #define CSPRNG_ADDR_NAME0       ADDR_NAME0
 #define CSPRNG_ADDR_NAME1       ADDR_NAME1
 #define CSPRNG_ADDR_VERSION     ADDR_VERSION
-#define CSPRNG_ADDR_CTRL        0x10
+#define CSPRNG_ADDR_CTRL        0x08
 #define CSPRNG_CTRL_ENABLE      1
 #define CSPRNG_CTRL_SEED        2
-#define CSPRNG_ADDR_STATUS      0x11
-#define CSPRNG_STATUS_VALID     1
-#define CSPRNG_ADDR_RANDOM      0x20
+#define CSPRNG_ADDR_STATUS      0x09
+#define CSPRNG_STATUS_VALID     2
+#define CSPRNG_ADDR_AVAIL       0x12      // number of words available
+#define CSPRNG_ADDR_STAT_BLOCKS_LO 0x14   // blocks generated
+#define CSPRNG_ADDR_STAT_BLOCKS_HI 0x15
+#define CSPRNG_ADDR_STAT_RESEEDS   0x16   // reseeds done, wraps
+#define CSPRNG_ADDR_RANDOM      0x20      // burst read window
+#define CSPRNG_RANDOM_WINDOW    32        // 0x20..0x3f, in words
 #define CSPRNG_ADDR_NROUNDS     0x40
 #define CSPRNG_ADDR_NBLOCKS_LO  0x41
 #define CSPRNG_ADDR_NBLOCKS_HI  0x42
+#define CSPRNG_BLOCK_LEN        64        // bytes of output per block
+#define CSPRNG_MAX_ROUNDS       30        // runs rounds/2 double rounds
+#define CSPRNG_MAX_BLOCKS       0x100000000ULL
 
 // current name and version values
 #define TRNG_NAME0              "trng"
@@ -255,11 +283,11 @@ in order to map it into a 16-bit address space.
 
 #define MIXER_NAME0             "rngm"
 #define MIXER_NAME1             "ixer"
-#define MIXER_VERSION           "0.50"
+#define MIXER_VERSION           "0.51"
 
 #define CSPRNG_NAME0            "cspr"
 #define CSPRNG_NAME1            "ng  "
-#define CSPRNG_VERSION          "0.50"
+#define CSPRNG_VERSION          "0.51"
 
 
 // -----------------------------------------------------------------
@@ -271,10 +299,22 @@ in order to map it into a 16-bit address space.
 #define AES_ADDR_VERSION        ADDR_VERSION
 #define AES_ADDR_CTRL           ADDR_CTRL
 #define AES_ADDR_STATUS         ADDR_STATUS
+#define AES_CTRL_CTR            4
+#define AES_CTRL_ABORT          8
+#define AES_CTRL_ERASE          16
+#define AES_STATUS_CTR          4
 
 #define AES_ADDR_CONFIG         0x0a
 #define AES_CONFIG_ENCDEC       1
 #define AES_CONFIG_KEYLEN       2
+#define AES_CONFIG_CTRW_128     (0 << 2)
+#define AES_CONFIG_CTRW_64      (1 << 2)
+#define AES_CONFIG_CTRW_32      (2 << 2)
+
+#define AES_ADDR_CTR_BLOCKS     0x0b
+#define AES_ADDR_KS_AVAIL       0x0c
+#define AES_ADDR_KEY_SLOT       0x0d
+#define AES_ADDR_KEY_SLOTS      0x0e
 
 #define AES_ADDR_KEY0           0x10
 #define AES_ADDR_KEY1           0x11
@@ -295,10 +335,53 @@ in order to map it into a 16-bit address space.
 #define AES_ADDR_RESULT2        0x32
 #define AES_ADDR_RESULT3        0x33
 
+#define AES_ADDR_CTR0           0x40
+#define AES_ADDR_CTR1           0x41
+#define AES_ADDR_CTR2           0x42
+#define AES_ADDR_CTR3           0x43
+
+// keystream read window, each read returns the next word
+#define AES_ADDR_KS_DATA        0x60
+#define AES_KS_WINDOW           32
+
+#define AES_BLOCK_LEN           bitsToBytes(128)
+#define AES_KEY_LEN_128         bitsToBytes(128)
+#define AES_KEY_LEN_256         bitsToBytes(256)
+
 // current name and version values
 #define AES_CORE_NAME0          "aes "
 #define AES_CORE_NAME1          "    "
-#define AES_CORE_VERSION        "0.80"
+#define AES_CORE_VERSION        "0.92"
+#define AES_CORE_VERSION_CTR    "0.90"  // first version with hardware CTR
+#define AES_CORE_VERSION_SLOTS  "0.91"  // first version with key slots
+#define AES_CORE_VERSION_ERASE  "0.92"  // first version with key slot erase
+#define AES_MAX_KEY_SLOTS       16
+
+
+// Keywrap core
+#define KEYWRAP_ADDR_NAME0      ADDR_NAME0
+#define KEYWRAP_ADDR_NAME1      ADDR_NAME1
+#define KEYWRAP_ADDR_VERSION    ADDR_VERSION
+#define KEYWRAP_ADDR_CTRL       ADDR_CTRL
+#define KEYWRAP_ADDR_STATUS     ADDR_STATUS
+
+#define KEYWRAP_ADDR_CONFIG     0x0a
+#define KEYWRAP_CONFIG_WRAP     1
+#define KEYWRAP_CONFIG_KEYLEN   2
+
+#define KEYWRAP_ADDR_RLEN       0x0b
+#define KEYWRAP_ADDR_A0         0x0c
+#define KEYWRAP_ADDR_A1         0x0d
+#define KEYWRAP_ADDR_KEY0       0x10
+#define KEYWRAP_ADDR_MEM        0x400
+
+#define KEYWRAP_MAX_BLOCKS      512
+#define KEYWRAP_MAX_DATA_LEN    (8 * KEYWRAP_MAX_BLOCKS)
+
+// current name and version values
+#define KEYWRAP_CORE_NAME0      "key "
+#define KEYWRAP_CORE_NAME1      "wrap"
+#define KEYWRAP_CORE_VERSION    "0.10"
 
 
 // Chacha core
@@ -325,6 +408,9 @@ in order to map it into a 16-bit address space.
 #define CHACHA_ADDR_IV0         0x20
 #define CHACHA_ADDR_IV1         0x21
 
+#define CHACHA_ADDR_CTR0        0x30    // block counter, low word first
+#define CHACHA_ADDR_CTR1        0x31
+
 #define CHACHA_ADDR_DATA_IN0    0x40
 #define CHACHA_ADDR_DATA_IN1    0x41
 #define CHACHA_ADDR_DATA_IN2    0x42
@@ -362,7 +448,83 @@ in order to map it into a 16-bit address space.
 // current name and version values
 #define CHACHA_NAME0            "chac"
 #define CHACHA_NAME1            "ha  "
-#define CHACHA_VERSION          "0.80"
+#define CHACHA_VERSION          "0.82"
+#define CHACHA_VERSION_CTR      "0.82"  // first version with a counter register
+
+#define CHACHA_BLOCK_LEN        bitsToBytes(512)
+#define CHACHA_KEY_LEN_128      bitsToBytes(128)
+#define CHACHA_KEY_LEN_256      bitsToBytes(256)
+#define CHACHA_IV_LEN           bitsToBytes(64)
+
+
+// ChaCha20-Poly1305 AEAD core
+#define AEAD_ADDR_NAME0         ADDR_NAME0
+#define AEAD_ADDR_NAME1         ADDR_NAME1
+#define AEAD_ADDR_VERSION       ADDR_VERSION
+#define AEAD_ADDR_CTRL          ADDR_CTRL
+#define AEAD_CTRL_INIT          1
+#define AEAD_CTRL_NEXT          2
+#define AEAD_CTRL_FINISH        4
+#define AEAD_ADDR_STATUS        ADDR_STATUS
+
+#define AEAD_ADDR_CONFIG        0x0a
+#define AEAD_CONFIG_ENCRYPT     1
+#define AEAD_CONFIG_AAD         2
+
+#define AEAD_ADDR_DATA_LEN      0x0b
+#define AEAD_ADDR_KEY0          0x10
+#define AEAD_ADDR_NONCE0        0x18
+#define AEAD_ADDR_TAG0          0x20
+#define AEAD_ADDR_DATA_IN0      0x40
+#define AEAD_ADDR_DATA_OUT0     0x80
+
+// current name and version values
+#define AEAD_NAME0              "c20p"
+#define AEAD_NAME1              "1305"
+#define AEAD_VERSION            "0.10"
+
+#define AEAD_BLOCK_LEN          bitsToBytes(512)
+#define AEAD_KEY_LEN            bitsToBytes(256)
+#define AEAD_NONCE_LEN          bitsToBytes(96)
+#define AEAD_TAG_LEN            bitsToBytes(128)
+
+
+// AES-GCM core
+#define GCM_ADDR_NAME0          ADDR_NAME0
+#define GCM_ADDR_NAME1          ADDR_NAME1
+#define GCM_ADDR_VERSION        ADDR_VERSION
+#define GCM_ADDR_CTRL           ADDR_CTRL
+#define GCM_CTRL_INIT           1
+#define GCM_CTRL_NEXT           2
+#define GCM_CTRL_START          4
+#define GCM_CTRL_FINISH         8
+#define GCM_ADDR_STATUS         ADDR_STATUS
+
+#define GCM_ADDR_CONFIG         0x0a
+#define GCM_CONFIG_ENCRYPT      1
+#define GCM_CONFIG_KEYLEN       2
+#define GCM_CONFIG_AAD          4
+
+#define GCM_ADDR_NUM_BLOCKS     0x0b
+#define GCM_ADDR_CYCLES         0x0c
+#define GCM_ADDR_LAST_LEN       0x0d
+#define GCM_ADDR_KEY0           0x10
+#define GCM_ADDR_IV0            0x18
+#define GCM_ADDR_TAG0           0x20
+#define GCM_ADDR_IN_BUF         0x100
+#define GCM_ADDR_OUT_BUF        0x200
+
+#define GCM_MAX_BLOCKS          64
+
+// current name and version values
+#define GCM_NAME0               "aesg"
+#define GCM_NAME1               "cm  "
+#define GCM_VERSION             "0.10"
+
+#define GCM_BLOCK_LEN           bitsToBytes(128)
+#define GCM_IV_LEN              bitsToBytes(96)
+#define GCM_TAG_LEN             bitsToBytes(128)
+#define GCM_RUN_LEN             (GCM_MAX_BLOCKS * GCM_BLOCK_LEN)
 
 
 // -----------------------------------------------------------------
@@ -452,10 +614,222 @@ int tc_expected(off_t offset, const uint8_t *expected, size_t len);
 int tc_init(off_t offset);
 int tc_next(off_t offset);
 int tc_wait(off_t offset, uint8_t status, int *count);
+int tc_wait_status(off_t offset, uint8_t status);
 int tc_wait_ready(off_t offset);
 int tc_wait_valid(off_t offset);
 
 
+//------------------------------------------------------------------
+// Streebog driver
+//------------------------------------------------------------------
+typedef struct {
+    off_t base;
+    int mode;
+    int first;
+    size_t buflen;
+    uint8_t buf[STREEBOG_BLOCK_LEN];
+} streebog_ctx_t;
+
+int streebog_block(off_t base, const uint8_t *block, int mode, int first);
+int streebog_final_block(off_t base, uint8_t *block, size_t len, int mode, int first);
+int streebog_init(streebog_ctx_t *ctx, off_t base, int mode);
+int streebog_update(streebog_ctx_t *ctx, const uint8_t *data, size_t len);
+int streebog_final(streebog_ctx_t *ctx, uint8_t *digest);
+
+
+//------------------------------------------------------------------
+// AES driver (ECB, CBC and CTR)
+//------------------------------------------------------------------
+typedef struct {
+    off_t base;
+    int hw_ctr;                 // core runs CTR mode by itself
+    unsigned key_slots;         // key slots to use, 0 if the core has none
+    int hw_erase;               // core can erase a key slot
+    size_t keylen;
+    uint8_t key[AES_KEY_LEN_256];
+    uint8_t iv[AES_BLOCK_LEN];  // CBC chaining value or CTR counter
+    uint8_t ks[AES_BLOCK_LEN];  // CTR keystream
+    size_t ks_used;
+} aes_ctx_t;
+
+int aes_init(aes_ctx_t *ctx, off_t base, const uint8_t *key, size_t keylen);
+int aes_set_iv(aes_ctx_t *ctx, const uint8_t *iv);
+void aes_clear(aes_ctx_t *ctx);
+int aes_ecb_encrypt(aes_ctx_t *ctx, const uint8_t *in, uint8_t *out, size_t len);
+int aes_ecb_decrypt(aes_ctx_t *ctx, const uint8_t *in, uint8_t *out, size_t len);
+int aes_cbc_encrypt(aes_ctx_t *ctx, const uint8_t *in, uint8_t *out, size_t len);
+int aes_cbc_decrypt(aes_ctx_t *ctx, const uint8_t *in, uint8_t *out, size_t len);
+int aes_ctr_crypt(aes_ctx_t *ctx, const uint8_t *in, uint8_t *out, size_t len);
+
+
+//------------------------------------------------------------------
+// AES key wrap driver (RFC 3394 and RFC 5649)
+//------------------------------------------------------------------
+// W (wrap != 0) or W^-1 from RFC 3394 on the 8 byte A and n 8 byte
+// blocks in r, both updated in place; a single AES operation on A | R
+// when n is 1
+int keywrap_run(off_t base, const uint8_t *kek, size_t keklen, int wrap,
+                uint8_t *a, uint8_t *r, size_t n);
+// RFC 5649 wrap and unwrap, *outlen is set to the length of the result
+int keywrap_wrap(off_t base, const uint8_t *kek, size_t keklen,
+                 const uint8_t *in, size_t len, uint8_t *out, size_t *outlen);
+int keywrap_unwrap(off_t base, const uint8_t *kek, size_t keklen,
+                   const uint8_t *in, size_t len, uint8_t *out, size_t *outlen);
+// wipe the KEK from the core and from the driver's cache
+int keywrap_clear(off_t base);
+
+
+//------------------------------------------------------------------
+// ChaCha stream cipher driver
+//------------------------------------------------------------------
+typedef struct {
+    off_t base;
+    unsigned rounds;            // 8, 12 or 20
+    int hw_ctr;                 // core has a counter register
+    size_t keylen;
+    uint8_t key[CHACHA_KEY_LEN_256];
+    uint8_t iv[CHACHA_IV_LEN];
+    uint64_t blocks;            // keystream blocks read from the core
+    uint8_t ks[CHACHA_BLOCK_LEN];
+    size_t ks_used;
+} chacha_ctx_t;
+
+int chacha_init(chacha_ctx_t *ctx, off_t base, const uint8_t *key, size_t keylen,
+                const uint8_t *iv, unsigned rounds);
+void chacha_clear(chacha_ctx_t *ctx);
+// encryption and decryption are the same operation
+int chacha_crypt(chacha_ctx_t *ctx, const uint8_t *in, uint8_t *out, size_t len);
+
+
+//------------------------------------------------------------------
+// ChaCha20-Poly1305 AEAD driver (RFC 8439)
+//------------------------------------------------------------------
+// ct and pt may be the same buffer
+int aead_encrypt(off_t base, const uint8_t *key, const uint8_t *nonce,
+                 const uint8_t *aad, size_t aad_len,
+                 const uint8_t *pt, size_t len, uint8_t *ct, uint8_t *tag);
+// returns -1 and wipes pt if the tag does not match
+int aead_decrypt(off_t base, const uint8_t *key, const uint8_t *nonce,
+                 const uint8_t *aad, size_t aad_len,
+                 const uint8_t *ct, size_t len, const uint8_t *tag, uint8_t *pt);
+
+
+//------------------------------------------------------------------
+// AES-GCM driver (NIST SP 800-38D), 96 bit IVs only
+//------------------------------------------------------------------
+// ct and pt may be the same buffer; keylen is 16 or 32
+int gcm_encrypt(off_t base, const uint8_t *key, size_t keylen, const uint8_t *iv,
+                const uint8_t *aad, size_t aad_len,
+                const uint8_t *pt, size_t len, uint8_t *ct, uint8_t *tag);
+// returns -1 and wipes pt if the tag does not match
+int gcm_decrypt(off_t base, const uint8_t *key, size_t keylen, const uint8_t *iv,
+                const uint8_t *aad, size_t aad_len,
+                const uint8_t *ct, size_t len, const uint8_t *tag, uint8_t *pt);
+// wipe the key from the core and from the driver's cache
+int gcm_clear(off_t base);
+
+
+//------------------------------------------------------------------
+// Random bytes service (prefetched pool of csprng output)
+//------------------------------------------------------------------
+struct random_stats {
+    uint64_t calls;
+    uint64_t bytes;
+    uint64_t hits;              // served from the pool
+    uint64_t misses;            // read directly from the core
+    uint64_t refills;
+    size_t   avail;             // bytes currently in the pool
+    uint32_t p50_ns;            // latency percentiles of recent calls
+    uint32_t p99_ns;
+};
+
+int random_init(size_t pool_size, size_t low, size_t high);
+int random_get(uint8_t *buf, size_t len);
+void random_stats(struct random_stats *st);
+void random_shutdown(void);
+
+
+//------------------------------------------------------------------
+// CSPRNG reseed policy controller
+//------------------------------------------------------------------
+#define CSPRNG_POLICY_MIN_ROUNDS  8
+#define CSPRNG_POLICY_MAX_ROUNDS  24      // reset default of the core
+#define CSPRNG_POLICY_MAX_BLOCKS  0x01000000 // reset default of the core
+
+struct csprng_policy {
+    unsigned min_rounds;
+    unsigned max_rounds;
+    uint64_t min_blocks;        // blocks between reseeds
+    uint64_t max_blocks;
+};
+
+struct csprng_monitor {
+    uint64_t blocks;            // core counters at the last sample
+    uint32_t reseeds;
+    uint64_t ns;
+    unsigned rounds;            // configuration at the last sample
+    uint64_t nblocks;
+    uint64_t new_blocks;        // since the previous sample
+    uint32_t new_reseeds;
+    double   bytes_per_sec;
+    double   blocks_per_reseed;
+    int      compliant;
+};
+
+int csprng_set_policy(const struct csprng_policy *p);
+void csprng_get_policy(struct csprng_policy *p);
+int csprng_configure(unsigned rounds, uint64_t nblocks);
+int csprng_get_config(unsigned *rounds, uint64_t *nblocks);
+int csprng_reseed(void);
+int csprng_monitor(struct csprng_monitor *m);
+
+
+//------------------------------------------------------------------
+// Host ChaCha20 DRBG, seeded and reseeded from the csprng
+//------------------------------------------------------------------
+#define DRBG_DEFAULT_RESEED_BYTES (64 * 1024 * 1024)
+#define DRBG_DEFAULT_RESEED_SECS  60
+
+struct drbg_stats {
+    uint64_t bytes;
+    uint64_t reseeds;
+    uint64_t forks;             // forks detected, each forces a reseed
+};
+
+int drbg_init(uint64_t reseed_bytes, unsigned reseed_secs);
+int drbg_get(uint8_t *buf, size_t len);
+void drbg_stats(struct drbg_stats *st);
+void drbg_shutdown(void);
+
+
+//------------------------------------------------------------------
+// SP 800-90B continuous health tests for raw entropy (byte samples)
+//------------------------------------------------------------------
+#define HEALTH_ALPHA_LOG2       20        // false positive rate 2^-20
+#define HEALTH_APT_WINDOW       512       // adaptive proportion window
+#define HEALTH_ALARM_RCT        1         // repetition count test failed
+#define HEALTH_ALARM_APT        2         // adaptive proportion test failed
+
+struct health_test {
+    double   h;                 // assessed min-entropy, bits per sample
+    unsigned rct_cutoff;
+    unsigned apt_cutoff;
+    uint8_t  rct_last;
+    unsigned rct_run;
+    uint8_t  apt_ref;
+    unsigned apt_count;
+    unsigned apt_pos;
+    uint64_t samples;
+    unsigned rct_failures;
+    unsigned apt_failures;
+    int      alarm;             // HEALTH_ALARM_* bits, sticky
+};
+
+int health_init(struct health_test *ht, double h);
+int health_check(struct health_test *ht, const uint8_t *buf, size_t len);
+int health_check_bytes(struct health_test *ht, const uint8_t *buf, size_t len);
+
+
 //------------------------------------------------------------------
 // I2C configuration
 // Only used in I2C, but not harmful to define for EIM
@@ -0,0 +1,266 @@
+/*
+ * csprng.c
+ * --------
+ * Reseed policy controller for the trng_csprng core: sets the number
+ * of ChaCha rounds and the number of blocks generated between reseeds
+ * within policy bounds, and monitors the core's block and reseed
+ * counters to report the achieved output rate.
+ *
+ * Copyright (c) 2016, NORDUnet A/S All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the NORDUnet nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <sys/types.h>
+
+#include "cryptech.h"
+
+static off_t csprng_base;
+
+static struct csprng_policy policy = {
+    .min_rounds = CSPRNG_POLICY_MIN_ROUNDS,
+    .max_rounds = CSPRNG_POLICY_MAX_ROUNDS,
+    .min_blocks = 1,
+    .max_blocks = CSPRNG_POLICY_MAX_BLOCKS,
+};
+
+/* ---------------- register access ---------------- */
+
+static int find_core(void)
+{
+    struct core_info *core;
+
+    if (csprng_base != 0)
+        return 0;
+
+    core = tc_core_first(CSPRNG_NAME0 CSPRNG_NAME1);
+    if (core == NULL) {
+        fprintf(stderr, "csprng core not found\n");
+        return -1;
+    }
+    csprng_base = core->base;
+    return 0;
+}
+
+static int write32(off_t addr, uint32_t val)
+{
+    uint8_t w[4];
+
+    w[0] = val >> 24;
+    w[1] = val >> 16;
+    w[2] = val >> 8;
+    w[3] = val;
+    return tc_write(csprng_base + addr, w, 4);
+}
+
+static int read32(off_t addr, uint32_t *val)
+{
+    uint8_t w[4];
+
+    if (tc_read(csprng_base + addr, w, 4) != 0)
+        return -1;
+    *val = ((uint32_t)w[0] << 24) | (w[1] << 16) | (w[2] << 8) | w[3];
+    return 0;
+}
+
+/* Read a 64-bit counter split over two registers, rereading the high
+ * word to catch a carry between the two reads.
+ */
+static int read64(off_t lo_addr, off_t hi_addr, uint64_t *val)
+{
+    uint32_t hi, lo, hi2;
+
+    do {
+        if (read32(hi_addr, &hi) || read32(lo_addr, &lo) || read32(hi_addr, &hi2))
+            return -1;
+    } while (hi != hi2);
+
+    *val = ((uint64_t)hi << 32) | lo;
+    return 0;
+}
+
+static inline uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/* ---------------- policy and configuration ---------------- */
+
+/* Set the bounds that csprng_configure() enforces. NULL restores the
+ * defaults.
+ */
+int csprng_set_policy(const struct csprng_policy *p)
+{
+    if (p == NULL) {
+        policy.min_rounds = CSPRNG_POLICY_MIN_ROUNDS;
+        policy.max_rounds = CSPRNG_POLICY_MAX_ROUNDS;
+        policy.min_blocks = 1;
+        policy.max_blocks = CSPRNG_POLICY_MAX_BLOCKS;
+        return 0;
+    }
+
+    if (p->min_rounds > p->max_rounds || p->max_rounds > CSPRNG_MAX_ROUNDS ||
+        p->min_blocks == 0 || p->min_blocks > p->max_blocks ||
+        p->max_blocks > CSPRNG_MAX_BLOCKS) {
+        fprintf(stderr, "csprng: invalid policy\n");
+        return -1;
+    }
+
+    policy = *p;
+    return 0;
+}
+
+void csprng_get_policy(struct csprng_policy *p)
+{
+    *p = policy;
+}
+
+/* Configure the number of rounds and the number of blocks between
+ * reseeds. Settings outside the policy are refused rather than clamped,
+ * so that a caller never runs with something it didn't ask for. The
+ * new block count takes effect at the next reseed.
+ */
+int csprng_configure(unsigned rounds, uint64_t nblocks)
+{
+    unsigned r;
+    uint64_t n;
+
+    if (rounds < policy.min_rounds || rounds > policy.max_rounds || (rounds & 1)) {
+        fprintf(stderr, "csprng: %u rounds is outside the policy (%u..%u, even)\n",
+                rounds, policy.min_rounds, policy.max_rounds);
+        return -1;
+    }
+    if (nblocks < policy.min_blocks || nblocks > policy.max_blocks) {
+        fprintf(stderr, "csprng: %llu blocks per reseed is outside the policy (%llu..%llu)\n",
+                (unsigned long long)nblocks,
+                (unsigned long long)policy.min_blocks,
+                (unsigned long long)policy.max_blocks);
+        return -1;
+    }
+
+    if (find_core() != 0 ||
+        write32(CSPRNG_ADDR_NROUNDS, rounds) ||
+        write32(CSPRNG_ADDR_NBLOCKS_LO, (uint32_t)nblocks) ||
+        write32(CSPRNG_ADDR_NBLOCKS_HI, (uint32_t)(nblocks >> 32)))
+        return -1;
+
+    /* make sure the core took it */
+    if (csprng_get_config(&r, &n) != 0)
+        return -1;
+    if (r != rounds || n != nblocks) {
+        fprintf(stderr, "csprng: configuration readback mismatch\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+int csprng_get_config(unsigned *rounds, uint64_t *nblocks)
+{
+    uint32_t r;
+
+    if (find_core() != 0 ||
+        read32(CSPRNG_ADDR_NROUNDS, &r) ||
+        read64(CSPRNG_ADDR_NBLOCKS_LO, CSPRNG_ADDR_NBLOCKS_HI, nblocks))
+        return -1;
+
+    *rounds = r;
+    return 0;
+}
+
+/* Force a reseed, e.g. so that a new block count applies at once. */
+int csprng_reseed(void)
+{
+    if (find_core() != 0)
+        return -1;
+
+    return write32(CSPRNG_ADDR_CTRL, CSPRNG_CTRL_ENABLE | CSPRNG_CTRL_SEED) ||
+        write32(CSPRNG_ADDR_CTRL, CSPRNG_CTRL_ENABLE);
+}
+
+/* ---------------- monitoring ---------------- */
+
+/* Sample the block and reseed counters. m holds the previous sample;
+ * zero it before the first call. The rates cover the time since the
+ * previous sample. Since the core stops generating when its output
+ * FIFO is full, the block rate is also the rate at which random data
+ * is being consumed.
+ */
+int csprng_monitor(struct csprng_monitor *m)
+{
+    uint64_t blocks, ns, nblocks;
+    uint32_t reseeds;
+    unsigned rounds;
+    double dt;
+
+    if (find_core() != 0 ||
+        read64(CSPRNG_ADDR_STAT_BLOCKS_LO, CSPRNG_ADDR_STAT_BLOCKS_HI, &blocks) ||
+        read32(CSPRNG_ADDR_STAT_RESEEDS, &reseeds) ||
+        csprng_get_config(&rounds, &nblocks))
+        return -1;
+    ns = now_ns();
+
+    m->new_blocks = 0;
+    m->new_reseeds = 0;
+    m->bytes_per_sec = 0.0;
+    m->blocks_per_reseed = 0.0;
+    m->compliant = 1;
+
+    if (m->ns != 0) {
+        dt = (ns - m->ns) / 1e9;
+        m->new_blocks = blocks - m->blocks;
+        m->new_reseeds = reseeds - m->reseeds;  /* the core's counter wraps */
+        if (dt > 0)
+            m->bytes_per_sec = m->new_blocks * CSPRNG_BLOCK_LEN / dt;
+        if (m->new_reseeds > 0)
+            m->blocks_per_reseed = (double)m->new_blocks / m->new_reseeds;
+
+        /* More blocks than the configured interval without a single
+         * reseed means the core is not keeping to its configuration.
+         */
+        if (m->new_blocks > nblocks && m->new_reseeds == 0)
+            m->compliant = 0;
+        if (rounds < policy.min_rounds || rounds > policy.max_rounds ||
+            nblocks < policy.min_blocks || nblocks > policy.max_blocks)
+            m->compliant = 0;
+    }
+
+    m->blocks = blocks;
+    m->reseeds = reseeds;
+    m->ns = ns;
+    m->rounds = rounds;
+    m->nblocks = nblocks;
+    return 0;
+}
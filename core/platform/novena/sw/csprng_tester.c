@@ -0,0 +1,275 @@
+/*
+ * csprng_tester.c
+ * ---------------
+ * Show the csprng reseed configuration, and sweep the reseed interval
+ * and round count to chart output rate against them.
+ *
+ * Copyright (c) 2016, NORDUnet A/S All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the NORDUnet nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <sys/types.h>
+#include <arpa/inet.h>
+
+#include "cryptech.h"
+
+char *usage =
+"Usage: %s [-h] [-s] [-n #] [-r #] [-m #] [-M #]\n\
+\n\
+-s      sweep rounds and blocks per reseed, and report the output rate\n\
+-n      number of words to read per measurement (default 262144)\n\
+-r      only sweep this number of rounds\n\
+-m      smallest number of blocks per reseed to sweep (default 1)\n\
+-M      largest number of blocks per reseed to sweep (default policy max)\n\
+";
+
+static off_t csprng_base;
+static int csprng_burst;
+
+static inline uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/* Read nwords words of csprng output and throw them away, using the
+ * burst read window when the core has one.
+ */
+static int drain(unsigned long nwords)
+{
+    uint32_t buf[CSPRNG_RANDOM_WINDOW], avail;
+
+    while (nwords > 0) {
+        if (csprng_burst) {
+            if (tc_read(csprng_base + CSPRNG_ADDR_AVAIL, (uint8_t *)&avail, 4) != 0)
+                return -1;
+            avail = ntohl(avail);
+            if (avail == 0)
+                continue;
+        }
+        else {
+            if (tc_wait(csprng_base + CSPRNG_ADDR_STATUS, CSPRNG_STATUS_VALID, NULL) != 0)
+                return -1;
+            avail = 1;
+        }
+        if (avail > CSPRNG_RANDOM_WINDOW)
+            avail = CSPRNG_RANDOM_WINDOW;
+        if (avail > nwords)
+            avail = nwords;
+        if (tc_read(csprng_base + CSPRNG_ADDR_RANDOM, (uint8_t *)buf, avail * 4) != 0)
+            return -1;
+        nwords -= avail;
+    }
+
+    return 0;
+}
+
+/* Read nwords under the current configuration. Returns the host side
+ * rate in bytes/sec, and the core's view of it in m.
+ */
+static double measure(unsigned long nwords, struct csprng_monitor *m)
+{
+    uint64_t start;
+    double secs;
+
+    memset(m, 0, sizeof(*m));
+    if (csprng_monitor(m) != 0)
+        return -1.0;
+
+    start = now_ns();
+    if (drain(nwords) != 0)
+        return -1.0;
+    secs = (now_ns() - start) / 1e9;
+
+    if (csprng_monitor(m) != 0)
+        return -1.0;
+
+    return (secs > 0) ? nwords * 4 / secs : 0.0;
+}
+
+static int show(unsigned long nwords)
+{
+    struct csprng_policy p;
+    struct csprng_monitor m;
+    unsigned rounds;
+    uint64_t nblocks;
+    double rate;
+
+    csprng_get_policy(&p);
+    if (csprng_get_config(&rounds, &nblocks) != 0)
+        return 1;
+
+    printf("rounds %u, %llu blocks per reseed\n",
+           rounds, (unsigned long long)nblocks);
+    printf("policy: rounds %u..%u, %llu..%llu blocks per reseed\n",
+           p.min_rounds, p.max_rounds,
+           (unsigned long long)p.min_blocks, (unsigned long long)p.max_blocks);
+
+    if ((rate = measure(nwords, &m)) < 0)
+        return 1;
+    printf("core: %llu blocks generated, %u reseeds\n",
+           (unsigned long long)m.blocks, m.reseeds);
+    printf("%lu words read at %.3f MB/s (core %.3f MB/s), %s\n",
+           nwords, rate / 1e6, m.bytes_per_sec / 1e6,
+           m.compliant ? "compliant" : "NOT compliant");
+    return 0;
+}
+
+static int sweep(unsigned long nwords, unsigned only_rounds,
+                 uint64_t min_blocks, uint64_t max_blocks)
+{
+    static const unsigned round_list[] = { 8, 12, 20, 24 };
+    struct csprng_monitor m;
+    unsigned rounds, saved_rounds, best_rounds = 0, i;
+    uint64_t nblocks, saved_nblocks, best_nblocks = 0;
+    double rate, best_rate = 0.0;
+    int ret = 0;
+
+    if (csprng_get_config(&saved_rounds, &saved_nblocks) != 0)
+        return 1;
+
+    printf("# rounds  blocks/reseed      MB/s  core MB/s  reseeds  compliant\n");
+
+    for (i = 0; i < sizeof(round_list)/sizeof(round_list[0]); ++i) {
+        rounds = only_rounds ? only_rounds : round_list[i];
+
+        for (nblocks = min_blocks; nblocks <= max_blocks; nblocks *= 4) {
+            if (csprng_configure(rounds, nblocks) != 0 ||
+                csprng_reseed() != 0) {
+                ret = 1;
+                goto out;
+            }
+            if ((rate = measure(nwords, &m)) < 0) {
+                ret = 1;
+                goto out;
+            }
+
+            printf("%8u  %13llu  %8.3f  %9.3f  %7u  %s\n",
+                   rounds, (unsigned long long)nblocks, rate / 1e6,
+                   m.bytes_per_sec / 1e6, m.new_reseeds, m.compliant ? "yes" : "no");
+            fflush(stdout);
+
+            if (m.compliant && rate > best_rate) {
+                best_rate = rate;
+                best_rounds = rounds;
+                best_nblocks = nblocks;
+            }
+        }
+
+        if (only_rounds)
+            break;
+    }
+
+    if (best_rate > 0)
+        printf("# fastest compliant: %u rounds, %llu blocks per reseed, %.3f MB/s\n",
+               best_rounds, (unsigned long long)best_nblocks, best_rate / 1e6);
+
+out:
+    /* put back what we found */
+    if (csprng_configure(saved_rounds, saved_nblocks) != 0 || csprng_reseed() != 0) {
+        fprintf(stderr, "could not restore rounds %u, %llu blocks per reseed\n",
+                saved_rounds, (unsigned long long)saved_nblocks);
+        ret = 1;
+    }
+    return ret;
+}
+
+int main(int argc, char *argv[])
+{
+    struct csprng_policy p;
+    struct core_info *core;
+    unsigned long nwords = 262144;
+    unsigned rounds = 0;
+    uint64_t min_blocks = 0, max_blocks = 0;
+    int opt, do_sweep = 0;
+
+    while ((opt = getopt(argc, argv, "h?sn:r:m:M:")) != -1) {
+        switch (opt) {
+        case 'h':
+        case '?':
+            printf(usage, argv[0]);
+            return EXIT_SUCCESS;
+        case 's':
+            do_sweep = 1;
+            break;
+        case 'n':
+            nwords = strtoul(optarg, NULL, 0);
+            break;
+        case 'r':
+            rounds = strtoul(optarg, NULL, 0);
+            break;
+        case 'm':
+            min_blocks = strtoull(optarg, NULL, 0);
+            break;
+        case 'M':
+            max_blocks = strtoull(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, usage, argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    core = tc_core_first(CSPRNG_NAME0 CSPRNG_NAME1);
+    if (core == NULL) {
+        fprintf(stderr, "csprng core not found\n");
+        return EXIT_FAILURE;
+    }
+    csprng_base = core->base;
+    csprng_burst = (strncmp(core->version, CSPRNG_VERSION, 4) >= 0);
+
+    csprng_get_policy(&p);
+    if (min_blocks == 0)
+        min_blocks = p.min_blocks;
+    if (max_blocks == 0)
+        max_blocks = p.max_blocks;
+    if (nwords == 0 || min_blocks > max_blocks) {
+        fprintf(stderr, usage, argv[0]);
+        return EXIT_FAILURE;
+    }
+    if ((rounds != 0 && (rounds < p.min_rounds || rounds > p.max_rounds)) ||
+        min_blocks < p.min_blocks || max_blocks > p.max_blocks) {
+        fprintf(stderr, "sweep range is outside the policy (rounds %u..%u, %llu..%llu blocks per reseed)\n",
+                p.min_rounds, p.max_rounds,
+                (unsigned long long)p.min_blocks, (unsigned long long)p.max_blocks);
+        return EXIT_FAILURE;
+    }
+
+    if (do_sweep)
+        return sweep(nwords, rounds, min_blocks, max_blocks) ? EXIT_FAILURE : EXIT_SUCCESS;
+
+    return show(nwords) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,407 @@
+/*
+ * drbg.c
+ * ------
+ * Host-side ChaCha20 DRBG for bulk random data, seeded and periodically
+ * reseeded from the FPGA csprng.
+ *
+ * Security boundary: the generator runs in ordinary process memory on
+ * the host, so its output is only as strong as the csprng seed and the
+ * secrecy of this process. It is meant for bulk consumers (padding,
+ * wiping, test data) that can't afford a bus round trip per word, not
+ * for long-term keys, which should come from the csprng directly.
+ *
+ * The key is replaced with fresh keystream after every request ("fast
+ * key erasure"), so a later compromise of the state does not reveal
+ * earlier output. The generator reseeds from the csprng after a byte
+ * or time budget, and after a fork the child never continues the
+ * parent's stream.
+ *
+ * The block function computes four blocks at once with GCC vector
+ * types, which map onto NEON on the Novena (the Makefile builds this
+ * file with -mfpu=neon on ARM) and SSE on a PC.
+ *
+ * Copyright (c) 2016, NORDUnet A/S All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the NORDUnet nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/types.h>
+
+#include "cryptech.h"
+
+#define DRBG_GROUP      256             /* four 64-byte blocks */
+#define DRBG_BUF_SIZE   (16 * DRBG_GROUP)
+#define DRBG_SEED_LEN   40              /* key and nonce */
+
+/* without NEON, GCC lowers the vector type to scalar code */
+#if defined(__arm__) && !defined(__ARM_NEON)
+#warning "drbg.c built without NEON, the block function will be slow"
+#endif
+
+typedef uint32_t v4u __attribute__ ((vector_size (16)));
+
+static struct {
+    pthread_mutex_t lock;       /* protects everything below */
+    int seeded;
+    pid_t pid;
+    uint32_t input[16];         /* constants, key, 64-bit counter, nonce */
+    uint8_t buf[DRBG_BUF_SIZE]; /* future output, consumed from the end */
+    size_t avail;
+
+    /* reseed policy */
+    uint64_t reseed_bytes, since_reseed;
+    uint64_t reseed_ns, reseed_time;
+
+    /* statistics */
+    uint64_t bytes, reseeds, forks;
+} drbg = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+};
+
+/* ---------------- block function ---------------- */
+
+#define ROTL(v, n)      (((v) << (n)) | ((v) >> (32 - (n))))
+
+#define QR(a, b, c, d)                                  \
+    do {                                                \
+        a += b; d ^= a; d = ROTL(d, 16);                \
+        c += d; b ^= c; b = ROTL(b, 12);                \
+        a += b; d ^= a; d = ROTL(d, 8);                 \
+        c += d; b ^= c; b = ROTL(b, 7);                 \
+    } while (0)
+
+static inline void store32_le(uint8_t *p, uint32_t v)
+{
+    p[0] = v;
+    p[1] = v >> 8;
+    p[2] = v >> 16;
+    p[3] = v >> 24;
+}
+
+static inline uint32_t load32_le(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/* Generate ngroups groups of four consecutive keystream blocks into
+ * out, advancing the block counter. Each vector lane holds one block.
+ */
+static void chacha20_generate(uint32_t *input, uint8_t *out, size_t ngroups)
+{
+    v4u x[16], orig[16];
+    uint64_t ctr;
+    int i, j;
+
+    while (ngroups-- > 0) {
+        for (i = 0; i < 16; ++i)
+            for (j = 0; j < 4; ++j)
+                orig[i][j] = input[i];
+        ctr = input[12] | ((uint64_t)input[13] << 32);
+        for (j = 0; j < 4; ++j) {
+            orig[12][j] = (uint32_t)(ctr + j);
+            orig[13][j] = (uint32_t)((ctr + j) >> 32);
+        }
+        memcpy(x, orig, sizeof(x));
+
+        for (i = 0; i < 10; ++i) {
+            QR(x[0], x[4], x[8],  x[12]);
+            QR(x[1], x[5], x[9],  x[13]);
+            QR(x[2], x[6], x[10], x[14]);
+            QR(x[3], x[7], x[11], x[15]);
+            QR(x[0], x[5], x[10], x[15]);
+            QR(x[1], x[6], x[11], x[12]);
+            QR(x[2], x[7], x[8],  x[13]);
+            QR(x[3], x[4], x[9],  x[14]);
+        }
+
+        for (i = 0; i < 16; ++i)
+            x[i] += orig[i];
+        for (j = 0; j < 4; ++j)
+            for (i = 0; i < 16; ++i)
+                store32_le(out + 64 * j + 4 * i, x[i][j]);
+
+        ctr += 4;
+        input[12] = (uint32_t)ctr;
+        input[13] = (uint32_t)(ctr >> 32);
+        out += DRBG_GROUP;
+    }
+
+    memset(x, 0, sizeof(x));
+    memset(orig, 0, sizeof(orig));
+}
+
+/* Known answer test from RFC 8439 section 2.3.2. That vector uses a
+ * 32-bit counter and a 96-bit nonce; its first nonce word lands in the
+ * high half of our 64-bit counter.
+ */
+static int chacha20_selftest(void)
+{
+    static const uint8_t expected[64] = {
+        0x10, 0xf1, 0xe7, 0xe4, 0xd1, 0x3b, 0x59, 0x15,
+        0x50, 0x0f, 0xdd, 0x1f, 0xa3, 0x20, 0x71, 0xc4,
+        0xc7, 0xd1, 0xf4, 0xc7, 0x33, 0xc0, 0x68, 0x03,
+        0x04, 0x22, 0xaa, 0x9a, 0xc3, 0xd4, 0x6c, 0x4e,
+        0xd2, 0x82, 0x64, 0x46, 0x07, 0x9f, 0xaa, 0x09,
+        0x14, 0xc2, 0xd7, 0x05, 0xd9, 0x8b, 0x02, 0xa2,
+        0xb5, 0x12, 0x9c, 0xd1, 0xde, 0x16, 0x4e, 0xb9,
+        0xcb, 0xd0, 0x83, 0xe8, 0xa2, 0x50, 0x3c, 0x4e,
+    };
+    uint32_t input[16] = {
+        0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+        0x03020100, 0x07060504, 0x0b0a0908, 0x0f0e0d0c,
+        0x13121110, 0x17161514, 0x1b1a1918, 0x1f1e1d1c,
+        0x00000001, 0x09000000, 0x4a000000, 0x00000000,
+    };
+    uint8_t out[DRBG_GROUP];
+
+    chacha20_generate(input, out, 1);
+    return memcmp(out, expected, sizeof(expected)) != 0;
+}
+
+/* ---------------- state handling ---------------- */
+
+static inline uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void wipe(void)
+{
+    memset(drbg.input, 0, sizeof(drbg.input));
+    memset(drbg.buf, 0, sizeof(drbg.buf));
+    drbg.avail = 0;
+    drbg.seeded = 0;
+}
+
+/* Replace the key with fresh keystream and restart the counter. */
+static void rekey(void)
+{
+    uint8_t tmp[DRBG_GROUP];
+    int i;
+
+    chacha20_generate(drbg.input, tmp, 1);
+    for (i = 0; i < 8; ++i)
+        drbg.input[4 + i] = load32_le(tmp + 4 * i);
+    drbg.input[12] = drbg.input[13] = 0;
+    memset(tmp, 0, sizeof(tmp));
+}
+
+/* Refill the output buffer. The first 32 bytes become the next key. */
+static void refill(void)
+{
+    int i;
+
+    chacha20_generate(drbg.input, drbg.buf, DRBG_BUF_SIZE / DRBG_GROUP);
+    for (i = 0; i < 8; ++i)
+        drbg.input[4 + i] = load32_le(drbg.buf + 4 * i);
+    drbg.input[12] = drbg.input[13] = 0;
+    memset(drbg.buf, 0, 32);
+    drbg.avail = DRBG_BUF_SIZE - 32;
+}
+
+/* Mix fresh csprng output into the key and nonce. Buffered output from
+ * before the reseed is thrown away.
+ */
+static int reseed(void)
+{
+    uint8_t seed[DRBG_SEED_LEN];
+    int i;
+
+    if (random_get(seed, sizeof(seed)) != 0) {
+        fprintf(stderr, "drbg: can't read seed from the csprng\n");
+        return -1;
+    }
+
+    if (!drbg.seeded) {
+        drbg.input[0] = 0x61707865;
+        drbg.input[1] = 0x3320646e;
+        drbg.input[2] = 0x79622d32;
+        drbg.input[3] = 0x6b206574;
+    }
+    for (i = 0; i < 8; ++i)
+        drbg.input[4 + i] ^= load32_le(seed + 4 * i);
+    drbg.input[14] ^= load32_le(seed + 32);
+    drbg.input[15] ^= load32_le(seed + 36);
+    drbg.input[12] = drbg.input[13] = 0;
+    memset(seed, 0, sizeof(seed));
+
+    memset(drbg.buf, 0, sizeof(drbg.buf));
+    drbg.avail = 0;
+    rekey();
+
+    drbg.seeded = 1;
+    drbg.pid = getpid();
+    drbg.since_reseed = 0;
+    drbg.reseed_time = now_ns();
+    ++drbg.reseeds;
+    return 0;
+}
+
+/* ---------------- fork handling ---------------- */
+
+static void atfork_prepare(void)
+{
+    pthread_mutex_lock(&drbg.lock);
+}
+
+static void atfork_parent(void)
+{
+    pthread_mutex_unlock(&drbg.lock);
+}
+
+/* The child must never continue the parent's stream. */
+static void atfork_child(void)
+{
+    wipe();
+    ++drbg.forks;
+    pthread_mutex_init(&drbg.lock, NULL);
+}
+
+/* ---------------- public interface ---------------- */
+
+/* Set the reseed policy: reseed after reseed_bytes of output or
+ * reseed_secs seconds, whichever comes first. Zero selects the default.
+ * Seeding itself is deferred to the first drbg_get().
+ */
+int drbg_init(uint64_t reseed_bytes, unsigned reseed_secs)
+{
+    static int atfork_installed = 0;
+    int ret = -1;
+
+    if (chacha20_selftest() != 0) {
+        fprintf(stderr, "drbg: ChaCha20 self-test failed\n");
+        return -1;
+    }
+
+    /* the random service registers its fork handlers first, so that
+     * our lock is taken outside its locks, same as in drbg_get() */
+    if (random_init(0, 0, 0) != 0)
+        return -1;
+
+    pthread_mutex_lock(&drbg.lock);
+
+    if (!atfork_installed) {
+        if (pthread_atfork(atfork_prepare, atfork_parent, atfork_child) != 0)
+            goto out;
+        atfork_installed = 1;
+    }
+
+    drbg.reseed_bytes = reseed_bytes ? reseed_bytes : DRBG_DEFAULT_RESEED_BYTES;
+    drbg.reseed_ns = (uint64_t)(reseed_secs ? reseed_secs : DRBG_DEFAULT_RESEED_SECS) * 1000000000;
+    ret = 0;
+out:
+    pthread_mutex_unlock(&drbg.lock);
+    return ret;
+}
+
+/* Fill buf with len bytes of DRBG output. */
+int drbg_get(uint8_t *buf, size_t len)
+{
+    size_t n, off;
+    int bulk = 0, ret = 0;
+
+    if (drbg.reseed_bytes == 0 && drbg_init(0, 0) != 0)
+        return -1;
+
+    pthread_mutex_lock(&drbg.lock);
+
+    /* a fork done with a raw syscall skips the atfork handlers */
+    if (drbg.seeded && drbg.pid != getpid()) {
+        wipe();
+        ++drbg.forks;
+    }
+
+    if (!drbg.seeded ||
+        drbg.since_reseed >= drbg.reseed_bytes ||
+        now_ns() - drbg.reseed_time >= drbg.reseed_ns) {
+        if (reseed() != 0) {
+            ret = -1;
+            goto out;
+        }
+    }
+
+    drbg.since_reseed += len;
+    drbg.bytes += len;
+
+    while (len > 0) {
+        /* large requests are generated straight into the caller's buffer */
+        if (drbg.avail == 0 && len >= DRBG_GROUP) {
+            n = len / DRBG_GROUP;
+            chacha20_generate(drbg.input, buf, n);
+            buf += n * DRBG_GROUP;
+            len -= n * DRBG_GROUP;
+            bulk = 1;
+            continue;
+        }
+
+        if (drbg.avail == 0)
+            refill();
+
+        n = (len < drbg.avail) ? len : drbg.avail;
+        off = DRBG_BUF_SIZE - drbg.avail;
+        memcpy(buf, drbg.buf + off, n);
+        memset(drbg.buf + off, 0, n);
+        drbg.avail -= n;
+        buf += n;
+        len -= n;
+    }
+
+    /* forget the key that produced this output */
+    if (bulk)
+        rekey();
+
+out:
+    pthread_mutex_unlock(&drbg.lock);
+    return ret;
+}
+
+void drbg_stats(struct drbg_stats *st)
+{
+    pthread_mutex_lock(&drbg.lock);
+    st->bytes = drbg.bytes;
+    st->reseeds = drbg.reseeds;
+    st->forks = drbg.forks;
+    pthread_mutex_unlock(&drbg.lock);
+}
+
+/* Wipe the generator state. The next drbg_get() reseeds. */
+void drbg_shutdown(void)
+{
+    pthread_mutex_lock(&drbg.lock);
+    wipe();
+    pthread_mutex_unlock(&drbg.lock);
+}
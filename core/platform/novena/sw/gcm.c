@@ -0,0 +1,266 @@
+/*
+ * gcm.c
+ * -----
+ * AES-GCM (NIST SP 800-38D) on top of the aes_gcm core, which runs
+ * the counter mode encryption and GHASH in one pass.
+ *
+ * The core takes the AAD and the data in runs of up to 64 blocks, and
+ * only the last block of each may be short, so a message costs one
+ * write and one read of each run plus a start and a finish. The key
+ * is only loaded, and H computed, when it changes, and the
+ * configuration and length registers are only written when they
+ * change. gcm_clear() wipes the key from the core and from the
+ * driver. Only 96 bit IVs are supported.
+ *
+ * Copyright (c) 2016, NORDUnet A/S All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the NORDUnet nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/types.h>
+
+#include "cryptech.h"
+
+/* SP 800-38D limit: the counter is 32 bits and starts at 2 */
+#define GCM_MAX_DATA_LEN        ((((uint64_t)1 << 32) - 2) * GCM_BLOCK_LEN)
+
+/* the key currently expanded in the core */
+static struct {
+    off_t base;
+    size_t keylen;              /* 0 if unknown */
+    uint8_t key[32];
+} core;
+
+/* ---------------- core access ---------------- */
+
+static int write32(off_t addr, uint32_t val)
+{
+    uint8_t w[4];
+
+    w[0] = val >> 24;
+    w[1] = val >> 16;
+    w[2] = val >> 8;
+    w[3] = val;
+    return tc_write(addr, w, 4);
+}
+
+/* the configuration and length registers, as last written */
+struct regs {
+    uint32_t config;
+    uint32_t num_blocks;
+    uint32_t last_len;
+};
+
+static int set_reg(off_t addr, uint32_t val, uint32_t *cur)
+{
+    if (*cur == val)
+        return 0;
+    *cur = ~0;
+    if (write32(addr, val) != 0)
+        return 1;
+    *cur = val;
+    return 0;
+}
+
+static int load_key(off_t base, struct regs *regs, const uint8_t *key, size_t keylen)
+{
+    uint32_t config = (keylen == 32) ? GCM_CONFIG_KEYLEN : 0;
+
+    if (core.base == base && core.keylen == keylen &&
+        memcmp(core.key, key, keylen) == 0)
+        return 0;
+
+    memset(&core, 0, sizeof(core));
+
+    if (tc_write(base + GCM_ADDR_KEY0, key, keylen) != 0 ||
+        set_reg(base + GCM_ADDR_CONFIG, config, &regs->config) != 0 ||
+        tc_init(base + GCM_ADDR_CTRL) != 0 ||
+        tc_wait_ready(base + GCM_ADDR_STATUS) != 0)
+        return 1;
+
+    core.base = base;
+    core.keylen = keylen;
+    memcpy(core.key, key, keylen);
+    return 0;
+}
+
+/* Run 1..GCM_RUN_LEN bytes through the core. out is NULL for AAD. Only
+ * the words holding the bytes used are moved; the core ignores the
+ * rest of a short last block.
+ */
+static int run_blocks(off_t base, struct regs *regs, uint32_t config,
+                      const uint8_t *in, size_t len, uint8_t *out)
+{
+    uint8_t buf[GCM_RUN_LEN];
+    size_t wlen = (len + 3) & ~3;
+    uint32_t num_blocks = (len + GCM_BLOCK_LEN - 1) / GCM_BLOCK_LEN;
+    int ret = 1;
+
+    memcpy(buf, in, len);
+    memset(buf + len, 0, wlen - len);
+
+    if (tc_write(base + GCM_ADDR_IN_BUF, buf, wlen) != 0 ||
+        set_reg(base + GCM_ADDR_CONFIG, config, &regs->config) != 0 ||
+        set_reg(base + GCM_ADDR_NUM_BLOCKS, num_blocks, &regs->num_blocks) != 0 ||
+        set_reg(base + GCM_ADDR_LAST_LEN, len - GCM_BLOCK_LEN * (num_blocks - 1),
+                &regs->last_len) != 0 ||
+        tc_next(base + GCM_ADDR_CTRL) != 0 ||
+        tc_wait_valid(base + GCM_ADDR_STATUS) != 0)
+        goto out;
+
+    if (out != NULL) {
+        if (tc_read(base + GCM_ADDR_OUT_BUF, buf, wlen) != 0)
+            goto out;
+        memcpy(out, buf, len);
+    }
+    ret = 0;
+
+out:
+    memset(buf, 0, sizeof(buf));
+    return ret;
+}
+
+/* Run the AAD and the data through the core and get the tag. */
+static int run(off_t base, const uint8_t *key, size_t keylen, const uint8_t *iv,
+               int encrypt, const uint8_t *aad, size_t aad_len,
+               const uint8_t *in, size_t len, uint8_t *out, uint8_t *tag)
+{
+    struct regs regs = { ~0, ~0, ~0 };
+    uint32_t config = (keylen == 32) ? GCM_CONFIG_KEYLEN : 0;
+    size_t n;
+
+    if (load_key(base, &regs, key, keylen) != 0 ||
+        tc_write(base + GCM_ADDR_IV0, iv, GCM_IV_LEN) != 0 ||
+        write32(base + GCM_ADDR_CTRL, GCM_CTRL_START) != 0 ||
+        tc_wait_ready(base + GCM_ADDR_STATUS) != 0)
+        return 1;
+
+    for (; aad_len > 0; aad += n, aad_len -= n) {
+        n = (aad_len < GCM_RUN_LEN) ? aad_len : GCM_RUN_LEN;
+        if (run_blocks(base, &regs, config | GCM_CONFIG_AAD, aad, n, NULL) != 0)
+            return 1;
+    }
+
+    if (encrypt)
+        config |= GCM_CONFIG_ENCRYPT;
+    for (; len > 0; in += n, out += n, len -= n) {
+        n = (len < GCM_RUN_LEN) ? len : GCM_RUN_LEN;
+        if (run_blocks(base, &regs, config, in, n, out) != 0)
+            return 1;
+    }
+
+    if (write32(base + GCM_ADDR_CTRL, GCM_CTRL_FINISH) != 0 ||
+        tc_wait_valid(base + GCM_ADDR_STATUS) != 0 ||
+        tc_read(base + GCM_ADDR_TAG0, tag, GCM_TAG_LEN) != 0)
+        return 1;
+
+    return 0;
+}
+
+static int check_args(off_t *base, const uint8_t *key, size_t keylen,
+                      const uint8_t *iv, const uint8_t *aad, size_t aad_len,
+                      const uint8_t *in, size_t len, const uint8_t *out,
+                      const uint8_t *tag)
+{
+    if (key == NULL || iv == NULL || tag == NULL ||
+        (keylen != 16 && keylen != 32) ||
+        (aad_len > 0 && aad == NULL) ||
+        (len > 0 && (in == NULL || out == NULL)) ||
+        (uint64_t)len > GCM_MAX_DATA_LEN)
+        return -1;
+
+    if (*base == 0)
+        *base = tc_core_base(GCM_NAME0 GCM_NAME1);
+    if (*base == 0)
+        return -1;
+
+    return 0;
+}
+
+/* Overwrite the key and H in the core with those of an all-zero key,
+ * and forget the host's copy of the key.
+ */
+int gcm_clear(off_t base)
+{
+    static const uint8_t zero[32];
+
+    memset(&core, 0, sizeof(core));
+
+    if (base == 0)
+        base = tc_core_base(GCM_NAME0 GCM_NAME1);
+    if (base == 0)
+        return -1;
+
+    if (tc_write(base + GCM_ADDR_KEY0, zero, sizeof(zero)) != 0 ||
+        tc_init(base + GCM_ADDR_CTRL) != 0 ||
+        tc_wait_ready(base + GCM_ADDR_STATUS) != 0)
+        return 1;
+
+    return 0;
+}
+
+/* ---------------- encrypt / decrypt ---------------- */
+
+int gcm_encrypt(off_t base, const uint8_t *key, size_t keylen, const uint8_t *iv,
+                const uint8_t *aad, size_t aad_len,
+                const uint8_t *pt, size_t len, uint8_t *ct, uint8_t *tag)
+{
+    if (check_args(&base, key, keylen, iv, aad, aad_len, pt, len, ct, tag) != 0)
+        return -1;
+
+    return run(base, key, keylen, iv, 1, aad, aad_len, pt, len, ct, tag);
+}
+
+int gcm_decrypt(off_t base, const uint8_t *key, size_t keylen, const uint8_t *iv,
+                const uint8_t *aad, size_t aad_len,
+                const uint8_t *ct, size_t len, const uint8_t *tag, uint8_t *pt)
+{
+    uint8_t t[GCM_TAG_LEN];
+    uint8_t diff = 0;
+    size_t i;
+    int ret;
+
+    if (check_args(&base, key, keylen, iv, aad, aad_len, ct, len, pt, tag) != 0)
+        return -1;
+
+    if ((ret = run(base, key, keylen, iv, 0, aad, aad_len, ct, len, pt, t)) == 0) {
+        /* no early exit, so the time taken does not depend on the tag */
+        for (i = 0; i < GCM_TAG_LEN; ++i)
+            diff |= t[i] ^ tag[i];
+        if (diff != 0)
+            ret = -1;
+    }
+
+    if (ret != 0 && len > 0)
+        memset(pt, 0, len);
+    memset(t, 0, sizeof(t));
+    return ret;
+}
@@ -0,0 +1,326 @@
+/*
+ * gcm_tester.c
+ * ------------
+ * Checks the AES-GCM driver against GCM test cases 2, 4 and 16 from
+ * the GCM specification (as used by NIST CAVP), then reports the
+ * throughput for 64 byte, 1 KiB and 64 KiB messages.
+ *
+ * Copyright (c) 2016, NORDUnet A/S All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the NORDUnet nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <sys/types.h>
+
+#include "cryptech.h"
+
+char *usage =
+"Usage: %s [-h] [-a #] [-k #] [-n #]\n\
+\n\
+-a      bytes of AAD per message (default 16)\n\
+-k      key length in bits, 128 or 256 (default 128)\n\
+-n      number of bytes to process per message size (default 1048576)\n\
+";
+
+static off_t gcm_base;
+
+static inline uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/* ---------------- test vectors ---------------- */
+
+/* key, IV and plaintext of test cases 1 and 2 */
+static const uint8_t zero[32];
+
+/* GCM test case 2 */
+static const uint8_t ct_2[16] = {
+    0x03, 0x88, 0xda, 0xce, 0x60, 0xb6, 0xa3, 0x92, 0xf3, 0x28, 0xc2, 0xb9,
+    0x71, 0xb2, 0xfe, 0x78,
+};
+
+static const uint8_t tag_2[GCM_TAG_LEN] = {
+    0xab, 0x6e, 0x47, 0xd4, 0x2c, 0xec, 0x13, 0xbd, 0xf5, 0x3a, 0x67, 0xb2,
+    0x12, 0x57, 0xbd, 0xdf,
+};
+
+/* GCM test cases 4 and 16, the latter with the key repeated */
+static const uint8_t key_4[32] = {
+    0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c, 0x6d, 0x6a, 0x8f, 0x94,
+    0x67, 0x30, 0x83, 0x08, 0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c,
+    0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08,
+};
+
+static const uint8_t iv_4[GCM_IV_LEN] = {
+    0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88,
+};
+
+static const uint8_t aad_4[20] = {
+    0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef, 0xfe, 0xed, 0xfa, 0xce,
+    0xde, 0xad, 0xbe, 0xef, 0xab, 0xad, 0xda, 0xd2,
+};
+
+static const uint8_t pt_4[60] = {
+    0xd9, 0x31, 0x32, 0x25, 0xf8, 0x84, 0x06, 0xe5, 0xa5, 0x59, 0x09, 0xc5,
+    0xaf, 0xf5, 0x26, 0x9a, 0x86, 0xa7, 0xa9, 0x53, 0x15, 0x34, 0xf7, 0xda,
+    0x2e, 0x4c, 0x30, 0x3d, 0x8a, 0x31, 0x8a, 0x72, 0x1c, 0x3c, 0x0c, 0x95,
+    0x95, 0x68, 0x09, 0x53, 0x2f, 0xcf, 0x0e, 0x24, 0x49, 0xa6, 0xb5, 0x25,
+    0xb1, 0x6a, 0xed, 0xf5, 0xaa, 0x0d, 0xe6, 0x57, 0xba, 0x63, 0x7b, 0x39,
+};
+
+static const uint8_t ct_4[60] = {
+    0x42, 0x83, 0x1e, 0xc2, 0x21, 0x77, 0x74, 0x24, 0x4b, 0x72, 0x21, 0xb7,
+    0x84, 0xd0, 0xd4, 0x9c, 0xe3, 0xaa, 0x21, 0x2f, 0x2c, 0x02, 0xa4, 0xe0,
+    0x35, 0xc1, 0x7e, 0x23, 0x29, 0xac, 0xa1, 0x2e, 0x21, 0xd5, 0x14, 0xb2,
+    0x54, 0x66, 0x93, 0x1c, 0x7d, 0x8f, 0x6a, 0x5a, 0xac, 0x84, 0xaa, 0x05,
+    0x1b, 0xa3, 0x0b, 0x39, 0x6a, 0x0a, 0xac, 0x97, 0x3d, 0x58, 0xe0, 0x91,
+};
+
+static const uint8_t tag_4[GCM_TAG_LEN] = {
+    0x5b, 0xc9, 0x4f, 0xbc, 0x32, 0x21, 0xa5, 0xdb, 0x94, 0xfa, 0xe9, 0x5a,
+    0xe7, 0x12, 0x1a, 0x47,
+};
+
+static const uint8_t ct_16[60] = {
+    0x52, 0x2d, 0xc1, 0xf0, 0x99, 0x56, 0x7d, 0x07, 0xf4, 0x7f, 0x37, 0xa3,
+    0x2a, 0x84, 0x42, 0x7d, 0x64, 0x3a, 0x8c, 0xdc, 0xbf, 0xe5, 0xc0, 0xc9,
+    0x75, 0x98, 0xa2, 0xbd, 0x25, 0x55, 0xd1, 0xaa, 0x8c, 0xb0, 0x8e, 0x48,
+    0x59, 0x0d, 0xbb, 0x3d, 0xa7, 0xb0, 0x8b, 0x10, 0x56, 0x82, 0x88, 0x38,
+    0xc5, 0xf6, 0x1e, 0x63, 0x93, 0xba, 0x7a, 0x0a, 0xbc, 0xc9, 0xf6, 0x62,
+};
+
+static const uint8_t tag_16[GCM_TAG_LEN] = {
+    0x76, 0xfc, 0x6e, 0xce, 0x0f, 0x4e, 0x17, 0x68, 0xcd, 0xdf, 0x88, 0x53,
+    0xbb, 0x2d, 0x55, 0x1b,
+};
+
+static const struct {
+    const char *name;
+    const uint8_t *key, *iv, *aad, *pt, *ct, *tag;
+    size_t keylen, aad_len, len;
+} vectors[] = {
+    { "GCM test case 2", zero, zero, NULL, zero, ct_2, tag_2,
+      16, 0, sizeof(ct_2) },
+    { "GCM test case 4", key_4, iv_4, aad_4, pt_4, ct_4, tag_4,
+      16, sizeof(aad_4), sizeof(pt_4) },
+    { "GCM test case 16", key_4, iv_4, aad_4, pt_4, ct_16, tag_16,
+      32, sizeof(aad_4), sizeof(pt_4) },
+};
+
+/* Check the vectors in both directions, and that a message with a
+ * flipped bit in the ciphertext or the tag is rejected and wiped.
+ */
+static int check_vectors(void)
+{
+    uint8_t buf[sizeof(pt_4)], tag[GCM_TAG_LEN];
+    size_t v;
+
+    for (v = 0; v < sizeof(vectors) / sizeof(vectors[0]); ++v) {
+        if (gcm_encrypt(gcm_base, vectors[v].key, vectors[v].keylen, vectors[v].iv,
+                        vectors[v].aad, vectors[v].aad_len,
+                        vectors[v].pt, vectors[v].len, buf, tag) != 0 ||
+            memcmp(buf, vectors[v].ct, vectors[v].len) != 0 ||
+            memcmp(tag, vectors[v].tag, GCM_TAG_LEN) != 0) {
+            fprintf(stderr, "%s: encryption failed\n", vectors[v].name);
+            return 1;
+        }
+
+        if (gcm_decrypt(gcm_base, vectors[v].key, vectors[v].keylen, vectors[v].iv,
+                        vectors[v].aad, vectors[v].aad_len,
+                        vectors[v].ct, vectors[v].len, vectors[v].tag, buf) != 0 ||
+            memcmp(buf, vectors[v].pt, vectors[v].len) != 0) {
+            fprintf(stderr, "%s: decryption failed\n", vectors[v].name);
+            return 1;
+        }
+
+        memcpy(buf, vectors[v].ct, vectors[v].len);
+        buf[vectors[v].len - 1] ^= 1;
+        if (gcm_decrypt(gcm_base, vectors[v].key, vectors[v].keylen, vectors[v].iv,
+                        vectors[v].aad, vectors[v].aad_len,
+                        buf, vectors[v].len, vectors[v].tag, buf) != -1 ||
+            buf[0] != 0) {
+            fprintf(stderr, "%s: modified ciphertext accepted\n", vectors[v].name);
+            return 1;
+        }
+
+        memcpy(tag, vectors[v].tag, GCM_TAG_LEN);
+        tag[GCM_TAG_LEN - 1] ^= 0x80;
+        if (gcm_decrypt(gcm_base, vectors[v].key, vectors[v].keylen, vectors[v].iv,
+                        vectors[v].aad, vectors[v].aad_len,
+                        vectors[v].ct, vectors[v].len, tag, buf) != -1) {
+            fprintf(stderr, "%s: modified tag accepted\n", vectors[v].name);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/* Round trip messages whose AAD and data lengths sit around the 16 byte
+ * block and the 1 KiB run boundaries.
+ */
+static int check_lengths(void)
+{
+    static const size_t lens[] = { 0, 1, 15, 16, 17, 1023, 1024, 1025, 2048, 2049 };
+    static uint8_t msg[2049], ct[2049], pt[2049];
+    uint8_t tag[GCM_TAG_LEN];
+    size_t a, d, i;
+
+    for (i = 0; i < sizeof(msg); ++i)
+        msg[i] = 0xa5 ^ i;
+
+    for (a = 0; a < sizeof(lens) / sizeof(lens[0]); ++a)
+        for (d = 0; d < sizeof(lens) / sizeof(lens[0]); ++d) {
+            if (gcm_encrypt(gcm_base, key_4, 16, iv_4, msg, lens[a],
+                            msg, lens[d], ct, tag) != 0 ||
+                gcm_decrypt(gcm_base, key_4, 16, iv_4, msg, lens[a],
+                            ct, lens[d], tag, pt) != 0 ||
+                memcmp(pt, msg, lens[d]) != 0) {
+                fprintf(stderr, "%lu bytes AAD, %lu bytes data: round trip failed\n",
+                        (unsigned long)lens[a], (unsigned long)lens[d]);
+                return 1;
+            }
+        }
+
+    return 0;
+}
+
+/* ---------------- benchmark ---------------- */
+
+/* Encrypt len bytes as messages of size bytes and return the time it
+ * took in seconds, or a negative value on error.
+ */
+static double run(size_t keylen, const uint8_t *aad, size_t aad_len,
+                  const uint8_t *in, uint8_t *out, size_t len, size_t size)
+{
+    uint8_t tag[GCM_TAG_LEN];
+    uint64_t start;
+    size_t off, n;
+
+    start = now_ns();
+
+    for (off = 0; off < len; off += n) {
+        n = (len - off < size) ? len - off : size;
+        if (gcm_encrypt(gcm_base, key_4, keylen, iv_4, aad, aad_len,
+                        in + off, n, out + off, tag) != 0)
+            return -1.0;
+    }
+
+    return (now_ns() - start) / 1e9;
+}
+
+int main(int argc, char *argv[])
+{
+    static const size_t sizes[] = { 64, 1024, 65536 };
+    unsigned long nbytes = 1048576, aad_len = 16, keybits = 128;
+    uint8_t *aad, *in, *out;
+    double secs;
+    int opt, ret = EXIT_SUCCESS;
+    size_t i;
+
+    while ((opt = getopt(argc, argv, "h?a:k:n:")) != -1) {
+        switch (opt) {
+        case 'h':
+        case '?':
+            printf(usage, argv[0]);
+            return EXIT_SUCCESS;
+        case 'a':
+            aad_len = strtoul(optarg, NULL, 0);
+            break;
+        case 'k':
+            keybits = strtoul(optarg, NULL, 0);
+            break;
+        case 'n':
+            nbytes = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, usage, argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (nbytes == 0 || (keybits != 128 && keybits != 256)) {
+        fprintf(stderr, usage, argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    gcm_base = tc_core_base(GCM_NAME0 GCM_NAME1);
+    if (gcm_base == 0) {
+        fprintf(stderr, "aes_gcm core not found\n");
+        return EXIT_FAILURE;
+    }
+
+    if (check_vectors() != 0 || check_lengths() != 0)
+        return EXIT_FAILURE;
+    printf("# GCM test vectors and round trips ok\n");
+
+    aad = malloc(aad_len + 1);
+    in = malloc(nbytes);
+    out = malloc(nbytes);
+    if (aad == NULL || in == NULL || out == NULL) {
+        perror("malloc");
+        return EXIT_FAILURE;
+    }
+    memset(aad, 0x5a, aad_len);
+    memset(in, 0xa5, nbytes);
+
+    printf("# AES-%lu-GCM encryption, %lu bytes AAD, %lu bytes per message size\n",
+           keybits, aad_len, nbytes);
+    printf("# msg bytes     MB/s  us/msg\n");
+
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]) && sizes[i] <= nbytes; ++i) {
+        if ((secs = run(keybits / 8, aad, aad_len, in, out, nbytes, sizes[i])) < 0) {
+            fprintf(stderr, "%lu byte messages failed\n", (unsigned long)sizes[i]);
+            ret = EXIT_FAILURE;
+            break;
+        }
+        printf("%11lu %8.3f %7.2f\n", (unsigned long)sizes[i],
+               secs > 0 ? nbytes / secs / 1e6 : 0.0,
+               secs * 1e6 / ((nbytes + sizes[i] - 1) / sizes[i]));
+        fflush(stdout);
+    }
+
+    if (gcm_clear(gcm_base) != 0) {
+        fprintf(stderr, "gcm_clear failed\n");
+        ret = EXIT_FAILURE;
+    }
+
+    free(aad);
+    free(in);
+    free(out);
+    return ret;
+}
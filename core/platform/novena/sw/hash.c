@@ -54,7 +54,8 @@
 
 char *usage =
 "Usage: %s [-d] [-v] [-q] [algorithm [file]]\n"
-"algorithms: sha-1, sha-256, sha-512/224, sha-512/256, sha-384, sha-512\n";
+"algorithms: sha-1, sha-256, sha-512/224, sha-512/256, sha-384, sha-512,\n"
+"            streebog-256, streebog-512\n";
 
 int quiet = 0;
 int verbose = 0;
@@ -62,6 +63,14 @@ int verbose = 0;
 
 /* ---------------- algorithm lookup code ---------------- */
 
+typedef int (*pad_func_t)(off_t base, uint8_t *block, uint8_t flen, uint8_t blen,
+                          uint8_t mode, long long tlen, int first);
+
+static int sha_pad_transmit(off_t base, uint8_t *block, uint8_t flen, uint8_t blen,
+                            uint8_t mode, long long tlen, int first);
+static int streebog_pad_transmit(off_t base, uint8_t *block, uint8_t flen, uint8_t blen,
+                                 uint8_t mode, long long tlen, int first);
+
 struct ctrl {
     char *name;
     off_t base_addr;
@@ -70,19 +79,24 @@ struct ctrl {
     off_t digest_addr;
     int   digest_len;
     int   mode;
+    pad_func_t pad;
 } ctrl[] = {
     { "sha-1",       0, SHA1_ADDR_BLOCK, SHA1_BLOCK_LEN,
-                     SHA1_ADDR_DIGEST, SHA1_DIGEST_LEN, 0 },
+                     SHA1_ADDR_DIGEST, SHA1_DIGEST_LEN, 0, sha_pad_transmit },
     { "sha-256",     0, SHA256_ADDR_BLOCK, SHA256_BLOCK_LEN,
-                     SHA256_ADDR_DIGEST, SHA256_DIGEST_LEN, 0 },
+                     SHA256_ADDR_DIGEST, SHA256_DIGEST_LEN, 0, sha_pad_transmit },
     { "sha-512/224", 0, SHA512_ADDR_BLOCK, SHA512_BLOCK_LEN,
-                     SHA512_ADDR_DIGEST, SHA512_224_DIGEST_LEN, MODE_SHA_512_224 },
+                     SHA512_ADDR_DIGEST, SHA512_224_DIGEST_LEN, MODE_SHA_512_224, sha_pad_transmit },
     { "sha-512/256", 0, SHA512_ADDR_BLOCK, SHA512_BLOCK_LEN,
-                     SHA512_ADDR_DIGEST, SHA512_256_DIGEST_LEN, MODE_SHA_512_256 },
+                     SHA512_ADDR_DIGEST, SHA512_256_DIGEST_LEN, MODE_SHA_512_256, sha_pad_transmit },
     { "sha-384",     0, SHA512_ADDR_BLOCK, SHA512_BLOCK_LEN,
-                     SHA512_ADDR_DIGEST, SHA384_DIGEST_LEN, MODE_SHA_384 },
+                     SHA512_ADDR_DIGEST, SHA384_DIGEST_LEN, MODE_SHA_384, sha_pad_transmit },
     { "sha-512",     0, SHA512_ADDR_BLOCK, SHA512_BLOCK_LEN,
-                     SHA512_ADDR_DIGEST, SHA512_DIGEST_LEN, MODE_SHA_512 },
+                     SHA512_ADDR_DIGEST, SHA512_DIGEST_LEN, MODE_SHA_512, sha_pad_transmit },
+    { "streebog-256", 0, STREEBOG_ADDR_BLOCK, STREEBOG_BLOCK_LEN,
+                     STREEBOG_ADDR_DIGEST, STREEBOG_256_DIGEST_LEN, MODE_STREEBOG_256, streebog_pad_transmit },
+    { "streebog-512", 0, STREEBOG_ADDR_BLOCK, STREEBOG_BLOCK_LEN,
+                     STREEBOG_ADDR_DIGEST, STREEBOG_512_DIGEST_LEN, MODE_STREEBOG_512, streebog_pad_transmit },
     { NULL, 0, 0, 0 }
 };
 
@@ -135,6 +149,12 @@ static int init(void)
 	}
     }
 
+    core = tc_core_first(STREEBOG_NAME0 STREEBOG_NAME1);
+    if (core) {
+        patch("streebog-256", core->base);
+        patch("streebog-512", core->base);
+    }
+
     inited = 1;
     return 0;
 }
@@ -156,8 +176,8 @@ static int transmit(off_t base, uint8_t *block, int blen, int mode, int first)
 	tc_wait(base + ADDR_STATUS, STATUS_READY, &limit);
 }
 
-static int pad_transmit(off_t base, uint8_t *block, uint8_t flen, uint8_t blen,
-			uint8_t mode, long long tlen, int first)
+static int sha_pad_transmit(off_t base, uint8_t *block, uint8_t flen, uint8_t blen,
+                            uint8_t mode, long long tlen, int first)
 {
     assert(flen < blen);
 
@@ -180,6 +200,17 @@ static int pad_transmit(off_t base, uint8_t *block, uint8_t flen, uint8_t blen,
     return transmit(base, block, blen, mode, first);
 }
 
+/* Streebog pads with a single 1 bit and no length field, the core
+ * keeps track of the length itself.
+ */
+static int streebog_pad_transmit(off_t base, uint8_t *block, uint8_t flen, uint8_t blen,
+                                 uint8_t mode, long long tlen, int first)
+{
+    assert(flen < blen);
+
+    return streebog_final_block(base, block, flen, mode, first);
+}
+
 /* return number of digest bytes read */
 static int hash(char *algo, char *file, uint8_t *digest)
 {
@@ -233,7 +264,7 @@ static int hash(char *algo, char *file, uint8_t *digest)
         }
         else if (nread < blen) {
             /* partial read = last block */
-            if (pad_transmit(base, block, nread, blen, mode,
+            if (ctrl->pad(base, block, nread, blen, mode,
                              (nblk * blen + nread) * 8, first) != 0)
                 goto out;
             break;
@@ -247,7 +278,7 @@ static int hash(char *algo, char *file, uint8_t *digest)
 
     /* Strictly speaking we should query "valid" status before reading digest,
      * but transmit() waits for "ready" status before returning, and the SHA
-     * cores always assert valid before ready.
+     * and Streebog cores always assert valid before ready.
      */
     if (tc_read(daddr, digest, dlen) != 0) {
         perror("eim read failed");
@@ -0,0 +1,256 @@
+/*
+ * health.c
+ * --------
+ * Continuous health tests for raw entropy samples, following
+ * NIST SP 800-90B section 4.4: the repetition count test and the
+ * adaptive proportion test.
+ *
+ * Samples are bytes. The tests run inline on the sample stream as it
+ * is read from the entropy cores, so the bulk of the work is done a
+ * 32-bit word (four samples) at a time with SWAR byte compares, and a
+ * plain per-sample implementation handles unaligned heads and tails.
+ *
+ * Copyright (c) 2016, NORDUnet A/S All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the NORDUnet nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "cryptech.h"
+
+#define BCAST(b)        ((uint32_t)(b) * 0x01010101U)
+
+/* ---------------- cutoff values ---------------- */
+
+/* Repetition count test cutoff, C = 1 + ceil(-log2(alpha) / H). */
+static unsigned rct_cutoff(double h)
+{
+    return 1 + (unsigned)ceil(HEALTH_ALPHA_LOG2 / h);
+}
+
+/* Adaptive proportion test cutoff, C = 1 + CRITBINOM(W, 2^-H, 1 - alpha),
+ * i.e. one more than the smallest k for which the binomial CDF reaches
+ * 1 - alpha.
+ */
+static unsigned apt_cutoff(double h, unsigned w)
+{
+    double p = pow(2.0, -h), q = 1.0 - p;
+    double alpha = pow(2.0, -HEALTH_ALPHA_LOG2);
+    double cdf = 0.0;
+    unsigned k;
+
+    if (q <= 0.0)
+        return w;
+
+    for (k = 0; k <= w; ++k) {
+        cdf += exp(lgamma(w + 1.0) - lgamma(k + 1.0) - lgamma(w - k + 1.0) +
+                   k * log(p) + (w - k) * log(q));
+        if (cdf >= 1.0 - alpha)
+            break;
+    }
+
+    return (k + 1 > w) ? w : k + 1;
+}
+
+/* Set up the tests for a source with the given assessed min-entropy
+ * per sample (bits per byte, 0 < h <= 8).
+ */
+int health_init(struct health_test *ht, double h)
+{
+    if (ht == NULL || !(h > 0.0 && h <= 8.0))
+        return -1;
+
+    memset(ht, 0, sizeof(*ht));
+    ht->h = h;
+    ht->rct_cutoff = rct_cutoff(h);
+    ht->apt_cutoff = apt_cutoff(h, HEALTH_APT_WINDOW);
+    return 0;
+}
+
+/* ---------------- per-sample implementation ---------------- */
+
+static inline int rct_sample(struct health_test *ht, uint8_t b)
+{
+    if (ht->samples != 0 && b == ht->rct_last) {
+        if (++ht->rct_run >= ht->rct_cutoff)
+            return -1;
+    }
+    else {
+        ht->rct_last = b;
+        ht->rct_run = 1;
+    }
+    return 0;
+}
+
+static inline int apt_sample(struct health_test *ht, uint8_t b)
+{
+    if (ht->apt_pos == 0) {
+        ht->apt_ref = b;
+        ht->apt_count = 1;
+    }
+    else if (b == ht->apt_ref) {
+        if (++ht->apt_count >= ht->apt_cutoff)
+            return -1;
+    }
+    if (++ht->apt_pos == HEALTH_APT_WINDOW)
+        ht->apt_pos = 0;
+    return 0;
+}
+
+static int health_alarm(struct health_test *ht, int rct_fail, int apt_fail)
+{
+    if (rct_fail) {
+        ++ht->rct_failures;
+        ht->alarm |= HEALTH_ALARM_RCT;
+    }
+    if (apt_fail) {
+        ++ht->apt_failures;
+        ht->alarm |= HEALTH_ALARM_APT;
+    }
+    return -1;
+}
+
+/* Run the tests on len samples, one at a time. */
+int health_check_bytes(struct health_test *ht, const uint8_t *buf, size_t len)
+{
+    int r, a;
+
+    if (ht->alarm)
+        return -1;
+
+    for (; len > 0; --len, ++buf) {
+        r = rct_sample(ht, *buf);
+        a = apt_sample(ht, *buf);
+        ++ht->samples;
+        if (r || a)
+            return health_alarm(ht, r, a);
+    }
+
+    return 0;
+}
+
+/* ---------------- word-at-a-time implementation ---------------- */
+
+/* number of zero bytes in x */
+static inline unsigned zero_bytes(uint32_t x)
+{
+    uint32_t t = (x & 0x7f7f7f7fU) + 0x7f7f7f7fU;
+
+    /* bit 7 of each byte of t is now set iff that byte of x is zero */
+    t = ~(t | x | 0x7f7f7f7fU);
+    return ((t >> 7) * 0x01010101U) >> 24;
+}
+
+/* Run the tests on len samples. The result is the same as for
+ * health_check_bytes(), this is just faster. Returns 0 if the
+ * samples pass, or -1 (with ht->alarm set) on failure.
+ *
+ * The repetition count test only looks at runs that touch a word
+ * boundary. A run strictly inside a word is at most two samples,
+ * which can not reach the cutoff since that is at least 4 for any
+ * h <= 8.
+ */
+int health_check(struct health_test *ht, const uint8_t *buf, size_t len)
+{
+    uint32_t w, e, last, ref;
+    unsigned n, run, count, pos, rct_cutoff, apt_cutoff;
+    size_t nwords, i;
+
+    if (ht->alarm)
+        return -1;
+
+    /* get in step with the adaptive proportion window */
+    n = (4 - (ht->apt_pos & 3)) & 3;
+    if (ht->samples == 0)
+        n = 4;
+    if (n > len)
+        n = len;
+    if (health_check_bytes(ht, buf, n) != 0)
+        return -1;
+    buf += n;
+    len -= n;
+
+    /* Work on local copies of the state. buf may alias anything, so
+     * the compiler would otherwise reload ht after every byte read.
+     */
+    last = ht->rct_last;
+    run = ht->rct_run;
+    ref = ht->apt_ref;
+    count = ht->apt_count;
+    pos = ht->apt_pos;
+    rct_cutoff = ht->rct_cutoff;
+    apt_cutoff = ht->apt_cutoff;
+    nwords = len / 4;
+
+    for (i = 0; i < nwords; ++i, buf += 4) {
+        w = buf[0] | (buf[1] << 8) | (buf[2] << 16) | ((uint32_t)buf[3] << 24);
+
+        /* repetition count */
+        e = w ^ BCAST(last);
+        if (e == 0) {
+            run += 4;
+        }
+        else {
+            run += __builtin_ctz(e) >> 3;
+            if (run >= rct_cutoff)
+                break;
+            last = w >> 24;
+            e = w ^ BCAST(last);
+            run = e ? (__builtin_clz(e) >> 3) : 4;
+        }
+
+        /* adaptive proportion */
+        if (pos == 0) {
+            ref = w & 0xff;
+            count = 0;
+        }
+        count += zero_bytes(w ^ BCAST(ref));
+        pos = (pos + 4) & (HEALTH_APT_WINDOW - 1);
+
+        if (run >= rct_cutoff || count >= apt_cutoff)
+            break;
+    }
+
+    ht->rct_last = last;
+    ht->rct_run = run;
+    ht->apt_ref = ref;
+    ht->apt_count = count;
+    ht->apt_pos = pos;
+    ht->samples += 4 * i;
+
+    if (i < nwords) {
+        ht->samples += 4;
+        return health_alarm(ht, run >= rct_cutoff, count >= apt_cutoff);
+    }
+
+    return health_check_bytes(ht, buf, len & 3);
+}
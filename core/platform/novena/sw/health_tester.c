@@ -0,0 +1,281 @@
+/*
+ * health_tester.c
+ * ---------------
+ * Known answer tests and benchmark for the SP 800-90B continuous
+ * health tests in health.c. Optionally reads raw samples from one of
+ * the entropy cores to compare the cost of the tests with the cost
+ * of getting the samples off the FPGA.
+ *
+ * Copyright (c) 2016, NORDUnet A/S All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the NORDUnet nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "cryptech.h"
+
+char *usage =
+"Usage: %s [-h] [-a|-r|-R] [-n #] [-e #]\n\
+\n\
+-a      also benchmark against avalanche entropy samples\n\
+-r      also benchmark against rosc entropy samples\n\
+-R      also benchmark against raw rosc samples\n\
+-n      number of 4-byte samples to read from the core (default 65536)\n\
+-e      assessed min-entropy per byte (default 4.0)\n\
+";
+
+static uint32_t xs = 2463534242U;
+
+static uint8_t prng(void)
+{
+    xs ^= xs << 13;
+    xs ^= xs >> 17;
+    xs ^= xs << 5;
+    return xs >> 24;
+}
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int failures = 0;
+
+static void check(char *name, int cond)
+{
+    printf("%-48s %s\n", name, cond ? "ok" : "FAILED");
+    if (!cond)
+        ++failures;
+}
+
+/* ---------------- known answer tests ---------------- */
+
+static void kat(void)
+{
+    static uint8_t buf[1 << 20];
+    struct health_test ht;
+    double h[] = { 0.5, 1.0, 2.0, 4.0, 6.0, 8.0 };
+    int i;
+
+    for (i = 0; i < sizeof(h) / sizeof(h[0]); ++i) {
+        health_init(&ht, h[i]);
+        printf("H = %.1f: repetition count cutoff %u, adaptive proportion cutoff %u/%d\n",
+               h[i], ht.rct_cutoff, ht.apt_cutoff, HEALTH_APT_WINDOW);
+    }
+
+    /* stuck source */
+    health_init(&ht, 4.0);
+    memset(buf, 0x55, 4096);
+    check("stuck source trips repetition count",
+          health_check(&ht, buf, 4096) != 0 && (ht.alarm & HEALTH_ALARM_RCT) &&
+          ht.samples <= ht.rct_cutoff + 4);
+    check("alarm is sticky", health_check(&ht, buf, 4) != 0);
+
+    /* every other sample is the same value, no runs */
+    health_init(&ht, 4.0);
+    for (i = 0; i < 4096; ++i)
+        buf[i] = (i & 1) ? (prng() & 0x7f) : 0xa5;
+    check("biased source trips adaptive proportion",
+          health_check(&ht, buf, 4096) != 0 && ht.alarm == HEALTH_ALARM_APT);
+
+    /* good data */
+    health_init(&ht, 6.0);
+    for (i = 0; i < sizeof(buf); ++i)
+        buf[i] = prng();
+    check("uniform data passes",
+          health_check(&ht, buf, sizeof(buf)) == 0 && ht.samples == sizeof(buf));
+}
+
+/* The word-at-a-time and per-sample implementations must agree, also
+ * when the stream is fed in odd sized pieces.
+ */
+static void cross_check(void)
+{
+    static uint8_t buf[1 << 16];
+    struct health_test a, b;
+    size_t off, n;
+    int i, j, ok = 1, ra, rb;
+
+    for (i = 0; i < 2000 && ok; ++i) {
+        for (j = 0; j < sizeof(buf); ++j)
+            buf[j] = prng() & 0x0f;
+        /* insert a run or a burst of one value somewhere */
+        off = (prng() << 8 | prng()) % (sizeof(buf) - 64);
+        n = 1 + prng() % 32;
+        for (j = 0; j < n; ++j)
+            buf[off + (i & 1 ? j : 2 * j)] = 0x07;
+
+        health_init(&a, 3.0);
+        health_init(&b, 3.0);
+        ra = rb = 0;
+        for (off = 0; off < sizeof(buf) && !ra; off += n) {
+            n = 1 + prng() % 700;
+            if (n > sizeof(buf) - off)
+                n = sizeof(buf) - off;
+            ra = health_check(&a, buf + off, n);
+        }
+        rb = health_check_bytes(&b, buf, sizeof(buf));
+        ok = (ra == rb) && (a.alarm == b.alarm);
+    }
+    check("word and sample implementations agree", ok);
+}
+
+/* ---------------- benchmark ---------------- */
+
+static void bench(void)
+{
+    size_t len = 64 << 20;
+    uint8_t *buf = malloc(len);
+    struct health_test ht;
+    double t0, t1, t2;
+    size_t i;
+
+    if (buf == NULL) {
+        perror("malloc");
+        return;
+    }
+    for (i = 0; i < len; ++i)
+        buf[i] = prng();
+
+    health_init(&ht, 6.0);
+    t0 = now();
+    health_check_bytes(&ht, buf, len);
+    t1 = now();
+    health_init(&ht, 6.0);
+    health_check(&ht, buf, len);
+    t2 = now();
+
+    printf("per-sample:      %.2f ns/sample, %.0f MB/s\n",
+           (t1 - t0) * 1e9 / len, len / (t1 - t0) / 1e6);
+    printf("word-at-a-time:  %.2f ns/sample, %.0f MB/s\n",
+           (t2 - t1) * 1e9 / len, len / (t2 - t1) / 1e6);
+    free(buf);
+}
+
+/* Read samples from a core, then time the tests on them. A raw
+ * register does not consume the sample, so ack_addr, if set, is read
+ * after each one to start the next.
+ */
+static int bench_source(off_t base, off_t data_addr, off_t ack_addr,
+                        unsigned long num, double h)
+{
+    uint32_t ack;
+    uint32_t *buf = malloc(num * 4);
+    struct health_test ht;
+    unsigned long i;
+    double t0, t1, t2;
+
+    if (buf == NULL) {
+        perror("malloc");
+        return 1;
+    }
+
+    t0 = now();
+    for (i = 0; i < num; ++i) {
+        if (tc_wait(base + ENTROPY1_ADDR_STATUS, ENTROPY1_STATUS_VALID, NULL) != 0 ||
+            tc_read(data_addr, (uint8_t *)&buf[i], 4) != 0 ||
+            (ack_addr != 0 && tc_read(ack_addr, (uint8_t *)&ack, 4) != 0)) {
+            free(buf);
+            return 1;
+        }
+    }
+    t1 = now();
+    health_init(&ht, h);
+    health_check(&ht, (uint8_t *)buf, num * 4);
+    t2 = now();
+
+    printf("extraction:      %.2f ns/sample\n", (t1 - t0) * 1e9 / (num * 4));
+    printf("health tests:    %.2f ns/sample (%.4f%% of extraction)\n",
+           (t2 - t1) * 1e9 / (num * 4), 100 * (t2 - t1) / (t1 - t0));
+    printf("result:          %s\n", ht.alarm ? "ALARM" : "pass");
+
+    free(buf);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    off_t base = 0, data_addr = 0, ack_addr = 0;
+    unsigned long num = 65536;
+    double h = 4.0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "h?arRn:e:")) != -1) {
+        switch (opt) {
+        case 'h':
+        case '?':
+            printf(usage, argv[0]);
+            return EXIT_SUCCESS;
+        case 'a':
+            base = tc_core_base("extnoise");
+            data_addr = base + ENTROPY1_ADDR_ENTROPY;
+            break;
+        case 'r':
+            base = tc_core_base("rosc ent");
+            data_addr = base + ENTROPY2_ADDR_ENTROPY;
+            break;
+        case 'R':
+            base = tc_core_base("rosc ent");
+            data_addr = base + ENTROPY2_ADDR_RAW;
+            ack_addr = base + ENTROPY2_ADDR_ENTROPY;
+            break;
+        case 'n':
+            num = strtoul(optarg, NULL, 0);
+            break;
+        case 'e':
+            h = atof(optarg);
+            break;
+        default:
+            fprintf(stderr, usage, argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    kat();
+    cross_check();
+    bench();
+
+    if (data_addr != 0) {
+        if (base == 0) {
+            fprintf(stderr, "entropy core not present\n");
+            return EXIT_FAILURE;
+        }
+        if (bench_source(base, data_addr, ack_addr, num, h) != 0)
+            return EXIT_FAILURE;
+    }
+
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
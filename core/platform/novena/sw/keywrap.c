@@ -0,0 +1,218 @@
+/*
+ * keywrap.c
+ * ---------
+ * AES key wrap (RFC 3394) and key wrap with padding (RFC 5649) on top
+ * of the keywrap core.
+ *
+ * The core runs the whole 6n step wrapping loop by itself, so a key
+ * costs one write of the data, one start, the wait and one read of the
+ * result, instead of a bus round trip per AES operation. The padding,
+ * the alternative initial value and the integrity check are done here.
+ *
+ * The KEK is expanded in the core once and kept there until another
+ * one is used, or until keywrap_clear() wipes it.
+ *
+ * Copyright (c) 2016, NORDUnet A/S All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the NORDUnet nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/types.h>
+
+#include "cryptech.h"
+
+/* the KEK currently expanded in the core */
+static struct {
+    off_t base;
+    size_t keklen;              /* 0 if unknown */
+    uint8_t kek[32];
+} core;
+
+/* RFC 5649 alternative initial value, followed by the 32-bit MLI */
+static const uint8_t aiv[4] = { 0xa6, 0x59, 0x59, 0xa6 };
+
+/* ---------------- core access ---------------- */
+
+static int load_kek(off_t base, const uint8_t *kek, size_t keklen)
+{
+    uint8_t config[4] = { 0, 0, 0, (keklen == 32) ? KEYWRAP_CONFIG_KEYLEN : 0 };
+
+    if (core.base == base && core.keklen == keklen &&
+        memcmp(core.kek, kek, keklen) == 0)
+        return 0;
+
+    memset(&core, 0, sizeof(core));
+
+    if (tc_write(base + KEYWRAP_ADDR_KEY0, kek, keklen) != 0 ||
+        tc_write(base + KEYWRAP_ADDR_CONFIG, config, 4) != 0 ||
+        tc_init(base + KEYWRAP_ADDR_CTRL) != 0 ||
+        tc_wait_ready(base + KEYWRAP_ADDR_STATUS) != 0)
+        return 1;
+
+    core.base = base;
+    core.keklen = keklen;
+    memcpy(core.kek, kek, keklen);
+    return 0;
+}
+
+int keywrap_run(off_t base, const uint8_t *kek, size_t keklen, int wrap,
+                uint8_t *a, uint8_t *r, size_t n)
+{
+    uint8_t config[4] = { 0, 0, 0, 0 };
+    uint8_t rlen[4] = { 0, 0, n >> 8, n };
+
+    if (kek == NULL || a == NULL || r == NULL ||
+        (keklen != 16 && keklen != 32) ||
+        n == 0 || n > KEYWRAP_MAX_BLOCKS)
+        return -1;
+
+    if (base == 0)
+        base = tc_core_base(KEYWRAP_CORE_NAME0 KEYWRAP_CORE_NAME1);
+    if (base == 0)
+        return -1;
+
+    if (keklen == 32)
+        config[3] |= KEYWRAP_CONFIG_KEYLEN;
+    if (wrap)
+        config[3] |= KEYWRAP_CONFIG_WRAP;
+
+    /* the bytes of R map straight onto the memory words, high word of
+     * each block first
+     */
+    if (load_kek(base, kek, keklen) != 0 ||
+        tc_write(base + KEYWRAP_ADDR_RLEN, rlen, 4) != 0 ||
+        tc_write(base + KEYWRAP_ADDR_A0, a, 8) != 0 ||
+        tc_write(base + KEYWRAP_ADDR_MEM, r, 8 * n) != 0 ||
+        tc_write(base + KEYWRAP_ADDR_CONFIG, config, 4) != 0 ||
+        tc_next(base + KEYWRAP_ADDR_CTRL) != 0 ||
+        tc_wait_valid(base + KEYWRAP_ADDR_STATUS) != 0 ||
+        tc_read(base + KEYWRAP_ADDR_A0, a, 8) != 0 ||
+        tc_read(base + KEYWRAP_ADDR_MEM, r, 8 * n) != 0)
+        return 1;
+
+    return 0;
+}
+
+/* Overwrite the KEK in the core with an all-zero key, and forget the
+ * host's copy of it.
+ */
+int keywrap_clear(off_t base)
+{
+    static const uint8_t zero[32];
+
+    memset(&core, 0, sizeof(core));
+
+    if (base == 0)
+        base = tc_core_base(KEYWRAP_CORE_NAME0 KEYWRAP_CORE_NAME1);
+    if (base == 0)
+        return -1;
+
+    if (tc_write(base + KEYWRAP_ADDR_KEY0, zero, sizeof(zero)) != 0 ||
+        tc_init(base + KEYWRAP_ADDR_CTRL) != 0 ||
+        tc_wait_ready(base + KEYWRAP_ADDR_STATUS) != 0)
+        return 1;
+
+    return 0;
+}
+
+/* ---------------- RFC 5649 ---------------- */
+
+/* out needs room for len rounded up to a multiple of 8, plus 8 */
+int keywrap_wrap(off_t base, const uint8_t *kek, size_t keklen,
+                 const uint8_t *in, size_t len, uint8_t *out, size_t *outlen)
+{
+    size_t n = (len + 7) / 8;
+    int ret;
+
+    if (in == NULL || out == NULL || outlen == NULL ||
+        len == 0 || len > KEYWRAP_MAX_DATA_LEN)
+        return -1;
+
+    memcpy(out, aiv, 4);
+    out[4] = len >> 24;
+    out[5] = len >> 16;
+    out[6] = len >> 8;
+    out[7] = len;
+    memmove(out + 8, in, len);
+    memset(out + 8 + len, 0, 8 * n - len);
+
+    if ((ret = keywrap_run(base, kek, keklen, 1, out, out + 8, n)) != 0) {
+        memset(out, 0, 8 * (n + 1));
+        return ret;
+    }
+
+    *outlen = 8 * (n + 1);
+    return 0;
+}
+
+/* out needs room for len - 8 bytes; the key is unwrapped in place and
+ * wiped if the integrity check fails
+ */
+int keywrap_unwrap(off_t base, const uint8_t *kek, size_t keklen,
+                   const uint8_t *in, size_t len, uint8_t *out, size_t *outlen)
+{
+    uint8_t a[8];
+    size_t n, mli, i;
+    uint8_t pad = 0;
+    int ret;
+
+    if (in == NULL || out == NULL || outlen == NULL ||
+        len % 8 != 0 || len < 16 || len > KEYWRAP_MAX_DATA_LEN + 8)
+        return -1;
+
+    n = len / 8 - 1;
+    memcpy(a, in, 8);
+    memmove(out, in + 8, 8 * n);
+
+    if ((ret = keywrap_run(base, kek, keklen, 0, a, out, n)) != 0)
+        goto fail;
+
+    mli = (size_t)a[4] << 24 | (size_t)a[5] << 16 | (size_t)a[6] << 8 | a[7];
+    if (memcmp(a, aiv, 4) != 0 || mli <= 8 * (n - 1) || mli > 8 * n) {
+        ret = -1;
+        goto fail;
+    }
+    for (i = mli; i < 8 * n; ++i)
+        pad |= out[i];
+    if (pad != 0) {
+        ret = -1;
+        goto fail;
+    }
+
+    memset(a, 0, sizeof(a));
+    *outlen = mli;
+    return 0;
+
+fail:
+    memset(out, 0, 8 * n);
+    memset(a, 0, sizeof(a));
+    return ret;
+}
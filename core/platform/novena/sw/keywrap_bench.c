@@ -0,0 +1,363 @@
+/*
+ * keywrap_bench.c
+ * ---------------
+ * Keys wrapped and unwrapped per second by the keywrap core, against
+ * the same RFC 3394 loop driven from the host over the aes core, one
+ * bus round trip per AES operation.
+ *
+ * Both are checked against the RFC 3394 test vectors first, and the
+ * RFC 5649 functions are checked for round trips over a range of key
+ * lengths, and for rejecting a corrupted wrapped key.
+ *
+ * Copyright (c) 2016, NORDUnet A/S All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the NORDUnet nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <sys/types.h>
+
+#include "cryptech.h"
+
+char *usage =
+"Usage: %s [-h] [-k 128|256] [-l #] [-n #]\n\
+\n\
+-k      KEK length in bits (default 128)\n\
+-l      length in bytes of the key to wrap (default 32)\n\
+-n      number of keys to wrap and unwrap (default 1000)\n\
+";
+
+static off_t aes_base, keywrap_base;
+
+static inline uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/* ---------------- RFC 3394, 4.1 and 4.6 ---------------- */
+
+static const uint8_t rfc_kek[32] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+
+static const uint8_t rfc_iv[8] = {
+    0xa6, 0xa6, 0xa6, 0xa6, 0xa6, 0xa6, 0xa6, 0xa6
+};
+
+static const uint8_t rfc_key[32] = {
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+    0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+
+/* 128 bit key data under a 128 bit KEK */
+static const uint8_t rfc_wrap_41[24] = {
+    0x1f, 0xa6, 0x8b, 0x0a, 0x81, 0x12, 0xb4, 0x47,
+    0xae, 0xf3, 0x4b, 0xd8, 0xfb, 0x5a, 0x7b, 0x82,
+    0x9d, 0x3e, 0x86, 0x23, 0x71, 0xd2, 0xcf, 0xe5
+};
+
+/* 256 bit key data under a 256 bit KEK */
+static const uint8_t rfc_wrap_46[40] = {
+    0x28, 0xc9, 0xf4, 0x04, 0xc4, 0xb8, 0x10, 0xf4,
+    0xcb, 0xcc, 0xb3, 0x5c, 0xfb, 0x87, 0xf8, 0x26,
+    0x3f, 0x57, 0x86, 0xe2, 0xd8, 0x0e, 0xd3, 0x26,
+    0xcb, 0xc7, 0xf0, 0xe7, 0x1a, 0x99, 0xf4, 0x3b,
+    0xfb, 0x98, 0x8b, 0x9b, 0x7a, 0x02, 0xdd, 0x21
+};
+
+/* ---------------- host-driven RFC 3394 loop ---------------- */
+
+static void xor_t(uint8_t *a, uint64_t t)
+{
+    int i;
+
+    for (i = 7; i >= 0; --i, t >>= 8)
+        a[i] ^= t;
+}
+
+/* W or W^-1 with one call to the aes driver per step, and the step
+ * counter t XORed into A on the host.
+ */
+static int host_run(aes_ctx_t *ctx, int wrap, uint8_t *a, uint8_t *r, size_t n)
+{
+    uint8_t b[AES_BLOCK_LEN];
+    size_t i, t;
+
+    memcpy(b, a, 8);
+
+    if (n == 1) {
+        memcpy(b + 8, r, 8);
+        if ((wrap ? aes_ecb_encrypt(ctx, b, b, AES_BLOCK_LEN) :
+                    aes_ecb_decrypt(ctx, b, b, AES_BLOCK_LEN)) != 0)
+            return 1;
+        memcpy(a, b, 8);
+        memcpy(r, b + 8, 8);
+        return 0;
+    }
+
+    if (wrap) {
+        for (t = 1; t <= 6 * n; ++t) {
+            i = (t - 1) % n;
+            memcpy(b + 8, r + 8 * i, 8);
+            if (aes_ecb_encrypt(ctx, b, b, AES_BLOCK_LEN) != 0)
+                return 1;
+            xor_t(b, t);
+            memcpy(r + 8 * i, b + 8, 8);
+        }
+    }
+    else {
+        for (t = 6 * n; t >= 1; --t) {
+            i = (t - 1) % n;
+            xor_t(b, t);
+            memcpy(b + 8, r + 8 * i, 8);
+            if (aes_ecb_decrypt(ctx, b, b, AES_BLOCK_LEN) != 0)
+                return 1;
+            memcpy(r + 8 * i, b + 8, 8);
+        }
+    }
+
+    memcpy(a, b, 8);
+    return 0;
+}
+
+/* ---------------- self-test ---------------- */
+
+/* Run one RFC 3394 vector both ways, on the core and on the host. */
+static int check_vector(const char *what, size_t keklen, size_t len, const uint8_t *expected)
+{
+    uint8_t buf[8 + 32];
+    size_t n = len / 8;
+    aes_ctx_t ctx;
+    int host, ret = 0;
+
+    if (aes_init(&ctx, aes_base, rfc_kek, keklen) != 0)
+        return 1;
+
+    for (host = 0; host <= 1 && ret == 0; ++host) {
+        memcpy(buf, rfc_iv, 8);
+        memcpy(buf + 8, rfc_key, len);
+        if ((host ? host_run(&ctx, 1, buf, buf + 8, n) :
+                    keywrap_run(keywrap_base, rfc_kek, keklen, 1, buf, buf + 8, n)) != 0 ||
+            memcmp(buf, expected, len + 8) != 0) {
+            fprintf(stderr, "%s wrap (%s): result does not match RFC 3394\n",
+                    what, host ? "host" : "core");
+            ret = 1;
+            break;
+        }
+        if ((host ? host_run(&ctx, 0, buf, buf + 8, n) :
+                    keywrap_run(keywrap_base, rfc_kek, keklen, 0, buf, buf + 8, n)) != 0 ||
+            memcmp(buf, rfc_iv, 8) != 0 || memcmp(buf + 8, rfc_key, len) != 0) {
+            fprintf(stderr, "%s unwrap (%s): result does not match RFC 3394\n",
+                    what, host ? "host" : "core");
+            ret = 1;
+        }
+    }
+
+    aes_clear(&ctx);
+    return ret;
+}
+
+/* RFC 5649 round trips for every key length up to 72 bytes, which
+ * covers the single block case and the padding, and a wrapped key
+ * with one bit flipped, which has to be rejected.
+ */
+static int check_padded(size_t keklen)
+{
+    uint8_t key[72], wrapped[8 + 72], unwrapped[72];
+    size_t len, wlen, ulen;
+
+    for (len = 0; len < sizeof(key); ++len)
+        key[len] = len * 7 + 1;
+
+    for (len = 1; len <= sizeof(key); ++len) {
+        if (keywrap_wrap(keywrap_base, rfc_kek, keklen, key, len, wrapped, &wlen) != 0 ||
+            wlen != 8 * ((len + 7) / 8 + 1) ||
+            keywrap_unwrap(keywrap_base, rfc_kek, keklen, wrapped, wlen, unwrapped, &ulen) != 0 ||
+            ulen != len || memcmp(unwrapped, key, len) != 0) {
+            fprintf(stderr, "RFC 5649 round trip failed for %lu bytes\n", (unsigned long)len);
+            return 1;
+        }
+        wrapped[len % wlen] ^= 0x10;
+        if (keywrap_unwrap(keywrap_base, rfc_kek, keklen, wrapped, wlen, unwrapped, &ulen) != -1) {
+            fprintf(stderr, "RFC 5649 unwrap accepted a corrupted key of %lu bytes\n",
+                    (unsigned long)len);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static int self_test(void)
+{
+    return
+        check_vector("RFC 3394 4.1", 16, 16, rfc_wrap_41) ||
+        check_vector("RFC 3394 4.6", 32, 32, rfc_wrap_46) ||
+        check_padded(16) ||
+        check_padded(32);
+}
+
+/* ---------------- benchmark ---------------- */
+
+/* Wrap and unwrap count keys of len bytes, framed as RFC 5649 does it,
+ * and return the time it took in seconds, or a negative value on
+ * error. The unwrapped key is compared with the original.
+ */
+static double run(int host, const uint8_t *kek, size_t keklen, size_t len, unsigned long count)
+{
+    uint8_t key[KEYWRAP_MAX_DATA_LEN], a[8], r[KEYWRAP_MAX_DATA_LEN];
+    size_t n = (len + 7) / 8;
+    unsigned long c;
+    aes_ctx_t ctx;
+    uint64_t start;
+    int ret = 0;
+
+    memset(key, 0, sizeof(key));
+    for (c = 0; c < len; ++c)
+        key[c] = c;
+
+    if (host && aes_init(&ctx, aes_base, kek, keklen) != 0)
+        return -1.0;
+
+    start = now_ns();
+
+    for (c = 0; c < count && ret == 0; ++c) {
+        a[0] = 0xa6; a[1] = 0x59; a[2] = 0x59; a[3] = 0xa6;
+        a[4] = len >> 24; a[5] = len >> 16; a[6] = len >> 8; a[7] = len;
+        memcpy(r, key, 8 * n);
+
+        if (host)
+            ret = host_run(&ctx, 1, a, r, n) || host_run(&ctx, 0, a, r, n);
+        else
+            ret = keywrap_run(keywrap_base, kek, keklen, 1, a, r, n) ||
+                  keywrap_run(keywrap_base, kek, keklen, 0, a, r, n);
+
+        if (ret == 0 && memcmp(r, key, 8 * n) != 0) {
+            fprintf(stderr, "unwrapped key does not match\n");
+            ret = 1;
+        }
+    }
+
+    if (host)
+        aes_clear(&ctx);
+
+    if (ret != 0)
+        return -1.0;
+
+    return (now_ns() - start) / 1e9;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long len = 32, count = 1000;
+    unsigned keybits = 128;
+    uint8_t kek[32];
+    double host_secs, core_secs;
+    size_t i;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "h?k:l:n:")) != -1) {
+        switch (opt) {
+        case 'h':
+        case '?':
+            printf(usage, argv[0]);
+            return EXIT_SUCCESS;
+        case 'k':
+            keybits = strtoul(optarg, NULL, 0);
+            break;
+        case 'l':
+            len = strtoul(optarg, NULL, 0);
+            break;
+        case 'n':
+            count = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, usage, argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if ((keybits != 128 && keybits != 256) ||
+        len == 0 || len > KEYWRAP_MAX_DATA_LEN || count == 0) {
+        fprintf(stderr, usage, argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    aes_base = tc_core_base(AES_CORE_NAME0 AES_CORE_NAME1);
+    if (aes_base == 0) {
+        fprintf(stderr, "aes core not found\n");
+        return EXIT_FAILURE;
+    }
+    keywrap_base = tc_core_base(KEYWRAP_CORE_NAME0 KEYWRAP_CORE_NAME1);
+    if (keywrap_base == 0) {
+        fprintf(stderr, "keywrap core not found\n");
+        return EXIT_FAILURE;
+    }
+
+    if (self_test() != 0)
+        return EXIT_FAILURE;
+
+    for (i = 0; i < sizeof(kek); ++i)
+        kek[i] = 0xf0 ^ i;
+
+    if ((host_secs = run(1, kek, keybits / 8, len, count)) < 0 ||
+        (core_secs = run(0, kek, keybits / 8, len, count)) < 0) {
+        fprintf(stderr, "benchmark failed\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("# %lu byte keys under a %u bit KEK, %lu wrap + unwrap each\n",
+           len, keybits, count);
+    printf("# engine   keys/s  us/key  speedup\n");
+    printf("host   %10.1f  %6.1f  %7.2f\n",
+           host_secs > 0 ? 2 * count / host_secs : 0.0,
+           host_secs * 1e6 / (2 * count), 1.0);
+    printf("core   %10.1f  %6.1f  %7.2f\n",
+           core_secs > 0 ? 2 * count / core_secs : 0.0,
+           core_secs * 1e6 / (2 * count),
+           core_secs > 0 ? host_secs / core_secs : 0.0);
+
+    if (keywrap_clear(keywrap_base) != 0) {
+        fprintf(stderr, "keywrap_clear failed\n");
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,418 @@
+/*
+ * random.c
+ * --------
+ * Random bytes service on top of the trng csprng core.
+ *
+ * A background thread keeps a pool of csprng output in memory so that
+ * small requests (nonces, blinding factors, IVs) can be served without
+ * going out on the bus. The thread refills the pool to the high
+ * watermark whenever it drops below the low watermark. Bytes handed
+ * out are wiped from the pool, and the pool is discarded in the child
+ * after a fork so that parent and child never share random data.
+ *
+ * Copyright (c) 2016, NORDUnet A/S All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the NORDUnet nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/types.h>
+#include <arpa/inet.h>
+
+#include "cryptech.h"
+
+#define RANDOM_DEFAULT_POOL     (64 * 1024)
+#define RANDOM_DEFAULT_LOW      (16 * 1024)
+#define RANDOM_LATENCY_SAMPLES  4096
+
+static struct {
+    int started;
+    int stop;
+    pid_t pid;
+    pthread_t tid;
+    pthread_mutex_t lock;       /* protects everything below */
+    pthread_cond_t refill;      /* signalled when below low watermark */
+    uint8_t *buf;
+    size_t size, low, high;
+    size_t head, avail;         /* read position and fill level */
+
+    /* statistics */
+    uint64_t calls, bytes, hits, misses, refills;
+    uint32_t latency[RANDOM_LATENCY_SAMPLES];
+    unsigned nlatency;
+} pool = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .refill = PTHREAD_COND_INITIALIZER,
+};
+
+/* Bus access is shared between the prefetch thread and callers that
+ * have to go to the core directly when the pool is short.
+ */
+static pthread_mutex_t bus_lock = PTHREAD_MUTEX_INITIALIZER;
+static off_t csprng_base;
+static int csprng_burst;
+
+/* ---------------- bus access ---------------- */
+
+/* Read nwords 32-bit words of csprng output into buf. Uses the burst
+ * read window when the core has one.
+ */
+static int csprng_read(uint32_t *buf, size_t nwords)
+{
+    uint32_t avail;
+    int ret = 0;
+
+    pthread_mutex_lock(&bus_lock);
+
+    while (nwords > 0) {
+        if (csprng_burst) {
+            if (tc_read(csprng_base + CSPRNG_ADDR_AVAIL, (uint8_t *)&avail, 4) != 0)
+                goto errout;
+            avail = ntohl(avail);
+            if (avail == 0) {
+                /* bounded, as we hold the bus: a csprng that has
+                 * stopped must not hang every caller */
+                if (tc_wait_status(csprng_base + CSPRNG_ADDR_STATUS, CSPRNG_STATUS_VALID) != 0)
+                    goto errout;
+                avail = 1;
+            }
+            if (avail > CSPRNG_RANDOM_WINDOW)
+                avail = CSPRNG_RANDOM_WINDOW;
+        }
+        else {
+            if (tc_wait_status(csprng_base + CSPRNG_ADDR_STATUS, CSPRNG_STATUS_VALID) != 0)
+                goto errout;
+            avail = 1;
+        }
+        if (avail > nwords)
+            avail = nwords;
+
+        if (tc_read(csprng_base + CSPRNG_ADDR_RANDOM, (uint8_t *)buf, avail * 4) != 0)
+            goto errout;
+
+        buf += avail;
+        nwords -= avail;
+    }
+
+out:
+    pthread_mutex_unlock(&bus_lock);
+    return ret;
+errout:
+    ret = -1;
+    goto out;
+}
+
+/* read len bytes directly from the core, bypassing the pool */
+static int csprng_read_bytes(uint8_t *buf, size_t len)
+{
+    uint32_t tmp[CSPRNG_RANDOM_WINDOW];
+    size_t n;
+
+    while (len > 0) {
+        n = (len > sizeof(tmp)) ? sizeof(tmp) : len;
+        if (csprng_read(tmp, (n + 3) / 4) != 0)
+            return -1;
+        memcpy(buf, tmp, n);
+        buf += n;
+        len -= n;
+    }
+
+    memset(tmp, 0, sizeof(tmp));
+    return 0;
+}
+
+/* ---------------- prefetch thread ---------------- */
+
+static void *prefetch(void *arg)
+{
+    uint32_t tmp[CSPRNG_RANDOM_WINDOW];
+    size_t tail, n, want;
+
+    pthread_mutex_lock(&pool.lock);
+
+    while (!pool.stop) {
+        if (pool.avail >= pool.low) {
+            pthread_cond_wait(&pool.refill, &pool.lock);
+            continue;
+        }
+
+        ++pool.refills;
+        while (!pool.stop && pool.avail < pool.high) {
+            want = pool.high - pool.avail;
+            if (want > sizeof(tmp))
+                want = sizeof(tmp);
+
+            /* don't hold the pool lock while we are out on the bus */
+            pthread_mutex_unlock(&pool.lock);
+            if (csprng_read(tmp, (want + 3) / 4) != 0) {
+                pthread_mutex_lock(&pool.lock);
+                goto out;
+            }
+            pthread_mutex_lock(&pool.lock);
+
+            /* the pool may have been reset under us by random_shutdown() */
+            if (pool.buf == NULL)
+                goto out;
+
+            tail = (pool.head + pool.avail) % pool.size;
+            n = pool.size - tail;
+            if (n > want)
+                n = want;
+            memcpy(pool.buf + tail, tmp, n);
+            memcpy(pool.buf, (uint8_t *)tmp + n, want - n);
+            pool.avail += want;
+        }
+    }
+
+out:
+    pthread_mutex_unlock(&pool.lock);
+    memset(tmp, 0, sizeof(tmp));
+    return NULL;
+}
+
+/* ---------------- fork handling ---------------- */
+
+static void atfork_prepare(void)
+{
+    pthread_mutex_lock(&bus_lock);
+    pthread_mutex_lock(&pool.lock);
+}
+
+static void atfork_parent(void)
+{
+    pthread_mutex_unlock(&pool.lock);
+    pthread_mutex_unlock(&bus_lock);
+}
+
+/* The prefetch thread does not exist in the child, and the child must
+ * not hand out the same bytes as the parent. Wipe the pool and start
+ * over on the next request.
+ */
+static void atfork_child(void)
+{
+    if (pool.buf != NULL) {
+        memset(pool.buf, 0, pool.size);
+        free(pool.buf);
+        pool.buf = NULL;
+    }
+    pool.started = 0;
+    pool.head = pool.avail = 0;
+    pthread_mutex_init(&pool.lock, NULL);
+    pthread_cond_init(&pool.refill, NULL);
+    pthread_mutex_init(&bus_lock, NULL);
+}
+
+/* ---------------- public interface ---------------- */
+
+/* Start the pool. pool_size is the size of the pool in bytes, the
+ * prefetcher refills it up to high whenever it drops below low. Zero
+ * selects the defaults.
+ */
+int random_init(size_t pool_size, size_t low, size_t high)
+{
+    static int atfork_installed = 0;
+    int ret = -1;
+
+    if (pool_size == 0)
+        pool_size = RANDOM_DEFAULT_POOL;
+    if (high == 0 || high > pool_size)
+        high = pool_size;
+    if (low == 0)
+        low = (RANDOM_DEFAULT_LOW < high) ? RANDOM_DEFAULT_LOW : high / 2;
+    if (low > high)
+        return -1;
+
+    pthread_mutex_lock(&pool.lock);
+
+    if (pool.started) {
+        ret = 0;
+        goto out;
+    }
+
+    if (csprng_base == 0) {
+        struct core_info *core = tc_core_first(CSPRNG_NAME0 CSPRNG_NAME1);
+        if (core == NULL) {
+            fprintf(stderr, "random_init: csprng core not found\n");
+            goto out;
+        }
+        csprng_base = core->base;
+        csprng_burst = (strncmp(core->version, CSPRNG_VERSION, 4) >= 0);
+    }
+
+    if (!atfork_installed) {
+        if (pthread_atfork(atfork_prepare, atfork_parent, atfork_child) != 0)
+            goto out;
+        atfork_installed = 1;
+    }
+
+    pool.buf = calloc(1, pool_size);
+    if (pool.buf == NULL)
+        goto out;
+    pool.size = pool_size;
+    pool.low = low;
+    pool.high = high;
+    pool.head = pool.avail = 0;
+    pool.stop = 0;
+    pool.pid = getpid();
+
+    if (pthread_create(&pool.tid, NULL, prefetch, NULL) != 0) {
+        free(pool.buf);
+        pool.buf = NULL;
+        goto out;
+    }
+
+    pool.started = 1;
+    ret = 0;
+out:
+    pthread_mutex_unlock(&pool.lock);
+    return ret;
+}
+
+/* Stop the prefetcher and wipe the pool. */
+void random_shutdown(void)
+{
+    pthread_mutex_lock(&pool.lock);
+    if (!pool.started || pool.pid != getpid()) {
+        pthread_mutex_unlock(&pool.lock);
+        return;
+    }
+    pool.stop = 1;
+    pthread_cond_signal(&pool.refill);
+    pthread_mutex_unlock(&pool.lock);
+
+    pthread_join(pool.tid, NULL);
+
+    pthread_mutex_lock(&pool.lock);
+    memset(pool.buf, 0, pool.size);
+    free(pool.buf);
+    pool.buf = NULL;
+    pool.head = pool.avail = 0;
+    pool.started = 0;
+    pthread_mutex_unlock(&pool.lock);
+}
+
+static inline uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/* Fill buf with len random bytes. Served from the pool when it has
+ * enough data, otherwise read directly from the csprng.
+ */
+int random_get(uint8_t *buf, size_t len)
+{
+    uint64_t start = now_ns();
+    size_t n;
+    int hit = 0, ret = 0;
+
+    /* A fork done with a raw syscall skips the atfork handlers, so
+     * double check that the pool really belongs to this process.
+     */
+    if (pool.started && pool.pid != getpid())
+        atfork_child();
+
+    if (!pool.started && random_init(0, 0, 0) != 0)
+        return -1;
+
+    pthread_mutex_lock(&pool.lock);
+
+    if (pool.avail >= len) {
+        /* copy out, and wipe what we handed out */
+        n = pool.size - pool.head;
+        if (n > len)
+            n = len;
+        memcpy(buf, pool.buf + pool.head, n);
+        memset(pool.buf + pool.head, 0, n);
+        memcpy(buf + n, pool.buf, len - n);
+        memset(pool.buf, 0, len - n);
+        pool.head = (pool.head + len) % pool.size;
+        pool.avail -= len;
+        hit = 1;
+    }
+
+    if (pool.avail < pool.low)
+        pthread_cond_signal(&pool.refill);
+
+    pthread_mutex_unlock(&pool.lock);
+
+    if (!hit)
+        ret = csprng_read_bytes(buf, len);
+
+    pthread_mutex_lock(&pool.lock);
+    ++pool.calls;
+    pool.bytes += len;
+    if (hit)
+        ++pool.hits;
+    else
+        ++pool.misses;
+    pool.latency[pool.nlatency++ % RANDOM_LATENCY_SAMPLES] = now_ns() - start;
+    pthread_mutex_unlock(&pool.lock);
+
+    return ret;
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* Return usage counters and latency percentiles over the most recent
+ * RANDOM_LATENCY_SAMPLES calls.
+ */
+void random_stats(struct random_stats *st)
+{
+    uint32_t tmp[RANDOM_LATENCY_SAMPLES];
+    unsigned n;
+
+    pthread_mutex_lock(&pool.lock);
+    st->calls = pool.calls;
+    st->bytes = pool.bytes;
+    st->hits = pool.hits;
+    st->misses = pool.misses;
+    st->refills = pool.refills;
+    st->avail = pool.avail;
+    n = (pool.nlatency < RANDOM_LATENCY_SAMPLES) ? pool.nlatency : RANDOM_LATENCY_SAMPLES;
+    memcpy(tmp, pool.latency, n * sizeof(tmp[0]));
+    pthread_mutex_unlock(&pool.lock);
+
+    st->p50_ns = st->p99_ns = 0;
+    if (n > 0) {
+        qsort(tmp, n, sizeof(tmp[0]), cmp_u32);
+        st->p50_ns = tmp[n / 2];
+        st->p99_ns = tmp[(n * 99) / 100];
+    }
+}
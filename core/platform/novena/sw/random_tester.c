@@ -0,0 +1,193 @@
+/*
+ * random_tester.c
+ * ---------------
+ * Exercise and time the libcryptech random bytes service.
+ *
+ * Copyright (c) 2016, NORDUnet A/S All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the NORDUnet nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "cryptech.h"
+
+char *usage =
+"Usage: %s [-h] [-d] [-n #] [-s #] [-p #] [-l #] [-H #] [-u #]\n\
+\n\
+-n      number of requests (default 100000)\n\
+-s      request size in bytes (default 32)\n\
+-p      pool size in bytes\n\
+-l      low watermark in bytes\n\
+-H      high watermark in bytes\n\
+-u      microseconds to sleep between requests (default 0)\n\
+";
+
+static void print_stats(char *label, double secs)
+{
+    struct random_stats st;
+
+    random_stats(&st);
+    printf("%s: %llu calls, %llu bytes in %.3f sec\n", label,
+           (unsigned long long)st.calls, (unsigned long long)st.bytes, secs);
+    printf("%s: %llu pool hits, %llu direct reads, %llu refills, %lu bytes pooled\n",
+           label, (unsigned long long)st.hits, (unsigned long long)st.misses,
+           (unsigned long long)st.refills, (unsigned long)st.avail);
+    printf("%s: latency p50 %u ns, p99 %u ns\n", label, st.p50_ns, st.p99_ns);
+}
+
+/* After a fork the child must not get the bytes the parent has
+ * pooled. Take a value in the child and in the parent and compare.
+ */
+static int fork_test(size_t len)
+{
+    uint8_t parent[64], child[64];
+    int fds[2], status;
+    pid_t pid;
+
+    if (len > sizeof(parent))
+        len = sizeof(parent);
+
+    if (pipe(fds) != 0) {
+        perror("pipe");
+        return 1;
+    }
+
+    pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return 1;
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        if (random_get(child, len) != 0 || write(fds[1], child, len) != len)
+            _exit(1);
+        _exit(0);
+    }
+
+    close(fds[1]);
+    if (random_get(parent, len) != 0 ||
+        read(fds[0], child, len) != len ||
+        waitpid(pid, &status, 0) != pid || status != 0) {
+        fprintf(stderr, "fork test: child failed\n");
+        return 1;
+    }
+    close(fds[0]);
+
+    if (memcmp(parent, child, len) == 0) {
+        fprintf(stderr, "fork test: parent and child got the same bytes\n");
+        return 1;
+    }
+    printf("fork test: ok\n");
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long num = 100000, i;
+    size_t size = 32, pool_size = 0, low = 0, high = 0;
+    useconds_t pause = 0;
+    uint8_t *buf;
+    struct timespec start, stop;
+    double secs;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "h?dn:s:p:l:H:u:")) != -1) {
+        switch (opt) {
+        case 'h':
+        case '?':
+            printf(usage, argv[0]);
+            return EXIT_SUCCESS;
+        case 'd':
+            tc_set_debug(1);
+            break;
+        case 'n':
+            num = strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            size = strtoul(optarg, NULL, 0);
+            break;
+        case 'p':
+            pool_size = strtoul(optarg, NULL, 0);
+            break;
+        case 'l':
+            low = strtoul(optarg, NULL, 0);
+            break;
+        case 'H':
+            high = strtoul(optarg, NULL, 0);
+            break;
+        case 'u':
+            pause = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, usage, argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    buf = malloc(size);
+    if (buf == NULL) {
+        perror("malloc");
+        return EXIT_FAILURE;
+    }
+
+    if (random_init(pool_size, low, high) != 0) {
+        fprintf(stderr, "random_init failed\n");
+        return EXIT_FAILURE;
+    }
+
+    /* give the prefetcher a moment to fill the pool */
+    usleep(100000);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < num; ++i) {
+        if (random_get(buf, size) != 0) {
+            fprintf(stderr, "random_get failed\n");
+            return EXIT_FAILURE;
+        }
+        if (pause)
+            usleep(pause);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+
+    secs = (stop.tv_sec - start.tv_sec) + (stop.tv_nsec - start.tv_nsec) / 1e9;
+    print_stats("random", secs);
+
+    if (fork_test(size) != 0)
+        return EXIT_FAILURE;
+
+    random_shutdown();
+    free(buf);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,172 @@
+/*
+ * streebog.c
+ * ----------
+ * Driver for the Streebog (GOST R 34.11-2012) hash core.
+ *
+ * The core does the compression and the finalization with N and
+ * Sigma, the host does the padding of the last block and tells the
+ * core how many message bits it contains.
+ *
+ * Copyright (c) 2016, NORDUnet A/S All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the NORDUnet nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/types.h>
+#include <arpa/inet.h>
+
+#include "cryptech.h"
+
+/* ---------------- block level interface ---------------- */
+
+static int streebog_start(off_t base, const uint8_t *block, int ctrl)
+{
+    uint8_t ctrl_cmd[4] = { 0 };
+    int limit = 10;
+
+    if (tc_write(base + STREEBOG_ADDR_BLOCK, block, STREEBOG_BLOCK_LEN) != 0)
+        return 1;
+
+    ctrl_cmd[3] = ctrl;
+
+    return
+        tc_write(base + STREEBOG_ADDR_CTRL, ctrl_cmd, 4) ||
+        tc_wait(base + STREEBOG_ADDR_STATUS, STATUS_READY, &limit);
+}
+
+/* process one full message block */
+int streebog_block(off_t base, const uint8_t *block, int mode, int first)
+{
+    return streebog_start(base, block, (first ? CTRL_INIT : CTRL_NEXT) | mode);
+}
+
+/* Pad and process the last block, which holds len (0..63) bytes of
+ * message. The block buffer must be STREEBOG_BLOCK_LEN bytes long.
+ */
+int streebog_final_block(off_t base, uint8_t *block, size_t len, int mode, int first)
+{
+    uint32_t last_len;
+
+    if (len >= STREEBOG_BLOCK_LEN)
+        return -1;
+
+    block[len] = 0x01;
+    memset(block + len + 1, 0, STREEBOG_BLOCK_LEN - len - 1);
+
+    last_len = htonl(len * 8);
+    if (tc_write(base + STREEBOG_ADDR_LAST_LEN, (uint8_t *)&last_len, 4) != 0)
+        return 1;
+
+    return streebog_start(base, block,
+                          (first ? CTRL_INIT : 0) | STREEBOG_CTRL_LAST | mode);
+}
+
+/* ---------------- streaming interface ---------------- */
+
+int streebog_init(streebog_ctx_t *ctx, off_t base, int mode)
+{
+    if (ctx == NULL)
+        return -1;
+
+    if (base == 0)
+        base = tc_core_base(STREEBOG_NAME0 STREEBOG_NAME1);
+    if (base == 0)
+        return -1;
+
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->base = base;
+    ctx->mode = mode;
+    ctx->first = 1;
+    return 0;
+}
+
+int streebog_update(streebog_ctx_t *ctx, const uint8_t *data, size_t len)
+{
+    size_t n;
+
+    /* Full blocks are sent as soon as we have them. The last block
+     * is always padded, so a message that is a multiple of the block
+     * size is finalized with an empty last block.
+     */
+    while (len > 0) {
+        if (ctx->buflen == 0 && len >= STREEBOG_BLOCK_LEN) {
+            if (streebog_block(ctx->base, data, ctx->mode, ctx->first) != 0)
+                return 1;
+            ctx->first = 0;
+            data += STREEBOG_BLOCK_LEN;
+            len -= STREEBOG_BLOCK_LEN;
+            continue;
+        }
+
+        n = STREEBOG_BLOCK_LEN - ctx->buflen;
+        if (n > len)
+            n = len;
+        memcpy(ctx->buf + ctx->buflen, data, n);
+        ctx->buflen += n;
+        data += n;
+        len -= n;
+
+        if (ctx->buflen == STREEBOG_BLOCK_LEN) {
+            if (streebog_block(ctx->base, ctx->buf, ctx->mode, ctx->first) != 0)
+                return 1;
+            ctx->first = 0;
+            ctx->buflen = 0;
+        }
+    }
+
+    return 0;
+}
+
+/* Finish the hash and read out the digest. Returns the number of
+ * digest bytes, or -1 on error.
+ */
+int streebog_final(streebog_ctx_t *ctx, uint8_t *digest)
+{
+    int dlen = (ctx->mode == MODE_STREEBOG_256) ?
+        STREEBOG_256_DIGEST_LEN : STREEBOG_512_DIGEST_LEN;
+    int limit = 10;
+    int ret = -1;
+
+    if (streebog_final_block(ctx->base, ctx->buf, ctx->buflen,
+                             ctx->mode, ctx->first) != 0)
+        goto out;
+
+    if (tc_wait(ctx->base + STREEBOG_ADDR_STATUS, STATUS_VALID, &limit) != 0)
+        goto out;
+
+    if (tc_read(ctx->base + STREEBOG_ADDR_DIGEST, digest, dlen) != 0)
+        goto out;
+
+    ret = dlen;
+out:
+    memset(ctx, 0, sizeof(*ctx));
+    return ret;
+}
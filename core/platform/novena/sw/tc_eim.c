@@ -195,14 +195,20 @@ int tc_wait(off_t offset, uint8_t status, int *count)
     }
 }
 
-int tc_wait_ready(off_t offset)
+/* wait for any of the status bits, giving up after the bus's usual
+ * number of polls */
+int tc_wait_status(off_t offset, uint8_t status)
 {
     int limit = 100000000;
-    return tc_wait(offset, STATUS_READY, &limit);
+    return tc_wait(offset, status, &limit);
+}
+
+int tc_wait_ready(off_t offset)
+{
+    return tc_wait_status(offset, STATUS_READY);
 }
 
 int tc_wait_valid(off_t offset)
 {
-    int limit = 100000000;
-    return tc_wait(offset, STATUS_VALID, &limit);
+    return tc_wait_status(offset, STATUS_VALID);
 }
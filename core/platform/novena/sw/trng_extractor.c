@@ -39,16 +39,27 @@
 #include <unistd.h>
 #include <stdint.h>
 #include <ctype.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <arpa/inet.h>
 
 #include "cryptech.h"
 
 char *usage =
-"%s [-a|r|c] [-n #] [-o file]\n\
+"%s [-a|r|R|c|d] [-n #] [-e #] [-T] [-o file]\n\
 \n\
 -a      avalanche entropy\n\
 -r      rosc entropy\n\
+-R      raw rosc entropy\n\
 -c      csprng (default data source)\n\
--n      number of 4-byte samples (scale with K, M, or G suffix)\n\
+-d      host ChaCha20 DRBG seeded from the csprng\n\
+-n      number of bytes (scale with K, M, G, or T suffix)\n\
+-e      assessed min-entropy per byte for the health tests (default 4.0)\n\
+-T      don't run health tests on entropy sources\n\
 -o      output file (defaults to stdout)\n\
 -v      verbose operation\n\
 ";
@@ -56,17 +67,30 @@ char *usage =
 /* ---------------- startup code ---------------- */
 
 static off_t entropy1_addr_base, entropy2_addr_base, csprng_addr_base;
+static int csprng_burst;
 
 static void init(void)
 {
+    struct core_info *core;
+
     entropy1_addr_base = tc_core_base("extnoise");
     entropy2_addr_base = tc_core_base("rosc ent");
     csprng_addr_base = tc_core_base("csprng");
+
+    /* the burst read window and fill level register appeared in 0.51 */
+    core = tc_core_first("csprng");
+    if (core && strncmp(core->version, CSPRNG_VERSION, 4) >= 0)
+        csprng_burst = 1;
 }
 
 /* ---------------- extract one data sample ---------------- */
-static int extract(off_t status_addr, off_t data_addr, uint32_t *data)
+/* If ack_addr is set it is read after the data to consume the sample,
+ * for registers such as the raw rosc output that do not do so.
+ */
+static int extract(off_t status_addr, off_t data_addr, off_t ack_addr, uint32_t *data)
 {
+    uint32_t ack;
+
     if (tc_wait(status_addr, ENTROPY1_STATUS_VALID, NULL) != 0) {
         fprintf(stderr, "tc_wait failed\n");
         return 1;
@@ -77,67 +101,348 @@ static int extract(off_t status_addr, off_t data_addr, uint32_t *data)
         return 1;
     }
 
+    if (ack_addr != 0 && tc_read(ack_addr, (uint8_t *)&ack, 4) != 0) {
+        fprintf(stderr, "tc_read failed\n");
+        return 1;
+    }
+
     return 0;
 }
 
+/* ---------------- extract a burst of csprng data ---------------- */
+/* Read as many words as the csprng has available (up to max and the
+ * size of the read window) without polling status for every word.
+ * When nothing is available, wait on the valid bit with the usual retry
+ * limit, so that a stopped or missing csprng is an error and not a hang.
+ * Returns the number of words read, or -1 on error.
+ */
+static int extract_burst(off_t status_addr, off_t avail_addr, off_t data_addr,
+                         uint32_t *data, uint64_t max)
+{
+    uint32_t avail;
+
+    if (tc_read(avail_addr, (uint8_t *)&avail, 4) != 0) {
+        fprintf(stderr, "tc_read failed\n");
+        return -1;
+    }
+    avail = ntohl(avail);
+
+    if (avail == 0) {
+        if (tc_wait_status(status_addr, CSPRNG_STATUS_VALID) != 0) {
+            fprintf(stderr, "tc_wait_status failed\n");
+            return -1;
+        }
+        /* valid means there is at least one word */
+        avail = 1;
+    }
+
+    if (avail > CSPRNG_RANDOM_WINDOW)
+        avail = CSPRNG_RANDOM_WINDOW;
+    if (avail > max)
+        avail = max;
+
+    if (tc_read(data_addr, (uint8_t *)data, avail * 4) != 0) {
+        fprintf(stderr, "tc_read failed\n");
+        return -1;
+    }
+
+    return avail;
+}
+
+/* ---------------- ring buffer ---------------- */
+/* The bus reader thread and the output writer share a single-producer,
+ * single-consumer ring. head is only written by the reader and tail only
+ * by the writer, so no locks are needed, just acquire/release ordering
+ * on the two counters. Both counters run freely and are reduced modulo
+ * the ring size when indexing.
+ */
+#define RING_SIZE       (4 * 1024 * 1024)       /* must be a power of 2 */
+#define RING_MASK       (RING_SIZE - 1)
+#define WRITE_CHUNK     (256 * 1024)            /* preferred write() size */
+#define DRBG_CHUNK      (64 * 1024)             /* DRBG request size */
+
+static struct {
+    uint8_t buf[RING_SIZE];
+    uint64_t head;              /* bytes produced by the reader */
+    uint64_t tail;              /* bytes consumed by the writer */
+    int done;                   /* reader has finished */
+    int error;                  /* reader stopped because of an error */
+} ring;
+
+struct source {
+    off_t status_addr;
+    off_t data_addr;
+    off_t ack_addr;
+    int burst;
+    uint64_t num_bytes;
+    struct health_test *health;   /* NULL for the csprng */
+    int drbg;
+};
+
+static inline uint64_t load_acquire(uint64_t *p)
+{
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static inline void store_release(uint64_t *p, uint64_t val)
+{
+    __atomic_store_n(p, val, __ATOMIC_RELEASE);
+}
+
+/* copy len bytes into the ring at position pos, wrapping as needed */
+static void ring_put(uint64_t pos, const uint8_t *data, size_t len)
+{
+    size_t off = pos & RING_MASK;
+    size_t n = RING_SIZE - off;
+
+    if (n > len)
+        n = len;
+    memcpy(ring.buf + off, data, n);
+    memcpy(ring.buf, data + n, len - n);
+}
+
+/* ---------------- bus reader thread ---------------- */
+static void *reader(void *arg)
+{
+    struct source *src = arg;
+    uint32_t data[CSPRNG_RANDOM_WINDOW];
+    uint64_t head = 0;
+    size_t len;
+    int n;
+
+    while (head < src->num_bytes) {
+        /* the DRBG writes straight into the free part of the ring */
+        if (src->drbg) {
+            while ((len = RING_SIZE - (head - load_acquire(&ring.tail))) < DRBG_CHUNK &&
+                   len < src->num_bytes - head)
+                sched_yield();
+            if (len > RING_SIZE - (head & RING_MASK))
+                len = RING_SIZE - (head & RING_MASK);
+            if (len > DRBG_CHUNK)
+                len = DRBG_CHUNK;
+            if (len > src->num_bytes - head)
+                len = src->num_bytes - head;
+            if (drbg_get(ring.buf + (head & RING_MASK), len) != 0)
+                goto errout;
+            head += len;
+            store_release(&ring.head, head);
+            continue;
+        }
+
+        /* wait for room for a full burst */
+        while (head - load_acquire(&ring.tail) > RING_SIZE - sizeof(data))
+            sched_yield();
+
+        if (src->burst) {
+            n = extract_burst(src->status_addr, csprng_addr_base + CSPRNG_ADDR_AVAIL,
+                              src->data_addr, data, (src->num_bytes - head + 3) / 4);
+            if (n < 0)
+                goto errout;
+        }
+        else {
+            if (extract(src->status_addr, src->data_addr, src->ack_addr, data) != 0)
+                goto errout;
+            n = 1;
+        }
+
+        /* Run the continuous health tests on the raw samples before
+         * they go anywhere. On an alarm we stop rather than hand out
+         * data from a source that has failed.
+         */
+        if (src->health && health_check(src->health, (uint8_t *)data, n * 4) != 0) {
+            fprintf(stderr, "\n%s health test failed after %llu samples\n",
+                    (src->health->alarm & HEALTH_ALARM_RCT) ?
+                    "repetition count" : "adaptive proportion",
+                    (unsigned long long)src->health->samples);
+            goto errout;
+        }
+
+        len = n * 4;
+        if (len > src->num_bytes - head)
+            len = src->num_bytes - head;
+        ring_put(head, (uint8_t *)data, len);
+        head += len;
+        store_release(&ring.head, head);
+    }
+
+    __atomic_store_n(&ring.done, 1, __ATOMIC_RELEASE);
+    return NULL;
+
+errout:
+    __atomic_store_n(&ring.error, 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&ring.done, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+/* ---------------- output writer ---------------- */
+static int write_all(int fd, const uint8_t *buf, size_t len)
+{
+    ssize_t n;
+
+    while (len > 0) {
+        n = write(fd, buf, len);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            perror("write");
+            return 1;
+        }
+        buf += n;
+        len -= n;
+    }
+
+    return 0;
+}
+
+/* Drain the ring to the output in large writes. We wait for at least
+ * WRITE_CHUNK bytes unless the reader is done, so that the output side
+ * sees few, big writes even when the bus delivers data in small bursts.
+ */
+static int writer(int fd, uint64_t num_bytes, int verbose)
+{
+    uint64_t tail = 0, head, dots = 0;
+    size_t off, len;
+    int done;
+
+    while (tail < num_bytes) {
+        done = __atomic_load_n(&ring.done, __ATOMIC_ACQUIRE);
+        head = load_acquire(&ring.head);
+
+        if (head == tail) {
+            if (done)
+                break;
+            sched_yield();
+            continue;
+        }
+        if (head - tail < WRITE_CHUNK && !done && head < num_bytes) {
+            sched_yield();
+            continue;
+        }
+
+        off = tail & RING_MASK;
+        len = head - tail;
+        if (len > RING_SIZE - off)
+            len = RING_SIZE - off;
+
+        if (write_all(fd, ring.buf + off, len) != 0)
+            return 1;
+
+        tail += len;
+        store_release(&ring.tail, tail);
+
+        if (verbose) {
+            for (; dots < (tail >> 26); ++dots)
+                fprintf(stderr, ".");
+            fflush(stderr);
+        }
+    }
+
+    return ring.error || (tail < num_bytes);
+}
+
 /* ---------------- main ---------------- */
 int main(int argc, char *argv[])
 {
     int opt;
-    unsigned long num_words = 1, i;
+    uint64_t num_bytes = 4;
     char *endptr;
-    off_t status_addr = 0;
-    off_t data_addr = 0;
-    FILE *output = stdout;
-    uint32_t data;
+    struct source src = { 0, 0, 0, 0, 0, NULL, 0 };
+    struct health_test health;
+    double min_entropy = 4.0;
+    int use_health = 1, noise = 0;
+    int output = STDOUT_FILENO;
     int verbose = 0;
+    pthread_t tid;
+    struct timeval start, stop, difftime;
+    double secs;
+    int ret;
 
     init();
 
     /* parse command line */
-    while ((opt = getopt(argc, argv, "h?varcn:o:")) != -1) {
+    while ((opt = getopt(argc, argv, "h?varRcdn:e:To:")) != -1) {
         switch (opt) {
         case 'h':
         case '?':
             printf(usage, argv[0]);
             return EXIT_SUCCESS;
         case 'a':
-            status_addr = entropy1_addr_base + ENTROPY1_ADDR_STATUS;
-            data_addr = entropy1_addr_base + ENTROPY1_ADDR_ENTROPY;
+            src.status_addr = entropy1_addr_base + ENTROPY1_ADDR_STATUS;
+            src.data_addr = entropy1_addr_base + ENTROPY1_ADDR_ENTROPY;
+            src.ack_addr = 0;
+            src.burst = 0;
+            src.drbg = 0;
+            noise = 1;
             break;
         case 'r':
-            status_addr = entropy2_addr_base + ENTROPY2_ADDR_STATUS;
-            data_addr = entropy2_addr_base + ENTROPY2_ADDR_ENTROPY;
+            src.status_addr = entropy2_addr_base + ENTROPY2_ADDR_STATUS;
+            src.data_addr = entropy2_addr_base + ENTROPY2_ADDR_ENTROPY;
+            src.ack_addr = 0;
+            src.burst = 0;
+            src.drbg = 0;
+            noise = 1;
+            break;
+        case 'R':
+            src.status_addr = entropy2_addr_base + ENTROPY2_ADDR_STATUS;
+            src.data_addr = entropy2_addr_base + ENTROPY2_ADDR_RAW;
+            src.ack_addr = entropy2_addr_base + ENTROPY2_ADDR_ENTROPY;
+            src.burst = 0;
+            src.drbg = 0;
+            noise = 1;
             break;
         case 'c':
-            status_addr = csprng_addr_base + CSPRNG_ADDR_STATUS;
-            data_addr = csprng_addr_base + CSPRNG_ADDR_RANDOM;
+            src.status_addr = csprng_addr_base + CSPRNG_ADDR_STATUS;
+            src.data_addr = csprng_addr_base + CSPRNG_ADDR_RANDOM;
+            src.ack_addr = 0;
+            src.burst = csprng_burst;
+            src.drbg = 0;
+            noise = 0;
+            break;
+        case 'd':
+            src.status_addr = csprng_addr_base + CSPRNG_ADDR_STATUS;
+            src.ack_addr = 0;
+            src.burst = 0;
+            src.drbg = 1;
+            noise = 0;
             break;
         case 'v':
             verbose = 1;
             break;
         case 'n':
-            num_words = strtoul(optarg, &endptr, 10);
+            num_bytes = strtoull(optarg, &endptr, 10);
             switch (toupper(*endptr)) {
             case '\0':
                 break;
             case 'K':
-                num_words *= 1000;
+                num_bytes *= 1000;
                 break;
             case 'M':
-                num_words *= 1000000;
+                num_bytes *= 1000000;
                 break;
             case 'G':
-                num_words *= 1000000000;
+                num_bytes *= 1000000000;
+                break;
+            case 'T':
+                num_bytes *= 1000000000000ULL;
                 break;
             default:
                 fprintf(stderr, "unsupported -n suffix %s\n", endptr);
                 return EXIT_FAILURE;
             }
             break;
+        case 'e':
+            min_entropy = strtod(optarg, &endptr);
+            if (*endptr != '\0' || min_entropy <= 0.0 || min_entropy > 8.0) {
+                fprintf(stderr, "min-entropy must be in (0, 8]\n");
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'T':
+            use_health = 0;
+            break;
         case 'o':
-            output = fopen(optarg, "wb+");
-            if (output == NULL) {
+            output = open(optarg, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (output < 0) {
                 fprintf(stderr, "error opening output file %s: ", optarg);
                 perror("");
                 return EXIT_FAILURE;
@@ -160,26 +465,55 @@ int main(int argc, char *argv[])
         goto errout;
     }
 
-    if (status_addr == 0) {
-	status_addr = csprng_addr_base + CSPRNG_ADDR_STATUS;
-	data_addr = csprng_addr_base + CSPRNG_ADDR_RANDOM;
+    if (src.status_addr == 0) {
+	src.status_addr = csprng_addr_base + CSPRNG_ADDR_STATUS;
+	src.data_addr = csprng_addr_base + CSPRNG_ADDR_RANDOM;
+	src.burst = csprng_burst;
+    }
+    src.num_bytes = num_bytes;
+
+    if (src.drbg && drbg_init(0, 0) != 0)
+        return EXIT_FAILURE;
+
+    /* the csprng output is conditioned, only test the noise sources */
+    if (use_health && noise) {
+        health_init(&health, min_entropy);
+        src.health = &health;
     }
 
+    if (verbose)
+        gettimeofday(&start, NULL);
+
     /* get the data */
-    for (i = 0; i < num_words; ++i) {
-        if (extract(status_addr, data_addr, &data) != 0)
-            return EXIT_FAILURE;
-        if (fwrite(&data, sizeof(data), 1, output) != 1) {
-            perror("fwrite");
-            fclose(output);
-            return EXIT_FAILURE;
+    if (pthread_create(&tid, NULL, reader, &src) != 0) {
+        perror("pthread_create");
+        return EXIT_FAILURE;
+    }
+    ret = writer(output, num_bytes, verbose);
+    if (ret != 0)
+        /* the reader may be blocked on a full ring, don't wait for it */
+        return EXIT_FAILURE;
+    pthread_join(tid, NULL);
+
+    if (verbose) {
+        gettimeofday(&stop, NULL);
+        timersub(&stop, &start, &difftime);
+        secs = difftime.tv_sec + difftime.tv_usec / 1000000.0;
+        fprintf(stderr, "\n%llu bytes in %.3f sec (%.3f MB/s, %s)\n",
+                (unsigned long long)num_bytes, secs,
+                secs > 0 ? num_bytes / secs / 1000000 : 0.0,
+                src.drbg ? "drbg" : src.burst ? "burst reads" : "single word reads");
+        if (src.drbg) {
+            struct drbg_stats st;
+            drbg_stats(&st);
+            fprintf(stderr, "drbg reseeded %llu times from the csprng\n",
+                    (unsigned long long)st.reseeds);
         }
-        if (verbose && ((i & 0xffff) == 0)) {
-	    fprintf(stderr, ".");
-	    fflush(stderr);
-	}
+        if (src.health)
+            fprintf(stderr, "health tests passed (H = %.2f, RCT cutoff %u, APT cutoff %u/%u)\n",
+                    health.h, health.rct_cutoff, health.apt_cutoff, HEALTH_APT_WINDOW);
     }
 
-    fclose(output);
+    close(output);
     return EXIT_SUCCESS;
 }
@@ -46,16 +46,21 @@
 #include <stdint.h>
 #include <ctype.h>
 #include <signal.h>
+#include <math.h>
+#include <arpa/inet.h>
 
 #include "cryptech.h"
 
-char *usage = "Usage: %s [-h] [-d] [-q] [-r] [-w] [-n #] tc...\n";
+char *usage =
+"Usage: %s [-h] [-d] [-q] [-r] [-w] [-n #] tc...\n\
+       %s -b [-n #] [avalanche|rosc|rosc-raw|csprng]...\n";
 
 int debug = 0;
 int quiet = 0;
 int repeat = 0;
-int num_words = 10;
+int num_words = 0;
 int wait_stats = 0;
+int benchmark = 0;
 
 /* ---------------- startup code ---------------- */
 
@@ -326,6 +331,343 @@ int TC7(void)
 }
 
 
+/* ---------------- benchmark mode ---------------- */
+
+/* In benchmark mode (-b) we pull a large capture from each entropy
+ * source, timing every bus transaction, and feed the samples through
+ * streaming versions of the SP 800-90B 6.3 min-entropy estimators. No
+ * capture is kept in memory, so -n can be as large as you have patience
+ * for. Results are written to stdout as a JSON array, one object per
+ * source, so that runs on different bitstreams can be compared.
+ *
+ * The most common value estimate is computed over byte samples. The
+ * collision and Markov estimates are only defined for binary sources,
+ * so they are computed over the bit stream (msb first within a byte).
+ * All estimates are also reported normalized to bits per bit.
+ *
+ * For comparison, in simulation at 50 MHz the rosc core delivers a word
+ * every 8448 cycles (about 5900 words/s), and the csprng up to about
+ * 7.8M words/s at the core; see tb_csprng_rate. The avalanche rate is set
+ * by the noise source and cannot be simulated.
+ */
+
+#define BENCH_DEFAULT_WORDS     (1 << 18)
+
+struct estimator {
+    uint64_t count[256];        /* byte histogram for MCV */
+    uint64_t bytes;
+    uint64_t ones;              /* bit count for Markov */
+    uint64_t trans[2][2];       /* bit transitions for Markov */
+    uint64_t bits;
+    int      first_bit;
+    int      prev_bit;
+    uint64_t coll2, coll3;      /* collision times of 2 and 3 bits */
+    int      coll_len;
+    int      coll_first;
+};
+
+struct bench_source {
+    char     *name;
+    off_t    *base;
+    off_t    status_addr;
+    off_t    data_addr;
+    off_t    ack_addr;          /* read to consume the word, or 0 */
+    int      burst;
+};
+
+static void estimator_init(struct estimator *e)
+{
+    memset(e, 0, sizeof(*e));
+    e->prev_bit = -1;
+}
+
+static void estimator_update(struct estimator *e, const uint8_t *buf, size_t len)
+{
+    size_t i;
+    int j, b;
+
+    for (i = 0; i < len; ++i) {
+        e->count[buf[i]]++;
+        for (j = 7; j >= 0; --j) {
+            b = (buf[i] >> j) & 1;
+
+            /* Markov */
+            if (e->prev_bit < 0)
+                e->first_bit = b;
+            else
+                e->trans[e->prev_bit][b]++;
+            e->prev_bit = b;
+            e->ones += b;
+
+            /* collision: with a binary alphabet the third bit of a
+             * sequence always repeats one of the first two */
+            if (e->coll_len == 0) {
+                e->coll_first = b;
+                e->coll_len = 1;
+            }
+            else if (e->coll_len == 1 && b == e->coll_first) {
+                e->coll2++;
+                e->coll_len = 0;
+            }
+            else if (e->coll_len == 1) {
+                e->coll_len = 2;
+            }
+            else {
+                e->coll3++;
+                e->coll_len = 0;
+            }
+        }
+    }
+    e->bytes += len;
+    e->bits += 8 * len;
+}
+
+/* 6.3.1 most common value estimate, bits per byte */
+static double estimate_mcv(const struct estimator *e)
+{
+    uint64_t max = 0;
+    double p, pu;
+    int i;
+
+    for (i = 0; i < 256; ++i)
+        if (e->count[i] > max)
+            max = e->count[i];
+    if (e->bytes < 2)
+        return 0.0;
+
+    p = (double)max / e->bytes;
+    pu = p + 2.576 * sqrt(p * (1.0 - p) / (e->bytes - 1));
+    if (pu > 1.0)
+        pu = 1.0;
+    /* 0.0 - x rather than -x, so that p = 1 reports 0 and not -0 */
+    return 0.0 - log2(pu);
+}
+
+/* 6.3.2 collision estimate, bits per bit */
+static double estimate_collision(const struct estimator *e)
+{
+    double v = e->coll2 + e->coll3;
+    double mean, sigma, x, p;
+
+    if (v < 2)
+        return 0.0;
+
+    /* the sample variance of a list of 2s and 3s has a closed form */
+    mean = (2.0 * e->coll2 + 3.0 * e->coll3) / v;
+    sigma = sqrt((double)e->coll2 * e->coll3 / (v * (v - 1)));
+    x = mean - 2.576 * sigma / sqrt(v);
+
+    /* E[t] = 2 + 2p(1-p), solve for the larger root p >= 1/2 */
+    if (x >= 2.5)
+        p = 0.5;
+    else if (x <= 2.0)
+        p = 1.0;
+    else
+        p = (1.0 + sqrt(5.0 - 2.0 * x)) / 2.0;
+    return 0.0 - log2(p);
+}
+
+/* 6.3.3 Markov estimate, bits per bit */
+static double estimate_markov(const struct estimator *e)
+{
+    double p0, p1, p00, p01, p10, p11, lp[6], max;
+    uint64_t n0, n1;
+    int i;
+
+    if (e->bits < 2)
+        return 0.0;
+
+    n0 = e->trans[0][0] + e->trans[0][1];
+    n1 = e->trans[1][0] + e->trans[1][1];
+    p1 = (double)e->ones / e->bits;
+    p0 = 1.0 - p1;
+    p00 = n0 ? (double)e->trans[0][0] / n0 : 0.0;
+    p01 = n0 ? (double)e->trans[0][1] / n0 : 0.0;
+    p10 = n1 ? (double)e->trans[1][0] / n1 : 0.0;
+    p11 = n1 ? (double)e->trans[1][1] / n1 : 0.0;
+
+    /* log2 probabilities of the most likely 128-bit sequences */
+    lp[0] = log2(p0) + 127 * log2(p00);
+    lp[1] = log2(p0) + 64 * log2(p01) + 63 * log2(p10);
+    lp[2] = log2(p0) + log2(p01) + 126 * log2(p11);
+    lp[3] = log2(p1) + log2(p10) + 126 * log2(p00);
+    lp[4] = log2(p1) + 64 * log2(p10) + 63 * log2(p01);
+    lp[5] = log2(p1) + 127 * log2(p11);
+
+    max = lp[0];
+    for (i = 1; i < 6; ++i)
+        if (lp[i] > max)
+            max = lp[i];
+
+    max = (0.0 - max) / 128;
+    return (max > 1.0) ? 1.0 : max;
+}
+
+static inline uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/* Read one transaction's worth of words from a source: a single word
+ * after polling status, or a burst from the csprng read window.
+ * Reading the raw rosc register does not consume the word, so valid
+ * would stay set and we would read the same shift register again; the
+ * entropy register is read as well to start the next word.
+ * Returns the number of words read, or -1 on error.
+ */
+static int bench_read(struct bench_source *src, uint32_t *data, int max)
+{
+    uint32_t avail;
+
+    if (!src->burst) {
+        if (tc_wait(src->status_addr, ENTROPY1_STATUS_VALID, NULL) != 0 ||
+            tc_read(src->data_addr, (uint8_t *)data, 4) != 0)
+            return -1;
+        if (src->ack_addr != 0 && tc_read(src->ack_addr, (uint8_t *)&avail, 4) != 0)
+            return -1;
+        return 1;
+    }
+
+    do {
+        if (tc_read(csprng_addr_base + CSPRNG_ADDR_AVAIL, (uint8_t *)&avail, 4) != 0)
+            return -1;
+        avail = ntohl(avail);
+    } while (avail == 0);
+
+    if (avail > max)
+        avail = max;
+    if (tc_read(src->data_addr, (uint8_t *)data, avail * 4) != 0)
+        return -1;
+
+    return avail;
+}
+
+static int bench_source(struct bench_source *src, int words, int first)
+{
+    struct estimator e;
+    uint32_t data[CSPRNG_RANDOM_WINDOW];
+    uint64_t start, t0, t1, lat, lat_min = ~0ULL, lat_max = 0;
+    double secs, mcv, coll, markov;
+    int i, n;
+
+    estimator_init(&e);
+
+    start = now_ns();
+    for (i = 0; i < words; i += n) {
+        t0 = now_ns();
+        n = bench_read(src, data, (words - i < CSPRNG_RANDOM_WINDOW) ?
+                       words - i : CSPRNG_RANDOM_WINDOW);
+        t1 = now_ns();
+        if (n < 0) {
+            fprintf(stderr, "%s: bus error after %d words\n", src->name, i);
+            return 1;
+        }
+
+        lat = (t1 - t0) / n;
+        if (lat < lat_min)
+            lat_min = lat;
+        if (lat > lat_max)
+            lat_max = lat;
+
+        estimator_update(&e, (uint8_t *)data, n * 4);
+    }
+    secs = (now_ns() - start) / 1e9;
+
+    mcv = estimate_mcv(&e);
+    coll = estimate_collision(&e);
+    markov = estimate_markov(&e);
+
+    printf("%s  {\n", first ? "" : ",\n");
+    printf("    \"source\": \"%s\",\n", src->name);
+    printf("    \"reads\": \"%s\",\n", src->burst ? "burst" : "single");
+    printf("    \"words\": %d,\n", words);
+    printf("    \"seconds\": %.6f,\n", secs);
+    printf("    \"words_per_sec\": %.1f,\n", secs > 0 ? words / secs : 0.0);
+    printf("    \"latency_ns\": { \"mean\": %.1f, \"min\": %llu, \"max\": %llu },\n",
+           secs * 1e9 / words, (unsigned long long)lat_min, (unsigned long long)lat_max);
+    printf("    \"min_entropy\": {\n");
+    printf("      \"mcv_per_byte\": %.6f,\n", mcv);
+    printf("      \"mcv_per_bit\": %.6f,\n", mcv / 8);
+    printf("      \"collision_per_bit\": %.6f,\n", coll);
+    printf("      \"markov_per_bit\": %.6f,\n", markov);
+    printf("      \"min_per_bit\": %.6f\n",
+           fmin(mcv / 8, fmin(coll, markov)));
+    printf("    }\n");
+    printf("  }");
+    fflush(stdout);
+
+    return 0;
+}
+
+static int bench(int argc, char *argv[], int words)
+{
+    struct bench_source sources[] = {
+        { "avalanche", &entropy1_addr_base,
+          ENTROPY1_ADDR_STATUS, ENTROPY1_ADDR_ENTROPY, 0, 0 },
+        { "rosc", &entropy2_addr_base,
+          ENTROPY2_ADDR_STATUS, ENTROPY2_ADDR_ENTROPY, 0, 0 },
+        { "rosc-raw", &entropy2_addr_base,
+          ENTROPY2_ADDR_STATUS, ENTROPY2_ADDR_RAW, ENTROPY2_ADDR_ENTROPY, 0 },
+        { "csprng", &csprng_addr_base,
+          CSPRNG_ADDR_STATUS, CSPRNG_ADDR_RANDOM, 0, 0 },
+    };
+    int nsources = sizeof(sources)/sizeof(sources[0]);
+    struct bench_source *src;
+    struct core_info *core;
+    int i, j, first = 1;
+
+    if (init() != 0)
+        return 1;
+
+    /* the burst read window appeared in csprng 0.51 */
+    core = tc_core_first("csprng");
+    if (core && strncmp(core->version, CSPRNG_VERSION, 4) >= 0)
+        sources[3].burst = 1;
+
+    for (i = 0; i < argc; ++i) {
+        for (j = 0; j < nsources; ++j)
+            if (strcmp(argv[i], sources[j].name) == 0)
+                break;
+        if (j == nsources) {
+            fprintf(stderr, "unknown source %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    printf("[\n");
+    for (j = 0; j < nsources; ++j) {
+        src = &sources[j];
+
+        /* no names == all sources present in the bitstream */
+        if (argc > 0) {
+            for (i = 0; i < argc; ++i)
+                if (strcmp(argv[i], src->name) == 0)
+                    break;
+            if (i == argc)
+                continue;
+        }
+        if (*src->base == 0) {
+            fprintf(stderr, "%s: core not present\n", src->name);
+            continue;
+        }
+
+        src->status_addr += *src->base;
+        src->data_addr += *src->base;
+        if (src->ack_addr != 0)
+            src->ack_addr += *src->base;
+        if (bench_source(src, words, first) != 0)
+            return 1;
+        first = 0;
+    }
+    printf("\n]\n");
+
+    return 0;
+}
+
+
 /* ---------------- main ---------------- */
 
 /* signal handler for ctrl-c to end repeat testing */
@@ -349,11 +691,11 @@ int main(int argc, char *argv[])
     tcfp all_tests[] = { TC0, TC1, TC2, TC3, TC4, TC5, TC6, TC7 };
     int i, j, opt;
 
-    while ((opt = getopt(argc, argv, "h?dqrn:w")) != -1) {
+    while ((opt = getopt(argc, argv, "h?dqrn:wb")) != -1) {
         switch (opt) {
         case 'h':
         case '?':
-            printf(usage, argv[0]);
+            printf(usage, argv[0], argv[0]);
             return EXIT_SUCCESS;
         case 'd':
             tc_set_debug(1);
@@ -375,12 +717,24 @@ int main(int argc, char *argv[])
         case 'w':
             wait_stats = 1;
             break;
+        case 'b':
+            benchmark = 1;
+            break;
         default:
-            fprintf(stderr, usage, argv[0]);
+            fprintf(stderr, usage, argv[0], argv[0]);
             return EXIT_FAILURE;
         }
     }
 
+    if (num_words == 0)
+        num_words = benchmark ? BENCH_DEFAULT_WORDS : 10;
+
+    /* benchmark named sources (or all of them) and report JSON */
+    if (benchmark) {
+        return bench(argc - optind, argv + optind, num_words) ?
+            EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
     /* repeat one test until interrupted */
     if (repeat) {
         tcfp tc;
@@ -229,8 +229,6 @@ module trng(
                         .test_mode(test_mode_reg),
                         .security_error(mixer_security_error),
 
-                        .more_seed(csprng_more_seed),
-
                         .entropy0_enabled(entropy0_entropy_enabled),
                         .entropy0_syn(entropy0_entropy_syn),
                         .entropy0_data(entropy0_entropy_data),
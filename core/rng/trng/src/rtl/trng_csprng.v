@@ -77,11 +77,18 @@ module trng_csprng(
   localparam ADDR_STATUS           = 8'h09;
   localparam STATUS_RND_VALID_BIT  = 1;
 
+  localparam ADDR_RND_AVAIL        = 8'h12;
+
   localparam ADDR_STAT_BLOCKS_LOW  = 8'h14;
   localparam ADDR_STAT_BLOCKS_HIGH = 8'h15;
   localparam ADDR_STAT_RESEEDS     = 8'h16;
 
+  // Random data read window. Every read in the window returns the
+  // next 32-bit word from the FIFO, allowing the host to do burst
+  // reads of up to ADDR_RND_AVAIL words without polling status.
+  // Consecutive reads must be at least three cycles apart.
   localparam ADDR_RND_DATA         = 8'h20;
+  localparam ADDR_RND_DATA_LAST    = 8'h3f;
 
   localparam ADDR_NUM_ROUNDS       = 8'h40;
   localparam ADDR_NUM_BLOCKS_LOW   = 8'h41;
@@ -123,7 +130,7 @@ module trng_csprng(
 
   parameter CORE_NAME0     = 32'h63737072; // "cspr"
   parameter CORE_NAME1     = 32'h6e672020; // "ng  "
-  parameter CORE_VERSION   = 32'h302e3530; // "0.50"
+  parameter CORE_VERSION   = 32'h302e3531; // "0.51"
 
 
   //----------------------------------------------------------------
@@ -215,6 +222,7 @@ module trng_csprng(
   reg            fifo_cipher_data_valid;
 
   wire           muxed_rnd_ack;
+  wire [6 : 0]   rnd_words;
 
   reg [31 : 0]  tmp_read_data;
 
@@ -266,7 +274,9 @@ module trng_csprng(
 
                              .rnd_syn(rnd_syn),
                              .rnd_data(rnd_data),
-                             .rnd_ack(muxed_rnd_ack)
+                             .rnd_ack(muxed_rnd_ack),
+
+                             .rnd_words(rnd_words)
                             );
 
 
@@ -411,6 +421,16 @@ module trng_csprng(
               endcase // case (address)
             end // if (we)
 
+          else if ((address >= ADDR_RND_DATA) && (address <= ADDR_RND_DATA_LAST))
+            begin
+              // Reads in the random data window. Words are only
+              // consumed when the FIFO has data, reading an empty
+              // FIFO is signalled as an error.
+              tmp_read_data = rnd_data;
+              rnd_ack       = rnd_syn;
+              tmp_error     = !rnd_syn;
+            end
+
           else
             begin
               // Read operations.
@@ -440,11 +460,8 @@ module trng_csprng(
                 ADDR_STAT_RESEEDS:
                     tmp_read_data = reseed_stat_ctr_reg;
 
-                ADDR_RND_DATA:
-                  begin
-                    tmp_read_data = rnd_data;
-                    rnd_ack       = 1;
-                  end
+                ADDR_RND_AVAIL:
+                    tmp_read_data = {25'h0000000, rnd_words};
 
                 ADDR_NUM_ROUNDS:
                     tmp_read_data = {27'h0000000, num_rounds_reg};
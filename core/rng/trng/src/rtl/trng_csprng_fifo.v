@@ -49,7 +49,9 @@ module trng_csprng_fifo(
 
                         output wire          rnd_syn,
                         output wire [31 : 0] rnd_data,
-                        input wire           rnd_ack
+                        input wire           rnd_ack,
+
+                        output wire [6 : 0]  rnd_words
                        );
 
 
@@ -103,8 +105,6 @@ module trng_csprng_fifo(
   reg                            fifo_empty;
   reg                            fifo_full;
 
-  reg [31 : 0] rnd_data_reg;
-
   reg          rnd_syn_reg;
   reg          rnd_syn_new;
   reg          rnd_syn_we;
@@ -126,14 +126,16 @@ module trng_csprng_fifo(
   // Wires.
   //----------------------------------------------------------------
   reg [31 : 0] muxed_data;
+  reg [6 : 0]  tmp_rnd_words;
 
 
   //----------------------------------------------------------------
   // Concurrent connectivity for ports etc.
   //----------------------------------------------------------------
-  assign rnd_data  = rnd_data_reg;
+  assign rnd_data  = muxed_data;
   assign rnd_syn   = rnd_syn_reg;
   assign more_data = more_data_reg;
+  assign rnd_words = tmp_rnd_words;
 
 
   //----------------------------------------------------------------
@@ -154,7 +156,6 @@ module trng_csprng_fifo(
           rd_ptr_reg       <= {(FIFO_ADDR_BITS){1'h0}};
           wr_ptr_reg       <= {(FIFO_ADDR_BITS){1'h0}};
           fifo_ctr_reg     <= {FIFO_ADDR_BITS{1'h0}};
-          rnd_data_reg     <= 32'h0;
           rnd_syn_reg      <= 1'h0;
           more_data_reg    <= 1'h0;
           wr_ctrl_reg      <= WR_IDLE;
@@ -162,8 +163,6 @@ module trng_csprng_fifo(
         end
       else
         begin
-          rnd_data_reg <= muxed_data;
-
           if (more_data_we)
             more_data_reg <= more_data_new;
 
@@ -303,6 +302,10 @@ module trng_csprng_fifo(
       fifo_empty    = 0;
       fifo_full     = 0;
 
+      // Number of 32-bit words available to consumers. The element
+      // currently being read has mux_data_ptr_reg words already used.
+      tmp_rnd_words = {fifo_ctr_reg, 4'h0} - {3'h0, mux_data_ptr_reg};
+
       if (fifo_ctr_reg == 0)
         begin
           fifo_empty = 1;
@@ -319,13 +322,15 @@ module trng_csprng_fifo(
           fifo_ctr_we = 1;
         end
 
-      if (fifo_ctr_inc)
+      // A write and a read of an element in the same cycle
+      // leave the counter unchanged.
+      if (fifo_ctr_inc && !fifo_ctr_dec)
         begin
           fifo_ctr_new = fifo_ctr_reg + 1'b1;
           fifo_ctr_we  = 1;
         end
 
-      if (fifo_ctr_dec)
+      if (fifo_ctr_dec && !fifo_ctr_inc)
         begin
           fifo_ctr_new = fifo_ctr_reg - 1'b1;
           fifo_ctr_we  = 1;
@@ -378,21 +383,28 @@ module trng_csprng_fifo(
               end
             else
               begin
+                // Stay in RD_ACK with syn kept high as long as there
+                // are words left, so that consecutive reads in the
+                // burst window can consume one word per cycle.
                 if (rnd_ack)
                   begin
                     if (mux_data_ptr_reg == 4'hf)
                       begin
                         rd_ptr_inc       = 1;
                         mux_data_ptr_rst = 1;
+
+                        if (fifo_ctr_reg == 1)
+                          begin
+                            rnd_syn_new = 0;
+                            rnd_syn_we  = 1;
+                            rd_ctrl_new = RD_IDLE;
+                            rd_ctrl_we  = 1;
+                          end
                       end
                     else
                       begin
                         mux_data_ptr_inc = 1;
                       end
-                    rnd_syn_new  = 0;
-                    rnd_syn_we   = 1;
-                    rd_ctrl_new  = RD_IDLE;
-                    rd_ctrl_we   = 1;
                   end
               end
           end
@@ -455,10 +467,15 @@ module trng_csprng_fifo(
           begin
             if (csprng_data_valid)
               begin
-                fifo_mem_we = 1;
-                wr_ptr_inc  = 1;
-                wr_ctrl_new = WR_NEXT;
-                wr_ctrl_we  = 1;
+                // Drop the request in the same cycle so that the
+                // csprng does not start on a block the fifo has no
+                // room for.
+                fifo_mem_we   = 1;
+                wr_ptr_inc    = 1;
+                more_data_new = 1'b0;
+                more_data_we  = 1'b1;
+                wr_ctrl_new   = WR_NEXT;
+                wr_ctrl_we    = 1;
               end
           end
 
@@ -4,6 +4,21 @@
 // ------------
 // Mixer for the TRNG.
 //
+// Entropy is collected from all enabled sources in parallel. Each
+// source has a one word staging register that is filled (and the
+// source acked) as soon as the source has data, independently of
+// the other sources. The staged words are moved into the 1024 bit
+// block that is hashed with SHA-512 to form a seed taking one word
+// from each enabled source in turn, so every block mixes the sources
+// evenly whatever their rates. A source that has nothing staged
+// within the entropy timeout loses its turn.
+//
+// The mixer works ahead of the csprng: as soon as a seed has been
+// generated it starts on the next one, and it holds one finished seed
+// in a seed register plus the next one in the hash state. A reseed,
+// which takes two seeds, is therefore normally served without waiting
+// for entropy collection.
+//
 //
 // Author: Joachim Strombergson
 // Copyright (c) 2014, NORDUnet A/S
@@ -52,8 +67,6 @@ module trng_mixer(
                   input wire            test_mode,
                   output wire           security_error,
 
-                  input wire            more_seed,
-
                   input wire            entropy0_enabled,
                   input wire            entropy0_syn,
                   input wire [31 : 0]   entropy0_data,
@@ -83,22 +96,15 @@ module trng_mixer(
   //----------------------------------------------------------------
   localparam MODE_SHA_512 = 2'h3;
 
-  localparam ENTROPY_IDLE     = 4'h0;
-  localparam ENTROPY_SRC0     = 4'h1;
-  localparam ENTROPY_SRC0_ACK = 4'h2;
-  localparam ENTROPY_SRC1     = 4'h3;
-  localparam ENTROPY_SRC1_ACK = 4'h4;
-  localparam ENTROPY_SRC2     = 4'h5;
-  localparam ENTROPY_SRC2_ACK = 4'h6;
-  localparam TEST_ENTROPY     = 4'he;
-  localparam TEST_ENTROPY_ACK = 4'hf;
+  // Number of cycles after an ack before a source is sampled again,
+  // giving the source time to drop its syn.
+  localparam ACK_HOLDOFF  = 2'h3;
 
   localparam CTRL_IDLE    = 4'h0;
   localparam CTRL_COLLECT = 4'h1;
   localparam CTRL_MIX     = 4'h2;
-  localparam CTRL_SYN     = 4'h3;
-  localparam CTRL_ACK     = 4'h4;
-  localparam CTRL_NEXT    = 4'h5;
+  localparam CTRL_HASH    = 4'h3;
+  localparam CTRL_SEED    = 4'h4;
 
   localparam ADDR_NAME0            = 8'h00;
   localparam ADDR_NAME1            = 8'h01;
@@ -114,7 +120,7 @@ module trng_mixer(
 
   parameter CORE_NAME0     = 32'h726e676d; // "rngm"
   parameter CORE_NAME1     = 32'h69786572; // "ixer"
-  parameter CORE_VERSION   = 32'h302e3530; // "0.50"
+  parameter CORE_VERSION   = 32'h302e3531; // "0.51"
 
 
   //----------------------------------------------------------------
@@ -191,9 +197,51 @@ module trng_mixer(
   reg         word_ctr_rst;
   reg         word_ctr_we;
 
-  reg [3 : 0] entropy_collect_ctrl_reg;
-  reg [3 : 0] entropy_collect_ctrl_new;
-  reg         entropy_collect_ctrl_we;
+  reg [31 : 0] src0_data_reg;
+  reg          src0_data_we;
+  reg          src0_valid_reg;
+  reg          src0_valid_new;
+  reg          src0_valid_we;
+  reg          src0_ack_reg;
+  reg          src0_ack_new;
+  reg [1 : 0]  src0_holdoff_reg;
+  reg [1 : 0]  src0_holdoff_new;
+  reg          src0_holdoff_we;
+
+  reg [31 : 0] src1_data_reg;
+  reg          src1_data_we;
+  reg          src1_valid_reg;
+  reg          src1_valid_new;
+  reg          src1_valid_we;
+  reg          src1_ack_reg;
+  reg          src1_ack_new;
+  reg [1 : 0]  src1_holdoff_reg;
+  reg [1 : 0]  src1_holdoff_new;
+  reg          src1_holdoff_we;
+
+  reg [31 : 0] src2_data_reg;
+  reg          src2_data_we;
+  reg          src2_valid_reg;
+  reg          src2_valid_new;
+  reg          src2_valid_we;
+  reg          src2_ack_reg;
+  reg          src2_ack_new;
+  reg [1 : 0]  src2_holdoff_reg;
+  reg [1 : 0]  src2_holdoff_new;
+  reg          src2_holdoff_we;
+
+  reg [1 : 0]  rr_ptr_reg;
+  reg [1 : 0]  rr_ptr_new;
+  reg          rr_ptr_rst;
+  reg          rr_ptr_inc;
+  reg          rr_ptr_we;
+
+  reg          block_full_reg;
+  reg          block_full_new;
+  reg          block_full_we;
+
+  reg [511 : 0] seed_reg;
+  reg           seed_we;
 
   reg [23 : 0] entropy_timeout_ctr_reg;
   reg [23 : 0] entropy_timeout_ctr_new;
@@ -230,9 +278,16 @@ module trng_mixer(
   // Wires.
   //----------------------------------------------------------------
   reg [31 : 0]    muxed_entropy;
-  reg             collect_block;
   reg             update_block;
   reg             block_done;
+  reg             block_rst;
+
+  reg             turn_enabled;
+  reg             turn_valid;
+
+  reg             src0_take;
+  reg             src1_take;
+  reg             src2_take;
 
   reg             hash_init;
   reg             hash_next;
@@ -246,10 +301,6 @@ module trng_mixer(
   wire [511 : 0]  hash_digest;
   wire            hash_digest_valid;
 
-  reg             tmp_entropy0_ack;
-  reg             tmp_entropy1_ack;
-  reg             tmp_entropy2_ack;
-
   reg             tmp_error;
 
   reg [31 : 0] tmp_read_data;
@@ -263,7 +314,7 @@ module trng_mixer(
   assign security_error = 0;
 
   assign seed_syn  = seed_syn_reg;
-  assign seed_data = hash_digest;
+  assign seed_data = seed_reg;
 
   assign hash_block = {block00_reg, block01_reg, block02_reg, block03_reg,
                        block04_reg, block05_reg, block06_reg, block07_reg,
@@ -279,9 +330,9 @@ module trng_mixer(
   assign hash_work_factor     = 0;
   assign hash_work_factor_num = 32'h00000000;
 
-  assign entropy0_ack = tmp_entropy0_ack;
-  assign entropy1_ack = tmp_entropy1_ack;
-  assign entropy2_ack = tmp_entropy2_ack;
+  assign entropy0_ack = src0_ack_reg;
+  assign entropy1_ack = src1_ack_reg;
+  assign entropy2_ack = src2_ack_reg;
 
   assign debug = 8'h55;
 
@@ -351,6 +402,21 @@ module trng_mixer(
           block29_reg              <= 32'h0;
           block30_reg              <= 32'h0;
           block31_reg              <= 32'h0;
+          src0_data_reg            <= 32'h0;
+          src0_valid_reg           <= 1'h0;
+          src0_ack_reg             <= 1'h0;
+          src0_holdoff_reg         <= 2'h0;
+          src1_data_reg            <= 32'h0;
+          src1_valid_reg           <= 1'h0;
+          src1_ack_reg             <= 1'h0;
+          src1_holdoff_reg         <= 2'h0;
+          src2_data_reg            <= 32'h0;
+          src2_valid_reg           <= 1'h0;
+          src2_ack_reg             <= 1'h0;
+          src2_holdoff_reg         <= 2'h0;
+          rr_ptr_reg               <= 2'h0;
+          block_full_reg           <= 1'h0;
+          seed_reg                 <= {16{32'h0}};
           init_done_reg            <= 1'h0;
           word_ctr_reg             <= 5'h0;
           seed_syn_reg             <= 1'h0;
@@ -358,12 +424,50 @@ module trng_mixer(
           restart_reg              <= 1'h0;
           entropy_timeout_reg      <= DEFAULT_ENTROPY_TIMEOUT;
           entropy_timeout_ctr_reg  <= 24'h0;
-          entropy_collect_ctrl_reg <= CTRL_IDLE;
           mixer_ctrl_reg           <= CTRL_IDLE;
         end
       else
         begin
-          restart_reg <= restart_new;
+          restart_reg  <= restart_new;
+          src0_ack_reg <= src0_ack_new;
+          src1_ack_reg <= src1_ack_new;
+          src2_ack_reg <= src2_ack_new;
+
+          if (src0_data_we)
+            src0_data_reg <= entropy0_data;
+
+          if (src0_valid_we)
+            src0_valid_reg <= src0_valid_new;
+
+          if (src0_holdoff_we)
+            src0_holdoff_reg <= src0_holdoff_new;
+
+          if (src1_data_we)
+            src1_data_reg <= entropy1_data;
+
+          if (src1_valid_we)
+            src1_valid_reg <= src1_valid_new;
+
+          if (src1_holdoff_we)
+            src1_holdoff_reg <= src1_holdoff_new;
+
+          if (src2_data_we)
+            src2_data_reg <= entropy2_data;
+
+          if (src2_valid_we)
+            src2_valid_reg <= src2_valid_new;
+
+          if (src2_holdoff_we)
+            src2_holdoff_reg <= src2_holdoff_new;
+
+          if (rr_ptr_we)
+            rr_ptr_reg <= rr_ptr_new;
+
+          if (block_full_we)
+            block_full_reg <= block_full_new;
+
+          if (seed_we)
+            seed_reg <= hash_digest;
 
           if (block00_we)
             block00_reg <= muxed_entropy;
@@ -470,9 +574,6 @@ module trng_mixer(
           if (seed_syn_we)
             seed_syn_reg <= seed_syn_new;
 
-          if (entropy_collect_ctrl_we)
-            entropy_collect_ctrl_reg <= entropy_collect_ctrl_new;
-
           if (enable_we)
             enable_reg <= enable_new;
 
@@ -568,238 +669,293 @@ module trng_mixer(
 
 
   //----------------------------------------------------------------
-  // entropy_collect_ctrl
+  // entropy_staging
   //
-  // This FSM implements a round-robin mux for signals from the
-  // entropy sources and updates the block until a block has
-  // been filled.
+  // Each source has its own staging register. A source is sampled
+  // and acked as soon as it has data and its staging register is
+  // empty, independently of the other sources, so all sources are
+  // collected from in parallel. After an ack the source is left
+  // alone for ACK_HOLDOFF cycles so that it has dropped syn before
+  // we look at it again.
   //----------------------------------------------------------------
   always @*
-    begin : entropy_mux
-      tmp_entropy0_ack         = 0;
-      tmp_entropy1_ack         = 0;
-      tmp_entropy2_ack         = 0;
-      word_ctr_inc             = 0;
-      word_ctr_rst             = 0;
-      update_block             = 0;
-      block_done               = 0;
-      muxed_entropy            = 32'h00000000;
-      entropy_timeout_ctr_inc  = 0;
-      entropy_timeout_ctr_rst  = 0;
-      entropy_collect_ctrl_new = ENTROPY_IDLE;
-      entropy_collect_ctrl_we  = 0;
-
-      case (entropy_collect_ctrl_reg)
-        ENTROPY_IDLE:
-          begin
-            if (collect_block)
-              begin
-                word_ctr_rst             = 1;
-                entropy_timeout_ctr_rst  = 1;
-                entropy_collect_ctrl_new = ENTROPY_SRC0;
-                entropy_collect_ctrl_we  = 1;
-              end
-          end
+    begin : entropy_staging
+      src0_data_we     = 0;
+      src0_valid_new   = 0;
+      src0_valid_we    = 0;
+      src0_ack_new     = 0;
+      src0_holdoff_new = 2'h0;
+      src0_holdoff_we  = 0;
+
+      src1_data_we     = 0;
+      src1_valid_new   = 0;
+      src1_valid_we    = 0;
+      src1_ack_new     = 0;
+      src1_holdoff_new = 2'h0;
+      src1_holdoff_we  = 0;
+
+      src2_data_we     = 0;
+      src2_valid_new   = 0;
+      src2_valid_we    = 0;
+      src2_ack_new     = 0;
+      src2_holdoff_new = 2'h0;
+      src2_holdoff_we  = 0;
+
+      if (src0_holdoff_reg != 2'h0)
+        begin
+          src0_holdoff_new = src0_holdoff_reg - 1'b1;
+          src0_holdoff_we  = 1;
+        end
 
-        ENTROPY_SRC0:
-          begin
-            if (!enable_reg)
-              begin
-                word_ctr_rst             = 1;
-                entropy_collect_ctrl_new = ENTROPY_IDLE;
-                entropy_collect_ctrl_we  = 1;
-              end
-            else
-              begin
-                if (entropy0_enabled)
-                  begin
-                    if (entropy0_syn)
-                      begin
-                        muxed_entropy            = entropy0_data;
-                        update_block             = 1;
-                        entropy_collect_ctrl_new = ENTROPY_SRC0_ACK;
-                        entropy_collect_ctrl_we  = 1;
-                      end
-                    else
-                      if (entropy_timeout)
-                        begin
-                          entropy_timeout_ctr_rst  = 1;
-                          entropy_collect_ctrl_new = ENTROPY_SRC1;
-                          entropy_collect_ctrl_we  = 1;
-                        end
-                      else
-                        begin
-                          entropy_timeout_ctr_inc = 1;
-                        end
-                  end
-                else
-                  begin
-                    entropy_timeout_ctr_rst  = 1;
-                    entropy_collect_ctrl_new = ENTROPY_SRC1;
-                    entropy_collect_ctrl_we  = 1;
-                  end
-              end
-          end
+      if (src1_holdoff_reg != 2'h0)
+        begin
+          src1_holdoff_new = src1_holdoff_reg - 1'b1;
+          src1_holdoff_we  = 1;
+        end
 
-        ENTROPY_SRC0_ACK:
-          begin
-            tmp_entropy0_ack = 1;
-            if (!enable_reg)
-              begin
-                word_ctr_rst             = 1;
-                entropy_collect_ctrl_new = ENTROPY_IDLE;
-                entropy_collect_ctrl_we  = 1;
-              end
-            else
-              begin
-                if (word_ctr_reg == 5'h1f)
-                  begin
-                    block_done               = 1;
-                    entropy_collect_ctrl_new = ENTROPY_IDLE;
-                    entropy_collect_ctrl_we  = 1;
-                  end
-                else
-                  begin
-                    word_ctr_inc             = 1;
-                    entropy_collect_ctrl_new = ENTROPY_SRC1;
-                    entropy_collect_ctrl_we  = 1;
-                  end
-              end
-          end
+      if (src2_holdoff_reg != 2'h0)
+        begin
+          src2_holdoff_new = src2_holdoff_reg - 1'b1;
+          src2_holdoff_we  = 1;
+        end
 
+      if (discard)
+        begin
+          src0_valid_new = 0;
+          src0_valid_we  = 1;
+          src1_valid_new = 0;
+          src1_valid_we  = 1;
+          src2_valid_new = 0;
+          src2_valid_we  = 1;
+        end
+      else
+        begin
+          if (src0_take)
+            begin
+              src0_valid_new = 0;
+              src0_valid_we  = 1;
+            end
+          else if (enable_reg && entropy0_enabled && entropy0_syn &&
+                   !src0_valid_reg && (src0_holdoff_reg == 2'h0))
+            begin
+              src0_data_we     = 1;
+              src0_valid_new   = 1;
+              src0_valid_we    = 1;
+              src0_ack_new     = 1;
+              src0_holdoff_new = ACK_HOLDOFF;
+              src0_holdoff_we  = 1;
+            end
 
-        ENTROPY_SRC1:
-          begin
-            if (!enable_reg)
-              begin
-                word_ctr_rst             = 1;
-                entropy_collect_ctrl_new = ENTROPY_IDLE;
-                entropy_collect_ctrl_we  = 1;
-              end
-            else
-              begin
-                if (entropy1_enabled)
-                  begin
-                    if (entropy1_syn)
-                      begin
-                        muxed_entropy            = entropy1_data;
-                        update_block             = 1;
-                        entropy_collect_ctrl_new = ENTROPY_SRC1_ACK;
-                        entropy_collect_ctrl_we  = 1;
-                      end
-                    else
-                      if (entropy_timeout)
-                        begin
-                          entropy_timeout_ctr_rst  = 1;
-                          entropy_collect_ctrl_new = ENTROPY_SRC2;
-                          entropy_collect_ctrl_we  = 1;
-                        end
-                      else
-                        begin
-                          entropy_timeout_ctr_inc = 1;
-                        end
-                  end
-                else
-                  begin
-                    entropy_collect_ctrl_new = ENTROPY_SRC2;
-                    entropy_collect_ctrl_we  = 1;
-                  end
-              end
-          end
+          if (src1_take)
+            begin
+              src1_valid_new = 0;
+              src1_valid_we  = 1;
+            end
+          else if (enable_reg && entropy1_enabled && entropy1_syn &&
+                   !src1_valid_reg && (src1_holdoff_reg == 2'h0))
+            begin
+              src1_data_we     = 1;
+              src1_valid_new   = 1;
+              src1_valid_we    = 1;
+              src1_ack_new     = 1;
+              src1_holdoff_new = ACK_HOLDOFF;
+              src1_holdoff_we  = 1;
+            end
 
-        ENTROPY_SRC1_ACK:
+          if (src2_take)
+            begin
+              src2_valid_new = 0;
+              src2_valid_we  = 1;
+            end
+          else if (enable_reg && entropy2_enabled && entropy2_syn &&
+                   !src2_valid_reg && (src2_holdoff_reg == 2'h0))
+            begin
+              src2_data_we     = 1;
+              src2_valid_new   = 1;
+              src2_valid_we    = 1;
+              src2_ack_new     = 1;
+              src2_holdoff_new = ACK_HOLDOFF;
+              src2_holdoff_we  = 1;
+            end
+        end
+    end // entropy_staging
+
+
+  //----------------------------------------------------------------
+  // block_fill
+  //
+  // Moves staged words into the block one source at a time, in the
+  // order 0, 1, 2, so that each block has the same share from every
+  // enabled source however fast or slow they are. A disabled source is
+  // skipped at once. An enabled source whose word is not staged is
+  // waited on for at most entropy_timeout_reg cycles, after which it
+  // loses its turn, so one stalled source cannot stop seeding. The
+  // other sources keep their staging registers full meanwhile.
+  //----------------------------------------------------------------
+  always @*
+    begin : block_fill
+      src0_take               = 0;
+      src1_take               = 0;
+      src2_take               = 0;
+      update_block            = 0;
+      block_done              = 0;
+      word_ctr_inc            = 0;
+      word_ctr_rst            = 0;
+      muxed_entropy           = 32'h00000000;
+      rr_ptr_rst              = 0;
+      rr_ptr_inc              = 0;
+      entropy_timeout_ctr_inc = 0;
+      entropy_timeout_ctr_rst = 0;
+      turn_enabled            = 0;
+      turn_valid              = 0;
+
+      case (rr_ptr_reg)
+        2'h1:
           begin
-            tmp_entropy1_ack = 1;
-            if (!enable_reg)
-              begin
-                word_ctr_rst             = 1;
-                entropy_collect_ctrl_new = ENTROPY_IDLE;
-                entropy_collect_ctrl_we  = 1;
-              end
-            else
-              begin
-                if (word_ctr_reg == 5'h1f)
-                  begin
-                    block_done               = 1;
-                    entropy_collect_ctrl_new = ENTROPY_IDLE;
-                    entropy_collect_ctrl_we  = 1;
-                  end
-                else
-                  begin
-                    word_ctr_inc             = 1;
-                    entropy_collect_ctrl_new = ENTROPY_SRC2;
-                    entropy_collect_ctrl_we  = 1;
-                  end
-              end
+            turn_enabled  = entropy1_enabled;
+            turn_valid    = src1_valid_reg;
+            muxed_entropy = src1_data_reg;
           end
 
-        ENTROPY_SRC2:
+        2'h2:
           begin
-            if (!enable_reg)
-              begin
-                word_ctr_rst             = 1;
-                entropy_collect_ctrl_new = ENTROPY_IDLE;
-                entropy_collect_ctrl_we  = 1;
-              end
-            else
-              begin
-                if (entropy2_enabled)
-                  begin
-                    if (entropy2_syn)
-                      begin
-                        muxed_entropy            = entropy2_data;
-                        update_block             = 1;
-                        entropy_collect_ctrl_new = ENTROPY_SRC2_ACK;
-                        entropy_collect_ctrl_we  = 1;
-                      end
-                    else
-                      if (entropy_timeout)
-                        begin
-                          entropy_timeout_ctr_rst  = 1;
-                          entropy_collect_ctrl_new = ENTROPY_SRC0;
-                          entropy_collect_ctrl_we  = 1;
-                        end
-                      else
-                        begin
-                          entropy_timeout_ctr_inc = 1;
-                        end
-                  end
-                else
-                  begin
-                    entropy_collect_ctrl_new = ENTROPY_SRC0;
-                    entropy_collect_ctrl_we  = 1;
-                  end
-              end
+            turn_enabled  = entropy2_enabled;
+            turn_valid    = src2_valid_reg;
+            muxed_entropy = src2_data_reg;
           end
 
-        ENTROPY_SRC2_ACK:
+        default:
           begin
-            tmp_entropy2_ack = 1;
-            if (!enable_reg)
-              begin
-                word_ctr_rst             = 1;
-                entropy_collect_ctrl_new = ENTROPY_IDLE;
-                entropy_collect_ctrl_we  = 1;
-              end
-            else
-              begin
-                if (word_ctr_reg == 5'h1f)
-                  begin
-                    block_done               = 1;
-                    entropy_collect_ctrl_new = ENTROPY_IDLE;
-                    entropy_collect_ctrl_we  = 1;
-                  end
-                else
-                  begin
-                    word_ctr_inc             = 1;
-                    entropy_collect_ctrl_new = ENTROPY_SRC0;
-                    entropy_collect_ctrl_we  = 1;
-                  end
-              end
+            turn_enabled  = entropy0_enabled;
+            turn_valid    = src0_valid_reg;
+            muxed_entropy = src0_data_reg;
           end
+      endcase // case (rr_ptr_reg)
 
-      endcase // case (entropy_collect_ctrl_reg)
-    end // entropy_mux
+      if (discard)
+        begin
+          word_ctr_rst            = 1;
+          rr_ptr_rst              = 1;
+          entropy_timeout_ctr_rst = 1;
+        end
+      else if (enable_reg && !block_full_reg)
+        begin
+          if (turn_enabled && turn_valid)
+            begin
+              case (rr_ptr_reg)
+                2'h1:    src1_take = 1;
+                2'h2:    src2_take = 1;
+                default: src0_take = 1;
+              endcase // case (rr_ptr_reg)
+
+              update_block            = 1;
+              rr_ptr_inc              = 1;
+              entropy_timeout_ctr_rst = 1;
+
+              if (word_ctr_reg == 5'h1f)
+                begin
+                  block_done   = 1;
+                  word_ctr_rst = 1;
+                end
+              else
+                begin
+                  word_ctr_inc = 1;
+                end
+            end
+          else if (!turn_enabled || entropy_timeout)
+            begin
+              rr_ptr_inc              = 1;
+              entropy_timeout_ctr_rst = 1;
+            end
+          else
+            begin
+              entropy_timeout_ctr_inc = 1;
+            end
+        end
+    end // block_fill
+
+
+  //----------------------------------------------------------------
+  // rr_ptr_logic
+  //
+  // Whose turn it is to give the next word of the block.
+  //----------------------------------------------------------------
+  always @*
+    begin : rr_ptr_logic
+      rr_ptr_new = 2'h0;
+      rr_ptr_we  = 0;
+
+      if (rr_ptr_rst)
+        begin
+          rr_ptr_new = 2'h0;
+          rr_ptr_we  = 1;
+        end
+
+      if (rr_ptr_inc)
+        begin
+          rr_ptr_new = (rr_ptr_reg == 2'h2) ? 2'h0 : rr_ptr_reg + 1'b1;
+          rr_ptr_we  = 1;
+        end
+    end // rr_ptr_logic
+
+
+  //----------------------------------------------------------------
+  // entropy_timeout_logic
+  //
+  // Logic that updates the entropy timeout counter and signals
+  // when the wait for entropy from the source whose turn it is has
+  // exceeded acceptable time.
+  //----------------------------------------------------------------
+  always @*
+    begin : entropy_timeout_logic
+      entropy_timeout_ctr_new = 24'h000000;
+      entropy_timeout_ctr_we  = 0;
+      entropy_timeout         = 0;
+
+      if (entropy_timeout_ctr_reg == entropy_timeout_reg)
+        begin
+          entropy_timeout         = 1;
+          entropy_timeout_ctr_new = 24'h000000;
+          entropy_timeout_ctr_we  = 1;
+        end
+
+      if (entropy_timeout_ctr_rst)
+        begin
+          entropy_timeout_ctr_new = 24'h000000;
+          entropy_timeout_ctr_we  = 1;
+        end
+
+      if (entropy_timeout_ctr_inc)
+        begin
+          entropy_timeout_ctr_new = entropy_timeout_ctr_reg + 1'b1;
+          entropy_timeout_ctr_we  = 1;
+        end
+    end // entropy_timeout_logic
+
+
+  //----------------------------------------------------------------
+  // block_full_logic
+  //
+  // The block is full from the time the last word has been written
+  // until the control FSM has started hashing it.
+  //----------------------------------------------------------------
+  always @*
+    begin : block_full_logic
+      block_full_new = 0;
+      block_full_we  = 0;
+
+      if (block_done)
+        begin
+          block_full_new = 1;
+          block_full_we  = 1;
+        end
+
+      if (block_rst || discard)
+        begin
+          block_full_new = 0;
+          block_full_we  = 1;
+        end
+    end // block_full_logic
 
 
   //----------------------------------------------------------------
@@ -880,40 +1036,6 @@ module trng_mixer(
     end // word_mux
 
 
-  //----------------------------------------------------------------
-  // entropy_timeout_logic
-  //
-  // Logic that updates the entropy timeout counter and signals
-  // when the wait for antropy from a provider has exceeded
-  // acceptable time.
-  //----------------------------------------------------------------
-  always @*
-    begin : entropy_timeout_logic
-      entropy_timeout_ctr_new = 24'h000000;
-      entropy_timeout_ctr_we  = 0;
-      entropy_timeout         = 0;
-
-      if (entropy_timeout_ctr_reg == entropy_timeout_reg)
-        begin
-          entropy_timeout         = 1;
-          entropy_timeout_ctr_new = 24'h000000;
-          entropy_timeout_ctr_we  = 1;
-        end
-
-      if (entropy_timeout_ctr_rst)
-        begin
-          entropy_timeout_ctr_new = 24'h000000;
-          entropy_timeout_ctr_we  = 1;
-        end
-
-      if (entropy_timeout_ctr_inc)
-        begin
-          entropy_timeout_ctr_new = entropy_timeout_ctr_reg + 1'b1;
-          entropy_timeout_ctr_we  = 1;
-        end
-    end
-
-
   //----------------------------------------------------------------
   // word_ctr
   //----------------------------------------------------------------
@@ -939,58 +1061,65 @@ module trng_mixer(
   //----------------------------------------------------------------
   // mixer_ctrl_fsm
   //
-  // Control FSM for the mixer.
+  // Control FSM for the mixer. Hashes each block as soon as it is
+  // full and moves the digest into the seed register as soon as
+  // that is free, that is when the previous seed has been acked.
+  // The block is released for collection of the next block when
+  // hashing starts, and the hash core keeps the digest stable until
+  // the next block is hashed, so the mixer always works one seed
+  // ahead of the csprng.
   //----------------------------------------------------------------
   always @*
     begin : mixer_ctrl_fsm
+      seed_we        = 0;
       seed_syn_new   = 0;
       seed_syn_we    = 0;
       init_done_new  = 0;
       init_done_we   = 0;
       hash_init      = 0;
       hash_next      = 0;
-      collect_block  = 0;
+      block_rst      = 0;
       mixer_ctrl_new = CTRL_IDLE;
       mixer_ctrl_we  = 0;
 
-      case (mixer_ctrl_reg)
-        CTRL_IDLE:
-          begin
-            if (more_seed)
-              begin
-                collect_block  = 1;
-                init_done_new  = 0;
-                init_done_we   = 1;
-                mixer_ctrl_new = CTRL_COLLECT;
-                mixer_ctrl_we  = 1;
-              end
-          end
+      // An acked seed is used up.
+      if (seed_ack)
+        begin
+          seed_syn_new = 0;
+          seed_syn_we  = 1;
+        end
 
-        CTRL_COLLECT:
-          begin
-            if ((discard))
+      if (discard)
+        begin
+          seed_syn_new   = 0;
+          seed_syn_we    = 1;
+          init_done_new  = 0;
+          init_done_we   = 1;
+          mixer_ctrl_new = CTRL_IDLE;
+          mixer_ctrl_we  = 1;
+        end
+      else
+        begin
+          case (mixer_ctrl_reg)
+            CTRL_IDLE:
               begin
-                mixer_ctrl_new = CTRL_IDLE;
-                mixer_ctrl_we  = 1;
+                if (enable_reg)
+                  begin
+                    mixer_ctrl_new = CTRL_COLLECT;
+                    mixer_ctrl_we  = 1;
+                  end
               end
-            else
+
+            CTRL_COLLECT:
               begin
-                if (block_done)
+                if (block_full_reg)
                   begin
                     mixer_ctrl_new = CTRL_MIX;
                     mixer_ctrl_we  = 1;
                   end
               end
-          end
 
-        CTRL_MIX:
-          begin
-            if ((discard))
-              begin
-                mixer_ctrl_new = CTRL_IDLE;
-                mixer_ctrl_we  = 1;
-              end
-            else
+            CTRL_MIX:
               begin
                 if (init_done_reg)
                   begin
@@ -1000,62 +1129,41 @@ module trng_mixer(
                   begin
                     hash_init = 1;
                   end
-                mixer_ctrl_new = CTRL_SYN;
+                init_done_new  = 1;
+                init_done_we   = 1;
+                block_rst      = 1;
+                mixer_ctrl_new = CTRL_HASH;
                 mixer_ctrl_we  = 1;
               end
-          end
 
-        CTRL_SYN:
-          begin
-            if ((discard))
+            CTRL_HASH:
               begin
-                mixer_ctrl_new = CTRL_IDLE;
-                mixer_ctrl_we  = 1;
-              end
-            else if (hash_ready)
-              begin
-                seed_syn_new   = 1;
-                seed_syn_we    = 1;
-                mixer_ctrl_new = CTRL_ACK;
-                mixer_ctrl_we  = 1;
+                if (hash_ready)
+                  begin
+                    mixer_ctrl_new = CTRL_SEED;
+                    mixer_ctrl_we  = 1;
+                  end
               end
 
-          end
-
-        CTRL_ACK:
-          begin
-            if ((discard))
+            CTRL_SEED:
               begin
-                mixer_ctrl_new = CTRL_IDLE;
-                mixer_ctrl_we  = 1;
-              end
-            else if (seed_ack)
-              begin
-                seed_syn_new   = 0;
-                seed_syn_we    = 1;
-                mixer_ctrl_new = CTRL_NEXT;
-                mixer_ctrl_we  = 1;
+                if (!seed_syn_reg || seed_ack)
+                  begin
+                    seed_we        = 1;
+                    seed_syn_new   = 1;
+                    seed_syn_we    = 1;
+                    mixer_ctrl_new = CTRL_COLLECT;
+                    mixer_ctrl_we  = 1;
+                  end
               end
-          end
 
-        CTRL_NEXT:
-          begin
-            if ((discard))
+            default:
               begin
                 mixer_ctrl_new = CTRL_IDLE;
                 mixer_ctrl_we  = 1;
               end
-            else if (more_seed)
-              begin
-                collect_block  = 1;
-                init_done_new  = 1;
-                init_done_we   = 1;
-                mixer_ctrl_new = CTRL_COLLECT;
-                mixer_ctrl_we  = 1;
-              end
-          end
-
-      endcase // case (cspng_ctrl_reg)
+          endcase // case (mixer_ctrl_reg)
+        end
     end // mixer_ctrl_fsm
 
 endmodule // trng_mixer
@@ -74,6 +74,7 @@ module tb_csprng_fifo();
   wire          tb_rnd_syn;
   wire [31 : 0] tb_rnd_data;
   reg           tb_rnd_ack;
+  wire [6 : 0]  tb_rnd_words;
 
   reg [7 : 0]   i;
 
@@ -92,7 +93,9 @@ module tb_csprng_fifo();
 
                        .rnd_syn(tb_rnd_syn),
                        .rnd_data(tb_rnd_data),
-                       .rnd_ack(tb_rnd_ack)
+                       .rnd_ack(tb_rnd_ack),
+
+                       .rnd_words(tb_rnd_words)
                       );
 
 
@@ -322,13 +325,35 @@ module tb_csprng_fifo();
     begin
       $display("*** Reading from the fifo: 0x%08x", tb_rnd_data);
       tb_rnd_ack = 1;
-      #(2 * CLK_PERIOD);
+      #(CLK_PERIOD);
       tb_rnd_ack = 0;
+      #(CLK_PERIOD);
       dump_dut_state();
     end
   endtask // read_w32
 
 
+  //----------------------------------------------------------------
+  // check_rnd_words()
+  //
+  // Check that the fill level reported by the fifo matches
+  // the expected number of available 32-bit words.
+  //----------------------------------------------------------------
+  task check_rnd_words(input [6 : 0] expected);
+    begin
+      tc_ctr = tc_ctr + 1;
+      if (tb_rnd_words == expected)
+        $display("*** Fill level %02d words as expected.", tb_rnd_words);
+      else
+        begin
+          $display("*** ERROR: Fill level %02d words, expected %02d.",
+                   tb_rnd_words, expected);
+          error_ctr = error_ctr + 1;
+        end
+    end
+  endtask // check_rnd_words
+
+
   //----------------------------------------------------------------
   // fifo_test()
   //
@@ -358,6 +383,7 @@ module tb_csprng_fifo();
 
       dump_dut_state();
       dump_fifo();
+      check_rnd_words(7'd64);
 
       // Read out a number of words from the fifo.
       for (j = 0 ; j < 17 ; j = j + 1)
@@ -367,6 +393,7 @@ module tb_csprng_fifo();
 
       dump_dut_state();
       dump_fifo();
+      check_rnd_words(7'd47);
 
       // Write another 512-bit word into the fifo.
       write_w512(8'h40);
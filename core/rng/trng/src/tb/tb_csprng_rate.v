@@ -0,0 +1,535 @@
+//======================================================================
+//
+// tb_csprng_rate.v
+// ----------------
+// Read rate testbench for the csprng. The testbench plays the part of
+// the mixer, always having a seed ready, and reads random words the
+// two ways the host can: polling status before every word, and
+// reading the fill level and then bursting that many words from the
+// data window. Every bus access is followed by a number of idle
+// cycles to model the cost of the bus. For each case we report the
+// cycles and accesses per word and the resulting MB/s at a 50 MHz
+// clock, and check that both ways read the same words. Finally the
+// burst rate is measured for a number of ChaCha round counts and
+// reseed intervals.
+//
+//
+// Copyright (c) 2014, NORDUnet A/S
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// - Neither the name of the NORDUnet nor the names of its contributors may
+//   be used to endorse or promote products derived from this software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+//------------------------------------------------------------------
+// Test module.
+//------------------------------------------------------------------
+module tb_csprng_rate();
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  parameter DEBUG     = 0;
+
+  parameter CLK_HALF_PERIOD = 1;
+  parameter CLK_PERIOD      = 2 * CLK_HALF_PERIOD;
+
+  parameter CLK_FREQ        = 50000000;
+  parameter NUM_WORDS       = 2048;
+  parameter MAX_BURST       = 32;
+
+  localparam ADDR_CTRL            = 8'h08;
+  localparam CTRL_ENABLE_BIT      = 0;
+  localparam CTRL_SEED_BIT        = 1;
+  localparam ADDR_STATUS          = 8'h09;
+  localparam STATUS_RND_VALID_BIT = 1;
+  localparam ADDR_RND_AVAIL       = 8'h12;
+  localparam ADDR_STAT_RESEEDS    = 8'h16;
+  localparam ADDR_RND_DATA        = 8'h20;
+  localparam ADDR_NUM_ROUNDS      = 8'h40;
+  localparam ADDR_NUM_BLOCKS_LOW  = 8'h41;
+  localparam ADDR_NUM_BLOCKS_HIGH = 8'h42;
+
+
+  //----------------------------------------------------------------
+  // Register and Wire declarations.
+  //----------------------------------------------------------------
+  reg [31 : 0]  cycle_ctr;
+  reg [31 : 0]  error_ctr;
+  reg [31 : 0]  tc_ctr;
+
+  reg           tb_clk;
+  reg           tb_reset_n;
+
+  reg           tb_cs;
+  reg           tb_we;
+  reg [7 : 0]   tb_address;
+  reg [31 : 0]  tb_write_data;
+  wire [31 : 0] tb_read_data;
+  wire          tb_error;
+
+  wire          tb_more_seed;
+  wire          tb_security_error;
+  reg [31 : 0]  seed_ctr;
+  wire [511 : 0] tb_seed_data;
+  wire          tb_seed_ack;
+
+  reg [31 : 0]  read_data;
+  reg           read_error;
+  reg [31 : 0]  bus_gap;
+  reg [31 : 0]  access_ctr;
+  reg [31 : 0]  read_errors;
+  reg [31 : 0]  checksum;
+
+
+  //----------------------------------------------------------------
+  // The seed source. A new seed is ready as soon as the previous
+  // one has been acked.
+  //----------------------------------------------------------------
+  assign tb_seed_data = {16{seed_ctr ^ 32'h5ca1ab1e}};
+
+  always @ (posedge tb_clk)
+    begin : seed_source
+      if (tb_seed_ack)
+        seed_ctr <= seed_ctr + 1'b1;
+    end
+
+
+  //----------------------------------------------------------------
+  // Device Under Test.
+  //----------------------------------------------------------------
+  trng_csprng dut(
+                  .clk(tb_clk),
+                  .reset_n(tb_reset_n),
+
+                  .cs(tb_cs),
+                  .we(tb_we),
+                  .address(tb_address),
+                  .write_data(tb_write_data),
+                  .read_data(tb_read_data),
+                  .error(tb_error),
+
+                  .discard(1'b0),
+                  .test_mode(1'b0),
+                  .more_seed(tb_more_seed),
+                  .security_error(tb_security_error),
+
+                  .seed_data(tb_seed_data),
+                  .seed_syn(1'b1),
+                  .seed_ack(tb_seed_ack),
+
+                  .debug(),
+                  .debug_update(1'b0)
+                 );
+
+
+  //----------------------------------------------------------------
+  // clk_gen
+  //
+  // Always running clock generator process.
+  //----------------------------------------------------------------
+  always
+    begin : clk_gen
+      #CLK_HALF_PERIOD;
+      tb_clk = !tb_clk;
+    end // clk_gen
+
+
+  //----------------------------------------------------------------
+  // sys_monitor()
+  //
+  // An always running process that creates a cycle counter.
+  //----------------------------------------------------------------
+  always
+    begin : sys_monitor
+      cycle_ctr = cycle_ctr + 1;
+      #(CLK_PERIOD);
+    end
+
+
+  //----------------------------------------------------------------
+  // reset_dut()
+  //
+  // Toggle reset to put the DUT and the seed source into a well
+  // known state.
+  //----------------------------------------------------------------
+  task reset_dut;
+    begin
+      tb_reset_n = 0;
+      seed_ctr   = 32'h0;
+      #(4 * CLK_PERIOD);
+      tb_reset_n = 1;
+    end
+  endtask // reset_dut
+
+
+  //----------------------------------------------------------------
+  // display_test_results()
+  //
+  // Display the accumulated test results.
+  //----------------------------------------------------------------
+  task display_test_results;
+    begin
+      if (error_ctr == 0)
+        begin
+          $display("*** All %02d test cases completed successfully", tc_ctr);
+        end
+      else
+        begin
+          $display("*** %02d tests completed - %02d test cases did not complete successfully.",
+                   tc_ctr, error_ctr);
+        end
+    end
+  endtask // display_test_results
+
+
+  //----------------------------------------------------------------
+  // init_sim()
+  //
+  // Initialize all counters and testbed functionality as well
+  // as setting the DUT inputs to defined values.
+  //----------------------------------------------------------------
+  task init_sim;
+    begin
+      cycle_ctr     = 0;
+      error_ctr     = 0;
+      tc_ctr        = 0;
+
+      tb_clk        = 0;
+      tb_reset_n    = 1;
+
+      tb_cs         = 0;
+      tb_we         = 0;
+      tb_address    = 8'h00;
+      tb_write_data = 32'h00000000;
+
+      seed_ctr      = 32'h0;
+      bus_gap       = 0;
+      access_ctr    = 0;
+    end
+  endtask // init_sim
+
+
+  //----------------------------------------------------------------
+  // read_word()
+  //
+  // Read a data word from the given address in the DUT into
+  // read_data, and the error signal into read_error. The access
+  // takes one cycle, as on the bus, plus bus_gap idle cycles. The
+  // data is sampled at the clock edge that sees cs, which is also
+  // the edge where a read in the data window pops the FIFO. Accesses
+  // start and end half a period away from that edge.
+  //----------------------------------------------------------------
+  task read_word(input [7 : 0] address);
+    begin
+      tb_address = address;
+      tb_cs = 1;
+      tb_we = 0;
+      @(posedge tb_clk);
+      read_data  = tb_read_data;
+      read_error = tb_error;
+      #(CLK_HALF_PERIOD);
+      tb_cs = 0;
+      #(bus_gap * CLK_PERIOD);
+      access_ctr = access_ctr + 1;
+
+      if (DEBUG)
+        $display("*** Reading 0x%08x from 0x%02x.", read_data, address);
+    end
+  endtask // read_word
+
+
+  //----------------------------------------------------------------
+  // write_word()
+  //
+  // Write a data word to the given address in the DUT. Used for
+  // configuration only, so it is not counted and has no bus gap.
+  //----------------------------------------------------------------
+  task write_word(input [7 : 0] address, input [31 : 0] word);
+    begin
+      tb_address    = address;
+      tb_write_data = word;
+      tb_cs         = 1;
+      tb_we         = 1;
+      #(CLK_PERIOD);
+      tb_cs         = 0;
+      tb_we         = 0;
+      #(CLK_PERIOD);
+    end
+  endtask // write_word
+
+
+  //----------------------------------------------------------------
+  // take_word()
+  //
+  // Add a random word to the checksum, and count a read error.
+  //----------------------------------------------------------------
+  task take_word;
+    begin
+      checksum = {checksum[30 : 0], checksum[31]} ^ read_data;
+      if (read_error)
+        read_errors = read_errors + 1;
+    end
+  endtask // take_word
+
+
+  //----------------------------------------------------------------
+  // read_per_word()
+  //
+  // Read NUM_WORDS words polling status before every word, as
+  // readers of the csprng before version 0.51 had to.
+  //----------------------------------------------------------------
+  task read_per_word;
+    reg [31 : 0] i;
+    begin
+      for (i = 0 ; i < NUM_WORDS ; i = i + 1)
+        begin
+          read_data = 0;
+          while (!read_data[STATUS_RND_VALID_BIT])
+            read_word(ADDR_STATUS);
+
+          read_word(ADDR_RND_DATA);
+          take_word();
+        end
+    end
+  endtask // read_per_word
+
+
+  //----------------------------------------------------------------
+  // read_burst()
+  //
+  // Read NUM_WORDS words by reading the fill level and then up to
+  // MAX_BURST words from consecutive addresses in the data window.
+  //----------------------------------------------------------------
+  task read_burst;
+    reg [31 : 0] i;
+    reg [31 : 0] j;
+    reg [31 : 0] burst;
+    begin
+      i = 0;
+      while (i < NUM_WORDS)
+        begin
+          read_word(ADDR_RND_AVAIL);
+          burst = read_data;
+          if (burst > MAX_BURST)
+            burst = MAX_BURST;
+          if (burst > NUM_WORDS - i)
+            burst = NUM_WORDS - i;
+
+          for (j = 0 ; j < burst ; j = j + 1)
+            begin
+              read_word(ADDR_RND_DATA + j[4 : 0]);
+              take_word();
+            end
+          i = i + burst;
+        end
+    end
+  endtask // read_burst
+
+
+  //----------------------------------------------------------------
+  // rate_test()
+  //
+  // Read NUM_WORDS words from a freshly reset csprng, per word or
+  // in bursts, with gap idle cycles after every bus access. The
+  // first block is waited for before the clock starts, so that the
+  // seeding is not counted. Returns the checksum of the words.
+  //----------------------------------------------------------------
+  task rate_test(input burst_mode, input [31 : 0] gap, output [31 : 0] sum);
+    reg [31 : 0] start;
+    reg [31 : 0] cycles;
+    reg [31 : 0] accesses;
+    begin
+      tc_ctr = tc_ctr + 1;
+      reset_dut();
+
+      bus_gap = 0;
+      read_data = 0;
+      while (!read_data[STATUS_RND_VALID_BIT])
+        read_word(ADDR_STATUS);
+
+      bus_gap     = gap;
+      checksum    = 32'h0;
+      read_errors = 0;
+      access_ctr  = 0;
+      start       = cycle_ctr;
+
+      if (burst_mode)
+        read_burst();
+      else
+        read_per_word();
+
+      cycles   = cycle_ctr - start;
+      accesses = access_ctr;
+      sum      = checksum;
+
+      $display("*** TC%0d: %0s reads, %0d cycles per access:", tc_ctr,
+               burst_mode ? "burst" : "per word", gap + 1);
+      $display("    %0d words in %0d cycles, %0d accesses, %0d.%02d cycles/word, %0d.%02d MB/s at %0d MHz",
+               NUM_WORDS, cycles, accesses,
+               cycles / NUM_WORDS, ((100 * cycles) / NUM_WORDS) % 100,
+               ((4 * NUM_WORDS) * (CLK_FREQ / 1000000)) / cycles,
+               (((400 * NUM_WORDS) * (CLK_FREQ / 1000000)) / cycles) % 100,
+               CLK_FREQ / 1000000);
+
+      if (read_errors != 0)
+        begin
+          $display("*** Error: %0d reads from the data window found the FIFO empty.",
+                   read_errors);
+          error_ctr = error_ctr + 1;
+        end
+    end
+  endtask // rate_test
+
+
+  //----------------------------------------------------------------
+  // reseed_test()
+  //
+  // Set the number of ChaCha rounds and the number of blocks
+  // between reseeds, force a reseed so that they apply at once, and
+  // burst read NUM_WORDS words on a bus as fast as the core. This is
+  // the rate at the core side of the sweep done by csprng_tester.
+  // The number of reseeds seen must match the interval.
+  //----------------------------------------------------------------
+  task reseed_test(input [4 : 0] rounds, input [31 : 0] blocks);
+    reg [31 : 0] start;
+    reg [31 : 0] cycles;
+    reg [31 : 0] reseeds;
+    begin
+      tc_ctr = tc_ctr + 1;
+      reset_dut();
+
+      write_word(ADDR_NUM_ROUNDS, {27'h0, rounds});
+      write_word(ADDR_NUM_BLOCKS_LOW, blocks);
+      write_word(ADDR_NUM_BLOCKS_HIGH, 32'h0);
+      write_word(ADDR_CTRL, (32'h1 << CTRL_SEED_BIT) | (32'h1 << CTRL_ENABLE_BIT));
+
+      bus_gap = 0;
+      read_data = 0;
+      while (!read_data[STATUS_RND_VALID_BIT])
+        read_word(ADDR_STATUS);
+
+      read_word(ADDR_STAT_RESEEDS);
+      reseeds = read_data;
+
+      checksum    = 32'h0;
+      read_errors = 0;
+      start       = cycle_ctr;
+      read_burst();
+      cycles = cycle_ctr - start;
+
+      read_word(ADDR_STAT_RESEEDS);
+      reseeds = read_data - reseeds;
+
+      $display("*** TC%0d: %0d rounds, reseed every %0d blocks:", tc_ctr, rounds, blocks);
+      $display("    %0d words in %0d cycles, %0d reseeds, %0d.%02d MB/s at %0d MHz",
+               NUM_WORDS, cycles, reseeds,
+               ((4 * NUM_WORDS) * (CLK_FREQ / 1000000)) / cycles,
+               (((400 * NUM_WORDS) * (CLK_FREQ / 1000000)) / cycles) % 100,
+               CLK_FREQ / 1000000);
+
+      if (read_errors != 0)
+        begin
+          $display("*** Error: %0d reads from the data window found the FIFO empty.",
+                   read_errors);
+          error_ctr = error_ctr + 1;
+        end
+
+      if ((reseeds * blocks > NUM_WORDS / 16 + blocks) ||
+          ((reseeds + 1) * blocks < NUM_WORDS / 16))
+        begin
+          $display("*** Error: %0d reseeds do not match the interval.", reseeds);
+          error_ctr = error_ctr + 1;
+        end
+    end
+  endtask // reseed_test
+
+
+  //----------------------------------------------------------------
+  // compare_sums()
+  //
+  // Both ways of reading must give the same words.
+  //----------------------------------------------------------------
+  task compare_sums(input [31 : 0] word_sum, input [31 : 0] burst_sum);
+    begin
+      if (word_sum != burst_sum)
+        begin
+          $display("*** Error: burst reads gave other words, checksum 0x%08x, expected 0x%08x.",
+                   burst_sum, word_sum);
+          error_ctr = error_ctr + 1;
+        end
+      $display("");
+    end
+  endtask // compare_sums
+
+
+  //----------------------------------------------------------------
+  // csprng_rate_test
+  //
+  // The main test functionality.
+  //----------------------------------------------------------------
+  initial
+    begin : csprng_rate_test
+      reg [31 : 0] word_sum;
+      reg [31 : 0] burst_sum;
+      reg [31 : 0] rounds;
+      reg [31 : 0] blocks;
+
+      $display("   -= Read rate testbench for csprng started =-");
+      $display("    ===========================================");
+      $display("");
+
+      init_sim();
+
+      // A bus as fast as the core.
+      rate_test(0, 0, word_sum);
+      rate_test(1, 0, burst_sum);
+      compare_sums(word_sum, burst_sum);
+
+      // A bus where every access costs eight cycles.
+      rate_test(0, 7, word_sum);
+      rate_test(1, 7, burst_sum);
+      compare_sums(word_sum, burst_sum);
+
+      // The cost of rounds and reseeds at the core.
+      for (rounds = 8 ; rounds <= 24 ; rounds = rounds + 4)
+        if (rounds != 16)
+          for (blocks = 1 ; blocks <= 1024 ; blocks = blocks * 32)
+            reseed_test(rounds[4 : 0], blocks);
+      $display("");
+
+      display_test_results();
+
+      $display("");
+      $display("*** Csprng rate simulation done. ***");
+      $finish;
+    end // csprng_rate_test
+endmodule // tb_csprng_rate
+
+//======================================================================
+// EOF tb_csprng_rate.v
+//======================================================================
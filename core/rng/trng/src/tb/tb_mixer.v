@@ -70,7 +70,6 @@ module tb_mixer();
 
   reg            tb_discard;
   reg            tb_test_mode;
-  reg            tb_more_seed;
   wire           tb_security_error;
 
   reg            tb_entropy0_enabled;
@@ -113,8 +112,6 @@ module tb_mixer();
                  .test_mode(tb_test_mode),
                  .security_error(tb_security_error),
 
-                 .more_seed(tb_more_seed),
-
                  .entropy0_enabled(tb_entropy0_enabled),
                  .entropy0_syn(tb_entropy0_syn),
                  .entropy0_data(tb_entropy0_data),
@@ -290,7 +287,6 @@ module tb_mixer();
 
       tb_discard          = 0;
       tb_test_mode        = 0;
-      tb_more_seed        = 0;
 
       tb_entropy0_enabled = 0;
       tb_entropy0_syn     = 0;
@@ -327,7 +323,6 @@ module tb_mixer();
       tb_entropy2_data    = 32'haa55aa55;
 
       tb_enable           = 1;
-      tb_more_seed        = 1;
       tb_ack              = 1;
 
       #(50000 * CLK_PERIOD);
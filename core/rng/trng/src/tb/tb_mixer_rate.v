@@ -0,0 +1,473 @@
+//======================================================================
+//
+// tb_mixer_rate.v
+// ---------------
+// Seed rate testbench for the mixer. The mixer is fed by the fake
+// avalanche and rosc entropy modules, throttled by the testbench to
+// model the latency of real sources, and the testbench plays the part
+// of the csprng, asking for two seeds per reseed. For each source
+// configuration we report the cycles per seed and the resulting seeds
+// per second at a 50 MHz clock, both for back-to-back reseeds and for
+// a reseed after the mixer has been left alone for a while, and check
+// that both sources give the same share of the words however different
+// their rates are.
+//
+// The testbench only uses the mixer ports, so the same testbench can
+// be run against earlier versions of the mixer for comparison. Those
+// before 0.51 have a more_seed port, define MIXER_MORE_SEED for them,
+// e.g. make mixer_rate.sim MIXER_SRC=old_mixer.v RATE_FLAGS=-DMIXER_MORE_SEED
+//
+//
+// Author: Joachim Strombergson
+// Copyright (c) 2014, NORDUnet A/S All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// - Neither the name of the NORDUnet nor the names of its contributors may
+//   be used to endorse or promote products derived from this software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+//------------------------------------------------------------------
+// Test module.
+//------------------------------------------------------------------
+module tb_mixer_rate();
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  parameter DEBUG     = 0;
+
+  parameter CLK_HALF_PERIOD = 1;
+  parameter CLK_PERIOD      = 2 * CLK_HALF_PERIOD;
+
+  parameter CLK_FREQ        = 50000000;
+  parameter NUM_RESEEDS     = 16;
+  parameter IDLE_CYCLES     = 100000;
+
+
+  //----------------------------------------------------------------
+  // Register and Wire declarations.
+  //----------------------------------------------------------------
+  reg [31 : 0]  cycle_ctr;
+  reg [31 : 0]  error_ctr;
+  reg [31 : 0]  tc_ctr;
+
+  reg            tb_clk;
+  reg            tb_reset_n;
+
+  reg            tb_cs;
+  reg            tb_we;
+  reg [7 : 0]    tb_address;
+  reg [31 : 0]   tb_write_data;
+  wire [31 : 0]  tb_read_data;
+  wire           tb_error;
+
+  reg            tb_discard;
+  reg            tb_test_mode;
+  reg            tb_more_seed;
+  wire           tb_security_error;
+
+  wire           tb_entropy1_enabled;
+  wire           tb_entropy1_valid;
+  wire           tb_entropy1_syn;
+  wire [31 : 0]  tb_entropy1_data;
+  wire           tb_entropy1_ack;
+
+  wire           tb_entropy2_enabled;
+  wire           tb_entropy2_valid;
+  wire           tb_entropy2_syn;
+  wire [31 : 0]  tb_entropy2_data;
+  wire           tb_entropy2_ack;
+
+  wire [511 : 0] tb_seed_data;
+  wire           tb_seed_syn;
+  reg            tb_seed_ack;
+
+  reg [31 : 0]   delay1;
+  reg [31 : 0]   delay2;
+  reg [31 : 0]   throttle1_ctr;
+  reg [31 : 0]   throttle2_ctr;
+  reg [31 : 0]   ack1_ctr;
+  reg [31 : 0]   ack2_ctr;
+
+  reg [511 : 0]  prev_seed;
+  reg [31 : 0]   seed_ctr;
+
+
+  //----------------------------------------------------------------
+  // Entropy sources. The fake modules always have data, the
+  // throttles hold off their syn for delay cycles after each ack.
+  //----------------------------------------------------------------
+  avalanche_entropy entropy1(
+                             .clk(tb_clk),
+                             .reset_n(tb_reset_n),
+
+                             .noise(1'b0),
+
+                             .cs(1'b0),
+                             .we(1'b0),
+                             .address(8'h00),
+                             .write_data(32'h00000000),
+                             .read_data(),
+                             .error(),
+
+                             .discard(tb_discard),
+                             .test_mode(tb_test_mode),
+                             .security_error(),
+
+                             .entropy_enabled(tb_entropy1_enabled),
+                             .entropy_data(tb_entropy1_data),
+                             .entropy_valid(tb_entropy1_valid),
+                             .entropy_ack(tb_entropy1_ack),
+
+                             .debug(),
+                             .debug_update(1'b0)
+                            );
+
+  rosc_entropy entropy2(
+                        .clk(tb_clk),
+                        .reset_n(tb_reset_n),
+
+                        .cs(1'b0),
+                        .we(1'b0),
+                        .address(8'h00),
+                        .write_data(32'h00000000),
+                        .read_data(),
+                        .error(),
+
+                        .discard(tb_discard),
+                        .test_mode(tb_test_mode),
+                        .security_error(),
+
+                        .entropy_enabled(tb_entropy2_enabled),
+                        .entropy_data(tb_entropy2_data),
+                        .entropy_valid(tb_entropy2_valid),
+                        .entropy_ack(tb_entropy2_ack),
+
+                        .debug(),
+                        .debug_update(1'b0)
+                       );
+
+  assign tb_entropy1_syn = tb_entropy1_valid && (throttle1_ctr == 32'h0);
+  assign tb_entropy2_syn = tb_entropy2_valid && (throttle2_ctr == 32'h0);
+
+
+  //----------------------------------------------------------------
+  // Device Under Test.
+  //----------------------------------------------------------------
+  trng_mixer dut(
+                 .clk(tb_clk),
+                 .reset_n(tb_reset_n),
+
+                 .cs(tb_cs),
+                 .we(tb_we),
+                 .address(tb_address),
+                 .write_data(tb_write_data),
+                 .read_data(tb_read_data),
+                 .error(tb_error),
+
+                 .discard(tb_discard),
+                 .test_mode(tb_test_mode),
+                 .security_error(tb_security_error),
+
+`ifdef MIXER_MORE_SEED
+                 .more_seed(tb_more_seed),
+`endif
+
+                 .entropy0_enabled(1'b0),
+                 .entropy0_syn(1'b0),
+                 .entropy0_data(32'h00000000),
+                 .entropy0_ack(),
+
+                 .entropy1_enabled(tb_entropy1_enabled),
+                 .entropy1_syn(tb_entropy1_syn),
+                 .entropy1_data(tb_entropy1_data),
+                 .entropy1_ack(tb_entropy1_ack),
+
+                 .entropy2_enabled(tb_entropy2_enabled),
+                 .entropy2_syn(tb_entropy2_syn),
+                 .entropy2_data(tb_entropy2_data),
+                 .entropy2_ack(tb_entropy2_ack),
+
+                 .seed_data(tb_seed_data),
+                 .seed_syn(tb_seed_syn),
+                 .seed_ack(tb_seed_ack),
+
+                 .debug(),
+                 .debug_update(1'b0)
+                );
+
+
+  //----------------------------------------------------------------
+  // clk_gen
+  //
+  // Always running clock generator process.
+  //----------------------------------------------------------------
+  always
+    begin : clk_gen
+      #CLK_HALF_PERIOD;
+      tb_clk = !tb_clk;
+    end // clk_gen
+
+
+  //----------------------------------------------------------------
+  // sys_monitor()
+  //
+  // An always running process that creates a cycle counter.
+  //----------------------------------------------------------------
+  always
+    begin : sys_monitor
+      cycle_ctr = cycle_ctr + 1;
+      #(CLK_PERIOD);
+    end
+
+
+  //----------------------------------------------------------------
+  // throttle
+  //
+  // Source latency models. Restart the delay after every ack, and
+  // count the acks.
+  //----------------------------------------------------------------
+  always @ (posedge tb_clk)
+    begin : throttle
+      if (tb_entropy1_ack)
+        ack1_ctr <= ack1_ctr + 1'b1;
+
+      if (tb_entropy2_ack)
+        ack2_ctr <= ack2_ctr + 1'b1;
+
+      if (tb_entropy1_ack)
+        throttle1_ctr <= delay1;
+      else if (throttle1_ctr != 32'h0)
+        throttle1_ctr <= throttle1_ctr - 1'b1;
+
+      if (tb_entropy2_ack)
+        throttle2_ctr <= delay2;
+      else if (throttle2_ctr != 32'h0)
+        throttle2_ctr <= throttle2_ctr - 1'b1;
+    end // throttle
+
+
+  //----------------------------------------------------------------
+  // reset_dut()
+  //
+  // Toggle reset to put the DUT into a well known state.
+  //----------------------------------------------------------------
+  task reset_dut;
+    begin
+      tb_reset_n = 0;
+      throttle1_ctr = 32'h0;
+      throttle2_ctr = 32'h0;
+      #(2 * CLK_PERIOD);
+      tb_reset_n = 1;
+    end
+  endtask // reset_dut
+
+
+  //----------------------------------------------------------------
+  // display_test_results()
+  //
+  // Display the accumulated test results.
+  //----------------------------------------------------------------
+  task display_test_results;
+    begin
+      if (error_ctr == 0)
+        begin
+          $display("*** All %02d test cases completed successfully", tc_ctr);
+        end
+      else
+        begin
+          $display("*** %02d tests completed - %02d test cases did not complete successfully.",
+                   tc_ctr, error_ctr);
+        end
+    end
+  endtask // display_test_results
+
+
+  //----------------------------------------------------------------
+  // init_sim()
+  //
+  // Initialize all counters and testbed functionality as well
+  // as setting the DUT inputs to defined values.
+  //----------------------------------------------------------------
+  task init_sim;
+    begin
+      cycle_ctr     = 0;
+      error_ctr     = 0;
+      tc_ctr        = 0;
+
+      tb_clk        = 0;
+      tb_reset_n    = 1;
+      tb_cs         = 0;
+      tb_we         = 0;
+      tb_address    = 8'h00;
+      tb_write_data = 32'h00000000;
+
+      tb_discard    = 0;
+      tb_test_mode  = 0;
+      tb_more_seed  = 0;
+      tb_seed_ack   = 0;
+
+      delay1        = 32'h0;
+      delay2        = 32'h0;
+      throttle1_ctr = 32'h0;
+      throttle2_ctr = 32'h0;
+      ack1_ctr      = 32'h0;
+      ack2_ctr      = 32'h0;
+
+      prev_seed     = {16{32'h0}};
+      seed_ctr      = 0;
+    end
+  endtask // init_sim
+
+
+  //----------------------------------------------------------------
+  // get_seed()
+  //
+  // Ask for one seed the way the csprng does: pulse more_seed,
+  // wait for syn and ack it. Every seed must differ from the
+  // previous one.
+  //----------------------------------------------------------------
+  task get_seed;
+    begin
+      tb_more_seed = 1;
+      #(CLK_PERIOD);
+      tb_more_seed = 0;
+
+      while (!tb_seed_syn)
+        #(CLK_PERIOD);
+
+      if (tb_seed_data == prev_seed)
+        begin
+          $display("*** Error: seed %0d is the same as the previous seed.", seed_ctr);
+          error_ctr = error_ctr + 1;
+        end
+      prev_seed = tb_seed_data;
+      seed_ctr  = seed_ctr + 1;
+
+      if (DEBUG)
+        $display("seed %0d at cycle %0d: 0x%0128x", seed_ctr, cycle_ctr, tb_seed_data);
+
+      tb_seed_ack = 1;
+      #(CLK_PERIOD);
+      tb_seed_ack = 0;
+      #(CLK_PERIOD);
+    end
+  endtask // get_seed
+
+
+  //----------------------------------------------------------------
+  // rate_test()
+  //
+  // Measure the seed rate for the given source latencies.
+  //----------------------------------------------------------------
+  task rate_test(input [31 : 0] d1, input [31 : 0] d2);
+    reg [31 : 0] i;
+    reg [31 : 0] start;
+    reg [31 : 0] cycles;
+    reg [31 : 0] idle_cycles;
+    reg [31 : 0] acks1;
+    reg [31 : 0] acks2;
+    begin
+      tc_ctr = tc_ctr + 1;
+      delay1 = d1;
+      delay2 = d2;
+      reset_dut();
+
+      // The first reseed after reset pays for the initial collection.
+      get_seed();
+      get_seed();
+
+      start = cycle_ctr;
+      acks1 = ack1_ctr;
+      acks2 = ack2_ctr;
+      for (i = 0 ; i < NUM_RESEEDS ; i = i + 1)
+        begin
+          get_seed();
+          get_seed();
+        end
+      cycles = cycle_ctr - start;
+      acks1 = ack1_ctr - acks1;
+      acks2 = ack2_ctr - acks2;
+
+      // Leave the mixer alone, then time a single reseed.
+      #(IDLE_CYCLES * CLK_PERIOD);
+      start = cycle_ctr;
+      get_seed();
+      get_seed();
+      idle_cycles = cycle_ctr - start;
+
+      $display("*** TC%0d: source delays %0d/%0d cycles:", tc_ctr, d1, d2);
+      $display("    back-to-back: %0d cycles per seed, %0d seeds/s at %0d MHz",
+               cycles / (2 * NUM_RESEEDS),
+               (CLK_FREQ * 2 * NUM_RESEEDS) / cycles, CLK_FREQ / 1000000);
+      $display("    after idle:   %0d cycles per reseed", idle_cycles);
+      $display("    words taken:  %0d from source 1, %0d from source 2", acks1, acks2);
+
+      // The sources take turns, so apart from the words staged at
+      // the start and end of the run they give the same number.
+      if ((acks1 > acks2 + 2) || (acks2 > acks1 + 2))
+        begin
+          $display("*** Error: the sources do not take turns.");
+          error_ctr = error_ctr + 1;
+        end
+    end
+  endtask // rate_test
+
+
+  //----------------------------------------------------------------
+  // mixer_rate_test
+  //
+  // The main test functionality.
+  //----------------------------------------------------------------
+  initial
+    begin : mixer_rate_test
+
+      $display("   -= Seed rate testbench for mixer started =-");
+      $display("    ==========================================");
+      $display("");
+
+      init_sim();
+
+      // Sources that always have data.
+      rate_test(0, 0);
+
+      // Two sources with the same latency.
+      rate_test(64, 64);
+
+      // A slow avalanche source next to a fast rosc source.
+      rate_test(2048, 64);
+
+      display_test_results();
+
+      $display("");
+      $display("*** Mixer rate simulation done. ***");
+      $finish;
+    end // mixer_rate_test
+endmodule // tb_mixer_rate
+
+//======================================================================
+// EOF tb_mixer_rate.v
+//======================================================================